@@ -64,18 +64,8 @@ static void zign_rename_for(REvent *ev, int type, void *user, void *data) {
 
 void r_anal_hint_storage_init(RAnal *a);
 void r_anal_hint_storage_fini(RAnal *a);
-
-static void r_meta_item_fini(RAnalMetaItem *item) {
-	free (item->str);
-}
-
-static void r_meta_item_free(void *_item) {
-	if (_item) {
-		RAnalMetaItem *item = _item;
-		r_meta_item_fini (item);
-		free (item);
-	}
-}
+void r_meta_storage_init(RAnal *a);
+void r_meta_storage_fini(RAnal *a);
 
 // Take nullable RArchConfig as argument?
 R_API RAnal *r_anal_new(void) {
@@ -109,7 +99,7 @@ R_API RAnal *r_anal_new(void) {
 	r_event_hook (anal->zign_spaces.event, R_SPACE_EVENT_COUNT, zign_count_for, NULL);
 	r_event_hook (anal->zign_spaces.event, R_SPACE_EVENT_RENAME, zign_rename_for, NULL);
 	r_anal_hint_storage_init (anal);
-	r_interval_tree_init (&anal->meta, r_meta_item_free);
+	r_meta_storage_init (anal);
 	anal->sdb_types = sdb_ns (anal->sdb, "types", 1);
 	anal->sdb_fmts = sdb_ns (anal->sdb, "spec", 1);
 	anal->sdb_cc = sdb_ns (anal->sdb, "cc", 1);
@@ -163,7 +153,7 @@ R_API void r_anal_free(RAnal *a) {
 	ht_pp_free (a->ht_name_fun);
 	set_u_free (a->visited);
 	r_anal_hint_storage_fini (a);
-	r_interval_tree_fini (&a->meta);
+	r_meta_storage_fini (a);
 	// R2_570 r_arch_config_free (a->config); // may cause UAF because this struct must be refcounted
 	free (a->zign_path);
 	r_list_free (a->plugins);
@@ -445,8 +435,8 @@ R_API bool r_anal_op_is_eob(RAnalOp *op) {
 
 R_API void r_anal_purge(RAnal *anal) {
 	r_anal_hint_clear (anal);
-	r_interval_tree_fini (&anal->meta);
-	r_interval_tree_init (&anal->meta, r_meta_item_free);
+	r_meta_storage_fini (anal);
+	r_meta_storage_init (anal);
 	sdb_reset (anal->sdb_types);
 	sdb_reset (anal->sdb_zigns);
 	sdb_reset (anal->sdb_classes);
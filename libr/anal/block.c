@@ -226,6 +226,7 @@ R_API void r_anal_block_set_size(RAnalBlock *block, ut64 size) {
 	// Do the actual resize
 	block->size = size;
 	r_rbtree_aug_update_sum (block->anal->bb_tree, &block->addr, &block->_rb, __bb_addr_cmp, NULL, __max_end);
+	R_DIRTY (block->anal);
 }
 
 R_API bool r_anal_block_relocate(RAnalBlock *block, ut64 addr, ut64 size) {
@@ -267,6 +268,7 @@ R_API bool r_anal_block_relocate(RAnalBlock *block, ut64 addr, ut64 size) {
 	block->size = size;
 	r_anal_block_update_hash (block);
 	r_rbtree_aug_insert (&block->anal->bb_tree, &block->addr, &block->_rb, __bb_addr_cmp, NULL, __max_end);
+	R_DIRTY (block->anal);
 	return true;
 }
 
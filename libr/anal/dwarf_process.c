@@ -1389,6 +1389,11 @@ static void sdb_save_dwarf_function(Function *dwarf_fcn, RList/*<Variable*>*/ *v
 	free (addr_key);
 	free (addr_val);
 
+	/* so the function can be found by its address */
+	char *at_key = r_str_newf ("addr.0x%" PFMT64x, dwarf_fcn->addr);
+	sdb_set (sdb, at_key, sname, 0);
+	free (at_key);
+
 	/* so we can have name without sanitization */
 	char *name_key = r_str_newf ("fcn.%s.name", sname);
 	char *name_val = r_str_newf ("%s", dwarf_fcn->name);
@@ -1709,10 +1714,77 @@ bool filter_sdb_function_names(void *user, const char *k, const char *v) {
 	return !strcmp (v, "fcn");
 }
 
+static void integrate_function(RAnal *anal, RFlag *flags, Sdb *dwarf_sdb, const char *func_sname) {
+	char *addr_key = r_str_newf ("fcn.%s.addr", func_sname);
+	ut64 faddr = sdb_num_get (dwarf_sdb, addr_key, 0);
+	free (addr_key);
+
+	/* if the function is analyzed so we can edit */
+	RAnalFunction *fcn = r_anal_get_function_at (anal, faddr);
+	if (fcn) {
+		/* prepend dwarf debug info stuff with dbg. */
+		char *real_name_key = r_str_newf ("fcn.%s.name", func_sname);
+		char *real_name = sdb_get (dwarf_sdb, real_name_key, 0);
+		free (real_name_key);
+
+		char *dwf_name = r_str_newf ("dbg.%s", real_name);
+		free (real_name);
+
+		r_anal_function_rename (fcn, dwf_name);
+		free (dwf_name);
+
+		char *tmp = r_str_newf ("fcn.%s.sig", func_sname);
+		char *fcnstr = sdb_get (dwarf_sdb, tmp, 0);
+		free (tmp);
+		/* Apply signature as a comment at a function address */
+		r_meta_set_string (anal, R_META_TYPE_COMMENT, faddr, fcnstr);
+		free (fcnstr);
+	}
+	char *var_names_key = r_str_newf ("fcn.%s.vars", func_sname);
+	char *vars = sdb_get (dwarf_sdb, var_names_key, NULL);
+	char *var_name;
+	sdb_aforeach (var_name, vars) {
+		char *var_key = r_str_newf ("fcn.%s.var.%s", func_sname, var_name);
+		char *var_data = sdb_get (dwarf_sdb, var_key, NULL);
+		if (!var_data) {
+			goto loop_end;
+		}
+		char *extra = NULL;
+		char *kind = sdb_anext (var_data, &extra);
+		char *type = NULL;
+		extra = sdb_anext (extra, &type);
+		st64 offset = 0;
+		if (*kind != 'r') {
+			offset = strtol (extra, NULL, 10);
+		}
+		if (*kind == 'g') { /* global, fixed addr TODO add size to variables? */
+			char *global_name = r_str_newf ("global_%s", var_name);
+			r_flag_unset_off (flags, offset);
+			r_flag_set_next (flags, global_name, offset, 4);
+			free (global_name);
+		} else if (*kind == 's' && fcn) {
+			r_anal_function_set_var (fcn, offset - fcn->maxstack, *kind, type, 4, false, var_name);
+		} else if (*kind == 'r' && fcn) {
+			RRegItem *i = r_reg_get (anal->reg, extra, -1);
+			if (!i) {
+				goto loop_end;
+			}
+			r_anal_function_set_var (fcn, i->index, *kind, type, 4, false, var_name);
+		} else if (fcn) { /* kind == 'b' */
+			r_anal_function_set_var (fcn, offset - fcn->bp_off, *kind, type, 4, false, var_name);
+		}
+		free (var_key);
+		free (var_data);
+	loop_end:
+		sdb_aforeach_next (var_name);
+	}
+	free (var_names_key);
+	free (vars);
+}
+
 /**
  * @brief Use parsed DWARF function info from Sdb in the anal functions
  *  XXX right now we only save parsed name and variables, we can't use signature now
- *  XXX refactor to be more readable
  * @param anal
  * @param dwarf_sdb
  */
@@ -1725,73 +1797,25 @@ R_API void r_anal_dwarf_integrate_functions(RAnal *anal, RFlag *flags, Sdb *dwar
 	SdbKv *kv;
 	/* iterate all function entries */
 	ls_foreach (sdb_list, it, kv) {
-		char *func_sname = kv->base.key;
-
-		char *addr_key = r_str_newf ("fcn.%s.addr", func_sname);
-		ut64 faddr = sdb_num_get (dwarf_sdb, addr_key, 0);
-		free (addr_key);
-
-		/* if the function is analyzed so we can edit */
-		RAnalFunction *fcn = r_anal_get_function_at (anal, faddr);
-		if (fcn) {
-			/* prepend dwarf debug info stuff with dbg. */
-			char *real_name_key = r_str_newf ("fcn.%s.name", func_sname);
-			char *real_name = sdb_get (dwarf_sdb, real_name_key, 0);
-			free (real_name_key);
-
-			char *dwf_name = r_str_newf ("dbg.%s", real_name);
-			free (real_name);
-
-			r_anal_function_rename (fcn, dwf_name);
-			free (dwf_name);
-
-			char *tmp = r_str_newf ("fcn.%s.sig", func_sname);
-			char *fcnstr = sdb_get (dwarf_sdb, tmp, 0);
-			free (tmp);
-			/* Apply signature as a comment at a function address */
-			r_meta_set_string (anal, R_META_TYPE_COMMENT, faddr, fcnstr);
-			free (fcnstr);
-		}
-		char *var_names_key = r_str_newf ("fcn.%s.vars", func_sname);
-		char *vars = sdb_get (dwarf_sdb, var_names_key, NULL);
-		char *var_name;
-		sdb_aforeach (var_name, vars) {
-			char *var_key = r_str_newf ("fcn.%s.var.%s", func_sname, var_name);
-			char *var_data = sdb_get (dwarf_sdb, var_key, NULL);
-			if (!var_data) {
-				goto loop_end;
-			}
-			char *extra = NULL;
-			char *kind = sdb_anext (var_data, &extra);
-			char *type = NULL;
-			extra = sdb_anext (extra, &type);
-			st64 offset = 0;
-			if (*kind != 'r') {
-				offset = strtol (extra, NULL, 10);
-			}
-			if (*kind == 'g') { /* global, fixed addr TODO add size to variables? */
-				char *global_name = r_str_newf ("global_%s", var_name);
-				r_flag_unset_off (flags, offset);
-				r_flag_set_next (flags, global_name, offset, 4);
-				free (global_name);
-			} else if (*kind == 's' && fcn) {
-				r_anal_function_set_var (fcn, offset - fcn->maxstack, *kind, type, 4, false, var_name);
-			} else if (*kind == 'r' && fcn) {
-				RRegItem *i = r_reg_get (anal->reg, extra, -1);
-				if (!i) {
-					goto loop_end;
-				}
-				r_anal_function_set_var (fcn, i->index, *kind, type, 4, false, var_name);
-			} else if (fcn) { /* kind == 'b' */
-				r_anal_function_set_var (fcn, offset - fcn->bp_off, *kind, type, 4, false, var_name);
-			}
-			free (var_key);
-			free (var_data);
-		loop_end:
-			sdb_aforeach_next (var_name);
-		}
-		free (var_names_key);
-		free (vars);
+		integrate_function (anal, flags, dwarf_sdb, kv->base.key);
 	}
 	ls_free (sdb_list);
 }
+
+/**
+ * @brief Use the parsed DWARF info of the function at addr only
+ *
+ * @return true if the DWARF info has a function at addr
+ */
+R_API bool r_anal_dwarf_integrate_function(RAnal *anal, RFlag *flags, Sdb *dwarf_sdb, ut64 addr) {
+	r_return_val_if_fail (anal && dwarf_sdb, false);
+	r_strf_var (at_key, 64, "addr.0x%" PFMT64x, addr);
+	const char *func_sname = sdb_const_get (dwarf_sdb, at_key, 0);
+	if (!func_sname) {
+		return false;
+	}
+	char *sname = strdup (func_sname);
+	integrate_function (anal, flags, dwarf_sdb, sname);
+	free (sname);
+	return true;
+}
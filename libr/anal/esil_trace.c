@@ -2,10 +2,6 @@
 
 #include <r_anal.h>
 
-#define DB esil->trace->db
-#define KEY(x) r_strf ("%d."x, esil->trace->idx)
-#define KEYAT(x,y) r_strf ("%d."x".0x%"PFMT64x, esil->trace->idx, y)
-#define KEYREG(x,y) r_strf ("%d."x".%s", esil->trace->idx, y)
 #define CMP_REG_CHANGE(x, y) ((x) - ((RAnalEsilRegChange *)y)->idx)
 #define CMP_MEM_CHANGE(x, y) ((x) - ((RAnalEsilMemChange *)y)->idx)
 
@@ -31,8 +27,10 @@ R_API RAnalEsilTrace *r_anal_esil_trace_new(RAnalEsil *esil) {
 	if (!trace->memory) {
 		goto error;
 	}
-	trace->db = sdb_new0 ();
-	if (!trace->db) {
+	r_vector_init (&trace->steps, sizeof (RAnalEsilTraceStep), NULL, NULL);
+	r_vector_init (&trace->accesses, sizeof (RAnalEsilTraceAccess), NULL, NULL);
+	r_vector_init (&trace->data, sizeof (ut8), NULL, NULL);
+	if (!r_str_constpool_init (&trace->regnames)) {
 		goto error;
 	}
 	// Save initial ESIL stack memory
@@ -72,7 +70,10 @@ R_API void r_anal_esil_trace_free(RAnalEsilTrace *trace) {
 			r_reg_arena_free (trace->arena[i]);
 		}
 		free (trace->stack_data);
-		sdb_free (trace->db);
+		r_vector_fini (&trace->steps);
+		r_vector_fini (&trace->accesses);
+		r_vector_fini (&trace->data);
+		r_str_constpool_fini (&trace->regnames);
 		R_FREE (trace);
 	}
 }
@@ -108,9 +109,32 @@ static void add_mem_change(RAnalEsilTrace *trace, int idx, ut64 addr, ut8 data)
 	r_vector_push (vmem, &mem);
 }
 
+static void add_access(RAnalEsilTrace *trace, RAnalEsilTraceAccessType type, const char *reg, ut64 addr, ut64 value, const ut8 *buf, int len) {
+	if (r_vector_empty (&trace->steps)) {
+		return;
+	}
+	RAnalEsilTraceStep *step = r_vector_index_ptr (&trace->steps, r_vector_len (&trace->steps) - 1);
+	RAnalEsilTraceAccess a = {
+		.type = type,
+		.reg = reg? r_str_constpool_get (&trace->regnames, reg): NULL,
+		.addr = addr,
+		.value = value,
+		.len = 0
+	};
+	if (buf && len > 0) {
+		a.value = r_vector_len (&trace->data);
+		a.len = len;
+		if (!r_vector_insert_range (&trace->data, a.value, (void *)buf, len)) {
+			return;
+		}
+	}
+	if (r_vector_push (&trace->accesses, &a)) {
+		step->count++;
+	}
+}
+
 static bool trace_hook_reg_read(RAnalEsil *esil, const char *name, ut64 *res, int *size) {
 	r_return_val_if_fail (esil && name && res, -1);
-	r_strf_buffer (128);
 	bool ret = false;
 	if (*name == '0') {
 		//eprintf ("Register not found in profile\n");
@@ -126,22 +150,18 @@ static bool trace_hook_reg_read(RAnalEsil *esil, const char *name, ut64 *res, in
 		ret = esil->cb.reg_read (esil, name, res, size);
 	}
 	if (ret) {
-		ut64 val = *res;
-		//eprintf ("[ESIL] REG READ %s 0x%08"PFMT64x"\n", name, val);
-		sdb_array_add (DB, KEY ("reg.read"), name, 0);
-		sdb_num_set (DB, KEYREG ("reg.read", name), val, 0);
+		//eprintf ("[ESIL] REG READ %s 0x%08"PFMT64x"\n", name, *res);
+		add_access (esil->trace, R_ANAL_ESIL_TRACE_REG_READ, name, 0, *res, NULL, 0);
 	}
 	return ret;
 }
 
 static bool trace_hook_reg_write(RAnalEsil *esil, const char *name, ut64 *val) {
-	r_strf_buffer (128);
 	bool ret = false;
 	//eprintf ("[ESIL] REG WRITE %s 0x%08"PFMT64x"\n", name, *val);
 	RRegItem *ri = r_reg_get (esil->anal->reg, name, -1);
 	if (ri) {
-		sdb_array_add (DB, KEY ("reg.write"), name, 0);
-		sdb_num_set (DB, KEYREG ("reg.write", name), *val, 0);
+		add_access (esil->trace, R_ANAL_ESIL_TRACE_REG_WRITE, name, 0, *val, NULL, 0);
 		add_reg_change (esil->trace, esil->trace->idx + 1, ri, *val);
 		if (ocbs.hook_reg_write) {
 			RAnalEsilCallbacks cbs = esil->cb;
@@ -154,17 +174,11 @@ static bool trace_hook_reg_write(RAnalEsil *esil, const char *name, ut64 *val) {
 }
 
 static bool trace_hook_mem_read(RAnalEsil *esil, ut64 addr, ut8 *buf, int len) {
-	char *hexbuf = calloc ((1 + len), 4);
-	r_strf_buffer (128);
 	int ret = 0;
 	if (esil->cb.mem_read) {
 		ret = esil->cb.mem_read (esil, addr, buf, len);
 	}
-	sdb_array_add_num (DB, KEY ("mem.read"), addr, 0);
-	r_hex_bin2str (buf, len, hexbuf);
-	sdb_set (DB, KEYAT ("mem.read.data", addr), hexbuf, 0);
-	//eprintf ("[ESIL] MEM READ 0x%08"PFMT64x" %s\n", addr, hexbuf);
-	free (hexbuf);
+	add_access (esil->trace, R_ANAL_ESIL_TRACE_MEM_READ, NULL, addr, 0, buf, len);
 
 	if (ocbs.hook_mem_read) {
 		RAnalEsilCallbacks cbs = esil->cb;
@@ -178,16 +192,7 @@ static bool trace_hook_mem_read(RAnalEsil *esil, ut64 addr, ut8 *buf, int len) {
 static bool trace_hook_mem_write(RAnalEsil *esil, ut64 addr, const ut8 *buf, int len) {
 	size_t i;
 	int ret = 0;
-	char *hexbuf = malloc ((1 + len) * 3);
-	if (!hexbuf) {
-		return false;
-	}
-	r_strf_buffer (128);
-	sdb_array_add_num (DB, KEY ("mem.write"), addr, 0);
-	r_hex_bin2str (buf, len, hexbuf);
-	sdb_set (DB, KEYAT ("mem.write.data", addr), hexbuf, 0);
-	//eprintf ("[ESIL] MEM WRITE 0x%08"PFMT64x" %s\n", addr, hexbuf);
-	free (hexbuf);
+	add_access (esil->trace, R_ANAL_ESIL_TRACE_MEM_WRITE, NULL, addr, 0, buf, len);
 	for (i = 0; i < len; i++) {
 		add_mem_change (esil->trace, esil->trace->idx + 1, addr + i, buf[i]);
 	}
@@ -203,7 +208,6 @@ static bool trace_hook_mem_write(RAnalEsil *esil, ut64 addr, const ut8 *buf, int
 
 R_API void r_anal_esil_trace_op(RAnalEsil *esil, RAnalOp *op) {
 	r_return_if_fail (esil && op);
-	r_strf_buffer (128);
 	const char *expr = r_strbuf_get (&op->esil);
 	if (R_STR_ISEMPTY (expr)) {
 		// do nothing
@@ -227,8 +231,12 @@ R_API void r_anal_esil_trace_op(RAnalEsil *esil, RAnalOp *op) {
 	}
 	ocbs = esil->cb;
 	ocbs_set = true;
-	sdb_num_set (DB, "idx", esil->trace->idx, 0);
-	sdb_num_set (DB, KEY ("addr"), op->addr, 0);
+	RAnalEsilTraceStep step = {
+		.addr = op->addr,
+		.start = r_vector_len (&esil->trace->accesses),
+		.count = 0
+	};
+	r_vector_push (&esil->trace->steps, &step);
 	RRegItem *pc_ri = r_reg_get (esil->anal->reg, "PC", -1);
 	add_reg_change (esil->trace, esil->trace->idx, pc_ri, op->addr);
 //	sdb_set (DB, KEY ("opcode"), op->mnemonic, 0);
@@ -307,6 +315,119 @@ R_API void r_anal_esil_trace_restore(RAnalEsil *esil, int idx) {
 	ht_up_foreach (trace->memory, restore_memory_cb, esil);
 }
 
+R_API RAnalEsilTraceStep *r_anal_esil_trace_get_step(RAnalEsilTrace *trace, int idx) {
+	r_return_val_if_fail (trace, NULL);
+	idx -= trace->log_start;
+	if (idx < 0 || idx >= r_vector_len (&trace->steps)) {
+		return NULL;
+	}
+	return r_vector_index_ptr (&trace->steps, idx);
+}
+
+// latest access of the given type recorded at step idx
+R_API RAnalEsilTraceAccess *r_anal_esil_trace_get_access(RAnalEsilTrace *trace, int idx, RAnalEsilTraceAccessType type, const char *reg) {
+	RAnalEsilTraceStep *step = r_anal_esil_trace_get_step (trace, idx);
+	if (!step) {
+		return NULL;
+	}
+	ut32 i;
+	for (i = step->count; i > 0; i--) {
+		RAnalEsilTraceAccess *a = r_vector_index_ptr (&trace->accesses, step->start + i - 1);
+		if (a->type == type && (!reg || (a->reg && !strcmp (a->reg, reg)))) {
+			return a;
+		}
+	}
+	return NULL;
+}
+
+// drop the log, the register and memory changes are kept for the restore
+R_API void r_anal_esil_trace_clear(RAnalEsilTrace *trace) {
+	r_return_if_fail (trace);
+	r_vector_clear (&trace->steps);
+	r_vector_clear (&trace->accesses);
+	r_vector_clear (&trace->data);
+	trace->log_start = trace->end_idx;
+}
+
+static inline ut64 access_key(RAnalEsilTraceAccess *a) {
+	// register names are interned, the pointer identifies them
+	return a->reg? (ut64)(size_t)a->reg: a->addr;
+}
+
+static const char *access_names[] = { "reg.read", "reg.write", "mem.read", "mem.write" };
+
+// replays the accesses of a step into db like the old tracer hooks
+static void trace_sdb_step(RAnalEsilTrace *trace, Sdb *db, HtUP **seen, int idx) {
+	r_strf_buffer (128);
+	char num[SDB_NUM_BUFSZ];
+	RAnalEsilTraceStep *step = r_anal_esil_trace_get_step (trace, idx);
+	RStrBuf *lists[R_ARRAY_SIZE (access_names)] = {0};
+	sdb_num_set (db, "idx", idx, 0);
+	sdb_num_set (db, r_strf ("%d.addr", idx), step->addr, 0);
+	ut32 i;
+	for (i = 0; i < step->count; i++) {
+		RAnalEsilTraceAccess *a = r_vector_index_ptr (&trace->accesses, step->start + i);
+		const char *name = access_names[a->type];
+		// the values are the steps the keys were last added to the arrays
+		if ((int)(size_t)ht_up_find (seen[a->type], access_key (a), NULL) != idx + 1) {
+			ht_up_update (seen[a->type], access_key (a), (void *)(size_t)(idx + 1));
+			if (!lists[a->type]) {
+				lists[a->type] = r_strbuf_new ("");
+			} else {
+				r_strbuf_append (lists[a->type], ",");
+			}
+			// sdb_array_add_num lists the addresses below 256 in decimal
+			r_strbuf_append (lists[a->type], a->reg? a->reg:
+				sdb_itoa (a->addr, num, a->addr < 256? 10: SDB_NUM_BASE));
+		}
+		if (a->reg) {
+			sdb_num_set (db, r_strf ("%d.%s.%s", idx, name, a->reg), a->value, 0);
+		} else {
+			char *hexbuf = calloc (a->len + 1, 2);
+			if (hexbuf) {
+				r_hex_bin2str (r_vector_index_ptr (&trace->data, a->value), a->len, hexbuf);
+				sdb_set (db, r_strf ("%d.%s.data.0x%"PFMT64x, idx, name, a->addr), hexbuf, 0);
+				free (hexbuf);
+			}
+		}
+	}
+	for (i = 0; i < R_ARRAY_SIZE (access_names); i++) {
+		if (lists[i]) {
+			sdb_set (db, r_strf ("%d.%s", idx, access_names[i]), r_strbuf_get (lists[i]), 0);
+			r_strbuf_free (lists[i]);
+		}
+	}
+}
+
+static Sdb *trace_sdb(RAnalEsilTrace *trace, int from, int to) {
+	Sdb *db = sdb_new0 ();
+	HtUP *seen[R_ARRAY_SIZE (access_names)] = {0};
+	size_t i;
+	for (i = 0; i < R_ARRAY_SIZE (access_names); i++) {
+		seen[i] = ht_up_new0 ();
+		if (!seen[i]) {
+			sdb_free (db);
+			db = NULL;
+			goto beach;
+		}
+	}
+	int idx;
+	for (idx = from; db && idx < to; idx++) {
+		trace_sdb_step (trace, db, seen, idx);
+	}
+beach:
+	for (i = 0; i < R_ARRAY_SIZE (access_names); i++) {
+		ht_up_free (seen[i]);
+	}
+	return db;
+}
+
+// builds the key=value database the tracer used to keep, for dte and dtek
+R_API Sdb *r_anal_esil_trace_sdb(RAnalEsilTrace *trace) {
+	r_return_val_if_fail (trace, NULL);
+	return trace_sdb (trace, trace->log_start, trace->log_start + r_vector_len (&trace->steps));
+}
+
 static int cmp_strings_by_leading_number(void *data1, void *data2) {
 	const char* a = sdbkv_key ((const SdbKv *)data1);
 	const char* b = sdbkv_key ((const SdbKv *)data2);
@@ -360,73 +481,52 @@ static int cmp_strings_by_leading_number(void *data1, void *data2) {
 }
 
 R_API void r_anal_esil_trace_list(RAnalEsil *esil) {
+	r_return_if_fail (esil);
+	if (!esil->trace) {
+		return;
+	}
 	PrintfCallback p = esil->anal->cb_printf;
+	Sdb *db = r_anal_esil_trace_sdb (esil->trace);
+	if (!db) {
+		return;
+	}
 	SdbKv *kv;
 	SdbListIter *iter;
-	SdbList *list = sdb_foreach_list (esil->trace->db, true);
+	SdbList *list = sdb_foreach_list (db, true);
 	ls_sort (list, (SdbListComparator) cmp_strings_by_leading_number);
 	ls_foreach (list, iter, kv) {
 		p ("%s=%s\n", sdbkv_key (kv), sdbkv_value (kv));
 	}
 	ls_free (list);
+	sdb_free (db);
 }
 
 R_API void r_anal_esil_trace_show(RAnalEsil *esil, int idx) {
+	r_return_if_fail (esil);
+	if (!esil->trace || !r_anal_esil_trace_get_step (esil->trace, idx)) {
+		return;
+	}
 	r_strf_buffer (128);
 	PrintfCallback p = esil->anal->cb_printf;
-	const char *str2;
-	const char *str;
-	int trace_idx = esil->trace->idx;
-	esil->trace->idx = idx;
-
-	str2 = sdb_const_get (DB, KEY ("addr"), 0);
-	if (!str2) {
+	Sdb *db = trace_sdb (esil->trace, idx, idx + 1);
+	if (!db) {
 		return;
 	}
-	p ("ar PC = %s\n", str2);
+	p ("ar PC = %s\n", sdb_const_get (db, r_strf ("%d.addr", idx), 0));
 	/* registers */
-	str = sdb_const_get (DB, KEY ("reg.read"), 0);
-	if (str) {
-		char regname[32];
-		const char *next, *ptr = str;
-		if (ptr && *ptr) {
-			do {
-				next = sdb_const_anext (ptr);
-				int len = next? (int)(size_t)(next - ptr) - 1 : strlen (ptr);
-				if (len < sizeof (regname)) {
-					memcpy (regname, ptr, len);
-					regname[len] = 0;
-					str2 = sdb_const_get (DB, KEYREG ("reg.read", regname), 0);
-					p ("ar %s = %s\n", regname, str2);
-				} else {
-					eprintf ("Invalid entry in reg.read\n");
-				}
-				ptr = next;
-			} while (next);
-		}
+	char *reg, *regs = sdb_get (db, r_strf ("%d.reg.read", idx), 0);
+	sdb_aforeach (reg, regs) {
+		p ("ar %s = %s\n", reg, sdb_const_get (db, r_strf ("%d.reg.read.%s", idx, reg), 0));
+		sdb_aforeach_next (reg);
 	}
+	free (regs);
 	/* memory */
-	str = sdb_const_get (DB, KEY ("mem.read"), 0);
-	if (str) {
-		char addr[64];
-		const char *next, *ptr = str;
-		if (ptr && *ptr) {
-			do {
-				next = sdb_const_anext (ptr);
-				int len = next? (int)(size_t)(next-ptr)-1 : strlen (ptr);
-				if (len < sizeof (addr)) {
-					memcpy (addr, ptr, len);
-					addr[len] = 0;
-					str2 = sdb_const_get (DB, KEYAT ("mem.read.data",
-						r_num_get (NULL, addr)), 0);
-					p ("wx %s @ %s\n", str2, addr);
-				} else {
-					eprintf ("Invalid entry in reg.read\n");
-				}
-				ptr = next;
-			} while (next);
-		}
-	}
-
-	esil->trace->idx = trace_idx;
+	char *addr, *addrs = sdb_get (db, r_strf ("%d.mem.read", idx), 0);
+	sdb_aforeach (addr, addrs) {
+		ut64 at = sdb_atoi (addr);
+		p ("wx %s @ %s\n", sdb_const_get (db, r_strf ("%d.mem.read.data.0x%"PFMT64x, idx, at), 0), addr);
+		sdb_aforeach_next (addr);
+	}
+	free (addrs);
+	sdb_free (db);
 }
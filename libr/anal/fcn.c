@@ -540,6 +540,24 @@ static inline bool has_vars(RAnal *anal, ut64 addr) {
 	return false;
 }
 
+// the read or write direction of the data reference of an instruction
+static int data_ref_type(RAnalOp *op) {
+	int dir = 0;
+	if (op->direction & R_ANAL_OP_DIR_READ) {
+		dir |= R_ANAL_REF_TYPE_READ;
+	}
+	if (op->direction & R_ANAL_OP_DIR_REF) {
+		dir |= R_ANAL_REF_TYPE_READ;
+	}
+	if (op->direction & R_ANAL_OP_DIR_WRITE) {
+		dir |= R_ANAL_REF_TYPE_WRITE;
+	}
+	if (op->direction & R_ANAL_OP_DIR_EXEC) {
+		dir |= R_ANAL_REF_TYPE_EXEC;
+	}
+	return R_ANAL_REF_TYPE_DATA | dir;
+}
+
 static int fcn_recurse(RAnal *anal, RAnalFunction *fcn, ut64 addr, ut64 len, int depth) {
 	char *bp_reg = NULL;
 	char *sp_reg = NULL;
@@ -880,22 +898,7 @@ repeat:
 			break;
 		}
 		if (op->ptr && op->ptr != UT64_MAX && op->ptr != UT32_MAX) {
-			// swapped parameters wtf
-			// its read or wr
-			int dir = 0;
-			if (op->direction & R_ANAL_OP_DIR_READ) {
-				dir |= R_ANAL_REF_TYPE_READ;
-			}
-			if (op->direction & R_ANAL_OP_DIR_REF) {
-				dir |= R_ANAL_REF_TYPE_READ;
-			}
-			if (op->direction & R_ANAL_OP_DIR_WRITE) {
-				dir |= R_ANAL_REF_TYPE_WRITE;
-			}
-			if (op->direction & R_ANAL_OP_DIR_EXEC) {
-				dir |= R_ANAL_REF_TYPE_EXEC;
-			}
-			r_anal_xrefs_set (anal, op->addr, op->ptr, R_ANAL_REF_TYPE_DATA | dir);
+			r_anal_xrefs_set (anal, op->addr, op->ptr, data_ref_type (op));
 		}
 		if (anal->opt.vars && !varset) {
 			// XXX uses op.src/dst and fails because regprofile invalidates the regitems
@@ -1553,25 +1556,23 @@ R_API void r_anal_del_jmprefs(RAnal *anal, RAnalFunction *fcn) {
 	r_list_free (refs);
 }
 
+static bool is_code_meta_cb(RIntervalNode *node, void *user) {
+	RAnalMetaItem *meta = node->data;
+	switch (meta->type) {
+	case R_META_TYPE_DATA:
+	case R_META_TYPE_STRING:
+	case R_META_TYPE_FORMAT:
+		return false;
+	default:
+		return true;
+	}
+}
+
 /* Does NOT invalidate read-ahead cache. */
 R_API int r_anal_function(RAnal *anal, RAnalFunction *fcn, ut64 addr, ut64 len, int reftype) {
 	r_return_val_if_fail (anal && fcn, 0);
-	RPVector *metas = r_meta_get_all_in (anal, addr, R_META_TYPE_ANY);
-	if (metas) {
-		void **it;
-		r_pvector_foreach (metas, it) {
-			RAnalMetaItem *meta = ((RIntervalNode *)*it)->data;
-			switch (meta->type) {
-			case R_META_TYPE_DATA:
-			case R_META_TYPE_STRING:
-			case R_META_TYPE_FORMAT:
-				r_pvector_free (metas);
-				return 0;
-			default:
-				break;
-			}
-		}
-		r_pvector_free (metas);
+	if (!r_meta_foreach_in (anal, addr, R_META_TYPE_ANY, is_code_meta_cb, NULL)) {
+		return 0;
 	}
 	if (anal->opt.norevisit) {
 		if (!anal->visited) {
@@ -2244,13 +2245,81 @@ static void free_ht_up(HtUPKv *kv) {
 	ht_up_free ((HtUP *)kv->value);
 }
 
+// Remove the references going out of an instruction that is going to be decoded again
+static void clear_op_refs(RAnal *anal, ut64 addr) {
+	RList *refs = r_anal_xrefs_get_from (anal, addr);
+	RListIter *it;
+	RAnalRef *ref;
+	r_list_foreach (refs, it, ref) {
+		r_anal_xrefs_deln (anal, ref->at, ref->addr, ref->type);
+	}
+	r_list_free (refs);
+}
+
+static void clear_bb_refs(RAnal *anal, RAnalBlock *bb) {
+	int i;
+	for (i = 0; i < bb->ninstr; i++) {
+		const ut64 addr = r_anal_bb_opaddr_i (bb, i);
+		if (addr == UT64_MAX) {
+			break;
+		}
+		clear_op_refs (anal, addr);
+	}
+}
+
+// Same references fcn_recurse creates for an instruction. The string
+// refs found by aar are kept when the data ref still points to them.
+static void set_op_refs(RAnal *anal, RAnalOp *op, RList *old_refs) {
+	if (op->ptr && op->ptr != UT64_MAX && op->ptr != UT32_MAX) {
+		int type = data_ref_type (op);
+		RListIter *it;
+		RAnalRef *ref;
+		r_list_foreach (old_refs, it, ref) {
+			if (ref->addr == op->ptr && R_ANAL_REF_TYPE_MASK (ref->type) == R_ANAL_REF_TYPE_STRING) {
+				type = ref->type;
+				break;
+			}
+		}
+		r_anal_xrefs_set (anal, op->addr, op->ptr, type);
+	}
+	switch (op->type & R_ANAL_OP_TYPE_MASK) {
+	case R_ANAL_OP_TYPE_JMP:
+		if (anal->opt.jmpref && op->jump != UT64_MAX) {
+			r_anal_xrefs_set (anal, op->addr, op->jump, R_ANAL_REF_TYPE_CODE | R_ANAL_REF_TYPE_EXEC);
+		}
+		break;
+	case R_ANAL_OP_TYPE_CJMP:
+	case R_ANAL_OP_TYPE_MCJMP:
+	case R_ANAL_OP_TYPE_RCJMP:
+	case R_ANAL_OP_TYPE_UCJMP:
+		if (anal->opt.cjmpref && op->jump != UT64_MAX) {
+			r_anal_xrefs_set (anal, op->addr, op->jump, R_ANAL_REF_TYPE_CODE);
+		}
+		break;
+	case R_ANAL_OP_TYPE_UCALL:
+	case R_ANAL_OP_TYPE_RCALL:
+	case R_ANAL_OP_TYPE_ICALL:
+	case R_ANAL_OP_TYPE_IRCALL:
+		if (op->ptr != UT64_MAX) {
+			r_anal_xrefs_set (anal, op->addr, op->ptr, R_ANAL_REF_TYPE_CALL);
+		}
+		break;
+	case R_ANAL_OP_TYPE_CALL:
+	case R_ANAL_OP_TYPE_CCALL:
+		if (op->jump != UT64_MAX) {
+			r_anal_xrefs_set (anal, op->addr, op->jump, R_ANAL_REF_TYPE_CALL | R_ANAL_REF_TYPE_EXEC);
+		}
+		break;
+	}
+}
+
 static void update_var_analysis(RAnalFunction *fcn, int align, ut64 from, ut64 to) {
 	RAnal *anal = fcn->anal;
 	ut64 cur_addr;
 	int opsz;
 	from = align ? from - (from % align) : from;
 	to = align ? R_ROUND (to, align) : to;
-	if (UT64_SUB_OVFCHK (to, from)) {
+	if (to <= from) {
 		return;
 	}
 	ut64 len = to - from;
@@ -2258,18 +2327,24 @@ static void update_var_analysis(RAnalFunction *fcn, int align, ut64 from, ut64 t
 	if (!buf) {
 		return;
 	}
-	if (anal->iob.read_at (anal->iob.io, from, buf, len) < len) {
+	if (!anal->iob.read_at (anal->iob.io, from, buf, len)) {
+		free (buf);
 		return;
 	}
 	for (cur_addr = from; cur_addr < to; cur_addr += opsz, len -= opsz) {
 		RAnalOp op;
-		int ret = r_anal_op (anal->coreb.core, &op, cur_addr, buf, len, R_ANAL_OP_MASK_ESIL | R_ANAL_OP_MASK_VAL);
+		int ret = r_anal_op (anal, &op, cur_addr, buf + (cur_addr - from), len, R_ANAL_OP_MASK_ESIL | R_ANAL_OP_MASK_VAL);
 		if (ret < 1 || op.size < 1) {
 			r_anal_op_fini (&op);
 			break;
 		}
 		opsz = op.size;
 		r_anal_extract_vars (anal, fcn, &op);
+		// the block layout is the same, but the targets may have changed
+		RList *old_refs = r_anal_xrefs_get_from (anal, cur_addr);
+		clear_op_refs (anal, cur_addr);
+		set_op_refs (anal, &op, old_refs);
+		r_list_free (old_refs);
 		r_anal_op_fini (&op);
 	}
 	free (buf);
@@ -2348,6 +2423,7 @@ static void update_analysis(RAnal *anal, RList *fcns, HtUP *reachable) {
 
 static void calc_reachable_and_remove_block(RList *fcns, RAnalFunction *fcn, RAnalBlock *bb, HtUP *reachable) {
 	clear_bb_vars (fcn, bb, bb->addr, bb->addr + bb->size);
+	clear_bb_refs (fcn->anal, bb);
 	if (!r_list_contains (fcns, fcn)) {
 		r_list_append (fcns, fcn);
 		
@@ -2361,17 +2437,26 @@ static void calc_reachable_and_remove_block(RList *fcns, RAnalFunction *fcn, RAn
 	r_anal_function_remove_block (fcn, bb);
 }
 
-R_API void r_anal_update_analysis_range(RAnal *anal, ut64 addr, int size) {
-	r_return_if_fail (anal);
+/**
+ * @brief Redo the analysis of the blocks modified by a write of size bytes at addr
+ *
+ * Only the modified blocks and the code reachable from them are decoded again,
+ * the rest of the functions that contain them are kept as they are.
+ *
+ * @return RList* of the RAnalFunction that changed, NULL if none was affected
+ */
+R_API RList *r_anal_update_analysis_range(RAnal *anal, ut64 addr, int size) {
+	r_return_val_if_fail (anal, NULL);
 	RListIter *it, *it2, *tmp;
 	RAnalBlock *bb;
 	RAnalFunction *fcn;
 	RList *blocks = r_anal_get_blocks_intersect (anal, addr, size);
 	if (r_list_empty (blocks)) {
 		r_list_free (blocks);
-		return;
+		return NULL;
 	}
 	RList *fcns = r_list_new ();
+	RList *changed = r_list_new ();
 	HtUP *reachable = ht_up_new (NULL, free_ht_up, NULL);
 	const int align = r_anal_archinfo (anal, R_ANAL_ARCHINFO_ALIGN);
 	const ut64 end_write = addr + size;
@@ -2389,16 +2474,34 @@ R_API void r_anal_update_analysis_range(RAnal *anal, ut64 addr, int size) {
 					clear_bb_vars (fcn, bb, addr > bb->addr ? addr : bb->addr, end_write);
 					update_var_analysis (fcn, align, addr > bb->addr ? addr : bb->addr, end_write);
 					r_anal_function_delete_unused_vars (fcn);
+					if (!r_list_contains (changed, fcn)) {
+						r_list_append (changed, fcn);
+					}
 					continue;
 				}
 			}
 			calc_reachable_and_remove_block (fcns, fcn, bb, reachable);
 		}
+		if (!r_list_empty (bb->fcns)) {
+			// the block survived, its contents are up to date now
+			r_anal_block_update_hash (bb);
+		}
 	}
 	r_list_free (blocks); // This will call r_anal_block_unref to actually remove blocks from RAnal
 	update_analysis (anal, fcns, reachable);
+	r_list_foreach (fcns, it, fcn) {
+		if (!r_list_contains (changed, fcn)) {
+			r_list_append (changed, fcn);
+		}
+	}
 	ht_up_free (reachable);
 	r_list_free (fcns);
+	if (r_list_empty (changed)) {
+		r_list_free (changed);
+		return NULL;
+	}
+	R_DIRTY (anal);
+	return changed;
 }
 
 R_API void r_anal_function_update_analysis(RAnalFunction *fcn) {
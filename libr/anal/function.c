@@ -143,6 +143,7 @@ R_API bool r_anal_add_function(RAnal *anal, RAnalFunction *fcn) {
 	r_list_append (anal->fcns, fcn);
 	ht_pp_insert (anal->ht_name_fun, fcn->name, fcn);
 	ht_up_insert (anal->ht_addr_fun, fcn->addr, fcn);
+	R_DIRTY (anal);
 	return true;
 }
 
@@ -181,6 +182,7 @@ R_API RAnalFunction *r_anal_create_function(RAnal *anal, const char *name, ut64
 }
 
 R_API bool r_anal_function_delete(RAnalFunction *fcn) {
+	R_DIRTY (fcn->anal);
 	return r_list_delete_data (fcn->anal->fcns, fcn);
 }
 
@@ -203,6 +205,7 @@ R_API bool r_anal_function_relocate(RAnalFunction *fcn, ut64 addr) {
 	ht_up_delete (fcn->anal->ht_addr_fun, fcn->addr);
 	fcn->addr = addr;
 	ht_up_insert (fcn->anal->ht_addr_fun, addr, fcn);
+	R_DIRTY (fcn->anal);
 	return true;
 }
 
@@ -227,6 +230,7 @@ R_API bool r_anal_function_rename(RAnalFunction *fcn, const char *name) {
 		// only re-insert if it really was in the tree before
 		ht_pp_insert (anal->ht_name_fun, fcn->name, fcn);
 	}
+	R_DIRTY (anal);
 	return true;
 }
 
@@ -237,6 +241,7 @@ R_API void r_anal_function_add_block(RAnalFunction *fcn, RAnalBlock *bb) {
 	r_list_append (bb->fcns, fcn); // associate the given fcn with this bb
 	r_anal_block_ref (bb);
 	r_list_append (fcn->bbs, bb);
+	R_DIRTY (fcn->anal);
 
 	if (fcn->meta._min != UT64_MAX) {
 		if (bb->addr + bb->size > fcn->meta._max) {
@@ -263,6 +268,7 @@ R_API void r_anal_function_remove_block(RAnalFunction *fcn, RAnalBlock *bb) {
 
 	r_list_delete_data (fcn->bbs, bb);
 	r_anal_block_unref (bb);
+	R_DIRTY (fcn->anal);
 }
 
 static void ensure_fcn_range(RAnalFunction *fcn) {
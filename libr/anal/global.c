@@ -70,7 +70,7 @@ R_API bool r_anal_global_rename(RAnal *anal, ut64 addr, const char *new_name) {
 R_API const char *r_anal_global_get_type(RAnal *anal, ut64 addr) {
 	RFlagItem *fi = r_anal_global_get (anal, addr);
 	if (fi) {
-		return fi->type;
+		return r_flag_item_type (fi);
 	}
 	return NULL;
 }
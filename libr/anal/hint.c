@@ -84,6 +84,7 @@ void r_anal_hint_storage_fini(RAnal *a) {
 R_API void r_anal_hint_clear(RAnal *a) {
 	r_anal_hint_storage_fini (a);
 	r_anal_hint_storage_init (a);
+	R_DIRTY (a);
 }
 
 typedef struct {
@@ -102,6 +103,7 @@ static bool addr_hint_range_delete_cb(void *user, const ut64 key, const void *va
 }
 
 R_API void r_anal_hint_del(RAnal *a, ut64 addr, ut64 size) {
+	R_DIRTY (a);
 	if (size <= 1) {
 		// only single address
 		ht_up_delete (a->addr_hints, addr);
@@ -147,6 +149,7 @@ static void unset_addr_hint_record(RAnal *anal, RAnalAddrHintType type, ut64 add
 		if (record->type == type) {
 			addr_hint_record_fini (record, NULL);
 			r_vector_remove_at (records, i, NULL);
+			R_DIRTY (anal);
 			return;
 		}
 	}
@@ -154,6 +157,7 @@ static void unset_addr_hint_record(RAnal *anal, RAnalAddrHintType type, ut64 add
 
 // create or return the existing addr hint record of the given type at addr
 static RAnalAddrHintRecord *ensure_addr_hint_record(RAnal *anal, RAnalAddrHintType type, ut64 addr) {
+	R_DIRTY (anal);
 	RVector *records = ht_up_find (anal->addr_hints, addr, NULL);
 	if (!records) {
 		records = r_vector_new (sizeof (RAnalAddrHintRecord), addr_hint_record_fini, NULL);
@@ -183,7 +187,8 @@ static RAnalAddrHintRecord *ensure_addr_hint_record(RAnal *anal, RAnalAddrHintTy
 	setcode \
 } while(0)
 
-static RAnalRangedHintRecordBase *ensure_ranged_hint_record(RBTree *tree, ut64 addr, size_t sz) {
+static RAnalRangedHintRecordBase *ensure_ranged_hint_record(RAnal *anal, RBTree *tree, ut64 addr, size_t sz) {
+	R_DIRTY (anal);
 	RBNode *node = r_rbtree_find (*tree, &addr, ranged_hint_record_cmp, NULL);
 	if (node) {
 		return container_of (node, RAnalRangedHintRecordBase, rb);
@@ -279,7 +284,7 @@ R_API void r_anal_hint_set_val(RAnal *a, ut64 addr, ut64 v) {
 }
 
 R_API void r_anal_hint_set_arch(RAnal *a, ut64 addr, const char *arch) {
-	RAnalArchHintRecord *record = (RAnalArchHintRecord *)ensure_ranged_hint_record (&a->arch_hints, addr, sizeof (RAnalArchHintRecord));
+	RAnalArchHintRecord *record = (RAnalArchHintRecord *)ensure_ranged_hint_record (a, &a->arch_hints, addr, sizeof (RAnalArchHintRecord));
 	if (!record) {
 		return;
 	}
@@ -288,7 +293,7 @@ R_API void r_anal_hint_set_arch(RAnal *a, ut64 addr, const char *arch) {
 }
 
 R_API void r_anal_hint_set_bits(RAnal *a, ut64 addr, int bits) {
-	RAnalBitsHintRecord *record = (RAnalBitsHintRecord *)ensure_ranged_hint_record (&a->bits_hints, addr, sizeof (RAnalBitsHintRecord));
+	RAnalBitsHintRecord *record = (RAnalBitsHintRecord *)ensure_ranged_hint_record (a, &a->bits_hints, addr, sizeof (RAnalBitsHintRecord));
 	if (!record) {
 		return;
 	}
@@ -363,10 +368,12 @@ R_API void r_anal_hint_unset_stackframe(RAnal *a, ut64 addr) {
 }
 
 R_API void r_anal_hint_unset_arch(RAnal *a, ut64 addr) {
+	R_DIRTY (a);
 	r_rbtree_delete (&a->arch_hints, &addr, ranged_hint_record_cmp, NULL, arch_hint_record_free_rb, NULL);
 }
 
 R_API void r_anal_hint_unset_bits(RAnal *a, ut64 addr) {
+	R_DIRTY (a);
 	r_rbtree_delete (&a->bits_hints, &addr, ranged_hint_record_cmp, NULL, bits_hint_record_free_rb, NULL);
 }
 
@@ -3,6 +3,68 @@
 #include <r_anal.h>
 #include <r_core.h>
 
+static int type_index(RAnalMetaType type) {
+	switch (type) {
+	case R_META_TYPE_DATA: return 0;
+	case R_META_TYPE_CODE: return 1;
+	case R_META_TYPE_STRING: return 2;
+	case R_META_TYPE_FORMAT: return 3;
+	case R_META_TYPE_MAGIC: return 4;
+	case R_META_TYPE_HIDE: return 5;
+	case R_META_TYPE_COMMENT: return 6;
+	case R_META_TYPE_RUN: return 7;
+	case R_META_TYPE_HIGHLIGHT: return 8;
+	case R_META_TYPE_VARTYPE: return 9;
+	default: return -1;
+	}
+}
+
+// smallest tree holding all the items of the given type
+static RIntervalTree *type_tree(RAnal *a, RAnalMetaType type) {
+	int idx = type_index (type);
+	return idx < 0? &a->meta: &a->meta_index[idx];
+}
+
+static void meta_item_free(void *_item) {
+	if (_item) {
+		RAnalMetaItem *item = _item;
+		free (item->str);
+		free (item);
+	}
+}
+
+// used in anal.c, but no API needed
+void r_meta_storage_init(RAnal *a) {
+	r_interval_tree_init (&a->meta, meta_item_free);
+	int i;
+	for (i = 0; i < R_META_TYPE_COUNT; i++) {
+		// the items are owned by a->meta
+		r_interval_tree_init (&a->meta_index[i], NULL);
+	}
+}
+
+// used in anal.c, but no API needed
+void r_meta_storage_fini(RAnal *a) {
+	int i;
+	for (i = 0; i < R_META_TYPE_COUNT; i++) {
+		r_interval_tree_fini (&a->meta_index[i]);
+	}
+	r_interval_tree_fini (&a->meta);
+}
+
+static void index_insert(RAnal *a, RAnalMetaItem *item, ut64 start, ut64 end) {
+	RIntervalTree *tree = type_tree (a, item->type);
+	if (tree != &a->meta) {
+		r_interval_tree_insert (tree, start, end, item);
+	}
+}
+
+static RIntervalNode *index_node(RAnal *a, RIntervalNode *node) {
+	RAnalMetaItem *item = node->data;
+	RIntervalTree *tree = type_tree (a, item->type);
+	return tree != &a->meta? r_interval_tree_node_at_data (tree, node->start, item): NULL;
+}
+
 static bool item_matches_filter(RAnalMetaItem *item, RAnalMetaType type, R_NULLABLE const RSpace *space) {
 	return (type == R_META_TYPE_ANY || item->type == type)
 		   && (!space || item->space == space);
@@ -121,9 +183,15 @@ static bool meta_set(RAnal *a, RAnalMetaType type, int subtype, ut64 from, ut64
 	}
 	if (!node) {
 		r_interval_tree_insert (&a->meta, from, to, item);
+		index_insert (a, item, from, to);
 	} else if (node->end != to) {
+		RIntervalNode *inode = index_node (a, node);
+		if (inode) {
+			r_interval_tree_resize (type_tree (a, type), inode, from, to);
+		}
 		r_interval_tree_resize (&a->meta, node, from, to);
 	}
+	R_DIRTY (a);
 	return true;
 }
 
@@ -168,7 +236,15 @@ static void del(RAnal *a, RAnalMetaType type, const RSpace *space, ut64 addr, ut
 	}
 	void **it;
 	r_pvector_foreach (victims, it) {
-		r_interval_tree_delete (&a->meta, *it, true);
+		RIntervalNode *node = *it;
+		RIntervalNode *inode = index_node (a, node);
+		if (inode) {
+			r_interval_tree_delete (type_tree (a, ((RAnalMetaItem *)node->data)->type), inode, false);
+		}
+		r_interval_tree_delete (&a->meta, node, true);
+	}
+	if (!r_pvector_empty (victims)) {
+		R_DIRTY (a);
 	}
 	r_pvector_free (victims);
 }
@@ -219,6 +295,67 @@ R_API RPVector *r_meta_get_all_intersect(RAnal *a, ut64 start, ut64 size, RAnalM
 	return collect_nodes_intersect (a, type, r_spaces_current (&a->meta_spaces), start, end);
 }
 
+typedef struct {
+	RAnalMetaType type;
+	const RSpace *space;
+	RIntervalIterCb cb;
+	void *user;
+} ForeachCtx;
+
+static bool foreach_cb(RIntervalNode *node, void *user) {
+	ForeachCtx *ctx = user;
+	return !item_matches_filter (node->data, ctx->type, ctx->space) || ctx->cb (node, ctx->user);
+}
+
+R_API bool r_meta_foreach_at(RAnal *a, ut64 at, RAnalMetaType type, RIntervalIterCb cb, void *user) {
+	r_return_val_if_fail (a && cb, false);
+	ForeachCtx ctx = { type, r_spaces_current (&a->meta_spaces), cb, user };
+	return r_interval_tree_all_at (type_tree (a, type), at, foreach_cb, &ctx);
+}
+
+R_API bool r_meta_foreach_in(RAnal *a, ut64 at, RAnalMetaType type, RIntervalIterCb cb, void *user) {
+	r_return_val_if_fail (a && cb, false);
+	ForeachCtx ctx = { type, r_spaces_current (&a->meta_spaces), cb, user };
+	return r_interval_tree_all_in (type_tree (a, type), at, true, foreach_cb, &ctx);
+}
+
+R_API bool r_meta_foreach_intersect(RAnal *a, ut64 start, ut64 size, RAnalMetaType type, RIntervalIterCb cb, void *user) {
+	r_return_val_if_fail (a && size && cb, false);
+	ut64 end = start + size - 1;
+	if (end < start) {
+		end = UT64_MAX;
+	}
+	ForeachCtx ctx = { type, r_spaces_current (&a->meta_spaces), cb, user };
+	return r_interval_tree_all_intersect (type_tree (a, type), start, end, true, foreach_cb, &ctx);
+}
+
+static RIntervalNode *iter_skip(RAnalMetaIter *it) {
+	while (r_rbtree_iter_has (&it->it)) {
+		RIntervalNode *node = r_interval_tree_iter_get (&it->it);
+		if (item_matches_filter (node->data, it->type, NULL)) {
+			return node;
+		}
+		r_rbtree_iter_next (&it->it);
+	}
+	return NULL;
+}
+
+R_API RIntervalNode *r_meta_iter_first(RAnal *a, RAnalMetaIter *it, RAnalMetaType type, ut64 from) {
+	r_return_val_if_fail (a && it, NULL);
+	it->type = type;
+	it->it = r_interval_tree_first_from (type_tree (a, type), from);
+	return iter_skip (it);
+}
+
+R_API RIntervalNode *r_meta_iter_next(RAnalMetaIter *it) {
+	r_return_val_if_fail (it, NULL);
+	if (!r_rbtree_iter_has (&it->it)) {
+		return NULL;
+	}
+	r_rbtree_iter_next (&it->it);
+	return iter_skip (it);
+}
+
 R_API const char *r_meta_type_to_string(int type) {
 	// XXX: use type as '%c'
 	switch (type) {
@@ -514,13 +651,10 @@ static void print_meta_list(RAnal *a, int type, int rad, ut64 addr, const char *
 		}
 	}
 
-	RIntervalTreeIter it;
-	RAnalMetaItem *item;
-	r_interval_tree_foreach (&a->meta, it, item) {
-		RIntervalNode *node = r_interval_tree_iter_get (&it);
-		if (type != R_META_TYPE_ANY && item->type != type) {
-			continue;
-		}
+	RAnalMetaIter it;
+	RIntervalNode *node;
+	r_meta_foreach_type (a, it, node, type) {
+		RAnalMetaItem *item = node->data;
 		if (fcn && !r_anal_function_contains (fcn, node->start)) {
 			continue;
 		}
@@ -565,6 +699,11 @@ R_API void r_meta_rebase(RAnal *anal, ut64 diff) {
 	}
 	RIntervalTree old = anal->meta;
 	r_interval_tree_init (&anal->meta, old.free);
+	int i;
+	for (i = 0; i < R_META_TYPE_COUNT; i++) {
+		r_interval_tree_fini (&anal->meta_index[i]);
+		r_interval_tree_init (&anal->meta_index[i], NULL);
+	}
 	RIntervalTreeIter it;
 	RAnalMetaItem *item;
 	r_interval_tree_foreach (&old, it, item) {
@@ -577,9 +716,11 @@ R_API void r_meta_rebase(RAnal *anal, ut64 diff) {
 			newend = node->end;
 		}
 		r_interval_tree_insert (&anal->meta, newstart, newend, item);
+		index_insert (anal, item, newstart, newend);
 	}
 	old.free = NULL;
 	r_interval_tree_fini (&old);
+	R_DIRTY (anal);
 }
 
 R_API void r_meta_space_unset_for(RAnal *a, const RSpace *space) {
@@ -592,14 +733,10 @@ R_API ut64 r_meta_get_size(RAnal *a, RAnalMetaType type) {
 		return 0;
 	}
 	ut64 sum = 0;
-	RIntervalTreeIter it;
-	RAnalMetaItem *item;
+	RAnalMetaIter it;
+	RIntervalNode *node;
 	RIntervalNode *prev = NULL;
-	r_interval_tree_foreach (&a->meta, it, item) {
-		RIntervalNode *node = r_interval_tree_iter_get (&it);
-		if (type != R_META_TYPE_ANY && item->type != type) {
-			continue;
-		}
+	r_meta_foreach_type (a, it, node, type) {
 		ut64 start = R_MAX (prev ? prev->end : 0, node->start);
 		sum += node->end - start + 1;
 		prev = node;
@@ -77,6 +77,21 @@ R_API void r_anal_reflines_free(RAnalRefline *rl) {
  * nlines - max number of lines of code to consider
  * linesout - true if you want to display lines that go outside of the scope [addr;addr+len)
  * linescall - true if you want to display call lines */
+static bool meta_skip_cb(RIntervalNode *node, void *user) {
+	RAnalMetaItem *meta = node->data;
+	switch (meta->type) {
+	case R_META_TYPE_DATA:
+	case R_META_TYPE_STRING:
+	case R_META_TYPE_HIDE:
+	case R_META_TYPE_FORMAT:
+	case R_META_TYPE_MAGIC:
+		*(ut64 *)user = r_meta_node_size (node);
+		return false;
+	default:
+		return true;
+	}
+}
+
 R_API RList *r_anal_reflines_get(RAnal *anal, ut64 addr, const ut8 *buf, ut64 len, int nlines, int linesout, int linescall) {
 	RList *list, *sten;
 	RListIter *iter;
@@ -122,32 +137,12 @@ R_API RList *r_anal_reflines_get(RAnal *anal, ut64 addr, const ut8 *buf, ut64 le
 		}
 		addr += sz;
 		{
-			RPVector *metas = r_meta_get_all_at (anal, addr);
-			if (metas) {
-				void **it;
-				ut64 skip = 0;
-				r_pvector_foreach (metas, it) {
-					RIntervalNode *node = *it;
-					RAnalMetaItem *meta = node->data;
-					switch (meta->type) {
-					case R_META_TYPE_DATA:
-					case R_META_TYPE_STRING:
-					case R_META_TYPE_HIDE:
-					case R_META_TYPE_FORMAT:
-					case R_META_TYPE_MAGIC:
-						skip = r_meta_node_size (node);
-						goto do_skip;
-					default:
-						break;
-					}
-				}
-do_skip:
-				r_pvector_free (metas);
-				if (skip) {
-					ptr += skip;
-					addr += skip;
-					goto __next;
-				}
+			ut64 skip = 0;
+			r_meta_foreach_at (anal, addr, R_META_TYPE_ANY, meta_skip_cb, &skip);
+			if (skip) {
+				ptr += skip;
+				addr += skip;
+				goto __next;
 			}
 		}
 		if (!anal->iob.is_valid_offset (anal->iob.io, addr, 1)) {
@@ -205,6 +205,7 @@ R_API void r_anal_var_set_type(RAnalVar *var, const char *type) {
 		free (var->type);
 		var->type = nt;
 		shadow_var_struct_members (var);
+		R_DIRTY (var->fcn->anal);
 	}
 }
 
@@ -564,6 +565,7 @@ R_API bool r_anal_var_rename(RAnalVar *var, const char *new_name, bool verbose)
 	}
 	free (var->name);
 	var->name = nn;
+	R_DIRTY (var->fcn->anal);
 	return true;
 }
 
@@ -659,6 +661,7 @@ R_API void r_anal_var_set_access(RAnalVar *var, const char *reg, ut64 access_add
 	acc->type |= (ut8)access_type;
 	acc->stackptr = stackptr;
 	acc->reg = r_str_constpool_get (&var->fcn->anal->constpool, reg);
+	R_DIRTY (var->fcn->anal);
 
 	// add the inverse reference from the instruction to the var
 	RPVector *inst_accesses = ht_up_find (var->fcn->inst_vars, (ut64)offset, NULL);
@@ -0,0 +1,248 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include <r_bin.h>
+
+R_API RBinAddrLineTable *r_bin_addrline_new(void) {
+	RBinAddrLineTable *t = R_NEW0 (RBinAddrLineTable);
+	if (!t) {
+		return NULL;
+	}
+	r_vector_init (&t->rows, sizeof (RBinAddrLine), NULL, NULL);
+	r_vector_init (&t->by_line, sizeof (RBinAddrLineKey), NULL, NULL);
+	r_pvector_init (&t->files, free);
+	t->file_ids = ht_pp_new0 ();
+	if (!t->file_ids) {
+		r_bin_addrline_free (t);
+		return NULL;
+	}
+	t->sorted = true;
+	return t;
+}
+
+R_API void r_bin_addrline_reset(RBinAddrLineTable *t) {
+	r_return_if_fail (t);
+	r_vector_clear (&t->rows);
+	r_vector_clear (&t->by_line);
+	r_pvector_clear (&t->files);
+	ht_pp_free (t->file_ids);
+	t->file_ids = ht_pp_new0 ();
+	t->seq = 0;
+	t->sorted = true;
+}
+
+R_API void r_bin_addrline_free(RBinAddrLineTable *t) {
+	if (t) {
+		r_vector_fini (&t->rows);
+		r_vector_fini (&t->by_line);
+		r_pvector_fini (&t->files);
+		ht_pp_free (t->file_ids);
+		free (t);
+	}
+}
+
+// file ids are stored off by one in the hashtable, so NULL means missing
+static ut32 file_id(RBinAddrLineTable *t, const char *file, bool add) {
+	size_t id = (size_t)ht_pp_find (t->file_ids, file, NULL);
+	if (id) {
+		return id - 1;
+	}
+	if (!add) {
+		return UT32_MAX;
+	}
+	char *name = strdup (file);
+	if (!name || !r_pvector_push (&t->files, name)) {
+		free (name);
+		return UT32_MAX;
+	}
+	id = r_pvector_len (&t->files);
+	ht_pp_insert (t->file_ids, name, (void *)id);
+	return id - 1;
+}
+
+R_API bool r_bin_addrline_add(RBinAddrLineTable *t, ut64 addr, const char *file, ut32 line, ut32 column) {
+	r_return_val_if_fail (t && file, false);
+	ut32 id = file_id (t, file, true);
+	if (id == UT32_MAX) {
+		return false;
+	}
+	RBinAddrLine row = {
+		.addr = addr,
+		.file = id,
+		.line = line,
+		.column = column,
+		.seq = t->seq
+	};
+	if (!r_vector_push (&t->rows, &row)) {
+		return false;
+	}
+	t->seq++;
+	t->sorted = false;
+	return true;
+}
+
+static int cmp_addr(const void *a, const void *b) {
+	const RBinAddrLine *ra = a;
+	const RBinAddrLine *rb = b;
+	if (ra->addr != rb->addr) {
+		return ra->addr < rb->addr? -1: 1;
+	}
+	return (ra->seq > rb->seq) - (ra->seq < rb->seq);
+}
+
+static int cmp_line(const void *a, const void *b) {
+	const RBinAddrLineKey *ka = a;
+	const RBinAddrLineKey *kb = b;
+	if (ka->file != kb->file) {
+		return ka->file < kb->file? -1: 1;
+	}
+	if (ka->line != kb->line) {
+		return ka->line < kb->line? -1: 1;
+	}
+	return (ka->seq > kb->seq) - (ka->seq < kb->seq);
+}
+
+// rows are appended in line program order, the indexes are built on the first query
+static void addrline_sort(RBinAddrLineTable *t) {
+	if (t->sorted) {
+		return;
+	}
+	size_t i, n = r_vector_len (&t->rows);
+	RBinAddrLine *rows = t->rows.a;
+	qsort (rows, n, sizeof (RBinAddrLine), cmp_addr);
+	// the line program repeats rows, only drop the exact copies so every
+	// line mapped to an address is kept
+	size_t j = 0;
+	for (i = 0; i < n; i++) {
+		size_t k;
+		bool dup = false;
+		for (k = j; k > 0 && rows[k - 1].addr == rows[i].addr; k--) {
+			if (rows[k - 1].file == rows[i].file && rows[k - 1].line == rows[i].line) {
+				dup = true;
+				break;
+			}
+		}
+		if (!dup) {
+			rows[j++] = rows[i];
+		}
+	}
+	t->rows.len = j;
+	r_vector_shrink (&t->rows);
+	r_vector_clear (&t->by_line);
+	if (r_vector_reserve (&t->by_line, j)) {
+		RBinAddrLineKey *keys = t->by_line.a;
+		for (i = 0; i < j; i++) {
+			keys[i].addr = rows[i].addr;
+			keys[i].file = rows[i].file;
+			keys[i].line = rows[i].line;
+			keys[i].seq = rows[i].seq;
+		}
+		t->by_line.len = j;
+		qsort (keys, j, sizeof (RBinAddrLineKey), cmp_line);
+	}
+	t->sorted = true;
+}
+
+// index of the first row at addr or above
+static size_t addrline_lower_bound(RBinAddrLineTable *t, ut64 addr) {
+	size_t lo = 0, hi = r_vector_len (&t->rows);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		RBinAddrLine *row = r_vector_index_ptr (&t->rows, mid);
+		if (row->addr < addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/* returns the first row registered for addr */
+R_API const RBinAddrLine *r_bin_addrline_get(RBinAddrLineTable *t, ut64 addr) {
+	r_return_val_if_fail (t, NULL);
+	addrline_sort (t);
+	size_t i = addrline_lower_bound (t, addr);
+	if (i < r_vector_len (&t->rows)) {
+		RBinAddrLine *row = r_vector_index_ptr (&t->rows, i);
+		if (row->addr == addr) {
+			return row;
+		}
+	}
+	return NULL;
+}
+
+/* returns the first address registered for file:line */
+R_API ut64 r_bin_addrline_find(RBinAddrLineTable *t, const char *file, ut32 line) {
+	r_return_val_if_fail (t && file, UT64_MAX);
+	ut32 id = file_id (t, file, false);
+	if (id == UT32_MAX) {
+		return UT64_MAX;
+	}
+	addrline_sort (t);
+	size_t lo = 0, hi = r_vector_len (&t->by_line);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		RBinAddrLineKey *key = r_vector_index_ptr (&t->by_line, mid);
+		if (key->file < id || (key->file == id && key->line < line)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (lo < r_vector_len (&t->by_line)) {
+		RBinAddrLineKey *key = r_vector_index_ptr (&t->by_line, lo);
+		if (key->file == id && key->line == line) {
+			return key->addr;
+		}
+	}
+	return UT64_MAX;
+}
+
+R_API const char *r_bin_addrline_file(RBinAddrLineTable *t, const RBinAddrLine *row) {
+	r_return_val_if_fail (t && row, NULL);
+	return row->file < r_pvector_len (&t->files)? r_pvector_at (&t->files, row->file): NULL;
+}
+
+/* removes every row at addr, both indexes stay sorted */
+R_API bool r_bin_addrline_del(RBinAddrLineTable *t, ut64 addr) {
+	r_return_val_if_fail (t, false);
+	addrline_sort (t);
+	size_t from = addrline_lower_bound (t, addr);
+	size_t to = from, n = r_vector_len (&t->rows);
+	RBinAddrLine *rows = t->rows.a;
+	while (to < n && rows[to].addr == addr) {
+		to++;
+	}
+	if (to == from) {
+		return false;
+	}
+	memmove (rows + from, rows + to, (n - to) * sizeof (RBinAddrLine));
+	t->rows.len -= to - from;
+	size_t i, j = 0;
+	RBinAddrLineKey *keys = t->by_line.a;
+	for (i = 0; i < r_vector_len (&t->by_line); i++) {
+		if (keys[i].addr != addr) {
+			keys[j++] = keys[i];
+		}
+	}
+	t->by_line.len = j;
+	return true;
+}
+
+R_API bool r_bin_addrline_foreach(RBinAddrLineTable *t, RBinAddrLineCallback cb, void *user) {
+	r_return_val_if_fail (t && cb, false);
+	addrline_sort (t);
+	RBinAddrLine *row;
+	r_vector_foreach (&t->rows, row) {
+		if (!cb (user, row, r_bin_addrline_file (t, row))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+R_API size_t r_bin_addrline_count(RBinAddrLineTable *t) {
+	r_return_val_if_fail (t, 0);
+	addrline_sort (t);
+	return r_vector_len (&t->rows);
+}
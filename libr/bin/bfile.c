@@ -509,6 +509,7 @@ R_IPI RBinFile *r_bin_file_new(RBin *bin, const char *file, ut64 file_sz, int ra
 		bf->sdb = sdb_new0 ();
 		bf->sdb_addrinfo = sdb_new0 (); //ns (bf->sdb, "addrinfo", 1);
 		// bf->sdb_addrinfo->refs++;
+		bf->addrlines = r_bin_addrline_new ();
 	}
 	return bf;
 }
@@ -766,6 +767,10 @@ R_API void r_bin_file_free(void /*RBinFile*/ *_bf) {
 		sdb_free (bf->sdb_addrinfo);
 		bf->sdb_addrinfo = NULL;
 	}
+	r_bin_addrline_free (bf->addrlines);
+	bf->addrlines = NULL;
+	r_bin_dwarf_index_free (bf->dwarf_index);
+	bf->dwarf_index = NULL;
 	free (bf->file);
 	r_bin_object_free (bf->o);
 	r_list_free (bf->xtr_data);
@@ -915,18 +920,46 @@ R_API bool r_bin_file_close(RBin *bin, int bd) {
 	return false;
 }
 
+#define FILE_HASH_CHUNK (4 * 1024 * 1024)
+
+static const ut64 file_hash_algos[] = { R_HASH_MD5, R_HASH_SHA1, R_HASH_SHA256 };
+#define FILE_HASH_COUNT R_ARRAY_SIZE (file_hash_algos)
+
+typedef struct {
+	RHash *ctx[FILE_HASH_COUNT];
+	const ut8 *buf;
+	int len;
+} FileHashJobs;
+
+static bool file_hash_job(void *user, size_t idx, int tid) {
+	FileHashJobs *w = user;
+	// each algorithm owns its context, so they can run side by side
+	switch (file_hash_algos[idx]) {
+	case R_HASH_MD5:
+		(void)r_hash_do_md5 (w->ctx[idx], w->buf, w->len);
+		break;
+	case R_HASH_SHA1:
+		(void)r_hash_do_sha1 (w->ctx[idx], w->buf, w->len);
+		break;
+	case R_HASH_SHA256:
+		(void)r_hash_do_sha256 (w->ctx[idx], w->buf, w->len);
+		break;
+	}
+	return true;
+}
+
 R_API RList *r_bin_file_compute_hashes(RBin *bin, ut64 limit) {
 	r_return_val_if_fail (bin && bin->cur && bin->cur->o, NULL);
-	ut64 buf_len = 0, r = 0;
 	RBinFile *bf = bin->cur;
 	RBinObject *o = bf->o;
+	size_t i;
 
 	RIODesc *iod = r_io_desc_get (bin->iob.io, bf->fd);
 	if (!iod) {
 		return NULL;
 	}
 
-	buf_len = r_io_desc_size (iod);
+	ut64 buf_len = r_io_desc_size (iod);
 	// By SLURP_LIMIT normally cannot compute ...
 	if (buf_len > limit) {
 		if (bin->verbose) {
@@ -934,62 +967,55 @@ R_API RList *r_bin_file_compute_hashes(RBin *bin, ut64 limit) {
 		}
 		return NULL;
 	}
-	const size_t blocksize = 64000;
+	// a single pass over the file, each chunk is hashed with all the
+	// algorithms in parallel. the io is only used from this thread
+	const size_t blocksize = (size_t)R_MAX (1, R_MIN (buf_len, FILE_HASH_CHUNK));
+	FileHashJobs w = {0};
+	RList *file_hashes = NULL;
+	bool ok = true;
 	ut8 *buf = malloc (blocksize);
-	if (!buf) {
-		eprintf ("Cannot allocate computation buffer\n");
-		return NULL;
+	for (i = 0; i < FILE_HASH_COUNT; i++) {
+		w.ctx[i] = r_hash_new (false, file_hash_algos[i]);
+		ok &= w.ctx[i] != NULL;
 	}
-
-	char hash[128];
-	RHash *ctx = r_hash_new (false, R_HASH_MD5 | R_HASH_SHA1 | R_HASH_SHA256);
-	while (r + blocksize < buf_len) {
-		r_io_desc_seek (iod, r, R_IO_SEEK_SET);
-		int b = r_io_desc_read (iod, buf, blocksize);
-		(void)r_hash_do_md5 (ctx, buf, blocksize);
-		(void)r_hash_do_sha1 (ctx, buf, blocksize);
-		(void)r_hash_do_sha256 (ctx, buf, blocksize);
-		r += b;
-	}
-	if (r < buf_len) {
-		r_io_desc_seek (iod, r, R_IO_SEEK_SET);
-		const size_t rem_len = buf_len-r;
-		int b = r_io_desc_read (iod, buf, rem_len);
-		if (b < 1) {
+	if (!buf || !ok) {
+		eprintf ("Cannot allocate computation buffer\n");
+		goto beach;
+	}
+	int nthreads = r_bin_jobs_threads (FILE_HASH_COUNT);
+	ut64 at;
+	for (at = 0; at < buf_len; at += w.len) {
+		const int n = (int)R_MIN ((ut64)blocksize, buf_len - at);
+		r_io_desc_seek (iod, at, R_IO_SEEK_SET);
+		w.buf = buf;
+		w.len = r_io_desc_read (iod, buf, n);
+		if (w.len != n) {
 			eprintf ("r_io_desc_read: error\n");
-		} else {
-			(void)r_hash_do_md5 (ctx, buf, b);
-			(void)r_hash_do_sha1 (ctx, buf, b);
-			(void)r_hash_do_sha256 (ctx, buf, b);
+		}
+		// on a short read, the hashes cover the bytes read so far
+		if (w.len < 1) {
+			break;
+		}
+		if (!r_bin_jobs_run (NULL, FILE_HASH_COUNT, nthreads, file_hash_job, &w)) {
+			goto beach;
+		}
+		if (w.len != n) {
+			break;
 		}
 	}
-	r_hash_do_end (ctx, R_HASH_MD5);
-	r_hex_bin2str (ctx->digest, R_HASH_SIZE_MD5, hash);
-
-	RList *file_hashes = r_list_newf ((RListFree) r_bin_file_hash_free);
-	RBinFileHash *md5h = R_NEW0 (RBinFileHash);
-	if (md5h) {
-		md5h->type = strdup ("md5");
-		md5h->hex = strdup (hash);
-		r_list_push (file_hashes, md5h);
-	}
-	r_hash_do_end (ctx, R_HASH_SHA1);
-	r_hex_bin2str (ctx->digest, R_HASH_SIZE_SHA1, hash);
-
-	RBinFileHash *sha1h = R_NEW0 (RBinFileHash);
-	if (sha1h) {
-		sha1h->type = strdup ("sha1");
-		sha1h->hex = strdup (hash);
-		r_list_push (file_hashes, sha1h);
-	}
-	r_hash_do_end (ctx, R_HASH_SHA256);
-	r_hex_bin2str (ctx->digest, R_HASH_SIZE_SHA256, hash);
 
-	RBinFileHash *sha256h = R_NEW0 (RBinFileHash);
-	if (sha256h) {
-		sha256h->type = strdup ("sha256");
-		sha256h->hex = strdup (hash);
-		r_list_push (file_hashes, sha256h);
+	file_hashes = r_list_newf ((RListFree) r_bin_file_hash_free);
+	for (i = 0; i < FILE_HASH_COUNT; i++) {
+		const ut64 algo = file_hash_algos[i];
+		char hash[128];
+		r_hash_do_end (w.ctx[i], algo);
+		r_hex_bin2str (w.ctx[i]->digest, r_hash_size (algo), hash);
+		RBinFileHash *fh = R_NEW0 (RBinFileHash);
+		if (fh) {
+			fh->type = strdup (r_hash_name (algo));
+			fh->hex = strdup (hash);
+			r_list_push (file_hashes, fh);
+		}
 	}
 
 	if (o->plugin && o->plugin->hashes) {
@@ -998,9 +1024,11 @@ R_API RList *r_bin_file_compute_hashes(RBin *bin, ut64 limit) {
 		free (plugin_hashes);
 	}
 	// TODO: add here more rows
-
+beach:
+	for (i = 0; i < FILE_HASH_COUNT; i++) {
+		r_hash_free (w.ctx[i]);
+	}
 	free (buf);
-	r_hash_free (ctx);
 	return file_hashes;
 }
 
@@ -77,34 +77,31 @@ R_API char *r_bin_filter_name(RBinFile *bf, HtPU *db, ut64 vaddr, char *name) {
 	return resname;
 }
 
-R_API void r_bin_filter_sym(RBinFile *bf, HtPP *ht, ut64 vaddr, RBinSymbol *sym) {
-	r_return_if_fail (ht && sym && sym->name);
+// dn is the demangled name of the symbol, if any, and is owned by it afterwards
+static void filter_sym(RBinFile *bf, HtPP *ht, ut64 vaddr, RBinSymbol *sym, char *dn) {
 	const char *name = sym->name;
 	// if (!strncmp (sym->name, "imp.", 4)) {
-	// demangle symbol name depending on the language specs if any
-	if (bf && bf->o && bf->o->lang) {
-		const char *lang = r_bin_lang_tostring (bf->o->lang);
-		char *dn = r_bin_demangle (bf, lang, sym->name, sym->vaddr, false);
-		if (dn && *dn) {
-			sym->dname = dn;
-			// XXX this is wrong but is required for this test to pass
-			// pmb:new pancake$ bin/r2r.js db/formats/mangling/swift
-			sym->name = dn;
-			// extract class information from demangled symbol name
-			char *p = strchr (dn, '.');
-			if (p) {
-				if (IS_UPPER (*dn)) {
-					sym->classname = strdup (dn);
-					sym->classname[p - dn] = 0;
-				} else if (IS_UPPER (p[1])) {
-					sym->classname = strdup (p + 1);
-					p = strchr (sym->classname, '.');
-					if (p) {
-						*p = 0;
-					}
+	if (dn && *dn) {
+		sym->dname = dn;
+		// XXX this is wrong but is required for this test to pass
+		// pmb:new pancake$ bin/r2r.js db/formats/mangling/swift
+		sym->name = dn;
+		// extract class information from demangled symbol name
+		char *p = strchr (dn, '.');
+		if (p) {
+			if (IS_UPPER (*dn)) {
+				sym->classname = strdup (dn);
+				sym->classname[p - dn] = 0;
+			} else if (IS_UPPER (p[1])) {
+				sym->classname = strdup (p + 1);
+				p = strchr (sym->classname, '.');
+				if (p) {
+					*p = 0;
 				}
 			}
 		}
+	} else {
+		free (dn);
 	}
 
 	r_strf_var (uname, 256, "%" PFMT64x ".%c.%s", vaddr, sym->is_imported ? 'i' : 's', name);
@@ -127,6 +124,17 @@ R_API void r_bin_filter_sym(RBinFile *bf, HtPP *ht, ut64 vaddr, RBinSymbol *sym)
 	}
 }
 
+R_API void r_bin_filter_sym(RBinFile *bf, HtPP *ht, ut64 vaddr, RBinSymbol *sym) {
+	r_return_if_fail (ht && sym && sym->name);
+	char *dn = NULL;
+	// demangle symbol name depending on the language specs if any
+	if (bf && bf->o && bf->o->lang) {
+		const char *lang = r_bin_lang_tostring (bf->o->lang);
+		dn = r_bin_demangle (bf, lang, sym->name, sym->vaddr, false);
+	}
+	filter_sym (bf, ht, vaddr, sym, dn);
+}
+
 R_API void r_bin_filter_symbols(RBinFile *bf, RList *list) {
 	HtPP *ht = ht_pp_new0 ();
 	if (!ht) {
@@ -135,11 +143,40 @@ R_API void r_bin_filter_symbols(RBinFile *bf, RList *list) {
 
 	RListIter *iter;
 	RBinSymbol *sym;
+	// all the names are demangled at once, which dedups them and uses threads
+	size_t i = 0, count = r_list_length (list);
+	const char **names = NULL;
+	ut64 *vaddrs = NULL;
+	char **dns = NULL;
+	if (bf && bf->rbin && bf->o && bf->o->lang && count > 0) {
+		names = R_NEWS0 (const char *, count);
+		vaddrs = R_NEWS0 (ut64, count);
+		dns = R_NEWS0 (char *, count);
+		if (names && vaddrs && dns) {
+			r_list_foreach (list, iter, sym) {
+				names[i] = (sym && sym->name && *sym->name)? sym->name: NULL;
+				vaddrs[i++] = sym? sym->vaddr: 0;
+			}
+			const char *lang = r_bin_lang_tostring (bf->o->lang);
+			if (!r_bin_demangle_batch (bf, lang, names, vaddrs, dns, count, false)) {
+				R_FREE (dns);
+			}
+		}
+	}
+	i = 0;
 	r_list_foreach (list, iter, sym) {
 		if (sym && sym->name && *sym->name) {
-			r_bin_filter_sym (bf, ht, sym->vaddr, sym);
+			if (dns) {
+				filter_sym (bf, ht, sym->vaddr, sym, dns[i]);
+			} else {
+				r_bin_filter_sym (bf, ht, sym->vaddr, sym);
+			}
 		}
+		i++;
 	}
+	free (names);
+	free (vaddrs);
+	free (dns);
 	ht_pp_free (ht);
 }
 
@@ -468,6 +468,7 @@ R_API void r_bin_free(RBin *bin) {
 		sdb_free (bin->sdb);
 		r_id_storage_free (bin->ids);
 		r_str_constpool_fini (&bin->constpool);
+		r_bin_demangle_cache_clear (bin);
 		free (bin);
 	}
 }
@@ -0,0 +1,108 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include "i/private.h"
+
+// runs independent jobs, like parsing each image of a container, on a
+// few threads. Jobs write their results into their own slot, so callers
+// can merge them in order and get the same output as a serial loop.
+
+#define BIN_JOBS_MAX 16
+
+typedef struct {
+	RBinJobCallback cb;
+	void *user;
+	size_t count;
+	size_t next;
+	bool stop;
+	RThreadLock *lock;
+} BinJobs;
+
+typedef struct {
+	BinJobs *jobs;
+	int tid;
+} BinJobsThread;
+
+static bool jobs_next(BinJobs *w, size_t *idx) {
+	r_th_lock_enter (w->lock);
+	bool ok = !w->stop && w->next < w->count;
+	if (ok) {
+		*idx = w->next++;
+	}
+	r_th_lock_leave (w->lock);
+	return ok;
+}
+
+static void jobs_stop(BinJobs *w) {
+	r_th_lock_enter (w->lock);
+	w->stop = true;
+	r_th_lock_leave (w->lock);
+}
+
+static RThreadFunctionRet jobs_thread(RThread *th) {
+	BinJobsThread *t = th->user;
+	size_t idx;
+	while (jobs_next (t->jobs, &idx)) {
+		if (!t->jobs->cb (t->jobs->user, idx, t->tid)) {
+			jobs_stop (t->jobs);
+		}
+	}
+	return R_TH_STOP;
+}
+
+R_API int r_bin_jobs_threads(size_t count) {
+	return (int)R_MAX (1, R_MIN (R_MIN ((size_t)r_th_ncpus (), count), BIN_JOBS_MAX));
+}
+
+/**
+ * @brief Run cb for every index below count
+ *
+ * The calling thread takes jobs too and is the only one checking for ^C.
+ * cb gets the index of the thread running it, below nthreads, to pick its
+ * own scratch state (a buffer with its own cursor, etc).
+ *
+ * @param nthreads as returned by r_bin_jobs_threads, or 1 to run serially
+ * @return false if a job failed or the user interrupted the loop
+ */
+R_API bool r_bin_jobs_run(RBin *bin, size_t count, int nthreads, RBinJobCallback cb, void *user) {
+	r_return_val_if_fail (cb, false);
+	RConsIsBreaked is_breaked = (bin && bin->consb.is_breaked)? bin->consb.is_breaked: NULL;
+	BinJobs w = { .cb = cb, .user = user, .count = count };
+	RThread *threads[BIN_JOBS_MAX] = {0};
+	BinJobsThread ctx[BIN_JOBS_MAX];
+	size_t idx;
+	int i;
+	nthreads = R_MIN (nthreads, BIN_JOBS_MAX);
+	if (nthreads > 1) {
+		w.lock = r_th_lock_new (false);
+	}
+	if (!w.lock) {
+		for (idx = 0; idx < count; idx++) {
+			if ((is_breaked && is_breaked ()) || !cb (user, idx, 0)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	for (i = 1; i < nthreads; i++) {
+		ctx[i].jobs = &w;
+		ctx[i].tid = i;
+		threads[i] = r_th_new (jobs_thread, &ctx[i], 0);
+	}
+	// check ^C before taking a job, the other threads may take all of them
+	while (!(is_breaked && is_breaked ()) && jobs_next (&w, &idx)) {
+		if (!cb (user, idx, 0)) {
+			jobs_stop (&w);
+		}
+	}
+	if (is_breaked && is_breaked ()) {
+		jobs_stop (&w);
+	}
+	for (i = 1; i < nthreads; i++) {
+		if (threads[i]) {
+			r_th_wait (threads[i]);
+			r_th_free (threads[i]);
+		}
+	}
+	r_th_lock_free (w.lock);
+	return !w.stop;
+}
@@ -22,6 +22,16 @@ R_API bool r_bin_addr2line(RBin *bin, ut64 addr, char *file, int len, int *line)
 
 R_API bool r_bin_addr2line2(RBin *bin, ut64 addr, char *file, int len, int *line) {
 	r_return_val_if_fail (bin, false);
+	if (bin->cur && bin->cur->addrlines) {
+		const RBinAddrLine *row = r_bin_addrline_get (bin->cur->addrlines, addr);
+		if (row) {
+			if (line) {
+				*line = row->line;
+			}
+			r_str_ncpy (file, r_bin_addrline_file (bin->cur->addrlines, row), len);
+			return true;
+		}
+	}
 	if (!bin->cur || !bin->cur->sdb_addrinfo) {
 		return false;
 	}
@@ -54,7 +64,13 @@ R_API char *r_bin_addr2text(RBin *bin, ut64 addr, int origin) {
 		return NULL;
 	}
 	char *key = r_str_newf ("0x%"PFMT64x, addr);
-	char *file_line = sdb_get (bin->cur->sdb_addrinfo, key, 0);
+	char *file_line = NULL;
+	const RBinAddrLine *row = bin->cur->addrlines? r_bin_addrline_get (bin->cur->addrlines, addr): NULL;
+	if (row) {
+		file_line = r_str_newf ("%s|%u", r_bin_addrline_file (bin->cur->addrlines, row), row->line);
+	} else {
+		file_line = sdb_get (bin->cur->sdb_addrinfo, key, 0);
+	}
 	if (file_line) {
 		char *token = strchr (file_line, '|');
 		if (token) {
@@ -62,16 +62,28 @@ R_API int r_bin_demangle_type(const char *str) {
 	return R_BIN_NM_NONE;
 }
 
-R_API char *r_bin_demangle(RBinFile *bf, const char *def, const char *str, ut64 vaddr, bool libs) {
-	int type = -1;
+// results are cached in the RBin, shared by all its files, and dropped
+// all at once when they take more than this
+#define DEMANGLE_CACHE_SIZE (128 * 1024 * 1024)
+// below this many names the batch is not worth the threads
+#define DEMANGLE_THREADS_MIN 1024
+
+typedef struct {
+	const char *str; // name without the prefixes
+	const char *lib; // library prefixed to the demangled name, if any
+	int type;
+} DemangleName;
+
+// strips the prefixes and resolves the language, false if there is nothing to demangle
+static bool demangle_prepare(RBinFile *bf, const char *def, const char *str, bool libs, DemangleName *dn) {
 	if (R_STR_ISEMPTY (str)) {
-		return NULL;
+		return false;
 	}
 	RBin *bin = bf? bf->rbin: NULL;
-	bool trylib = bin? bin->demangle_trylib: true;
 	RBinObject *o = bf? bf->o: NULL;
 	RListIter *iter;
 	const char *lib = NULL;
+	int type = -1;
 	if (!strncmp (str, "reloc.", 6)) {
 		str += 6;
 	}
@@ -115,25 +127,255 @@ R_API char *r_bin_demangle(RBinFile *bf, const char *def, const char *str, ut64
 	}
 	// if str is sym. or imp. when str+=4 str points to the end so just return
 	if (!*str) {
-		return NULL;
+		return false;
 	}
 	if (type == -1) {
 		type = r_bin_lang_type (bf, def, str);
 	}
-	char *demangled = NULL;
+	dn->str = str;
+	dn->lib = libs? lib: NULL;
+	dn->type = type;
+	return true;
+}
+
+// no side effects on the file, so it can run on the job threads, see demangle_add_method
+static char *demangle_as(RBin *bin, int type, const char *str) {
+	bool trylib = bin? bin->demangle_trylib: true;
 	switch (type) {
-	case R_BIN_NM_JAVA: demangled = r_bin_demangle_java (str); break;
-	case R_BIN_NM_RUST: demangled = r_bin_demangle_rust (bf, str, vaddr); break;
-	case R_BIN_NM_OBJC: demangled = r_bin_demangle_objc (NULL, str); break;
-	case R_BIN_NM_SWIFT: demangled = r_bin_demangle_swift (str, bin? bin->demangle_usecmd: false, trylib); break;
-	case R_BIN_NM_CXX: demangled = r_bin_demangle_cxx (bf, str, vaddr); break;
-	case R_BIN_NM_MSVC: demangled = r_bin_demangle_msvc (str); break;
-	case R_BIN_NM_DLANG: demangled = r_bin_demangle_plugin (bin, "dlang", str); break;
-	}
-	if (libs && demangled && lib) {
-		char *d = r_str_newf ("%s_%s", lib, demangled);
+	case R_BIN_NM_JAVA: return r_bin_demangle_java (str);
+	case R_BIN_NM_RUST: return r_bin_demangle_rust (NULL, str, 0);
+	case R_BIN_NM_OBJC: return r_bin_demangle_objc (NULL, str);
+	case R_BIN_NM_SWIFT: return r_bin_demangle_swift (str, bin? bin->demangle_usecmd: false, trylib);
+	case R_BIN_NM_CXX: return r_bin_demangle_cxx (NULL, str, 0);
+	case R_BIN_NM_MSVC: return r_bin_demangle_msvc (str);
+	case R_BIN_NM_DLANG: return r_bin_demangle_plugin (bin, "dlang", str);
+	}
+	return NULL;
+}
+
+// c++ and rust names register their class methods in the file, this is
+// done on the calling thread for every name, also the cached ones
+static void demangle_add_method(RBinFile *bf, int type, const char *demangled, ut64 vaddr) {
+	if (bf && bf->o && demangled && (type == R_BIN_NM_CXX || type == R_BIN_NM_RUST)) {
+		r_bin_demangle_cxx_method (bf, demangled, vaddr);
+	}
+}
+
+// the swift and msvc demanglers keep global state and plugins are unknown
+static bool demangle_is_reentrant(int type) {
+	switch (type) {
+	case R_BIN_NM_JAVA:
+	case R_BIN_NM_RUST:
+	case R_BIN_NM_OBJC:
+	case R_BIN_NM_CXX:
+		return true;
+	}
+	return false;
+}
+
+static char *demangle_finish(const DemangleName *dn, const char *demangled) {
+	if (!demangled) {
+		return NULL;
+	}
+	return dn->lib? r_str_newf ("%s_%s", dn->lib, demangled): strdup (demangled);
+}
+
+static void demangle_cache_kv_free(HtPPKv *kv) {
+	free (kv->key);
+	free (kv->value);
+}
+
+// swift output also depends on how it is demangled
+static char *demangle_cache_key(RBin *bin, const DemangleName *dn) {
+	int mode = (dn->type == R_BIN_NM_SWIFT)? bin->demangle_usecmd | (bin->demangle_trylib << 1): 0;
+	return r_str_newf ("%x.%d.%s", dn->type, mode, dn->str);
+}
+
+// NULL results are cached too, found tells them apart from misses
+static const char *demangle_cache_get(RBin *bin, const char *key, bool *found) {
+	*found = false;
+	return bin->demangle_cache? ht_pp_find (bin->demangle_cache, key, found): NULL;
+}
+
+static void demangle_cache_set(RBin *bin, const char *key, const char *demangled) {
+	size_t size = strlen (key) + (demangled? strlen (demangled): 0) + sizeof (HtPPKv);
+	if (bin->demangle_cache && bin->demangle_cache_size + size > DEMANGLE_CACHE_SIZE) {
+		r_bin_demangle_cache_clear (bin);
+	}
+	if (!bin->demangle_cache) {
+		bin->demangle_cache = ht_pp_new (NULL, demangle_cache_kv_free, NULL);
+		if (!bin->demangle_cache) {
+			return;
+		}
+	}
+	char *value = demangled? strdup (demangled): NULL;
+	if (ht_pp_insert (bin->demangle_cache, key, value)) {
+		bin->demangle_cache_size += size;
+	} else {
+		free (value);
+	}
+}
+
+R_API void r_bin_demangle_cache_clear(RBin *bin) {
+	r_return_if_fail (bin);
+	ht_pp_free (bin->demangle_cache);
+	bin->demangle_cache = NULL;
+	bin->demangle_cache_size = 0;
+}
+
+R_API char *r_bin_demangle(RBinFile *bf, const char *def, const char *str, ut64 vaddr, bool libs) {
+	DemangleName dn;
+	if (!demangle_prepare (bf, def, str, libs, &dn)) {
+		return NULL;
+	}
+	RBin *bin = bf? bf->rbin: NULL;
+	if (!bin) {
+		char *demangled = demangle_as (NULL, dn.type, dn.str);
+		demangle_add_method (bf, dn.type, demangled, vaddr);
+		char *res = demangle_finish (&dn, demangled);
 		free (demangled);
-		demangled = d;
+		return res;
+	}
+	bool found;
+	char *key = demangle_cache_key (bin, &dn);
+	const char *cached = key? demangle_cache_get (bin, key, &found): NULL;
+	if (key && found) {
+		free (key);
+		demangle_add_method (bf, dn.type, cached, vaddr);
+		return demangle_finish (&dn, cached);
+	}
+	char *demangled = demangle_as (bin, dn.type, dn.str);
+	demangle_add_method (bf, dn.type, demangled, vaddr);
+	if (key) {
+		demangle_cache_set (bin, key, demangled);
+		free (key);
+	}
+	char *res = demangle_finish (&dn, demangled);
+	free (demangled);
+	return res;
+}
+
+typedef struct {
+	RBin *bin;
+	char **keys;
+	const char **strs;
+	int *types;
+	char **results;
+} DemangleJobs;
+
+static bool demangle_job(void *user, size_t idx, int tid) {
+	DemangleJobs *w = user;
+	if (w->types[idx] != R_BIN_NM_NONE) {
+		w->results[idx] = demangle_as (w->bin, w->types[idx], w->strs[idx]);
+	}
+	return true;
+}
+
+/**
+ * @brief Demangle many names at once
+ *
+ * Same as calling r_bin_demangle on each name, but every distinct name is
+ * demangled only once and, for big batches, on several threads. The
+ * results go to the cache of the RBin, shared with the other files.
+ *
+ * @param names count names to demangle, NULL entries are skipped
+ * @param vaddrs count addresses of the names, for the methods of the classes, or NULL
+ * @param out count slots for the results, to be freed by the caller
+ */
+R_API bool r_bin_demangle_batch(RBinFile *bf, const char *def, const char **names, const ut64 *vaddrs, char **out, size_t count, bool libs) {
+	r_return_val_if_fail (bf && bf->rbin && names && out, false);
+	RBin *bin = bf->rbin;
+	DemangleName *dns = R_NEWS0 (DemangleName, count);
+	char **keys = R_NEWS0 (char *, count);
+	// index of the first name with the same key, that one is demangled
+	size_t *first = R_NEWS (size_t, count);
+	HtPU *seen = ht_pu_new0 ();
+	DemangleJobs w = { .bin = bin };
+	size_t i, njobs = 0;
+	bool ret = false;
+	if (!dns || !keys || !first || !seen) {
+		goto beach;
+	}
+	w.keys = R_NEWS0 (char *, count);
+	w.strs = R_NEWS0 (const char *, count);
+	w.types = R_NEWS0 (int, count);
+	w.results = R_NEWS0 (char *, count);
+	size_t *job = R_NEWS0 (size_t, count);
+	if (!w.keys || !w.strs || !w.types || !w.results || !job) {
+		free (job);
+		goto beach;
+	}
+	for (i = 0; i < count; i++) {
+		out[i] = NULL;
+		first[i] = i;
+		if (!names[i] || !demangle_prepare (bf, def, names[i], libs, &dns[i])) {
+			dns[i].str = NULL;
+			continue;
+		}
+		keys[i] = demangle_cache_key (bin, &dns[i]);
+		if (!keys[i]) {
+			continue;
+		}
+		bool found;
+		const char *cached = demangle_cache_get (bin, keys[i], &found);
+		if (found) {
+			demangle_add_method (bf, dns[i].type, cached, vaddrs? vaddrs[i]: 0);
+			out[i] = demangle_finish (&dns[i], cached);
+			R_FREE (keys[i]);
+			continue;
+		}
+		ut64 prev = ht_pu_find (seen, keys[i], &found);
+		if (found) {
+			first[i] = (size_t)prev;
+			continue;
+		}
+		ht_pu_insert (seen, keys[i], i);
+		job[i] = njobs;
+		w.keys[njobs] = keys[i];
+		w.strs[njobs] = dns[i].str;
+		w.types[njobs] = dns[i].type;
+		njobs++;
+	}
+	// the reentrant ones go to the threads, the rest is done here
+	size_t nsafe = 0;
+	for (i = 0; i < njobs; i++) {
+		if (!demangle_is_reentrant (w.types[i])) {
+			w.results[i] = demangle_as (bin, w.types[i], w.strs[i]);
+			w.types[i] = R_BIN_NM_NONE;
+		} else {
+			nsafe++;
+		}
+	}
+	int nthreads = nsafe >= DEMANGLE_THREADS_MIN? r_bin_jobs_threads (nsafe): 1;
+	r_bin_jobs_run (NULL, njobs, nthreads, demangle_job, &w);
+	for (i = 0; i < njobs; i++) {
+		demangle_cache_set (bin, w.keys[i], w.results[i]);
+	}
+	for (i = 0; i < count; i++) {
+		if (keys[i]) {
+			const char *demangled = w.results[job[first[i]]];
+			demangle_add_method (bf, dns[i].type, demangled, vaddrs? vaddrs[i]: 0);
+			out[i] = demangle_finish (&dns[i], demangled);
+		}
+	}
+	for (i = 0; i < njobs; i++) {
+		free (w.results[i]);
+	}
+	free (job);
+	ret = true;
+beach:
+	if (keys) {
+		for (i = 0; i < count; i++) {
+			free (keys[i]);
+		}
 	}
-	return demangled;
+	ht_pu_free (seen);
+	free (w.keys);
+	free (w.strs);
+	free (w.types);
+	free (w.results);
+	free (first);
+	free (keys);
+	free (dns);
+	return ret;
 }
@@ -5,6 +5,7 @@
 #include <r_bin.h>
 #include <r_bin_dwarf.h>
 #include <r_core.h>
+#include <r_th.h>
 
 #define STANDARD_OPERAND_COUNT_DWARF2 9
 #define STANDARD_OPERAND_COUNT_DWARF3 12
@@ -340,6 +341,12 @@ static int abbrev_cmp(const void *a, const void *b) {
 	}
 }
 
+static int offset_cmp(const void *a, const void *b) {
+	ut64 first = *(const ut64 *)a;
+	ut64 second = *(const ut64 *)b;
+	return (first > second) - (first < second);
+}
+
 static bool is_printable_lang(ut64 attr_code) {
 	if (attr_code >= sizeof (dwarf_langs) / sizeof (dwarf_langs[0])) {
 		return false;
@@ -673,13 +680,10 @@ static const ut8 *parse_line_header(
 	return buf;
 }
 
-static inline void add_sdb_addrline(Sdb *s, ut64 addr, const char *file, ut64 line, int mode, PrintfCallback print) {
+static inline void add_addrline(RBinAddrLineTable *t, ut64 addr, const char *file, ut64 line, ut64 column, int mode, PrintfCallback print) {
 	const char *p;
-	char *fileline;
-	char offset[64];
-	char *offset_ptr;
 
-	if (!s || !file) {
+	if (!t || !file) {
 		return;
 	}
 	p = r_str_rchr (file, NULL, '/');
@@ -704,11 +708,7 @@ static inline void add_sdb_addrline(Sdb *s, ut64 addr, const char *file, ut64 li
 #else
 	p = file;
 #endif
-	fileline = r_str_newf ("%s|%"PFMT64d, p, line);
-	offset_ptr = sdb_itoa (addr, offset, 16);
-	sdb_add (s, offset_ptr, fileline, 0);
-	sdb_add (s, fileline, offset_ptr, 0);
-	free (fileline);
+	r_bin_addrline_add (t, addr, p, line, column);
 }
 
 static const ut8 *parse_ext_opcode(const RBin *bin, const ut8 *obuf,
@@ -745,11 +745,11 @@ static const ut8 *parse_ext_opcode(const RBin *bin, const ut8 *obuf,
 	case DW_LNE_end_sequence:
 		regs->end_sequence = DWARF_TRUE;
 
-		if (binfile && binfile->sdb_addrinfo && hdr->file_names) {
+		if (binfile && binfile->addrlines && hdr->file_names) {
 			int fnidx = regs->file - 1;
 			if (fnidx >= 0 && fnidx < hdr->file_names_count) {
-				add_sdb_addrline(binfile->sdb_addrinfo, regs->address,
-						hdr->file_names[fnidx].name, regs->line, mode, print);
+				add_addrline (binfile->addrlines, regs->address,
+						hdr->file_names[fnidx].name, regs->line, regs->column, mode, print);
 			}
 		}
 
@@ -835,12 +835,12 @@ static const ut8 *parse_spec_opcode(
 		print ("advance Address by %"PFMT64d" to 0x%"PFMT64x" and Line by %d to %"PFMT64d"\n",
 			advance_adr, regs->address, line_increment, regs->line);
 	}
-	if (binfile && binfile->sdb_addrinfo && hdr->file_names) {
+	if (binfile && binfile->addrlines && hdr->file_names) {
 		int idx = regs->file -1;
 		if (idx >= 0 && idx < hdr->file_names_count) {
-			add_sdb_addrline (binfile->sdb_addrinfo, regs->address,
+			add_addrline (binfile->addrlines, regs->address,
 					hdr->file_names[idx].name,
-					regs->line, mode, print);
+					regs->line, regs->column, mode, print);
 		}
 	}
 	regs->basic_block = DWARF_FALSE;
@@ -876,13 +876,13 @@ static const ut8 *parse_std_opcode(
 		if (mode == R_MODE_PRINT) {
 			print ("Copy\n");
 		}
-		if (binfile && binfile->sdb_addrinfo && hdr->file_names) {
+		if (binfile && binfile->addrlines && hdr->file_names) {
 			int fnidx = regs->file - 1;
 			if (fnidx >= 0 && fnidx < hdr->file_names_count) {
-				add_sdb_addrline (binfile->sdb_addrinfo,
+				add_addrline (binfile->addrlines,
 					regs->address,
 					hdr->file_names[fnidx].name,
-					regs->line, mode, print);
+					regs->line, regs->column, mode, print);
 			}
 		}
 		regs->basic_block = DWARF_FALSE;
@@ -1194,12 +1194,37 @@ static int init_debug_info(RBinDwarfDebugInfo *inf) {
 	return true;
 }
 
-static int init_die(RBinDwarfDie *die, ut64 abbr_code, ut64 attr_count) {
+#define ATTR_CHUNK_MIN 64
+#define ATTR_CHUNK_MAX 4096
+
+// attribute values are carved from chunks owned by the comp unit instead
+// of doing one allocation per die, they are all released with the unit
+static RBinDwarfAttrValue *cu_alloc_attrs(RBinDwarfCompUnit *cu, size_t n) {
+	if (cu->attr_left < n) {
+		// chunks grow geometrically so small units stay small
+		size_t nchunks = R_MIN (r_pvector_len (&cu->attr_chunks), 6);
+		size_t size = R_MAX (R_MIN (ATTR_CHUNK_MAX, ATTR_CHUNK_MIN << nchunks), n);
+		RBinDwarfAttrValue *chunk = R_NEWS0 (RBinDwarfAttrValue, size);
+		if (!chunk || !r_pvector_push (&cu->attr_chunks, chunk)) {
+			free (chunk);
+			return NULL;
+		}
+		cu->attr_next = chunk;
+		cu->attr_left = size;
+	}
+	RBinDwarfAttrValue *res = cu->attr_next;
+	cu->attr_next += n;
+	cu->attr_left -= n;
+	return res;
+}
+
+static int init_die(RBinDwarfCompUnit *cu, RBinDwarfDie *die, ut64 abbr_code, ut64 attr_count) {
 	if (!die) {
 		return -1;
 	}
-	die->attr_values = calloc (sizeof (RBinDwarfAttrValue), attr_count);
-	if (!die->attr_values) {
+	// dies without attributes are valid, they just take no space
+	die->attr_values = attr_count? cu_alloc_attrs (cu, attr_count): NULL;
+	if (attr_count && !die->attr_values) {
 		return -1;
 	}
 	die->abbrev_code = abbr_code;
@@ -1216,6 +1241,9 @@ static bool init_comp_unit(RBinDwarfCompUnit *cu) {
 	if (!cu->dies) {
 		return false;
 	}
+	r_pvector_init (&cu->attr_chunks, free);
+	cu->attr_next = NULL;
+	cu->attr_left = 0;
 	cu->capacity = COMP_UNIT_CAPACITY;
 	cu->count = 0;
 	return true;
@@ -1390,7 +1418,8 @@ static void free_die(RBinDwarfDie *die) {
 	for (i = 0; i < die->count; i++) {
 		free_attr_value (&die->attr_values[i]);
 	}
-	R_FREE (die->attr_values);
+	// the storage belongs to the comp unit arena
+	die->attr_values = NULL;
 }
 
 static void free_comp_unit(RBinDwarfCompUnit *cu) {
@@ -1404,6 +1433,7 @@ static void free_comp_unit(RBinDwarfCompUnit *cu) {
 		}
 	}
 	R_FREE (cu->dies);
+	r_pvector_fini (&cu->attr_chunks);
 }
 
 R_API void r_bin_dwarf_free_debug_info(RBinDwarfDebugInfo *inf) {
@@ -1872,7 +1902,7 @@ static const ut8 *parse_attr_value(const ut8 *obuf, int obuf_len,
  * @param sdb
  * @return const ut8* Updated buffer
  */
-static const ut8 *parse_die(const ut8 *buf, const ut8 *buf_end, RBinDwarfAbbrevDecl *abbrev, RBinDwarfCompUnitHdr *hdr, RBinDwarfDie *die, const ut8 *debug_str, size_t debug_str_len, Sdb *sdb) {
+static const ut8 *parse_die(const ut8 *buf, const ut8 *buf_end, RBinDwarfAbbrevDecl *abbrev, RBinDwarfCompUnitHdr *hdr, RBinDwarfDie *die, const ut8 *debug_str, size_t debug_str_len, const char **comp_dir) {
 	size_t i;
 	if (!buf || !buf_end || buf > buf_end) {
 		return NULL;
@@ -1901,8 +1931,7 @@ static const ut8 *parse_die(const ut8 *buf, const ut8 *buf_end, RBinDwarfAbbrevD
 		// Or atleast it needs to rework becase there will be
 		// more comp units -> more comp dirs and only the last one will be kept
 		if (attribute->attr_name == DW_AT_comp_dir && is_valid_string_form) {
-			const char *name = attribute->string.content;
-			sdb_set (sdb, "DW_AT_comp_dir", name, 0);
+			*comp_dir = attribute->string.content;
 		}
 		die->count++;
 	}
@@ -1912,25 +1941,24 @@ static const ut8 *parse_die(const ut8 *buf, const ut8 *buf_end, RBinDwarfAbbrevD
 /**
  * @brief Reads throught comp_unit buffer and parses all its DIEntries
  *
- * @param sdb
+ * Only touches the given unit, so different units can be parsed concurrently.
+ *
  * @param buf_start Start of the compilation unit data
+ * @param buf_end End of the compilation unit data
  * @param unit Unit to store the newly parsed information
  * @param abbrevs Parsed abbrev section info of *all* abbreviations
  * @param first_abbr_idx index for first abbrev of the current comp unit in abbrev array
  * @param debug_str Ptr to string section start
  * @param debug_str_len Length of the string section
+ * @param comp_dir Set to the last DW_AT_comp_dir string found in the unit
  *
  * @return const ut8* Update buffer
  */
-static const ut8 *parse_comp_unit(RBinDwarfDebugInfo *info, Sdb *sdb, const ut8 *buf_start, const ut8 *buf_end,
+static const ut8 *parse_comp_unit(const ut8 *buf_start, const ut8 *buf_end,
 		RBinDwarfCompUnit *unit, const RBinDwarfDebugAbbrev *abbrevs,
-		size_t first_abbr_idx, const ut8 *debug_str, size_t debug_str_len) {
+		size_t first_abbr_idx, const ut8 *debug_str, size_t debug_str_len, const char **comp_dir) {
 
 	const ut8 *buf = buf_start;
-	const ut8 *theoric_buf_end = buf_start + unit->hdr.length - unit->hdr.header_size;
-	if (theoric_buf_end < buf_end) {
-		buf_end = theoric_buf_end;
-	}
 
 	while (buf && buf < buf_end && buf >= buf_start) {
 		if (unit->count && unit->capacity == unit->count) {
@@ -1965,13 +1993,13 @@ static const ut8 *parse_comp_unit(RBinDwarfDebugInfo *info, Sdb *sdb, const ut8
 		}
 		RBinDwarfAbbrevDecl *abbrev = &abbrevs->decls[abbr_idx - 1];
 
-		if (init_die (die, abbr_code, abbrev->count)) {
+		if (init_die (unit, die, abbr_code, abbrev->count)) {
 			return NULL; // error
 		}
 		die->tag = abbrev->tag;
 		die->has_children = abbrev->has_children;
 
-		buf = parse_die (buf, buf_end, abbrev, &unit->hdr, die, debug_str, debug_str_len, sdb);
+		buf = parse_die (buf, buf_end, abbrev, &unit->hdr, die, debug_str, debug_str_len, comp_dir);
 		if (!buf) {
 			return NULL;
 		}
@@ -2035,26 +2063,109 @@ static int expand_info(RBinDwarfDebugInfo *info) {
 	return 0;
 }
 
+typedef struct {
+	const ut8 *start; // first die of the unit
+	const ut8 *end;
+	size_t first_abbr_idx;
+	const char *comp_dir;
+	bool ok;
+} DwarfUnitJob;
+
+typedef struct {
+	RBinDwarfDebugInfo *info;
+	const RBinDwarfDebugAbbrev *da;
+	DwarfUnitJob *jobs;
+	const ut8 *debug_str;
+	size_t debug_str_len;
+	RThreadLock *lock;
+	size_t next;
+} DwarfInfoWork;
+
+// units below this size are not worth spawning threads for
+#define DWARF_THREADS_MIN_SIZE (512 * 1024)
+#define DWARF_THREADS_MAX 16
+
+static void parse_unit_job(DwarfInfoWork *w, size_t i) {
+	DwarfUnitJob *job = &w->jobs[i];
+	RBinDwarfCompUnit *unit = &w->info->comp_units[i];
+	job->ok = parse_comp_unit (job->start, job->end, unit, w->da,
+		job->first_abbr_idx, w->debug_str, w->debug_str_len, &job->comp_dir) != NULL;
+}
+
+static RThreadFunctionRet parse_units_thread(RThread *th) {
+	DwarfInfoWork *w = th->user;
+	for (;;) {
+		r_th_lock_enter (w->lock);
+		size_t i = w->next++;
+		r_th_lock_leave (w->lock);
+		if (i >= w->info->count) {
+			break;
+		}
+		parse_unit_job (w, i);
+	}
+	return R_TH_STOP;
+}
+
+// every unit is written to its own slot, so the result does not depend on scheduling.
+// want is bin.dbginfo.threads, 0 picks one per cpu for big sections
+static void parse_units(DwarfInfoWork *w, size_t len, int want) {
+	size_t i, nthreads = 1;
+	if (want > 0) {
+		nthreads = R_MIN (R_MIN ((size_t)want, w->info->count), DWARF_THREADS_MAX);
+	} else if (len >= DWARF_THREADS_MIN_SIZE && w->info->count > 1) {
+		nthreads = R_MIN (R_MIN ((size_t)r_th_ncpus (), w->info->count), DWARF_THREADS_MAX);
+	}
+	RThread *threads[DWARF_THREADS_MAX] = {0};
+	if (nthreads > 1) {
+		w->lock = r_th_lock_new (false);
+	}
+	if (w->lock) {
+		for (i = 0; i < nthreads; i++) {
+			threads[i] = r_th_new (parse_units_thread, w, 0);
+		}
+		for (i = 0; i < nthreads; i++) {
+			if (threads[i]) {
+				r_th_wait (threads[i]);
+				r_th_free (threads[i]);
+			}
+		}
+		r_th_lock_free (w->lock);
+		w->lock = NULL;
+	}
+	// pick up the leftovers if threads could not be created
+	for (i = w->next; i < w->info->count; i++) {
+		parse_unit_job (w, i);
+	}
+}
+
 /**
  * @brief Parses whole .debug_info section
  *
+ * The unit headers are walked first, then the units are parsed, in parallel
+ * for big sections, since they only share the read-only abbreviations.
+ *
  * @param sdb Sdb to store line related information into
  * @param da Parsed Abbreviations
  * @param obuf .debug_info section buffer start
  * @param len length of the section buffer
  * @param debug_str start of the .debug_str section
  * @param debug_str_len length of the debug_str section
- * @param mode
+ * @param units sorted offsets of the units to parse, NULL for all of them
+ * @param nunits number of unit offsets
+ * @param threads number of threads parsing the units, 0 to pick them by size
  * @return R_API* parse_info_raw Parsed information
  */
 static RBinDwarfDebugInfo *parse_info_raw(Sdb *sdb, RBinDwarfDebugAbbrev *da,
 		const ut8 *obuf, size_t len,
-		const ut8 *debug_str, size_t debug_str_len) {
+		const ut8 *debug_str, size_t debug_str_len,
+		const ut64 *units, size_t nunits, int threads) {
 
 	r_return_val_if_fail (da && sdb && obuf, false);
 
 	const ut8 *buf = obuf;
 	const ut8 *buf_end = obuf + len;
+	RVector jobs;
+	r_vector_init (&jobs, sizeof (DwarfUnitJob), NULL, NULL);
 
 	RBinDwarfDebugInfo *info = R_NEW0 (RBinDwarfDebugInfo);
 	if (!info) {
@@ -2063,31 +2174,38 @@ static RBinDwarfDebugInfo *parse_info_raw(Sdb *sdb, RBinDwarfDebugAbbrev *da,
 	if (init_debug_info (info) < 0) {
 		goto cleanup;
 	}
-	int unit_idx = 0;
 
 	while (buf < buf_end) {
+		RBinDwarfCompUnitHdr hdr = {0};
+		ut64 offset = buf - obuf;
+		// small redundancy, because it was easiest solution at a time
+		hdr.unit_offset = offset;
+		buf = info_comp_unit_read_hdr (buf, buf_end, &hdr);
+		if (hdr.length > len) {
+			goto cleanup;
+		}
+		const ut8 *unit_end = buf;
+		if (hdr.length > hdr.header_size) {
+			ut64 size = hdr.length - hdr.header_size;
+			unit_end = size < (ut64)(buf_end - buf)? buf + size: buf_end;
+		}
+		if (units && !bsearch (&offset, units, nunits, sizeof (ut64), offset_cmp)) {
+			buf = unit_end;
+			continue;
+		}
 		if (info->count >= info->capacity) {
 			if (expand_info (info)) {
 				break;
 			}
 		}
 
-		RBinDwarfCompUnit *unit = &info->comp_units[unit_idx];
+		RBinDwarfCompUnit *unit = &info->comp_units[info->count];
 		if (!init_comp_unit (unit)) {
-			unit_idx--;
 			goto cleanup;
 		}
 		info->count++;
-
-		unit->offset = buf - obuf;
-		// small redundancy, because it was easiest solution at a time
-		unit->hdr.unit_offset = buf - obuf;
-
-		buf = info_comp_unit_read_hdr (buf, buf_end, &unit->hdr);
-
-		if (unit->hdr.length > len) {
-			goto cleanup;
-		}
+		unit->offset = offset;
+		unit->hdr = hdr;
 
 		if (da->decls->count >= da->capacity) {
 			eprintf ("Warning: malformed dwarf have not enough buckets for decls.\n");
@@ -2102,20 +2220,43 @@ static RBinDwarfDebugInfo *parse_info_raw(Sdb *sdb, RBinDwarfDebugAbbrev *da,
 		if (!abbrev_start) {
 			goto cleanup;
 		}
-		// They point to the same array object, so should be def. behaviour
-		size_t first_abbr_idx = abbrev_start - da->decls;
-
-		buf = parse_comp_unit (info, sdb, buf, buf_end, unit, da, first_abbr_idx, debug_str, debug_str_len);
-		if (!buf) {
+		DwarfUnitJob job = {
+			.start = buf,
+			.end = unit_end,
+			// They point to the same array object, so should be def. behaviour
+			.first_abbr_idx = abbrev_start - da->decls
+		};
+		if (!r_vector_push (&jobs, &job)) {
 			goto cleanup;
 		}
-
-		unit_idx++;
+		buf = unit_end;
 	}
 
+	DwarfInfoWork work = {
+		.info = info,
+		.da = da,
+		.jobs = jobs.a,
+		.debug_str = debug_str,
+		.debug_str_len = debug_str_len
+	};
+	parse_units (&work, len, threads);
+
+	size_t i;
+	DwarfUnitJob *job;
+	r_vector_enumerate (&jobs, job, i) {
+		if (!job->ok) {
+			goto cleanup;
+		}
+		// same as a sequential parse, the last one wins
+		if (job->comp_dir) {
+			sdb_set (sdb, "DW_AT_comp_dir", job->comp_dir, 0);
+		}
+	}
+	r_vector_fini (&jobs);
 	return info;
 
 cleanup:
+	r_vector_fini (&jobs);
 	r_bin_dwarf_free_debug_info (info);
 	return NULL;
 }
@@ -2212,15 +2353,7 @@ static ut8 *get_section_bytes(RBin *bin, const char *sect_name, size_t *len) {
 	return buf;
 }
 
-/**
- * @brief Parses .debug_info section
- *
- * @param da Parsed abbreviations
- * @param bin
- * @param mode R_MODE_PRINT to print
- * @return RBinDwarfDebugInfo* Parsed information, NULL if error
- */
-R_API RBinDwarfDebugInfo *r_bin_dwarf_parse_info(RBinDwarfDebugAbbrev *da, RBin *bin, int mode) {
+static RBinDwarfDebugInfo *parse_info(RBinDwarfDebugAbbrev *da, RBin *bin, int mode, const ut64 *units, size_t nunits) {
 	RBinDwarfDebugInfo *info = NULL;
 	RBinSection *debug_str;
 	RBinSection *section = getsection (bin, "debug_info");
@@ -2260,7 +2393,7 @@ R_API RBinDwarfDebugInfo *r_bin_dwarf_parse_info(RBinDwarfDebugAbbrev *da, RBin
 		/* set the endianity global [HOTFIX] */
 		big_end = r_bin_is_big_endian (bin);
 		info = parse_info_raw (binfile->sdb_addrinfo, da, buf, len,
-			debug_str_buf, debug_str_len);
+			debug_str_buf, debug_str_len, units, nunits, bin->dwarf_threads);
 
 		if (mode == R_MODE_PRINT && info) {
 			print_debug_info (info, bin->cb_printf);
@@ -2285,6 +2418,42 @@ cleanup:
 	return NULL;
 }
 
+/**
+ * @brief Parses .debug_info section
+ *
+ * @param da Parsed abbreviations
+ * @param bin
+ * @param mode R_MODE_PRINT to print
+ * @return RBinDwarfDebugInfo* Parsed information, NULL if error
+ */
+R_API RBinDwarfDebugInfo *r_bin_dwarf_parse_info(RBinDwarfDebugAbbrev *da, RBin *bin, int mode) {
+	return parse_info (da, bin, mode, NULL, 0);
+}
+
+/**
+ * @brief Parses only the given compilation units of the .debug_info section
+ *
+ * References to dies of other units are left unresolved in the lookup table.
+ *
+ * @param da Parsed abbreviations
+ * @param bin
+ * @param units offsets of the units in .debug_info, as found in the index
+ * @param count number of units
+ * @return RBinDwarfDebugInfo* Parsed information, NULL if error
+ */
+R_API RBinDwarfDebugInfo *r_bin_dwarf_parse_units(RBinDwarfDebugAbbrev *da, RBin *bin, const ut64 *units, size_t count) {
+	r_return_val_if_fail (da && bin && units, NULL);
+	ut64 *sorted = R_NEWS (ut64, count);
+	if (!sorted) {
+		return NULL;
+	}
+	memcpy (sorted, units, count * sizeof (ut64));
+	qsort (sorted, count, sizeof (ut64), offset_cmp);
+	RBinDwarfDebugInfo *info = parse_info (da, bin, R_MODE_SET, sorted, count);
+	free (sorted);
+	return info;
+}
+
 static RBinDwarfRow *row_new(ut64 addr, const char *file, int line, int col) {
 	RBinDwarfRow *row = R_NEW0 (RBinDwarfRow);
 	if (!row) {
@@ -2293,7 +2462,7 @@ static RBinDwarfRow *row_new(ut64 addr, const char *file, int line, int col) {
 	row->file = strdup (file);
 	row->address = addr;
 	row->line = line;
-	row->column = 0;
+	row->column = col;
 	return row;
 }
 
@@ -2303,6 +2472,14 @@ static void row_free(void *p) {
 	free (row);
 }
 
+static bool addrline_to_row(void *user, const RBinAddrLine *al, const char *file) {
+	RBinDwarfRow *row = row_new (al->addr, file, al->line, al->column);
+	if (row) {
+		r_list_append ((RList *)user, row);
+	}
+	return true;
+}
+
 R_API RList *r_bin_dwarf_parse_line(RBin *bin, int mode) {
 	ut8 *buf;
 	RList *list = NULL;
@@ -2331,36 +2508,14 @@ R_API RList *r_bin_dwarf_parse_line(RBin *bin, int mode) {
 		/* set the endianity global [HOTFIX] */
 		big_end = r_bin_is_big_endian (bin);
 		// Actually parse the section
+		if (binfile->addrlines) {
+			r_bin_addrline_reset (binfile->addrlines);
+		}
 		parse_line_raw (bin, buf, len, mode);
-		// k bin/cur/addrinfo/*
-		SdbListIter *iter;
-		SdbKv *kv;
-		SdbList *ls = sdb_foreach_list (binfile->sdb_addrinfo, false);
 		// Use the parsed information from _raw and transform it to more useful format
-		ls_foreach (ls, iter, kv) {
-			if (!strncmp (sdbkv_key (kv), "0x", 2)) {
-				ut64 addr;
-				RBinDwarfRow *row;
-				int line;
-				char *file = strdup (sdbkv_value (kv));
-				if (!file) {
-					free (buf);
-					ls_free (ls);
-					r_list_free (list);
-					return NULL;
-				}
-				char *tok = strchr (file, '|');
-				if (tok) {
-					*tok++ = 0;
-					line = atoi (tok);
-					addr = r_num_math (NULL, sdbkv_key (kv));
-					row = row_new (addr, file, line, 0);
-					r_list_append (list, row);
-				}
-				free (file);
-			}
+		if (binfile->addrlines) {
+			r_bin_addrline_foreach (binfile->addrlines, addrline_to_row, list);
 		}
-		ls_free (ls);
 		free (buf);
 	}
 	return list;
@@ -2582,3 +2737,451 @@ R_API void r_bin_dwarf_free_loc(HtUP /*<offset, RBinDwarfLocList*>*/ *loc_table)
 	loc_table->opt.freefn = free_loc_table_entry;
 	ht_up_free (loc_table);
 }
+
+static void index_name_free(HtPPKv *kv) {
+	free (kv->key);
+	r_vector_free (kv->value);
+}
+
+static void index_add_name(RBinDwarfIndex *idx, const char *name, ut64 unit, ut64 die, ut64 tag) {
+	RVector *entries = ht_pp_find (idx->names, name, NULL);
+	if (!entries) {
+		entries = r_vector_new (sizeof (RBinDwarfNameEntry), NULL, NULL);
+		if (!entries || !ht_pp_insert (idx->names, name, entries)) {
+			r_vector_free (entries);
+			return;
+		}
+	}
+	RBinDwarfNameEntry entry = { .unit = unit, .die = die, .tag = tag };
+	r_vector_push (entries, &entry);
+}
+
+static void index_add_range(RBinDwarfIndex *idx, ut64 from, ut64 to, ut64 unit) {
+	if (from < to) {
+		RBinDwarfAddrRange range = { .from = from, .to = to, .unit = unit };
+		r_vector_push (&idx->ranges, &range);
+	}
+}
+
+// gdb symbol kinds, stored in bits 28-30 of the cu vector entries
+static ut64 gdb_index_tag(ut32 v) {
+	switch ((v >> 28) & 7) {
+	case 2:
+		return DW_TAG_variable;
+	case 3:
+		return DW_TAG_subprogram;
+	default:
+		return 0;
+	}
+}
+
+// https://sourceware.org/gdb/onlinedocs/gdb/Index-Section-Format.html
+static bool parse_gdb_index(RBinDwarfIndex *idx, const ut8 *buf, size_t len) {
+	if (len < 24) {
+		return false;
+	}
+	// this section is always little endian
+	ut32 version = r_read_le32 (buf);
+	ut32 cu_list = r_read_le32 (buf + 4);
+	ut32 tu_list = r_read_le32 (buf + 8);
+	ut32 addr_area = r_read_le32 (buf + 12);
+	ut32 symtab = r_read_le32 (buf + 16);
+	ut32 pool = r_read_le32 (buf + 20);
+	if (version < 7 || cu_list > tu_list || tu_list > addr_area
+			|| addr_area > symtab || symtab > pool || pool > len) {
+		return false;
+	}
+	size_t i, j, ncus = (tu_list - cu_list) / 16;
+	const ut8 *cus = buf + cu_list;
+	for (i = addr_area; i + 20 <= symtab; i += 20) {
+		ut32 cu = r_read_le32 (buf + i + 16);
+		if (cu < ncus) {
+			index_add_range (idx, r_read_le64 (buf + i), r_read_le64 (buf + i + 8),
+				r_read_le64 (cus + cu * 16));
+		}
+	}
+	for (i = symtab; i + 8 <= pool; i += 8) {
+		ut32 name = r_read_le32 (buf + i);
+		ut32 vec = r_read_le32 (buf + i + 4);
+		if (!name && !vec) {
+			continue;
+		}
+		if ((ut64)pool + name >= len || (ut64)pool + vec + 4 > len) {
+			continue;
+		}
+		const char *str = (const char *)buf + pool + name;
+		if (!memchr (str, 0, len - pool - name)) {
+			continue;
+		}
+		const ut8 *v = buf + pool + vec;
+		ut32 count = r_read_le32 (v);
+		if (count > (len - pool - vec - 4) / 4) {
+			continue;
+		}
+		for (j = 0; j < count; j++) {
+			ut32 entry = r_read_le32 (v + 4 + j * 4);
+			ut32 cu = entry & 0xffffff;
+			// type units live in .debug_types, not handled
+			if (cu < ncus) {
+				index_add_name (idx, str, r_read_le64 (cus + cu * 16), UT64_MAX, gdb_index_tag (entry));
+			}
+		}
+	}
+	return true;
+}
+
+typedef struct {
+	ut64 code;
+	ut64 tag;
+	size_t count;
+	ut64 attrs[16][2]; // index, form
+} DebugNamesAbbrev;
+
+static bool debug_names_read_form(const ut8 **buf, const ut8 *buf_end, ut64 form, ut64 *value) {
+	const ut8 *p = *buf;
+	size_t size = 0;
+	switch (form) {
+	case DW_FORM_flag_present:
+		*value = 1;
+		return true;
+	case DW_FORM_udata:
+	case DW_FORM_ref_udata:
+		p = r_uleb128 (p, buf_end - p, value, NULL);
+		if (!p || p > buf_end) {
+			return false;
+		}
+		*buf = p;
+		return true;
+	case DW_FORM_data1:
+	case DW_FORM_ref1:
+	case DW_FORM_flag:
+		size = 1;
+		break;
+	case DW_FORM_data2:
+	case DW_FORM_ref2:
+		size = 2;
+		break;
+	case DW_FORM_data4:
+	case DW_FORM_ref4:
+		size = 4;
+		break;
+	case DW_FORM_data8:
+	case DW_FORM_ref8:
+	case DW_FORM_ref_sig8:
+		size = 8;
+		break;
+	default:
+		return false;
+	}
+	if (size > (size_t)(buf_end - p)) {
+		return false;
+	}
+	*value = r_read_ble (p, big_end, size * 8);
+	*buf = p + size;
+	return true;
+}
+
+static DebugNamesAbbrev *debug_names_abbrev(RVector *abbrevs, ut64 code) {
+	DebugNamesAbbrev *ab;
+	r_vector_foreach (abbrevs, ab) {
+		if (ab->code == code) {
+			return ab;
+		}
+	}
+	return NULL;
+}
+
+// parses one name index of .debug_names, returns the end of it or NULL
+static const ut8 *parse_debug_names_unit(RBinDwarfIndex *idx, const ut8 *buf, const ut8 *buf_end, const ut8 *str, size_t str_len) {
+	const ut8 *start = buf;
+	if (buf_end - buf < 4) {
+		return NULL;
+	}
+	bool is_64bit = false;
+	ut64 length = READ32 (buf);
+	if (length == (ut32)DWARF_INIT_LEN_64) {
+		length = READ64 (buf);
+		is_64bit = true;
+	}
+	if (length > (ut64)(buf_end - buf)) {
+		return NULL;
+	}
+	const ut8 *unit_end = buf + length;
+	buf_end = unit_end;
+	size_t offsz = is_64bit? 8: 4;
+	if (buf_end - buf < 36) {
+		return NULL;
+	}
+	ut16 version = r_read_ble16 (buf, big_end);
+	ut32 cu_count = r_read_ble32 (buf + 4, big_end);
+	ut32 ltu_count = r_read_ble32 (buf + 8, big_end);
+	ut32 ftu_count = r_read_ble32 (buf + 12, big_end);
+	ut32 bucket_count = r_read_ble32 (buf + 16, big_end);
+	ut32 name_count = r_read_ble32 (buf + 20, big_end);
+	ut32 abbrev_size = r_read_ble32 (buf + 24, big_end);
+	ut32 aug_size = r_read_ble32 (buf + 28, big_end);
+	buf += 32;
+	if (version != 5) {
+		return unit_end;
+	}
+	ut64 tables = (ut64)aug_size + ((ut64)cu_count + ltu_count + 2 * (ut64)name_count) * offsz
+		+ (ut64)ftu_count * 8 + (ut64)bucket_count * 4 + (bucket_count? (ut64)name_count * 4: 0)
+		+ abbrev_size;
+	if (tables > (ut64)(buf_end - buf)) {
+		return NULL;
+	}
+	const ut8 *cus = buf + aug_size;
+	const ut8 *strs = cus + ((ut64)cu_count + ltu_count) * offsz + (ut64)ftu_count * 8
+		+ (ut64)bucket_count * 4 + (bucket_count? (ut64)name_count * 4: 0);
+	const ut8 *entries = strs + (ut64)name_count * offsz;
+	const ut8 *abbrev = entries + (ut64)name_count * offsz;
+	const ut8 *pool = abbrev + abbrev_size;
+
+	RVector abbrevs;
+	r_vector_init (&abbrevs, sizeof (DebugNamesAbbrev), NULL, NULL);
+	const ut8 *p = abbrev;
+	while (p && p < pool) {
+		DebugNamesAbbrev ab = {0};
+		p = r_uleb128 (p, pool - p, &ab.code, NULL);
+		if (!ab.code || !p || p >= pool) {
+			break;
+		}
+		p = r_uleb128 (p, pool - p, &ab.tag, NULL);
+		for (;;) {
+			ut64 attr = 0, form = 0;
+			if (!p || p >= pool) {
+				break;
+			}
+			p = r_uleb128 (p, pool - p, &attr, NULL);
+			if (!p || p >= pool) {
+				break;
+			}
+			p = r_uleb128 (p, pool - p, &form, NULL);
+			if (!attr && !form) {
+				break;
+			}
+			if (ab.count < R_ARRAY_SIZE (ab.attrs)) {
+				ab.attrs[ab.count][0] = attr;
+				ab.attrs[ab.count][1] = form;
+				ab.count++;
+			}
+		}
+		r_vector_push (&abbrevs, &ab);
+	}
+
+	ut32 i;
+	size_t j;
+	for (i = 0; i < name_count; i++) {
+		ut64 name = r_read_ble (strs + i * offsz, big_end, offsz * 8);
+		ut64 entry = r_read_ble (entries + i * offsz, big_end, offsz * 8);
+		if (name >= str_len || entry >= (ut64)(buf_end - pool)) {
+			continue;
+		}
+		const char *s = (const char *)str + name;
+		if (!memchr (s, 0, str_len - name)) {
+			continue;
+		}
+		// every name has a series of entries ended by a zero abbrev code
+		const ut8 *e = pool + entry;
+		while (e && e < buf_end) {
+			ut64 code = 0;
+			e = r_uleb128 (e, buf_end - e, &code, NULL);
+			DebugNamesAbbrev *ab = code? debug_names_abbrev (&abbrevs, code): NULL;
+			if (!ab || !e) {
+				break;
+			}
+			ut64 cu = 0, die = UT64_MAX;
+			bool is_type_unit = false, ok = true;
+			for (j = 0; j < ab->count && ok; j++) {
+				ut64 value = 0;
+				ok = debug_names_read_form (&e, buf_end, ab->attrs[j][1], &value);
+				switch (ab->attrs[j][0]) {
+				case DW_IDX_compile_unit:
+					cu = value;
+					break;
+				case DW_IDX_type_unit:
+					is_type_unit = true;
+					break;
+				case DW_IDX_die_offset:
+					die = value;
+					break;
+				}
+			}
+			if (!ok) {
+				break;
+			}
+			if (!is_type_unit && cu < cu_count) {
+				ut64 unit = r_read_ble (cus + cu * offsz, big_end, offsz * 8);
+				// die offsets are relative to the unit
+				index_add_name (idx, s, unit, die != UT64_MAX? unit + die: UT64_MAX, ab->tag);
+			}
+		}
+	}
+	r_vector_fini (&abbrevs);
+	return unit_end > start? unit_end: NULL;
+}
+
+static bool parse_debug_names(RBinDwarfIndex *idx, const ut8 *buf, size_t len, const ut8 *str, size_t str_len) {
+	const ut8 *buf_end = buf + len;
+	bool found = false;
+	while (buf && buf < buf_end) {
+		buf = parse_debug_names_unit (idx, buf, buf_end, str, str_len);
+		found |= buf != NULL;
+	}
+	return found;
+}
+
+static void parse_aranges_index(RBinDwarfIndex *idx, const ut8 *obuf, size_t len) {
+	const ut8 *buf = obuf;
+	const ut8 *buf_end = obuf + len;
+	while (buf_end - buf >= 16) {
+		const ut8 *set = buf;
+		bool is_64bit = false;
+		ut64 length = READ32 (buf);
+		if (length == (ut32)DWARF_INIT_LEN_64) {
+			length = READ64 (buf);
+			is_64bit = true;
+		}
+		if (!length || length > (ut64)(buf_end - buf)) {
+			break;
+		}
+		const ut8 *set_end = buf + length;
+		buf += 2; // version
+		ut64 unit = dwarf_read_offset (is_64bit, &buf, set_end);
+		ut8 address_size = READ8 (buf);
+		ut8 segment_size = READ8 (buf);
+		size_t tuple = segment_size + 2 * address_size;
+		if ((address_size != 4 && address_size != 8) || buf > set_end) {
+			buf = set_end;
+			continue;
+		}
+		// tuples are aligned to their size from the start of the set
+		size_t pad = (tuple - ((buf - set) % tuple)) % tuple;
+		buf += pad;
+		while (set_end - buf >= (st64)tuple) {
+			buf += segment_size;
+			ut64 addr = r_read_ble (buf, big_end, address_size * 8);
+			ut64 size = r_read_ble (buf + address_size, big_end, address_size * 8);
+			buf += 2 * address_size;
+			if (!addr && !size) {
+				break;
+			}
+			index_add_range (idx, addr, addr + size, unit);
+		}
+		buf = set_end;
+	}
+}
+
+static int range_cmp(const void *a, const void *b) {
+	const RBinDwarfAddrRange *first = a;
+	const RBinDwarfAddrRange *second = b;
+	return (first->from > second->from) - (first->from < second->from);
+}
+
+/**
+ * @brief Parses the .debug_names or .gdb_index accelerator tables
+ *
+ * The index maps names and addresses to the compilation units defining them,
+ * so only those units have to be parsed with r_bin_dwarf_parse_units.
+ * Address ranges come from .debug_aranges when the index has none.
+ *
+ * @param bin
+ * @return RBinDwarfIndex* NULL if the binary has no usable index or ranges
+ */
+R_API RBinDwarfIndex *r_bin_dwarf_parse_index(RBin *bin) {
+	r_return_val_if_fail (bin, NULL);
+	RBinDwarfIndex *idx = R_NEW0 (RBinDwarfIndex);
+	if (!idx) {
+		return NULL;
+	}
+	idx->names = ht_pp_new (NULL, index_name_free, NULL);
+	idx->loaded = ht_up_new0 ();
+	idx->applied = ht_up_new0 ();
+	r_vector_init (&idx->ranges, sizeof (RBinDwarfAddrRange), NULL, NULL);
+	if (!idx->names || !idx->loaded || !idx->applied) {
+		r_bin_dwarf_index_free (idx);
+		return NULL;
+	}
+	/* set the endianity global [HOTFIX] */
+	big_end = r_bin_is_big_endian (bin);
+	bool found = false;
+	size_t len = 0, str_len = 0;
+	ut8 *buf = get_section_bytes (bin, "debug_names", &len);
+	if (buf) {
+		ut8 *str = get_section_bytes (bin, "debug_str", &str_len);
+		if (str) {
+			found = parse_debug_names (idx, buf, len, str, str_len);
+			free (str);
+		}
+		free (buf);
+	}
+	if (!found) {
+		buf = get_section_bytes (bin, "gdb_index", &len);
+		if (buf) {
+			found = parse_gdb_index (idx, buf, len);
+			free (buf);
+		}
+	}
+	if (!found) {
+		r_bin_dwarf_index_free (idx);
+		return NULL;
+	}
+	if (r_vector_empty (&idx->ranges)) {
+		buf = get_section_bytes (bin, "debug_aranges", &len);
+		if (buf) {
+			parse_aranges_index (idx, buf, len);
+			free (buf);
+		}
+	}
+	// without addresses the units of a function cannot be found
+	if (r_vector_empty (&idx->ranges)) {
+		r_bin_dwarf_index_free (idx);
+		return NULL;
+	}
+	qsort (idx->ranges.a, r_vector_len (&idx->ranges), sizeof (RBinDwarfAddrRange), range_cmp);
+	return idx;
+}
+
+R_API void r_bin_dwarf_index_free(RBinDwarfIndex *idx) {
+	if (idx) {
+		ht_pp_free (idx->names);
+		ht_up_free (idx->loaded);
+		ht_up_free (idx->applied);
+		r_vector_fini (&idx->ranges);
+		free (idx);
+	}
+}
+
+R_API const RVector *r_bin_dwarf_index_find(RBinDwarfIndex *idx, const char *name) {
+	r_return_val_if_fail (idx && name, NULL);
+	return ht_pp_find (idx->names, name, NULL);
+}
+
+/**
+ * @brief Finds the compilation unit covering an address
+ *
+ * @return ut64 offset of the unit in .debug_info, UT64_MAX if none
+ */
+R_API ut64 r_bin_dwarf_index_unit_at(RBinDwarfIndex *idx, ut64 addr) {
+	r_return_val_if_fail (idx, UT64_MAX);
+	size_t lo = 0, hi = r_vector_len (&idx->ranges);
+	// last range starting at or before addr
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		RBinDwarfAddrRange *range = r_vector_index_ptr (&idx->ranges, mid);
+		if (range->from <= addr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	// ranges of different units may nest, look back a bit
+	size_t i;
+	for (i = lo; i > 0 && lo - i < 8; i--) {
+		RBinDwarfAddrRange *range = r_vector_index_ptr (&idx->ranges, i - 1);
+		if (addr < range->to) {
+			return range->unit;
+		}
+	}
+	return UT64_MAX;
+}
@@ -38,4 +38,6 @@ R_IPI void r_bin_class_add_field(RBinFile *binfile, const char *classname, const
 
 R_IPI RBinFile *r_bin_file_xtr_load_buffer(RBin *bin, RBinXtrPlugin *xtr, const char *filename, RBuffer *buf, ut64 baseaddr, ut64 loadaddr, int idx, int fd, int rawstr);
 R_IPI RBinFile *r_bin_file_new_from_buffer(RBin *bin, const char *file, RBuffer *buf, int rawstr, ut64 baseaddr, ut64 loadaddr, int fd, const char *pluginname);
+
+R_IPI void r_bin_demangle_cxx_method(RBinFile *bf, const char *demangled, ut64 vaddr);
 #endif
@@ -4,6 +4,43 @@
 #include "../i/private.h"
 #include "./cxx/demangle.h"
 
+// registers "klass::method(args)" as a method of klass in the file
+R_IPI void r_bin_demangle_cxx_method(RBinFile *bf, const char *demangled, ut64 vaddr) {
+	const char *sign = strchr (demangled, '(');
+	if (!sign) {
+		return;
+	}
+	const char *str = demangled;
+	const char *nerd = NULL;
+	for (;;) {
+		const char *ptr = strstr (str, "::");
+		if (!ptr || ptr > sign) {
+			break;
+		}
+		nerd = ptr;
+		str = ptr + 1;
+	}
+	if (!nerd) {
+		return;
+	}
+	char *klass = r_str_ndup (demangled, nerd - demangled);
+	if (!klass) {
+		return;
+	}
+	RBinSymbol *sym = r_bin_file_add_method (bf, klass, nerd + 2, 0);
+	if (sym) {
+		if (sym->vaddr != 0 && sym->vaddr != vaddr) {
+			if (bf->rbin && bf->rbin->verbose) {
+				eprintf ("Dupped method found: %s\n", sym->name);
+			}
+		}
+		if (sym->vaddr == 0) {
+			sym->vaddr = vaddr;
+		}
+	}
+	free (klass);
+}
+
 R_API char *r_bin_demangle_cxx(RBinFile *bf, const char *str, ut64 vaddr) {
 	// DMGL_TYPES | DMGL_PARAMS | DMGL_ANSI | DMGL_VERBOSE
 	// | DMGL_RET_POSTFIX | DMGL_TYPES;
@@ -50,38 +87,8 @@ R_API char *r_bin_demangle_cxx(RBinFile *bf, const char *str, ut64 vaddr) {
 	char *out = NULL;
 #endif
 	free (tmpstr);
-	if (out) {
-		char *sign = (char *)strchr (out, '(');
-		if (sign) {
-			char *str = out;
-			char *ptr = NULL;
-			char *nerd = NULL;
-			for (;;) {
-				ptr = strstr (str, "::");
-				if (!ptr || ptr > sign) {
-					break;
-				}
-				nerd = ptr;
-				str = ptr + 1;
-			}
-			if (nerd && *nerd) {
-				*nerd = 0;
-				if (bf) {
-					RBinSymbol *sym = r_bin_file_add_method (bf, out, nerd + 2, 0);
-					if (sym) {
-						if (sym->vaddr != 0 && sym->vaddr != vaddr) {
-							if (bf && bf->rbin && bf->rbin->verbose) {
-								eprintf ("Dupped method found: %s\n", sym->name);
-							}
-						}
-						if (sym->vaddr == 0) {
-							sym->vaddr = vaddr;
-						}
-					}
-				}
-				*nerd = ':';
-			}
-		}
+	if (out && bf) {
+		r_bin_demangle_cxx_method (bf, out, vaddr);
 	}
 	return out;
 }
@@ -5,6 +5,14 @@
 
 // TODO: use proper dwarf api here.. or deprecate
 static bool get_line(RBinFile *bf, ut64 addr, char *file, int len, int *line) {
+	if (bf->addrlines) {
+		const RBinAddrLine *row = r_bin_addrline_get (bf->addrlines, addr);
+		if (row) {
+			r_str_ncpy (file, r_bin_addrline_file (bf->addrlines, row), len);
+			*line = row->line;
+			return true;
+		}
+	}
 	if (bf->sdb_addrinfo) {
 		char offset[64];
 		char *offset_ptr = sdb_itoa (addr, offset, 16);
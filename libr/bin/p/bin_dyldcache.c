@@ -11,14 +11,15 @@
 #define R_BIN_MACH064 1
 #include "../format/mach0/mach0.h"
 #include "objc/mach0_classes.h"
+#include "../i/private.h"
 
 #define R_IS_PTR_AUTHENTICATED(x) B_IS_SET(x, 63)
 #define MAX_N_HDR 16
+#define PAGE_CACHE_SIZE (64 * 1024 * 1024)
 
 typedef struct {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 } RDyldRebaseInfo;
@@ -37,7 +38,6 @@ typedef struct {
 typedef struct {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *page_starts;
@@ -50,7 +50,6 @@ typedef struct {
 typedef struct {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *page_starts;
@@ -66,7 +65,6 @@ typedef struct {
 typedef struct {
 	ut8 version;
 	ut64 slide;
-	ut8 *one_page_buf;
 	ut32 page_size;
 	ut64 start_of_data;
 	ut16 *toc;
@@ -75,6 +73,12 @@ typedef struct {
 	ut32 entries_size;
 } RDyldRebaseInfo1;
 
+typedef struct {
+	ut64 off;
+	int size;
+	ut8 data[];
+} RDyldPage;
+
 typedef struct {
 	ut64 local_symbols_offset;
 	ut64 nlists_offset;
@@ -95,8 +99,12 @@ typedef struct _r_dyldcache {
 
 	RList *bins;
 	RBuffer *buf;
-	int (*original_io_read)(RIO *io, RIODesc *fd, ut8 *buf, int count);
+	RIODesc *desc;
 	RDyldRebaseInfos *rebase_infos;
+	RThreadLock *pages_lock; // held while the pages are looked up, changed or copied
+	HtUP *pages; // page offset => RListIter in pages_lru
+	RList *pages_lru; // RDyldPage, least recently used first
+	ut64 pages_size;
 	cache_accel_t *accel;
 	RDyldLocSym *locsym;
 	objc_cache_opt_info *oi;
@@ -113,7 +121,21 @@ typedef struct _r_bin_image {
 	ut32 nlist_count;
 } RDyldBinImage;
 
-static R_TH_LOCAL RList *pending_bin_files = NULL;
+// the io plugins hooked to read the rebased pages. the hooks stay in place
+// for every file opened with the plugin, even after the caches are freed
+typedef struct {
+	RIOPlugin *plugin;
+	int (*read)(RIO *io, RIODesc *fd, ut8 *buf, int count);
+	int (*write)(RIO *io, RIODesc *fd, const ut8 *buf, int count);
+} RDyldIoHook;
+
+#define MAX_IO_HOOKS 8
+
+// shared by all the threads reading through the io hooks, see cache_by_desc
+static HtUP *caches_by_desc = NULL;
+static RDyldIoHook io_hooks[MAX_IO_HOOKS];
+static int n_io_hooks = 0;
+static RThreadLock caches_lock = R_THREAD_LOCK_INIT;
 
 static ut64 va2pa(uint64_t addr, ut32 n_maps, cache_map_t *maps, RBuffer *cache_buf, ut64 slide, ut32 *offset, ut32 *left) {
 	ut64 res = UT64_MAX;
@@ -180,7 +202,6 @@ static void rebase_info_free(RDyldRebaseInfo *rebase_info) {
 		return;
 	}
 
-	R_FREE (rebase_info->one_page_buf);
 
 	ut8 version = rebase_info->version;
 
@@ -361,7 +382,7 @@ static ut64 rebase_infos_get_slide(RDyldCache *cache) {
 	return 0;
 }
 
-static void symbols_from_locsym(RDyldCache *cache, RDyldBinImage *bin, RList *symbols, SetU *hash) {
+static void symbols_from_locsym(RDyldCache *cache, RBuffer *cache_buf, RDyldBinImage *bin, RList *symbols, SetU *hash, ut64 slide) {
 	RDyldLocSym *locsym = cache->locsym;
 	if (!locsym) {
 		return;
@@ -380,7 +401,7 @@ static void symbols_from_locsym(RDyldCache *cache, RDyldBinImage *bin, RList *sy
 	}
 	ut64 nlists_offset = locsym->local_symbols_offset + locsym->nlists_offset +
 		bin->nlist_start_index * sizeof (struct MACH0_(nlist));
-	if (r_buf_fread_at (cache->buf, nlists_offset, (ut8*) nlists, "iccsl", bin->nlist_count) != nlists_size) {
+	if (r_buf_fread_at (cache_buf, nlists_offset, (ut8*) nlists, "iccsl", bin->nlist_count) != nlists_size) {
 		free (nlists);
 		return;
 	}
@@ -400,16 +421,14 @@ static void symbols_from_locsym(RDyldCache *cache, RDyldBinImage *bin, RList *sy
 			break;
 		}
 		sym->type = "LOCAL";
-		sym->vaddr = nlist->n_value;
-		ut64 slide = rebase_infos_get_slide (cache);
+		sym->vaddr = nlist->n_value + slide;
 		sym->paddr = va2pa (nlist->n_value, cache->n_maps, cache->maps, cache->buf, slide, NULL, NULL);
 
-		char *symstr =r_buf_get_string (cache->buf, locsym->local_symbols_offset + locsym->strings_offset + nlist->n_strx);
+		char *symstr = r_buf_get_string (cache_buf, locsym->local_symbols_offset + locsym->strings_offset + nlist->n_strx);
 		if (symstr) {
 			sym->name = symstr;
 		} else {
-			static ut32 k = 0;
-			sym->name = r_str_newf ("unk_local%d", k++);
+			sym->name = r_str_newf ("unk_local%d", bin->nlist_start_index + j);
 		}
 
 		r_list_append (symbols, sym);
@@ -423,6 +442,18 @@ static void r_dyldcache_free(RDyldCache *cache) {
 		return;
 	}
 
+	r_th_lock_enter (&caches_lock);
+	if (caches_by_desc && ht_up_find (caches_by_desc, (ut64)(size_t)cache->desc, NULL) == cache) {
+		ht_up_delete (caches_by_desc, (ut64)(size_t)cache->desc);
+		if (!caches_by_desc->count) {
+			ht_up_free (caches_by_desc);
+			caches_by_desc = NULL;
+		}
+	}
+	r_th_lock_leave (&caches_lock);
+	ht_up_free (cache->pages);
+	r_list_free (cache->pages_lru);
+	r_th_lock_free (cache->pages_lock);
 	r_list_free (cache->bins);
 	cache->bins = NULL;
 	r_buf_free (cache->buf);
@@ -464,7 +495,8 @@ static ut64 bin_obj_va2pa(ut64 p, ut32 *offset, ut32 *left, RBinFile *bf) {
 	return res;
 }
 
-static struct MACH0_(obj_t) *bin_to_mach0(RBinFile *bf, RDyldBinImage *bin) {
+// cache_buf is cache->buf, or a view of the same bytes with its own cursor
+static struct MACH0_(obj_t) *bin_to_mach0(RBinFile *bf, RBuffer *cache_buf, RDyldBinImage *bin) {
 	if (!bin || !bf) {
 		return NULL;
 	}
@@ -474,7 +506,7 @@ static struct MACH0_(obj_t) *bin_to_mach0(RBinFile *bf, RDyldBinImage *bin) {
 		return NULL;
 	}
 
-	RBuffer *buf = r_buf_new_slice (cache->buf, bin->hdr_offset, r_buf_size (cache->buf) - bin->hdr_offset);
+	RBuffer *buf = r_buf_new_slice (cache_buf, bin->hdr_offset, r_buf_size (cache_buf) - bin->hdr_offset);
 	if (!buf) {
 		return NULL;
 	}
@@ -622,7 +654,6 @@ beach:
 static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 slideInfoOffset, ut64 slideInfoSize, ut64 start_of_data, ut64 slide) {
 	ut8 *tmp_buf_1 = NULL;
 	ut8 *tmp_buf_2 = NULL;
-	ut8 *one_page_buf = NULL;
 	RBuffer *cache_buf = cache->buf;
 
 	ut64 offset = slideInfoOffset;
@@ -655,13 +686,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 			}
 		}
 
-		if (slide_info.page_size > 0) {
-			one_page_buf = malloc (slide_info.page_size);
-			if (!one_page_buf) {
-				goto beach;
-			}
-		}
-
 		RDyldRebaseInfo3 *rebase_info = R_NEW0 (RDyldRebaseInfo3);
 		if (!rebase_info) {
 			goto beach;
@@ -675,7 +699,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 		rebase_info->page_starts_count = slide_info.page_starts_count;
 		rebase_info->auth_value_add = slide_info.auth_value_add;
 		rebase_info->page_size = slide_info.page_size;
-		rebase_info->one_page_buf = one_page_buf;
 		if (slide == UT64_MAX) {
 			rebase_info->slide = estimate_slide (bf, cache, 0x7ffffffffffffULL, 0);
 			if (rebase_info->slide) {
@@ -729,13 +752,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 			}
 		}
 
-		if (slide_info.page_size > 0) {
-			one_page_buf = malloc (slide_info.page_size);
-			if (!one_page_buf) {
-				goto beach;
-			}
-		}
-
 		RDyldRebaseInfo2 *rebase_info = R_NEW0 (RDyldRebaseInfo2);
 		if (!rebase_info) {
 			goto beach;
@@ -752,7 +768,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 		rebase_info->value_mask = ~rebase_info->delta_mask;
 		rebase_info->delta_shift = dumb_ctzll (rebase_info->delta_mask) - 2;
 		rebase_info->page_size = slide_info.page_size;
-		rebase_info->one_page_buf = one_page_buf;
 		if (slide == UT64_MAX) {
 			rebase_info->slide = estimate_slide (bf, cache, rebase_info->value_mask, rebase_info->value_add);
 			if (rebase_info->slide) {
@@ -806,11 +821,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 			}
 		}
 
-		one_page_buf = malloc (4096);
-		if (!one_page_buf) {
-			goto beach;
-		}
-
 		RDyldRebaseInfo1 *rebase_info = R_NEW0 (RDyldRebaseInfo1);
 		if (!rebase_info) {
 			goto beach;
@@ -818,7 +828,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 
 		rebase_info->version = 1;
 		rebase_info->start_of_data = start_of_data;
-		rebase_info->one_page_buf = one_page_buf;
 		rebase_info->page_size = 4096;
 		rebase_info->toc = (ut16*) tmp_buf_1;
 		rebase_info->toc_count = slide_info.toc_count;
@@ -842,7 +851,6 @@ static RDyldRebaseInfo *get_rebase_info(RBinFile *bf, RDyldCache *cache, ut64 sl
 beach:
 	R_FREE (tmp_buf_1);
 	R_FREE (tmp_buf_2);
-	R_FREE (one_page_buf);
 	return NULL;
 }
 
@@ -1337,7 +1345,7 @@ static void rebase_bytes_v1(RDyldRebaseInfo1 *rebase_info, ut8 *buf, ut64 offset
 		ut8 *entry = &rebase_info->entries[rebase_info->toc[page_index] * rebase_info->entries_size];
 		ut8 b = entry[entry_index];
 
-		if (b & (1 << offset_in_entry)) {
+		if (b & (1 << offset_in_entry) && in_buf + 8 <= count) {
 			ut64 value = r_read_le64 (buf + in_buf);
 			value += rebase_info->slide;
 			r_write_le64 (buf + in_buf, value);
@@ -1373,7 +1381,7 @@ static void rebase_bytes_v2(RDyldRebaseInfo2 *rebase_info, ut8 *buf, ut64 offset
 				ut32 delta = 1;
 				while (delta) {
 					ut64 position = in_buf + first_rebase_off - page_offset;
-					if (position + 8 >= count) {
+					if (position + 8 > count) {
 						break;
 					}
 					ut64 raw_value = r_read_le64 (buf + position);
@@ -1417,7 +1425,7 @@ static void rebase_bytes_v3(RDyldRebaseInfo3 *rebase_info, ut8 *buf, ut64 offset
 		if (first_rebase_off >= page_offset && first_rebase_off < page_offset + count) {
 			do {
 				ut64 position = in_buf + first_rebase_off - page_offset;
-				if (position + 8 >= count) {
+				if (position + 8 > count) {
 					break;
 				}
 				ut64 raw_value = r_read_le64 (buf + position);
@@ -1481,111 +1489,146 @@ static void rebase_bytes(RDyldRebaseInfo *rebase_info, ut8 *buf, ut64 offset, in
 	}
 }
 
-static int dyldcache_io_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
-	r_return_val_if_fail (io, -1);
-	RCore *core = (RCore*) io->corebind.core;
+// returns the rebased page at off, reading it if it is not cached yet.
+// the pages_lock must be held until the page is not used anymore
+static RDyldPage *page_get(RDyldCache *cache, RDyldRebaseInfo *rebase_info, RDyldIoHook *hook, RIO *io, RIODesc *fd, ut64 off) {
+	RListIter *it = ht_up_find (cache->pages, off, NULL);
+	if (it) {
+		r_list_iter_to_top (cache->pages_lru, it);
+		return it->data;
+	}
+	RDyldPage *page = malloc (sizeof (RDyldPage) + rebase_info->page_size);
+	if (!page) {
+		return NULL;
+	}
+	ut64 original_off = io->off;
+	io->off = off;
+	page->off = off;
+	page->size = hook->read (io, fd, page->data, rebase_info->page_size);
+	io->off = original_off;
+	if (page->size <= 0) {
+		free (page);
+		return NULL;
+	}
+	rebase_bytes (rebase_info, page->data, off, page->size, 0);
+	while (cache->pages_size + rebase_info->page_size > PAGE_CACHE_SIZE && !r_list_empty (cache->pages_lru)) {
+		RDyldPage *old = r_list_pop_head (cache->pages_lru);
+		ht_up_delete (cache->pages, old->off);
+		cache->pages_size -= old->size;
+		free (old);
+	}
+	it = r_list_append (cache->pages_lru, page);
+	if (!it) {
+		free (page);
+		return NULL;
+	}
+	ht_up_insert (cache->pages, off, it);
+	cache->pages_size += page->size;
+	return page;
+}
 
-	if (!core || !core->bin || !core->bin->binfiles) {
-		return -1;
+// drops the cached pages overlapping the given range
+static void pages_drop(RDyldCache *cache, ut64 off, int count) {
+	r_th_lock_enter (cache->pages_lock);
+	RListIter *it, *tmp;
+	RDyldPage *page;
+	r_list_foreach_safe (cache->pages_lru, it, tmp, page) {
+		if (page->off < off + count && off < page->off + page->size) {
+			ht_up_delete (cache->pages, page->off);
+			cache->pages_size -= page->size;
+			r_list_delete (cache->pages_lru, it);
+		}
 	}
+	r_th_lock_leave (cache->pages_lock);
+}
 
-	RDyldCache *cache = NULL;
-	RListIter *iter;
-	RBinFile *bf;
-	r_list_foreach (core->bin->binfiles, iter, bf) {
-		if (bf->fd == fd->fd ) {
-			if (!strncmp ((char*) bf->o->bin_obj, "dyldcac", 7)) {
-				cache = bf->o->bin_obj;
-			} else {
-				cache = ((struct MACH0_(obj_t)*) bf->o->bin_obj)->user;
-			}
-			if (pending_bin_files) {
-				RListIter *to_remove = r_list_contains (pending_bin_files, bf);
-				if (to_remove) {
-					r_list_delete (pending_bin_files, to_remove);
-					if (r_list_empty (pending_bin_files)) {
-						r_list_free (pending_bin_files);
-						pending_bin_files = NULL;
-					}
-				}
-			}
+// the cache loaded from the file of the given descriptor, if any, and the
+// functions of its plugin that were replaced by the hooks
+static RDyldCache *cache_by_desc(RIODesc *fd, RDyldIoHook *hook) {
+	memset (hook, 0, sizeof (RDyldIoHook));
+	r_th_lock_enter (&caches_lock);
+	RDyldCache *cache = caches_by_desc? ht_up_find (caches_by_desc, (ut64)(size_t)fd, NULL): NULL;
+	int i;
+	for (i = 0; i < n_io_hooks; i++) {
+		if (io_hooks[i].plugin == fd->plugin) {
+			*hook = io_hooks[i];
 			break;
 		}
 	}
-	if (!cache) {
-		r_list_foreach (pending_bin_files, iter, bf) {
-			if (bf->fd == fd->fd && bf->o) {
-				if (!strncmp ((char*) bf->o->bin_obj, "dyldcac", 7)) {
-					cache = bf->o->bin_obj;
-				} else {
-					cache = ((struct MACH0_(obj_t)*) bf->o->bin_obj)->user;
-				}
-				break;
-			}
-		}
+	r_th_lock_leave (&caches_lock);
+	return cache;
+}
+
+static int dyldcache_io_write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
+	r_return_val_if_fail (io && fd, -1);
+	RDyldIoHook hook;
+	RDyldCache *cache = cache_by_desc (fd, &hook);
+	if (!hook.write) {
+		return -1;
 	}
-	if (!cache || !cache->original_io_read) {
-		if (fd->plugin->read == &dyldcache_io_read) {
-			return -1;
-		}
-		return fd->plugin->read (io, fd, buf, count);
+	const ut64 off = io->off;
+	int result = hook.write (io, fd, buf, count);
+	if (cache && result > 0) {
+		pages_drop (cache, off, result);
 	}
+	return result;
+}
 
-	RDyldRebaseInfo *rebase_info = rebase_info_by_range (cache->rebase_infos, io->off, count);
+static int dyldcache_io_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
+	r_return_val_if_fail (io && fd, -1);
+	RDyldIoHook hook;
+	RDyldCache *cache = cache_by_desc (fd, &hook);
+	if (!hook.read) {
+		return -1;
+	}
+	RDyldRebaseInfo *rebase_info = cache? rebase_info_by_range (cache->rebase_infos, io->off, count): NULL;
+	if (!rebase_info || count <= 0 || !rebase_info->page_size) {
+		return hook.read (io, fd, buf, count);
+	}
 
+	// pages are rebased as a whole and kept, so hot pages are only copied
 	int result = 0;
-
-	if (rebase_info && count > 0) {
-		ut64 offset_in_data = io->off - rebase_info->start_of_data;
-		ut64 page_offset = offset_in_data % rebase_info->page_size;
-
-		ut64 internal_offset = io->off & ~(rebase_info->page_size - 1);
-		ut64 internal_end = io->off + count;
-		int rounded_count = internal_end - internal_offset;
-
-		ut8 *internal_buf = rebase_info->one_page_buf;
-		if (rounded_count > rebase_info->page_size) {
-			internal_buf = malloc (rounded_count);
-			if (!internal_buf) {
-				eprintf ("Cannot allocate memory for 'internal_buf'\n");
-				return -1;
-			}
-		}
-
-		ut64 original_off = io->off;
-		io->off = internal_offset;
-
-		int internal_result = cache->original_io_read (io, fd, internal_buf, rounded_count);
-
-		io->off = original_off;
-
-		if (internal_result >= page_offset + count) {
-			rebase_bytes (rebase_info, internal_buf, internal_offset, internal_result, page_offset);
-			result = R_MIN (count, internal_result);
-			memcpy (buf, internal_buf + page_offset, result);
-		} else {
-			eprintf ("ERROR rebasing\n");
-			result = cache->original_io_read (io, fd, buf, count);
+	r_th_lock_enter (cache->pages_lock);
+	while (result < count) {
+		ut64 off = io->off + result;
+		ut64 page_off = off & ~((ut64)rebase_info->page_size - 1);
+		RDyldPage *page = page_get (cache, rebase_info, &hook, io, fd, page_off);
+		if (!page || off - page_off >= page->size) {
+			break;
 		}
-
-		if (internal_buf != rebase_info->one_page_buf) {
-			R_FREE (internal_buf);
+		int n = R_MIN (count - result, page->size - (int)(off - page_off));
+		memcpy (buf + result, page->data + off - page_off, n);
+		result += n;
+		if (page->size < rebase_info->page_size) {
+			break;
 		}
-	} else {
-		result = cache->original_io_read (io, fd, buf, count);
 	}
-
-	return result;
+	r_th_lock_leave (cache->pages_lock);
+	return result? result: -1;
 }
 
-static void swizzle_io_read(RDyldCache *cache, RIO *io) {
-	if (!io || !io->desc || !io->desc->plugin) {
-		return;
+// must be called with the caches_lock held
+static bool swizzle_io_read(RIODesc *desc) {
+	RIOPlugin *plugin = desc->plugin;
+	int i;
+	for (i = 0; i < n_io_hooks; i++) {
+		if (io_hooks[i].plugin == plugin) {
+			return true;
+		}
 	}
-
-	RIOPlugin *plugin = io->desc->plugin;
-	cache->original_io_read = plugin->read;
+	if (n_io_hooks == MAX_IO_HOOKS || !plugin->read) {
+		return false;
+	}
+	RDyldIoHook *hook = &io_hooks[n_io_hooks++];
+	hook->plugin = plugin;
+	hook->read = plugin->read;
 	plugin->read = &dyldcache_io_read;
+	// writes drop the rebased pages they change
+	if (plugin->write) {
+		hook->write = plugin->write;
+		plugin->write = &dyldcache_io_write;
+	}
+	return true;
 }
 
 static cache_hdr_t *read_cache_header(RBuffer *cache_buf, ut64 offset) {
@@ -1909,15 +1952,26 @@ static bool load_buffer(RBinFile *bf, void **bin_obj, RBuffer *buf, ut64 loadadd
 	cache->rebase_infos = get_rebase_infos (bf, cache);
 	if (cache->rebase_infos) {
 		if (!rebase_infos_get_slide (cache)) {
-			if (!pending_bin_files) {
-				pending_bin_files = r_list_new ();
-				if (!pending_bin_files) {
-					r_dyldcache_free (cache);
-					return false;
-				}
+			cache->pages = ht_up_new0 ();
+			cache->pages_lru = r_list_newf (free);
+			cache->pages_lock = r_th_lock_new (false);
+			RIOBind *iob = &bf->rbin->iob;
+			RIODesc *desc = iob->io? iob->desc_get (iob->io, bf->fd): NULL;
+			r_th_lock_enter (&caches_lock);
+			if (!caches_by_desc) {
+				caches_by_desc = ht_up_new0 ();
+			}
+			bool ok = cache->pages && cache->pages_lru && cache->pages_lock && caches_by_desc;
+			// without a descriptor to hook the bytes are read as they are in the file
+			if (ok && desc && desc->plugin && swizzle_io_read (desc)) {
+				cache->desc = desc;
+				ht_up_update (caches_by_desc, (ut64)(size_t)desc, cache);
+			}
+			r_th_lock_leave (&caches_lock);
+			if (!ok) {
+				r_dyldcache_free (cache);
+				return false;
 			}
-			r_list_push (pending_bin_files, bf);
-			swizzle_io_read (cache, bf->rbin->iob.io);
 		}
 	}
 	*bin_obj = cache;
@@ -1983,8 +2037,8 @@ static ut64 baddr(RBinFile *bf) {
 	return 0x180000000;
 }
 
-void symbols_from_bin(RDyldCache *cache, RList *ret, RBinFile *bf, RDyldBinImage *bin, SetU *hash) {
-	struct MACH0_(obj_t) *mach0 = bin_to_mach0 (bf, bin);
+static void symbols_from_bin(RDyldCache *cache, RBuffer *cache_buf, RList *ret, RBinFile *bf, RDyldBinImage *bin, SetU *hash, ut64 slide) {
+	struct MACH0_(obj_t) *mach0 = bin_to_mach0 (bf, cache_buf, bin);
 	if (!mach0) {
 		return;
 	}
@@ -1992,6 +2046,7 @@ void symbols_from_bin(RDyldCache *cache, RList *ret, RBinFile *bf, RDyldBinImage
 	// const RList*symbols = MACH0_(get_symbols_list) (mach0);
 	const struct symbol_t *symbols = MACH0_(get_symbols) (mach0);
 	if (!symbols) {
+		MACH0_(mach0_free) (mach0);
 		return;
 	}
 	int i;
@@ -2007,7 +2062,7 @@ void symbols_from_bin(RDyldCache *cache, RList *ret, RBinFile *bf, RDyldBinImage
 			break;
 		}
 		sym->name = strdup (symbols[i].name);
-		sym->vaddr = symbols[i].addr;
+		sym->vaddr = symbols[i].addr + slide;
 		sym->forwarder = "NONE";
 		sym->bind = (symbols[i].type == R_BIN_MACH0_SYMBOL_TYPE_LOCAL)? R_BIN_BIND_LOCAL_STR: R_BIN_BIND_GLOBAL_STR;
 		sym->type = R_BIN_TYPE_FUNC_STR;
@@ -2015,7 +2070,7 @@ void symbols_from_bin(RDyldCache *cache, RList *ret, RBinFile *bf, RDyldBinImage
 		sym->size = symbols[i].size;
 		sym->ordinal = i;
 
-		set_u_add (hash, sym->vaddr);
+		set_u_add (hash, symbols[i].addr);
 		r_list_append (ret, sym);
 	}
 	MACH0_(mach0_free) (mach0);
@@ -2046,7 +2101,7 @@ static void sections_from_bin(RList *ret, RBinFile *bf, RDyldBinImage *bin) {
 		return;
 	}
 
-	struct MACH0_(obj_t) *mach0 = bin_to_mach0 (bf, bin);
+	struct MACH0_(obj_t) *mach0 = bin_to_mach0 (bf, cache->buf, bin);
 	if (!mach0) {
 		return;
 	}
@@ -2139,6 +2194,31 @@ static RList *sections(RBinFile *bf) {
 	return ret;
 }
 
+typedef struct {
+	RDyldCache *cache;
+	RBinFile *bf;
+	RDyldBinImage **bins;
+	RList **results;
+	RBuffer **bufs; // one per thread
+	ut64 slide;
+} SymbolsJobs;
+
+static bool symbols_job(void *user, size_t idx, int tid) {
+	SymbolsJobs *w = user;
+	RList *list = r_list_newf (free);
+	SetU *hash = set_u_new ();
+	if (!list || !hash) {
+		r_list_free (list);
+		set_u_free (hash);
+		return false;
+	}
+	symbols_from_bin (w->cache, w->bufs[tid], list, w->bf, w->bins[idx], hash, w->slide);
+	symbols_from_locsym (w->cache, w->bufs[tid], w->bins[idx], list, hash, w->slide);
+	set_u_free (hash);
+	w->results[idx] = list;
+	return true;
+}
+
 static RList *symbols(RBinFile *bf) {
 	RDyldCache *cache = (RDyldCache*) bf->o->bin_obj;
 	if (!cache) {
@@ -2150,50 +2230,72 @@ static RList *symbols(RBinFile *bf) {
 		return NULL;
 	}
 
+	size_t i, count = r_list_length (cache->bins);
+	SymbolsJobs w = {
+		.cache = cache,
+		.bf = bf,
+		.bins = R_NEWS0 (RDyldBinImage *, count),
+		.results = R_NEWS0 (RList *, count),
+		.slide = rebase_infos_get_slide (cache),
+	};
+	// threads read the images through views of the mapped file, cache->buf
+	// has a single cursor and may go through io, which is not thread safe
+	int nthreads = 1;
+	RMmap *map = NULL;
+	if (count > 1 && bf->file && r_file_exists (bf->file)) {
+		map = r_file_mmap (bf->file, false, 0);
+		if (map && map->len == r_buf_size (cache->buf)) {
+			nthreads = r_bin_jobs_threads (count);
+		}
+	}
+	w.bufs = R_NEWS0 (RBuffer *, nthreads);
+	if (!w.bins || !w.results || !w.bufs) {
+		goto beach;
+	}
 	RListIter *iter;
 	RDyldBinImage *bin;
-	ut32 i = 0;
-	RConsIsBreaked is_breaked = (bf->rbin && bf->rbin->consb.is_breaked)? bf->rbin->consb.is_breaked: NULL;
+	i = 0;
 	r_list_foreach (cache->bins, iter, bin) {
-		i++;
-		if (is_breaked && is_breaked ()) {
-			eprintf ("Parsing symbols stopped %d / %d\n", i, r_list_length (cache->bins));
-			break;
+		w.bins[i++] = bin;
+	}
+	if (nthreads > 1) {
+		for (i = 0; i < nthreads; i++) {
+			w.bufs[i] = r_buf_new_with_pointers (map->buf, map->len, false);
+			if (!w.bufs[i]) {
+				nthreads = i? i: 1;
+				break;
+			}
 		}
-		SetU *hash = set_u_new ();
-		if (!hash) {
-			r_list_free (ret);
-			return NULL;
+	}
+	if (!w.bufs[0]) {
+		w.bufs[0] = r_buf_ref (cache->buf);
+	}
+	if (!r_bin_jobs_run (bf->rbin, count, nthreads, symbols_job, &w)) {
+		eprintf ("Parsing symbols stopped\n");
+	}
+	// merged in image order whatever thread parsed them
+	for (i = 0; i < count; i++) {
+		if (w.results[i]) {
+			r_list_join (ret, w.results[i]);
+			r_list_free (w.results[i]);
 		}
-		symbols_from_bin (cache, ret, bf, bin, hash);
-		symbols_from_locsym (cache, bin, ret, hash);
-		set_u_free (hash);
 	}
-
-	ut64 slide = rebase_infos_get_slide (cache);
-	if (slide) {
-		RBinSymbol *sym;
-		r_list_foreach (ret, iter, sym) {
-			sym->vaddr += slide;
+beach:
+	if (w.bufs) {
+		for (i = 0; i < nthreads; i++) {
+			r_buf_free (w.bufs[i]);
 		}
 	}
-
+	r_file_mmap_free (map);
+	free (w.bufs);
+	free (w.results);
+	free (w.bins);
 	return ret;
 }
 
-/* static void unswizzle_io_read(RDyldCache *cache, RIO *io) {
-	if (!io || !io->desc || !io->desc->plugin || !cache->original_io_read) {
-		return;
-	}
-
-	RIOPlugin *plugin = io->desc->plugin;
-	plugin->read = cache->original_io_read;
-	cache->original_io_read = NULL;
-} */
-
 static void destroy(RBinFile *bf) {
 	RDyldCache *cache = (RDyldCache*) bf->o->bin_obj;
-	// unswizzle_io_read (cache, bf->rbin->iob.io); // XXX io may be dead here
+	// the io hooks are kept, io may be dead here
 	r_dyldcache_free (cache);
 }
 
@@ -2227,7 +2329,7 @@ static RList *classes(RBinFile *bf) {
 			eprintf ("Parsing classes stopped %d / %d\n", i, r_list_length (cache->bins));
 			break;
 		}
-		struct MACH0_(obj_t) *mach0 = bin_to_mach0 (bf, bin);
+		struct MACH0_(obj_t) *mach0 = bin_to_mach0 (bf, cache->buf, bin);
 		if (!mach0) {
 			goto beach;
 		}
@@ -6,8 +6,10 @@
 #include <r_bin.h>
 #include "mach0/dyldcache.h"
 #include "mach0/mach0.h"
+#include "../i/private.h"
 
 static RBinXtrData *extract(RBin *bin, int idx);
+static RBinXtrData *extract_lib(struct r_bin_dyldcache_obj_t *obj, int idx);
 static RList *extractall(RBin *bin);
 static RBinXtrData *oneshot(RBin *bin, const ut8 *buf, ut64 size, int idx);
 static RList *oneshotall(RBin *bin, const ut8 *buf, ut64 size);
@@ -39,6 +41,17 @@ static bool load(RBin *bin) {
 	return bin->cur->xtr_obj? true : false;
 }
 
+typedef struct {
+	struct r_bin_dyldcache_obj_t *views; // one per thread, sharing the bytes
+	RBinXtrData **results;
+} ExtractJobs;
+
+static bool extract_job(void *user, size_t idx, int tid) {
+	ExtractJobs *w = user;
+	w->results[idx] = extract_lib (&w->views[tid], (int)idx + 1);
+	return true;
+}
+
 static RList *extractall(RBin *bin) {
 	RList *result = NULL;
 	int nlib, i = 0;
@@ -54,10 +67,56 @@ static RList *extractall(RBin *bin) {
 		return NULL;
 	}
 	r_list_append (result, data);
-	for (i = 1; data && i < nlib; i++) {
-		data = extract (bin, i);
+	if (nlib < 2) {
+		return result;
+	}
+	struct r_bin_dyldcache_obj_t *obj = bin->cur->xtr_obj;
+	ut64 size = 0;
+	const ut8 *bytes = r_buf_data (obj->b, &size);
+	int nthreads = bytes? r_bin_jobs_threads (nlib): 1;
+	ExtractJobs w = {
+		.views = R_NEWS0 (struct r_bin_dyldcache_obj_t, nthreads),
+		.results = R_NEWS0 (RBinXtrData *, nlib),
+	};
+	if (!w.views || !w.results) {
+		goto beach;
+	}
+	for (i = 0; i < nthreads; i++) {
+		w.views[i] = *obj;
+		if (nthreads > 1) {
+			w.views[i].b = r_buf_new_with_pointers (bytes, size, false);
+			if (!w.views[i].b) {
+				nthreads = 1;
+				w.views[0].b = obj->b;
+				break;
+			}
+		}
+	}
+	r_bin_jobs_run (bin, nlib - 1, nthreads, extract_job, &w);
+	// stop at the first library that could not be extracted, like a serial loop would
+	for (i = 0; i < nlib - 1; i++) {
+		data = w.results[i];
+		w.results[i] = NULL;
 		r_list_append (result, data);
+		if (!data) {
+			break;
+		}
+	}
+beach:
+	if (w.results) {
+		for (i = 0; i < nlib - 1; i++) {
+			r_bin_xtrdata_free (w.results[i]);
+		}
 	}
+	if (w.views) {
+		for (i = 0; i < nthreads; i++) {
+			if (w.views[i].b != obj->b) {
+				r_buf_free (w.views[i].b);
+			}
+		}
+	}
+	free (w.views);
+	free (w.results);
 	return result;
 }
 
@@ -69,12 +128,15 @@ static inline void fill_metadata_info_from_hdr(RBinXtrMetadata *meta, struct MAC
 }
 
 static RBinXtrData *extract(RBin *bin, int idx) {
+	return extract_lib ((struct r_bin_dyldcache_obj_t*)bin->cur->xtr_obj, idx);
+}
+
+static RBinXtrData *extract_lib(struct r_bin_dyldcache_obj_t *obj, int idx) {
 	int nlib = 0;
 	RBinXtrData *res = NULL;
 	char *libname;
 	struct MACH0_(mach_header) *hdr;
-	struct r_bin_dyldcache_lib_t *lib = r_bin_dyldcache_extract (
-		(struct r_bin_dyldcache_obj_t*)bin->cur->xtr_obj, idx, &nlib);
+	struct r_bin_dyldcache_lib_t *lib = r_bin_dyldcache_extract (obj, idx, &nlib);
 
 	if (lib) {
 		RBinXtrMetadata *metadata = R_NEW0(RBinXtrMetadata);
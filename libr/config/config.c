@@ -293,20 +293,66 @@ R_API RConfigNode* r_config_node_get(RConfig *cfg, const char *name) {
 	return ht_pp_find (cfg->ht, name, NULL);
 }
 
+static const char *config_node_value(RConfig *cfg, RConfigNode *node) {
+	if (node->getter) {
+		node->getter (cfg->user, node);
+	}
+	if (r_config_node_is_bool (node)) {
+		return r_str_bool (r_str_is_true (node->value));
+	}
+	return node->value;
+}
+
+static ut64 config_node_i(RConfig *cfg, RConfigNode *node) {
+	if (node->getter) {
+		node->getter (cfg->user, node);
+	}
+	if (node->i_value) {
+		return node->i_value;
+	}
+	if (!strcmp (node->value, "false")) {
+		return 0;
+	}
+	if (!strcmp (node->value, "true")) {
+		return 1;
+	}
+	return (ut64) r_num_math (cfg->num, node->value);
+}
+
+// values that r_num_math has to resolve may change without touching the config
+static bool config_node_needs_eval(RConfigNode *node) {
+	if (node->i_value || !node->value) {
+		return false;
+	}
+	const char *v = node->value;
+	return *v && strcmp (v, "0") && strcmp (v, "false") && strcmp (v, "true");
+}
+
+// setting the value a key already has is not a change, so callers like
+// r_core_seek_arch_bits that reapply asm.bits do not flush caches
+static void config_changed(RConfig *cfg, RConfigNode *node, bool modified) {
+	if (!modified) {
+		return;
+	}
+	cfg->gen++;
+	if (node && cfg->watchers) {
+		RListIter *iter;
+		RConfigWatch *w;
+		r_list_foreach (cfg->watchers, iter, w) {
+			if (r_str_startswith (node->name, w->prefix)) {
+				w->cb (w->user, node);
+			}
+		}
+	}
+}
+
 R_API const char* r_config_get(RConfig *cfg, const char *name) {
 	r_return_val_if_fail (cfg && name, NULL);
 	RConfigNode *node = r_config_node_get (cfg, name);
 	if (node) {
-		if (node->getter) {
-			node->getter (cfg->user, node);
-		}
-		if (r_config_node_is_bool (node)) {
-			return r_str_bool (r_str_is_true (node->value));
-		}
-		return node->value;
-	} else {
-		eprintf ("r_config_get: variable '%s' not found\n", name);
+		return config_node_value (cfg, node);
 	}
+	eprintf ("r_config_get: variable '%s' not found\n", name);
 	return NULL;
 }
 
@@ -334,22 +380,77 @@ R_API bool r_config_get_b(RConfig *cfg, const char *name) {
 R_API ut64 r_config_get_i(RConfig *cfg, const char *name) {
 	r_return_val_if_fail (cfg, 0ULL);
 	RConfigNode *node = r_config_node_get (cfg, name);
-	if (node) {
-		if (node->getter) {
-			node->getter (cfg->user, node);
-		}
-		if (node->i_value) {
-			return node->i_value;
-		}
-		if (!strcmp (node->value, "false")) {
-			return 0;
-		}
-		if (!strcmp (node->value, "true")) {
-			return 1;
+	return node? config_node_i (cfg, node): 0ULL;
+}
+
+R_API void r_config_handle_init(RConfigHandle *h, RConfig *cfg, const char *name) {
+	r_return_if_fail (h && cfg && name);
+	h->cfg = cfg;
+	h->name = name;
+	r_config_handle_refresh (h);
+}
+
+/* resolves the node again and caches its int value until the next change */
+R_API void r_config_handle_refresh(RConfigHandle *h) {
+	r_return_if_fail (h && h->cfg);
+	RConfig *cfg = h->cfg;
+	h->gen = cfg->gen;
+	h->node = r_config_node_get (cfg, h->name);
+	if (h->node) {
+		h->dynamic = h->node->getter != NULL;
+		h->eval = config_node_needs_eval (h->node);
+		h->i = h->eval? 0: config_node_i (cfg, h->node);
+	} else {
+		h->i = 0;
+		h->dynamic = h->eval = false;
+	}
+}
+
+// the string is read from the node every time, setters and r_config_set
+// may reallocate it without changing the value
+R_API const char *r_config_handle_s(RConfigHandle *h) {
+	r_return_val_if_fail (h && h->cfg, NULL);
+	if (h->gen != h->cfg->gen) {
+		r_config_handle_refresh (h);
+	}
+	return h->node? config_node_value (h->cfg, h->node): NULL;
+}
+
+static void config_watch_free(RConfigWatch *w) {
+	if (w) {
+		free (w->prefix);
+		free (w);
+	}
+}
+
+/* calls cb after every successful change of the variables starting with prefix */
+R_API RConfigWatch *r_config_watch(RConfig *cfg, const char *prefix, RConfigWatchCallback cb, void *user) {
+	r_return_val_if_fail (cfg && cb, NULL);
+	if (!cfg->watchers) {
+		cfg->watchers = r_list_newf ((RListFree)config_watch_free);
+		if (!cfg->watchers) {
+			return NULL;
 		}
-		return (ut64) r_num_math (cfg->num, node->value);
 	}
-	return 0ULL;
+	RConfigWatch *w = R_NEW0 (RConfigWatch);
+	if (!w) {
+		return NULL;
+	}
+	w->prefix = strdup (r_str_get (prefix));
+	w->cb = cb;
+	w->user = user;
+	if (!w->prefix || !r_list_append (cfg->watchers, w)) {
+		config_watch_free (w);
+		return NULL;
+	}
+	return w;
+}
+
+R_API void r_config_unwatch(RConfig *cfg, RConfigWatch *w) {
+	r_return_if_fail (cfg);
+	if (w && cfg->watchers) {
+		r_list_delete_data (cfg->watchers, w);
+	}
 }
 
 R_API const char* r_config_node_type(RConfigNode *node) {
@@ -419,10 +520,13 @@ R_API RConfigNode* r_config_set(RConfig *cfg, const char *name, const char *valu
 		if (r_config_node_is_bool (node)) {
 			bool b = r_str_is_true (value);
 			node->i_value = b;
-			char *value = strdup (r_str_bool (b));
-			if (value) {
-				free (node->value);
-				node->value = value;
+			// keep the old string when the value does not change
+			if (strcmp (node->value, r_str_bool (b))) {
+				char *value = strdup (r_str_bool (b));
+				if (value) {
+					free (node->value);
+					node->value = value;
+				}
 			}
 		} else {
 			if (!value) {
@@ -433,8 +537,10 @@ R_API RConfigNode* r_config_set(RConfig *cfg, const char *name, const char *valu
 				if (node->value == value) {
 					goto beach;
 				}
-				free (node->value);
-				node->value = strdup (value);
+				if (strcmp (node->value, value)) {
+					free (node->value);
+					node->value = strdup (value);
+				}
 				if (IS_DIGIT (*value) || (value[0] == '-' && IS_DIGIT (value[1]))) {
 					if (strchr (value, '/')) {
 						node->i_value = r_num_get (cfg->num, value);
@@ -479,6 +585,10 @@ R_API RConfigNode* r_config_set(RConfig *cfg, const char *name, const char *valu
 			return NULL;
 		}
 	}
+	if (node) {
+		bool modified = oi != node->i_value || !ov || strcmp (ov, r_str_get (node->value));
+		config_changed (cfg, node, modified);
+	}
 beach:
 	free (ov);
 	return node;
@@ -507,6 +617,7 @@ R_API bool r_config_rm(RConfig *cfg, const char *name) {
 		R_DIRTY (cfg);
 		ht_pp_delete (cfg->ht, node->name);
 		r_list_delete_data (cfg->nodes, node);
+		config_changed (cfg, NULL, true);
 		return true;
 	}
 	return false;
@@ -534,6 +645,7 @@ R_API RConfigNode* r_config_set_b(RConfig *cfg, const char *name, bool b) {
 
 R_API RConfigNode* r_config_set_i(RConfig *cfg, const char *name, const ut64 i) {
 	char buf[128], *ov = NULL;
+	bool same = false;
 	r_return_val_if_fail (cfg && name, NULL);
 	RConfigNode *node = r_config_node_get (cfg, name);
 	R_DIRTY (cfg);
@@ -542,12 +654,15 @@ R_API RConfigNode* r_config_set_i(RConfig *cfg, const char *name, const ut64 i)
 			node = NULL;
 			goto beach;
 		}
-		ov = node->value;
-		r_config_node_value_format_i (buf, sizeof (buf), i, NULL);
-		node->value = strdup (buf);
-		if (!node->value) {
-			node = NULL;
-			goto beach;
+		r_config_node_value_format_i (buf, sizeof (buf), i, node);
+		same = node->value && !strcmp (node->value, buf);
+		if (!same) {
+			ov = node->value;
+			node->value = strdup (buf);
+			if (!node->value) {
+				node = NULL;
+				goto beach;
+			}
 		}
 		node->i_value = i;
 	} else {
@@ -574,11 +689,18 @@ R_API RConfigNode* r_config_set_i(RConfig *cfg, const char *name, const ut64 i)
 		int ret = node->setter (cfg->user, node);
 		if (!ret) {
 			node->i_value = oi;
-			free (node->value);
-			node->value = ov? ov: strdup ("");
-			ov = NULL;
+			if (!same) {
+				free (node->value);
+				node->value = ov? ov: strdup ("");
+				ov = NULL;
+			}
+			goto beach;
 		}
 	}
+	if (node) {
+		bool modified = !same && (!ov || strcmp (ov, r_str_get (node->value)));
+		config_changed (cfg, node, modified);
+	}
 beach:
 	free (ov);
 	return node;
@@ -702,6 +824,7 @@ R_API void r_config_free(RConfig *cfg) {
 	if (cfg) {
 		cfg->nodes->free = r_config_node_free; // damn
 		r_list_free (cfg->nodes);
+		r_list_free (cfg->watchers);
 		ht_pp_free (cfg->ht);
 		free (cfg);
 	}
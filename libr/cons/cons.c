@@ -181,6 +181,7 @@ static inline void __cons_write(const char *obuf, int olen) {
 	if (olen < 0) {
 		olen = strlen (obuf);
 	}
+	I->bytes_written += olen;
 	for (i = 0; (i + bucket) < olen; i += bucket) {
 		__cons_write_ll (obuf + i, bucket);
 	}
@@ -718,6 +719,7 @@ R_API RCons *r_cons_free(void) {
 	R_FREE (C->lastOutput);
 	C->lastLength = 0;
 	R_FREE (I->pager);
+	r_cons_frame_reset ();
 	return NULL;
 }
 
@@ -1186,6 +1188,8 @@ R_API void r_cons_visual_flush(void) {
 R_API void r_cons_print_fps(int col) {
 	int fps = 0, w = r_cons_get_size (NULL);
 	static ut64 prev = 0LL; //r_time_now_mono ();
+	static ut64 prev_bytes = 0LL;
+	char bytes[8];
 	fps = 0;
 	if (prev) {
 		ut64 now = r_time_now_mono ();
@@ -1199,21 +1203,193 @@ R_API void r_cons_print_fps(int col) {
 	} else {
 		prev = r_time_now_mono ();
 	}
+	// bytes written to the terminal since the last call, one frame
+	r_num_units (bytes, sizeof (bytes), I->bytes_written - prev_bytes);
+	prev_bytes = I->bytes_written;
 	if (col < 1) {
-		col = 12;
+		col = 20;
 	}
 #ifdef __WINDOWS__
 	if (I->vtmode) {
-		eprintf ("\x1b[0;%dH[%d FPS] \n", w - col, fps);
+		eprintf ("\x1b[0;%dH[%d FPS %sB] \n", w - col, fps, bytes);
 	} else {
 		r_cons_w32_gotoxy (2, w - col, 0);
-		eprintf (" [%d FPS] \n", fps);
+		eprintf (" [%d FPS %sB] \n", fps, bytes);
 	}
 #else
-	eprintf ("\x1b[0;%dH[%d FPS] \n", w - col, fps);
+	eprintf ("\x1b[0;%dH[%d FPS %sB] \n", w - col, fps, bytes);
 #endif
 }
 
+R_API void r_cons_frame_reset(void) {
+	int i;
+	if (I->frame) {
+		for (i = 0; i < I->frame_rows; i++) {
+			free (I->frame[i]);
+		}
+		R_FREE (I->frame);
+	}
+	I->frame_rows = 0;
+	I->frame_cols = 0;
+}
+
+#define FRAME_ATTR_SIZE 256
+
+// parse the escape sequence at s, returns its length and the final char
+static int frame_escape(const char *s, const char *end, char *final) {
+	const char *p = s + 2;
+	if (p > end || s[1] != '[') {
+		return 0;
+	}
+	while (p < end && (IS_DIGIT (*p) || *p == ';' || *p == '?')) {
+		p++;
+	}
+	if (p >= end) {
+		return 0;
+	}
+	*final = *p;
+	return p + 1 - s;
+}
+
+// follow the color state across rows, so a row can be drawn on its own
+static bool frame_attr(char *attr, int *attr_len, const char *esc, int len) {
+	if (len == 3 || !strncmp (esc, Color_RESET, len)) {
+		*attr_len = 0;
+	} else {
+		if (*attr_len + len >= FRAME_ATTR_SIZE) {
+			return false;
+		}
+		memcpy (attr + *attr_len, esc, len);
+		*attr_len += len;
+	}
+	attr[*attr_len] = 0;
+	return true;
+}
+
+static bool frame_row_eq(const char *old, const char *attr, int attr_len, const char *row, int row_len) {
+	return old && strlen (old) == attr_len + row_len
+		&& !memcmp (old, attr, attr_len)
+		&& !memcmp (old + attr_len, row, row_len);
+}
+
+// write a whole screen frame emitting only the rows that changed since
+// the previous one. the frame must start at the top left corner and can
+// only use colors and line erasing, returns false otherwise so the
+// caller can write it as is
+R_API bool r_cons_frame_write(const char *buf, int len) {
+	r_return_val_if_fail (buf, false);
+	const int rows = I->rows;
+	const int cols = I->columns;
+	const char *end = buf + ((len < 0)? strlen (buf): len);
+	const char *s = buf;
+	char attr[FRAME_ATTR_SIZE] = {0};
+	int attr_len = 0;
+	bool home = false;
+	RStrBuf *out = NULL;
+	char final = 0;
+	int n, row;
+	if (rows < 1 || cols < 1 || I->null) {
+		return false;
+	}
+	if (!I->frame || I->frame_rows != rows || I->frame_cols != cols || I->frame_end != I->bytes_written) {
+		// something else was written, the screen is unknown
+		r_cons_frame_reset ();
+		I->frame = R_NEWS0 (char *, rows);
+		if (!I->frame) {
+			return false;
+		}
+		I->frame_rows = rows;
+		I->frame_cols = cols;
+	}
+	// home, clear and reset sequences are not needed, all rows are redrawn
+	while (s < end) {
+		if (*s == '\r') {
+			s++;
+			continue;
+		}
+		if (*s != 0x1b || !(n = frame_escape (s, end, &final))) {
+			break;
+		}
+		if (final == 'H' && (n == 3 || !strncmp (s, "\x1b[0;0H", n) || !strncmp (s, "\x1b[1;1H", n))) {
+			home = true;
+		} else if (final == 'm') {
+			if (!frame_attr (attr, &attr_len, s, n)) {
+				goto fail;
+			}
+		} else if (final != 'J' || home) {
+			break;
+		}
+		s += n;
+	}
+	if (!home) {
+		goto fail;
+	}
+	out = r_strbuf_new (NULL);
+	for (row = 0; row < rows; row++) {
+		const char *e = s;
+		char row_attr[FRAME_ATTR_SIZE];
+		int row_attr_len = attr_len;
+		memcpy (row_attr, attr, attr_len + 1);
+		if (s < end) {
+			e = memchr (s, '\n', end - s);
+			if (!e) {
+				e = end;
+			}
+		}
+		const char *p = s;
+		while ((p = memchr (p, 0x1b, e - p))) {
+			n = frame_escape (p, e, &final);
+			if (final == 'm' && n > 0) {
+				if (!frame_attr (attr, &attr_len, p, n)) {
+					break;
+				}
+			} else if (final != 'K' || n < 1) {
+				break;
+			}
+			p += n;
+		}
+		if (p) {
+			goto fail;
+		}
+		if (!frame_row_eq (I->frame[row], row_attr, row_attr_len, s, e - s)) {
+			r_strbuf_appendf (out, "\x1b[%d;1H" Color_RESET "\x1b[2K", row + 1);
+			r_strbuf_append_n (out, row_attr, row_attr_len);
+			r_strbuf_append_n (out, s, e - s);
+			free (I->frame[row]);
+			I->frame[row] = r_str_newf ("%s%.*s", row_attr, (int)(e - s), s);
+		}
+		s = (e < end)? e + 1: end;
+	}
+	if (s < end) {
+		// more rows than the screen has would scroll
+		goto fail;
+	}
+	if (r_strbuf_length (out) > 0) {
+		r_strbuf_append (out, Color_RESET);
+		r_strbuf_append_n (out, attr, attr_len);
+		__cons_write (r_strbuf_get (out), r_strbuf_length (out));
+	}
+	r_strbuf_free (out);
+	I->frame_end = I->bytes_written;
+	return true;
+fail:
+	r_strbuf_free (out);
+	r_cons_frame_reset ();
+	return false;
+}
+
+// flush the buffer as a whole screen, see r_cons_frame_write
+R_API void r_cons_frame_flush(void) {
+	if (C->noflush) {
+		return;
+	}
+	if (I->damage && r_cons_is_interactive () && r_cons_frame_write (C->buffer, C->buffer_len)) {
+		r_cons_reset ();
+		return;
+	}
+	r_cons_flush ();
+}
+
 static int real_strlen(const char *ptr, int len) {
 	int utf8len = r_str_len_utf8 (ptr);
 	int ansilen = r_str_ansi_len (ptr);
@@ -1224,7 +1400,16 @@ static int real_strlen(const char *ptr, int len) {
 	return ansilen - diff;
 }
 
-R_API void r_cons_visual_write(char *buffer) {
+static void visual_out(RStrBuf *frame, const char *buf, int len) {
+	if (frame) {
+		r_strbuf_append_n (frame, buf, (len < 0)? strlen (buf): len);
+	} else {
+		__cons_write (buf, len);
+	}
+}
+
+// with a frame buffer the rows are collected for r_cons_frame_write
+static void visual_write(char *buffer, RStrBuf *frame) {
 	char white[1024];
 	int cols = I->columns;
 	int alen, plen, lines = I->rows;
@@ -1232,9 +1417,6 @@ R_API void r_cons_visual_write(char *buffer) {
 	const char *endptr;
 	char *nl, *ptr = buffer, *pptr;
 
-	if (I->null) {
-		return;
-	}
 	memset (&white, ' ', sizeof (white));
 	while ((nl = strchr (ptr, '\n'))) {
 		int len = ((int)(size_t)(nl - ptr)) + 1;
@@ -1257,27 +1439,30 @@ R_API void r_cons_visual_write(char *buffer) {
 			len = endptr - ptr;
 			plen = ptr > buffer ? len : len - 1;
 			if (lines > 0) {
-				__cons_write (pptr, plen);
+				visual_out (frame, pptr, plen);
 				if (len != olen) {
-					__cons_write (R_CONS_CLEAR_FROM_CURSOR_TO_END, -1);
-					__cons_write (Color_RESET, strlen (Color_RESET));
+					visual_out (frame, frame? "\x1b[0K": R_CONS_CLEAR_FROM_CURSOR_TO_END, -1);
+					visual_out (frame, Color_RESET, strlen (Color_RESET));
 				}
 			}
 		} else {
 			if (lines > 0) {
 				int w = cols - (alen % cols == 0 ? cols : alen % cols);
-				__cons_write (pptr, plen);
+				visual_out (frame, pptr, plen);
 				if (I->blankline && w > 0) {
 					if (w > sizeof (white) - 1) {
 						w = sizeof (white) - 1;
 					}
-					__cons_write (white, w);
+					visual_out (frame, white, w);
 				}
 			}
 			// TRICK to empty columns.. maybe buggy in w32
 			if (r_mem_mem ((const ut8*)ptr, len, (const ut8*)"\x1b[0;0H", 6)) {
 				lines = I->rows;
-				__cons_write (pptr, plen);
+				// the frame already starts at home
+				if (!frame || ptr > buffer) {
+					visual_out (frame, pptr, plen);
+				}
 			}
 		}
 		if (break_lines) {
@@ -1293,9 +1478,28 @@ R_API void r_cons_visual_write(char *buffer) {
 			cols = sizeof (white);
 		}
 		while (--lines >= 0) {
-			__cons_write (white, cols);
+			if (frame && ptr > buffer) {
+				visual_out (frame, "\n", 1);
+			}
+			visual_out (frame, white, cols);
+		}
+	}
+}
+
+R_API void r_cons_visual_write(char *buffer) {
+	if (I->null) {
+		return;
+	}
+	if (I->damage && !I->break_lines) {
+		RStrBuf *frame = r_strbuf_new (NULL);
+		visual_write (buffer, frame);
+		bool done = r_cons_frame_write (r_strbuf_get (frame), r_strbuf_length (frame));
+		r_strbuf_free (frame);
+		if (done) {
+			return;
 		}
 	}
+	visual_write (buffer, NULL);
 }
 
 R_API void r_cons_printf_list(const char *format, va_list ap) {
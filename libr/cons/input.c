@@ -588,6 +588,22 @@ R_API bool r_cons_readpush(const char *str, int len) {
 	return false;
 }
 
+// true when there are keys waiting to be read
+R_API bool r_cons_input_pending(void) {
+	if (readbuffer_length > 0) {
+		return true;
+	}
+#if __UNIX__ && !__wasi__
+	struct timeval tv = {0};
+	fd_set fdset;
+	FD_ZERO (&fdset);
+	FD_SET (0, &fdset);
+	return select (1, &fdset, NULL, NULL, &tv) == 1;
+#else
+	return false;
+#endif
+}
+
 R_API void r_cons_readflush(void) {
 	R_FREE (readbuffer);
 	readbuffer_length = 0;
@@ -148,6 +148,7 @@ static void __cons_pal_update_event(RConsContext *ctx) {
 		ctx->pal.rainbow[n++] = strdup (sdbkv_key (kv));
 	}
 	ctx->pal.rainbow_sz = n;
+	ctx->pal_gen++;
 	ls_free (list);
 	sdb_free (db);
 }
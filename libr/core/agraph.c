@@ -44,23 +44,21 @@ static const char *mousemodes[] = {
 #define BODY_SUMMARY    0x2
 #define BODY_COMMENTS   0x4
 
-#define NORMALIZE_MOV(x) ((x) < 0 ? -1 : ((x) > 0 ? 1 : 0))
+/* graphs with this many nodes (dummies included) are ordered with the
+ * barycenter heuristic before the adjacent swaps */
+#define LAYOUT_BARY_MIN_NODES 2048
+#define LAYOUT_BARY_ITER 16
+/* usecs that crossing minimization can take */
+#define LAYOUT_CROSSING_TIME (1000 * 1000)
 
-static void hash_set(Sdb *db, const void *k, ut64 v) {
-	r_strf_var (ks, 32, "%"PFMT64u, (ut64) (size_t) (k));
-	sdb_num_set (db, ks, (ut64) (size_t) (v), 0);
-}
+#define DIST_UNSET INT_MIN
 
-static ut64 hash_get(Sdb *db, const void *k) {
-	r_strf_var (ks, 32, "%"PFMT64u, (ut64) (size_t) (k));
-	return sdb_num_get (db, ks, NULL);
-}
+#define NORMALIZE_MOV(x) ((x) < 0 ? -1 : ((x) > 0 ? 1 : 0))
 
-#define hash_get_rnode(sdb, k) ((RGraphNode *) (size_t) hash_get (sdb, k))
-#define hash_get_rlist(sdb, k) ((RList *) (size_t) hash_get (sdb, k))
-#define hash_get_int(sdb, k) ((int) (size_t)hash_get (sdb, k))
 /* don't use macros for this */
 #define get_anode(gn) ((gn)? (RANode *) (gn)->data: NULL)
+/* index of a node in the arrays used during the layout */
+#define node_idx(g, gn) ((g)->layers[get_anode (gn)->layer].base + get_anode (gn)->pos_in_layer)
 
 #define graph_foreach_anode(list, it, pos, anode)\
 	if (list) for ((it) = (list)->head; (it) && ((pos) = (it)->data) && (pos) && ((anode) = (RANode *) (pos)->data); (it) = (it)->n)
@@ -70,12 +68,6 @@ struct len_pos_t {
 	int pos;
 };
 
-struct dist_t {
-	const RGraphNode *from;
-	const RGraphNode *to;
-	int dist;
-};
-
 struct g_cb {
 	RAGraph *graph;
 	RANodeCallback node_cb;
@@ -95,6 +87,7 @@ struct layer_t {
 	int n_nodes;
 	RGraphNode **nodes;
 	int position;
+	int base; // number of nodes in the layers before this one
 	int height;
 	int width;
 	int gap;
@@ -451,141 +444,143 @@ static void normal_RANode_print(const RAGraph *g, const RANode *n, int cur) {
 	}
 }
 
-static int **get_crossing_matrix(const RGraph *g, const struct layer_t layers[], int maxlayer, int i, int from_up, int *n_rows) {
-	int j, len = layers[i].n_nodes;
+/* positions of the neighbours of each node of layer i in the adjacent layer,
+ * sorted, so crossings between two nodes can be counted with a merge */
+struct cross_lists_t {
+	int *pos; // all positions, node k owns pos[off[k]] .. pos[off[k + 1] - 1]
+	int *off;
+};
 
-	int **m = R_NEWS0 (int *, len);
-	if (!m) {
-		return NULL;
-	}
-	for (j = 0; j < len; j++) {
-		m[j] = R_NEWS0 (int, len);
-		if (!m[j]) {
-			goto err_row;
-		}
+static int cmp_int(const void *a, const void *b) {
+	const int ia = *(const int *)a;
+	const int ib = *(const int *)b;
+	return (ia > ib) - (ia < ib);
+}
+
+static bool get_cross_lists(const RGraph *g, const struct layer_t layers[], int i, int from_up, struct cross_lists_t *cl) {
+	const int len = layers[i].n_nodes;
+	int j, k, n = 0;
+	cl->off = R_NEWS0 (int, len + 1);
+	if (!cl->off) {
+		return false;
 	}
-	/* calculate crossings between layer i and layer i-1 */
-	/* consider the crossings generated by each pair of edges */
-	if (i > 0 && from_up) {
-		if (r_cons_is_breaked ()) {
-			goto err_row;
-		}
+	/* count first, then fill the same way */
+	if (from_up) {
+		/* edges from layer i-1 to layer i, walked in the order of the upper
+		 * layer so each list is filled already sorted */
 		for (j = 0; j < layers[i - 1].n_nodes; j++) {
 			const RGraphNode *gj = layers[i - 1].nodes[j];
 			const RList *neigh = r_graph_get_neighbours (g, gj);
+			const RANode *ak;
 			RGraphNode *gk;
 			RListIter *itk;
-
-			r_list_foreach (neigh, itk, gk) {
-				int s;
-				// skip self-loop
-				if (gj == gk) {
-					continue;
-				}
-				for (s = 0; s < j; s++) {
-					const RGraphNode *gs = layers[i - 1].nodes[s];
-					const RList *neigh_s = r_graph_get_neighbours (g, gs);
-					RGraphNode *gt;
-					RListIter *itt;
-
-					r_list_foreach (neigh_s, itt, gt) {
-						const RANode *ak, *at; /* k and t should be "indexes" on layer i */
-						if (gt == gk || gt == gs) {
-							continue;
-						}
-						ak = get_anode (gk);
-						at = get_anode (gt);
-						if (ak->layer != i || at->layer != i) {
-							// this should never happen
-							// but it happens if we do graph.dummy = false, so better hide it for now
-#if 0
-							eprintf ("(WARNING) \"%s\" (%d) or \"%s\" (%d) are not on the right layer (%d)\n",
-								ak->title, ak->layer,
-								at->title, at->layer,
-								i);
-#endif
-							continue;
-						}
-						m[ak->pos_in_layer][at->pos_in_layer]++;
-					}
+			graph_foreach_anode (neigh, itk, gk, ak) {
+				// skip self-loop and edges that do not end in layer i (graph.dummy = false)
+				if (gk != gj && ak->layer == i) {
+					cl->off[ak->pos_in_layer + 1]++;
+					n++;
 				}
 			}
 		}
-	}
-
-	/* calculate crossings between layer i and layer i+1 */
-	if (i < maxlayer - 1 && !from_up) {
-		if (r_cons_is_breaked ()) {
-			goto err_row;
-		}
-		for (j = 0; j < layers[i].n_nodes; j++) {
+	} else {
+		for (j = 0; j < len; j++) {
 			const RGraphNode *gj = layers[i].nodes[j];
 			const RList *neigh = r_graph_get_neighbours (g, gj);
 			const RANode *ak, *aj = get_anode (gj);
 			RGraphNode *gk;
 			RListIter *itk;
-
-			if (r_cons_is_breaked ()) {
-				goto err_row;
+			graph_foreach_anode (neigh, itk, gk, ak) {
+				cl->off[aj->pos_in_layer + 1]++;
+				n++;
 			}
+		}
+	}
+	for (k = 0; k < len; k++) {
+		cl->off[k + 1] += cl->off[k];
+	}
+	cl->pos = R_NEWS (int, n + 1);
+	int *fill = R_NEWS (int, len + 1);
+	if (!cl->pos || !fill) {
+		free (fill);
+		R_FREE (cl->off);
+		R_FREE (cl->pos);
+		return false;
+	}
+	memcpy (fill, cl->off, sizeof (int) * (len + 1));
+	if (from_up) {
+		for (j = 0; j < layers[i - 1].n_nodes; j++) {
+			const RGraphNode *gj = layers[i - 1].nodes[j];
+			const RList *neigh = r_graph_get_neighbours (g, gj);
+			const RANode *ak;
+			RGraphNode *gk;
+			RListIter *itk;
 			graph_foreach_anode (neigh, itk, gk, ak) {
-				int s;
-				for (s = 0; s < layers[i].n_nodes; s++) {
-					const RGraphNode *gs = layers[i].nodes[s];
-					const RList *neigh_s;
-					RGraphNode *gt;
-					RListIter *itt;
-					const RANode *at, *as = get_anode (gs);
-
-					if (gs == gj) {
-						continue;
-					}
-					neigh_s = r_graph_get_neighbours (g, gs);
-					graph_foreach_anode (neigh_s, itt, gt, at) {
-						if (at->pos_in_layer < ak->pos_in_layer) {
-							m[aj->pos_in_layer][as->pos_in_layer]++;
-						}
-					}
+				if (gk != gj && ak->layer == i) {
+					cl->pos[fill[ak->pos_in_layer]++] = j;
 				}
 			}
 		}
+	} else {
+		for (j = 0; j < len; j++) {
+			const RGraphNode *gj = layers[i].nodes[j];
+			const RList *neigh = r_graph_get_neighbours (g, gj);
+			const RANode *ak, *aj = get_anode (gj);
+			RGraphNode *gk;
+			RListIter *itk;
+			graph_foreach_anode (neigh, itk, gk, ak) {
+				cl->pos[fill[aj->pos_in_layer]++] = ak->pos_in_layer;
+			}
+		}
+		for (k = 0; k < len; k++) {
+			qsort (cl->pos + cl->off[k], cl->off[k + 1] - cl->off[k], sizeof (int), cmp_int);
+		}
 	}
+	free (fill);
+	return true;
+}
 
-	if (n_rows) {
-		*n_rows = len;
-	}
-	return m;
-
-err_row:
-	for (i = 0; i < len; i++) {
-		free (m[i]);
+/* number of crossings between the edges of u and v when u is placed left of v */
+static int count_pair_crossings(const struct cross_lists_t *cl, int u, int v) {
+	const int *a = cl->pos + cl->off[u], *ae = cl->pos + cl->off[u + 1];
+	const int *b = cl->pos + cl->off[v], *be = cl->pos + cl->off[v + 1];
+	const int *bp = b;
+	int res = 0;
+	for (; a < ae; a++) {
+		while (bp < be && *bp < *a) {
+			bp++;
+		}
+		res += bp - b;
 	}
-	free (m);
-	return NULL;
+	return res;
 }
 
 static int layer_sweep(const RGraph *g, const struct layer_t layers[], int maxlayer, int i, int from_up) {
 	RGraphNode *u, *v;
 	const RANode *au, *av;
-	int n_rows, j, changed = false;
+	int j, changed = false;
 	int len = layers[i].n_nodes;
+	struct cross_lists_t cl;
 
-	int **cross_matrix = get_crossing_matrix (g, layers, maxlayer, i, from_up, &n_rows);
-	if (!cross_matrix) {
+	if (r_cons_is_breaked ()) {
+		return -1;
+	}
+	if ((from_up && i == 0) || (!from_up && i >= maxlayer - 1)) {
+		/* no layer to cross edges with */
+		return false;
+	}
+	if (!get_cross_lists (g, layers, i, from_up, &cl)) {
 		return -1; // ERROR HAPPENS
 	}
 
 	for (j = 0; j < len - 1; j++) {
-		int auidx, avidx;
-
 		u = layers[i].nodes[j];
 		v = layers[i].nodes[j + 1];
 		au = get_anode (u);
 		av = get_anode (v);
-		auidx = au->pos_in_layer;
-		avidx = av->pos_in_layer;
 
-		if (cross_matrix[auidx][avidx] > cross_matrix[avidx][auidx]) {
+		/* lists are indexed by the position at the start of the sweep */
+		if (count_pair_crossings (&cl, au->pos_in_layer, av->pos_in_layer)
+				> count_pair_crossings (&cl, av->pos_in_layer, au->pos_in_layer)) {
 			/* swap elements */
 			layers[i].nodes[j] = v;
 			layers[i].nodes[j + 1] = u;
@@ -593,18 +588,14 @@ static int layer_sweep(const RGraph *g, const struct layer_t layers[], int maxla
 		}
 	}
 
-	/* update position in the layer of each node. During the swap of some
-	 * elements we didn't swap also the pos_in_layer because the cross_matrix
-	 * is indexed by it, so do it now! */
+	/* update position in the layer of each node */
 	for (j = 0; j < layers[i].n_nodes; j++) {
 		RANode *n = get_anode (layers[i].nodes[j]);
 		n->pos_in_layer = j;
 	}
 
-	for (j = 0; j < n_rows; j++) {
-		free (cross_matrix[j]);
-	}
-	free (cross_matrix);
+	free (cl.pos);
+	free (cl.off);
 	return changed;
 }
 
@@ -705,12 +696,11 @@ static void assign_layers(const RAGraph *g) {
 	r_list_free (topological_sort);
 }
 
-static int find_edge(const RGraphEdge *a, const RGraphEdge *b) {
-	return a->from == b->to && a->to == b->from? 0: 1;
-}
+#define edge_key(from, to) (((ut64)(from)->idx << 32) | (to)->idx)
 
-static bool is_reversed(const RAGraph *g, const RGraphEdge *e) {
-	return (bool)r_list_find (g->back_edges, e, (RListComparator) find_edge);
+/* a long edge is reversed if it was a back edge before remove_cycles */
+static bool is_reversed(SetU *back_edges, const RGraphEdge *e) {
+	return set_u_contains (back_edges, edge_key (e->to, e->from));
 }
 
 /* add dummy nodes when there are edges that span multiple layers */
@@ -723,6 +713,13 @@ static void create_dummy_nodes(RAGraph *g) {
 	};
 	const RListIter *it;
 	const RGraphEdge *e;
+	SetU *back_edges = set_u_new ();
+	if (!back_edges) {
+		return;
+	}
+	r_list_foreach (g->back_edges, it, e) {
+		set_u_add (back_edges, edge_key (e->from, e->to));
+	}
 
 	g->long_edges = r_list_newf ((RListFree)free);
 	dummy_vis.data = g->long_edges;
@@ -735,17 +732,19 @@ static void create_dummy_nodes(RAGraph *g) {
 		RANode *to = get_anode (e->to);
 		int diff_layer = R_ABS (from->layer - to->layer);
 		RANode *prev = get_anode (e->from);
+		const bool reversed = is_reversed (back_edges, e);
 		int i, nth = e->nth;
 
 		r_agraph_del_edge (g, from, to);
 		for (i = 1; i < diff_layer; i++) {
 			RANode *dummy = r_agraph_add_node (g, NULL, NULL, NULL);
 			if (!dummy) {
+				set_u_free (back_edges);
 				return;
 			}
 			dummy->is_dummy = true;
 			dummy->layer = from->layer + i;
-			dummy->is_reversed = is_reversed (g, e);
+			dummy->is_reversed = reversed;
 			dummy->w = 1;
 			r_agraph_add_edge_at (g, prev, dummy, nth);
 
@@ -754,6 +753,7 @@ static void create_dummy_nodes(RAGraph *g) {
 		}
 		r_graph_add_edge (g->graph, prev->gnode, e->to);
 	}
+	set_u_free (back_edges);
 }
 
 /* create layers and assign an initial ordering of the nodes into them */
@@ -790,6 +790,7 @@ static void create_layers(RAGraph *g) {
 		g->layers[i].nodes = R_NEWS0 (RGraphNode *,
 			1 + g->layers[i].n_nodes);
 		g->layers[i].position = 0;
+		g->layers[i].base = i? g->layers[i - 1].base + g->layers[i - 1].n_nodes: 0;
 	}
 	graph_foreach_anode (nodes, it, gn, n) {
 		n->pos_in_layer = g->layers[n->layer].position;
@@ -797,11 +798,186 @@ static void create_layers(RAGraph *g) {
 	}
 }
 
+/* number of crossings between the edges going from layer i to layer i+1 */
+/* edges are visited sorted by their start and then by their end, the
+ * crossings of an edge are the previous ones that end to the right of it,
+ * kept in a fenwick tree indexed by position in layer i+1 */
+static int cmp_ut64(const void *a, const void *b) {
+	const ut64 ia = *(const ut64 *)a;
+	const ut64 ib = *(const ut64 *)b;
+	return (ia > ib) - (ia < ib);
+}
+
+static ut64 count_layer_crossings(const RAGraph *g, int i) {
+	const struct layer_t *up = &g->layers[i], *down = &g->layers[i + 1];
+	int *tree = R_NEWS0 (int, down->n_nodes + 1);
+	RVector edges;
+	ut64 res = 0, *e;
+	int j, seen = 0;
+
+	if (!tree) {
+		return 0;
+	}
+	r_vector_init (&edges, sizeof (ut64), NULL, NULL);
+	for (j = 0; j < up->n_nodes; j++) {
+		const RList *neigh = r_graph_get_neighbours (g->graph, up->nodes[j]);
+		const RGraphNode *gk;
+		const RListIter *itk;
+		const RANode *ak;
+		graph_foreach_anode (neigh, itk, gk, ak) {
+			if (ak->layer == i + 1) {
+				ut64 key = ((ut64)j << 32) | (ut32)ak->pos_in_layer;
+				r_vector_push (&edges, &key);
+			}
+		}
+	}
+	if (edges.len) {
+		qsort (edges.a, edges.len, sizeof (ut64), cmp_ut64);
+	}
+	r_vector_foreach (&edges, e) {
+		int k, end = (int)(*e & UT32_MAX), before = 0;
+		for (k = end + 1; k > 0; k -= k & -k) {
+			before += tree[k];
+		}
+		res += seen - before;
+		for (k = end + 1; k <= down->n_nodes; k += k & -k) {
+			tree[k]++;
+		}
+		seen++;
+	}
+	r_vector_fini (&edges);
+	free (tree);
+	return res;
+}
+
+static ut64 count_crossings(const RAGraph *g) {
+	ut64 res = 0;
+	int i;
+	for (i = 0; i + 1 < g->n_layers; i++) {
+		res += count_layer_crossings (g, i);
+	}
+	return res;
+}
+
+struct bary_t {
+	RGraphNode *gn;
+	double val;
+	int pos;
+};
+
+static int cmp_bary(const void *a, const void *b) {
+	const struct bary_t *ba = a, *bb = b;
+	if (ba->val != bb->val) {
+		return ba->val < bb->val? -1: 1;
+	}
+	return ba->pos - bb->pos;
+}
+
+/* sorts layer i by the mean position of the neighbours in the layer above
+ * (from_up) or below it */
+static void bary_sort_layer(const RAGraph *g, int i, int from_up, struct bary_t *tmp) {
+	const int adj = from_up? i - 1: i + 1;
+	struct layer_t *layer = &g->layers[i];
+	int j;
+
+	for (j = 0; j < layer->n_nodes; j++) {
+		RGraphNode *gn = layer->nodes[j];
+		const RList *neigh = from_up
+			? r_graph_innodes (g->graph, gn)
+			: r_graph_get_neighbours (g->graph, gn);
+		const RGraphNode *gk;
+		const RListIter *itk;
+		const RANode *ak;
+		int sum = 0, n = 0;
+		graph_foreach_anode (neigh, itk, gk, ak) {
+			if (ak->layer == adj) {
+				sum += ak->pos_in_layer;
+				n++;
+			}
+		}
+		tmp[j].gn = gn;
+		tmp[j].pos = j;
+		// nodes without neighbours there stay where they are
+		tmp[j].val = n? (double)sum / n: j;
+	}
+	qsort (tmp, layer->n_nodes, sizeof (struct bary_t), cmp_bary);
+	for (j = 0; j < layer->n_nodes; j++) {
+		layer->nodes[j] = tmp[j].gn;
+		get_anode (tmp[j].gn)->pos_in_layer = j;
+	}
+}
+
+static RGraphNode **save_order(const RAGraph *g, RGraphNode **order) {
+	int i, n = 0;
+	for (i = 0; i < g->n_layers; i++) {
+		memcpy (order + n, g->layers[i].nodes, sizeof (RGraphNode *) * g->layers[i].n_nodes);
+		n += g->layers[i].n_nodes;
+	}
+	return order;
+}
+
+static void restore_order(const RAGraph *g, RGraphNode **order) {
+	int i, j, n = 0;
+	for (i = 0; i < g->n_layers; i++) {
+		for (j = 0; j < g->layers[i].n_nodes; j++) {
+			g->layers[i].nodes[j] = order[n++];
+			get_anode (g->layers[i].nodes[j])->pos_in_layer = j;
+		}
+	}
+}
+
+/* barycenter heuristic, gets big graphs close to a good ordering with a few
+ * passes over the edges, which the adjacent swaps only reach after many
+ * sweeps. Keeps the ordering with less crossings. */
+static void barycenter_sweeps(const RAGraph *g, ut64 deadline) {
+	int i, iter, max_len = 0, n_nodes = 0;
+	for (i = 0; i < g->n_layers; i++) {
+		max_len = R_MAX (max_len, g->layers[i].n_nodes);
+		n_nodes += g->layers[i].n_nodes;
+	}
+	struct bary_t *tmp = R_NEWS (struct bary_t, max_len + 1);
+	RGraphNode **best = R_NEWS (RGraphNode *, n_nodes + 1);
+	if (!tmp || !best) {
+		free (tmp);
+		free (best);
+		return;
+	}
+	ut64 best_cross = count_crossings (g);
+	save_order (g, best);
+	for (iter = 0; iter < LAYOUT_BARY_ITER && best_cross > 0; iter++) {
+		for (i = 1; i < g->n_layers; i++) {
+			bary_sort_layer (g, i, true, tmp);
+		}
+		for (i = g->n_layers - 2; i >= 0; i--) {
+			bary_sort_layer (g, i, false, tmp);
+		}
+		ut64 cross = count_crossings (g);
+		if (cross >= best_cross) {
+			break;
+		}
+		best_cross = cross;
+		save_order (g, best);
+		if (r_cons_is_breaked () || r_time_now_mono () > deadline) {
+			break;
+		}
+	}
+	restore_order (g, best);
+	free (best);
+	free (tmp);
+}
+
 /* layer-by-layer sweep */
 /* it permutes each layer, trying to find the best ordering for each layer
  * to minimize the number of crossing edges */
+/* big graphs are ordered first with the barycenter heuristic, and the sweeps
+ * stop after LAYOUT_CROSSING_TIME, so huge graphs still get drawn */
 static void minimize_crossings(const RAGraph *g) {
 	int i, cross_changed, max_changes = 4096;
+	const ut64 deadline = r_time_now_mono () + LAYOUT_CROSSING_TIME;
+
+	if (g->graph->n_nodes >= LAYOUT_BARY_MIN_NODES) {
+		barycenter_sweeps (g, deadline);
+	}
 
 	do {
 		cross_changed = false;
@@ -814,7 +990,7 @@ static void minimize_crossings(const RAGraph *g) {
 			}
 			cross_changed |= !!rc;
 		}
-	} while (cross_changed && max_changes);
+	} while (cross_changed && max_changes && r_time_now_mono () < deadline);
 
 	max_changes = 4096;
 
@@ -829,34 +1005,26 @@ static void minimize_crossings(const RAGraph *g) {
 			}
 			cross_changed |= !!rc;
 		}
-	} while (cross_changed && max_changes);
-}
-
-static int find_dist(const struct dist_t *a, const struct dist_t *b) {
-	return a->from == b->from && a->to == b->to? 0: 1;
+	} while (cross_changed && max_changes && r_time_now_mono () < deadline);
 }
 
 /* returns the distance between two nodes */
 /* if the distance between two nodes were explicitly set, returns that;
  * otherwise calculate the distance of two nodes on the same layer */
 static int dist_nodes(const RAGraph *g, const RGraphNode *a, const RGraphNode *b) {
-	struct dist_t d;
 	const RANode *aa, *ab;
-	RListIter *it;
 	int res = 0;
 
-	if (g->dists) {
-		d.from = a;
-		d.to = b;
-		it = r_list_find (g->dists, &d, (RListComparator) find_dist);
-		if (it) {
-			struct dist_t *old = (struct dist_t *) r_list_iter_get_data (it);
-			return old->dist;
+	aa = get_anode (a);
+	ab = get_anode (b);
+	/* explicit distances are only kept between neighbours in a layer */
+	if (g->dists && aa && ab && aa->layer == ab->layer && aa->pos_in_layer + 1 == ab->pos_in_layer) {
+		int d = g->dists[node_idx (g, a)];
+		if (d != DIST_UNSET) {
+			return d;
 		}
 	}
 
-	aa = get_anode (a);
-	ab = get_anode (b);
 	if (aa && ab && aa->layer == ab->layer) {
 		int i;
 
@@ -869,12 +1037,9 @@ static int dist_nodes(const RAGraph *g, const RGraphNode *a, const RGraphNode *b
 			int found = false;
 
 			if (g->dists) {
-				d.from = cur;
-				d.to = next;
-				it = r_list_find (g->dists, &d, (RListComparator) find_dist);
-				if (it) {
-					struct dist_t *old = (struct dist_t *) r_list_iter_get_data (it);
-					res += old->dist;
+				int d = g->dists[g->layers[aa->layer].base + i];
+				if (d != DIST_UNSET) {
+					res += d;
 					found = true;
 				}
 			}
@@ -898,32 +1063,16 @@ static int dist_nodes(const RAGraph *g, const RGraphNode *a, const RGraphNode *b
 	return res;
 }
 
-/* explicitly set the distance between two nodes on the same layer */
+/* explicitly set the distance between two neighbour nodes on the same layer */
 static void set_dist_nodes(const RAGraph *g, int l, int cur, int next) {
-	struct dist_t *d, find_el;
-	const RGraphNode *vi, *vip;
 	const RANode *avi, *avip;
-	RListIter *it;
 
-	if (!g->dists) {
+	if (!g->dists || next != cur + 1) {
 		return;
 	}
-	vi = g->layers[l].nodes[cur];
-	vip = g->layers[l].nodes[next];
-	avi = get_anode (vi);
-	avip = get_anode (vip);
-
-	find_el.from = vi;
-	find_el.to = vip;
-	it = r_list_find (g->dists, &find_el, (RListComparator) find_dist);
-	d = it? (struct dist_t *) r_list_iter_get_data (it): R_NEW0 (struct dist_t);
-
-	d->from = vi;
-	d->to = vip;
-	d->dist = (avip && avi)? avip->x - avi->x: 0;
-	if (!it) {
-		r_list_push (g->dists, d);
-	}
+	avi = get_anode (g->layers[l].nodes[cur]);
+	avip = get_anode (g->layers[l].nodes[next]);
+	g->dists[g->layers[l].base + cur] = (avip && avi)? avip->x - avi->x: 0;
 }
 
 static int is_valid_pos(const RAGraph *g, int l, int pos) {
@@ -934,19 +1083,23 @@ static int is_valid_pos(const RAGraph *g, int l, int pos) {
 /* if v is an original node, L(v) = { v }
  * if v is a dummy node, L(v) is the set of all the dummies node that belongs
  *      to the same long edge */
-static Sdb *compute_vertical_nodes(const RAGraph *g) {
-	Sdb *res = sdb_new0 ();
+static RList **compute_vertical_nodes(const RAGraph *g) {
+	RList **res = R_NEWS0 (RList *, g->graph->n_nodes + 1);
 	int i, j;
 
+	if (!res) {
+		return NULL;
+	}
+
 	for (i = 0; i < g->n_layers; i++) {
 		for (j = 0; j < g->layers[i].n_nodes; j++) {
 			RGraphNode *gn = g->layers[i].nodes[j];
-			const RList *Ln = hash_get_rlist (res, gn);
+			const RList *Ln = res[node_idx (g, gn)];
 			const RANode *an = get_anode (gn);
 
 			if (!Ln) {
 				RList *vert = r_list_new ();
-				hash_set (res, gn, (size_t) vert);
+				res[node_idx (g, gn)] = vert;
 				if (an->is_dummy) {
 					RGraphNode *next = gn;
 					const RANode *anext = get_anode (next);
@@ -974,7 +1127,7 @@ static Sdb *compute_vertical_nodes(const RAGraph *g) {
  * - v E C
  * - w E C => L(v) is a subset of C
  * - w E C, the s+(w) exists and is not in any class yet => s+(w) E C */
-static RList **compute_classes(const RAGraph *g, Sdb *v_nodes, int is_left, int *n_classes) {
+static RList **compute_classes(const RAGraph *g, RList **v_nodes, int is_left, int *n_classes) {
 	int i, j, c;
 	RList **res = R_NEWS0 (RList *, g->n_layers);
 	RGraphNode *gn;
@@ -995,7 +1148,7 @@ static RList **compute_classes(const RAGraph *g, Sdb *v_nodes, int is_left, int
 			const RANode *aj = get_anode (gj);
 
 			if (aj->klass == -1) {
-				const RList *laj = hash_get_rlist (v_nodes, gj);
+				const RList *laj = v_nodes[node_idx (g, gj)];
 
 				if (!res[c]) {
 					res[c] = r_list_new ();
@@ -1036,16 +1189,16 @@ static RGraphNode *get_sibling(const RAGraph *g, const RANode *n, int is_left, i
 	return res;
 }
 
-static int adjust_class_val(const RAGraph *g, const RGraphNode *gn, const RGraphNode *sibl, Sdb *res, int is_left) {
+static int adjust_class_val(const RAGraph *g, const RGraphNode *gn, const RGraphNode *sibl, int *res, int is_left) {
 	if (is_left) {
-		return hash_get_int (res, sibl) - hash_get_int (res, gn) - dist_nodes (g, gn, sibl);
+		return res[node_idx (g, sibl)] - res[node_idx (g, gn)] - dist_nodes (g, gn, sibl);
 	}
-	return hash_get_int (res, gn) - hash_get_int (res, sibl) - dist_nodes (g, sibl, gn);
+	return res[node_idx (g, gn)] - res[node_idx (g, sibl)] - dist_nodes (g, sibl, gn);
 }
 
 /* adjusts the position of previously placed left/right classes */
 /* tries to place classes as close as possible */
-static void adjust_class(const RAGraph *g, int is_left, RList **classes, Sdb *res, int c) {
+static void adjust_class(const RAGraph *g, int is_left, RList **classes, int *res, int c) {
 	const RGraphNode *gn;
 	const RListIter *it;
 	const RANode *an;
@@ -1100,17 +1253,17 @@ static void adjust_class(const RAGraph *g, int is_left, RList **classes, Sdb *re
 	}
 
 	graph_foreach_anode (classes[c], it, gn, an) {
-		const int old_val = hash_get_int (res, gn);
+		const int old_val = res[node_idx (g, gn)];
 		const int new_val = is_left? old_val + dist: old_val - dist;
-		hash_set (res, gn, new_val);
+		res[node_idx (g, gn)] = new_val;
 	}
 }
 
-static int place_nodes_val(const RAGraph *g, const RGraphNode *gn, const RGraphNode *sibl, Sdb *res, int is_left) {
+static int place_nodes_val(const RAGraph *g, const RGraphNode *gn, const RGraphNode *sibl, int *res, int is_left) {
 	if (is_left) {
-		return hash_get_int (res, sibl) + dist_nodes (g, sibl, gn);
+		return res[node_idx (g, sibl)] + dist_nodes (g, sibl, gn);
 	}
-	return hash_get_int (res, sibl) - dist_nodes (g, gn, sibl);
+	return res[node_idx (g, sibl)] - dist_nodes (g, gn, sibl);
 }
 
 static int place_nodes_sel_p(int newval, int oldval, int is_first, int is_left) {
@@ -1124,8 +1277,8 @@ static int place_nodes_sel_p(int newval, int oldval, int is_first, int is_left)
 }
 
 /* places left/right the nodes of a class */
-static void place_nodes(const RAGraph *g, const RGraphNode *gn, int is_left, Sdb *v_nodes, RList **classes, Sdb *res, Sdb *placed) {
-	const RList *lv = hash_get_rlist (v_nodes, gn);
+static void place_nodes(const RAGraph *g, const RGraphNode *gn, int is_left, RList **v_nodes, RList **classes, int *res, bool *placed) {
+	const RList *lv = v_nodes[node_idx (g, gn)];
 	int p = 0, v, is_first = true;
 	const RGraphNode *gk;
 	const RListIter *itk;
@@ -1141,7 +1294,7 @@ static void place_nodes(const RAGraph *g, const RGraphNode *gn, int is_left, Sdb
 		}
 		sibl_anode = get_anode (sibling);
 		if (ak->klass == sibl_anode->klass) {
-			if (!hash_get (placed, sibling)) {
+			if (!placed[node_idx (g, sibling)]) {
 				place_nodes (g, sibling, is_left, v_nodes, classes, res, placed);
 			}
 
@@ -1156,13 +1309,13 @@ static void place_nodes(const RAGraph *g, const RGraphNode *gn, int is_left, Sdb
 	}
 
 	graph_foreach_anode (lv, itk, gk, ak) {
-		hash_set (res, gk, p);
-		hash_set (placed, gk, true);
+		res[node_idx (g, gk)] = p;
+		placed[node_idx (g, gk)] = true;
 	}
 }
 
 /* computes the position to the left/right of all the nodes */
-static Sdb *compute_pos(const RAGraph *g, int is_left, Sdb *v_nodes) {
+static int *compute_pos(const RAGraph *g, int is_left, RList **v_nodes) {
 	int n_classes, i;
 
 	RList **classes = compute_classes (g, v_nodes, is_left, &n_classes);
@@ -1170,14 +1323,17 @@ static Sdb *compute_pos(const RAGraph *g, int is_left, Sdb *v_nodes) {
 		return NULL;
 	}
 
-	Sdb *res = sdb_new0 ();
-	Sdb *placed = sdb_new0 ();
-	for (i = 0; i < n_classes; i++) {
+	int *res = R_NEWS0 (int, g->graph->n_nodes + 1);
+	bool *placed = R_NEWS0 (bool, g->graph->n_nodes + 1);
+	if (!res || !placed) {
+		R_FREE (res);
+	}
+	for (i = 0; res && i < n_classes; i++) {
 		const RGraphNode *gn;
 		const RListIter *it;
 
 		r_list_foreach (classes[i], it, gn) {
-			if (!hash_get_rnode (placed, gn)) {
+			if (!placed[node_idx (g, gn)]) {
 				place_nodes (g, gn, is_left, v_nodes, classes, res, placed);
 			}
 		}
@@ -1185,7 +1341,7 @@ static Sdb *compute_pos(const RAGraph *g, int is_left, Sdb *v_nodes) {
 		adjust_class (g, is_left, classes, res, i);
 	}
 
-	sdb_free (placed);
+	free (placed);
 	for (i = 0; i < n_classes; i++) {
 		if (classes[i]) {
 			r_list_free (classes[i]);
@@ -1195,11 +1351,6 @@ static Sdb *compute_pos(const RAGraph *g, int is_left, Sdb *v_nodes) {
 	return res;
 }
 
-static int free_vertical_nodes_cb(void *user UNUSED, const char *k UNUSED, const char *v) {
-	r_list_free ((RList *) (size_t) sdb_atoi (v));
-	return 1;
-}
-
 /* calculates position of all nodes, but in particular dummies nodes */
 /* computes two different placements (called "left"/"right") and set the final
  * position of each node to the average of the values in the two placements */
@@ -1209,30 +1360,33 @@ static void place_dummies(const RAGraph *g) {
 	const RListIter *it;
 	RANode *n;
 
-	Sdb *vertical_nodes = compute_vertical_nodes (g);
+	RList **vertical_nodes = compute_vertical_nodes (g);
+	int i;
 	if (!vertical_nodes) {
 		return;
 	}
-	Sdb *xminus = compute_pos (g, true, vertical_nodes);
+	int *xminus = compute_pos (g, true, vertical_nodes);
 	if (!xminus) {
 		goto xminus_err;
 	}
-	Sdb *xplus = compute_pos (g, false, vertical_nodes);
+	int *xplus = compute_pos (g, false, vertical_nodes);
 	if (!xplus) {
 		goto xplus_err;
 	}
 
 	nodes = r_graph_get_nodes (g->graph);
 	graph_foreach_anode (nodes, it, gn, n) {
-		n->x = (hash_get_int (xminus, gn) + hash_get_int (xplus, gn)) / 2;
+		n->x = (xminus[node_idx (g, gn)] + xplus[node_idx (g, gn)]) / 2;
 	}
 
-	sdb_free (xplus);
+	free (xplus);
 xplus_err:
-	sdb_free (xminus);
+	free (xminus);
 xminus_err:
-	sdb_foreach (vertical_nodes, (SdbForeachCallback)free_vertical_nodes_cb, NULL);
-	sdb_free (vertical_nodes);
+	for (i = 0; i < g->graph->n_nodes; i++) {
+		r_list_free (vertical_nodes[i]);
+	}
+	free (vertical_nodes);
 }
 
 static RGraphNode *get_right_dummy(const RAGraph *g, const RGraphNode *n) {
@@ -1256,7 +1410,7 @@ static RGraphNode *get_right_dummy(const RAGraph *g, const RGraphNode *n) {
 	return NULL;
 }
 
-static void adjust_directions(const RAGraph *g, int i, int from_up, Sdb *D, Sdb *P) {
+static void adjust_directions(const RAGraph *g, int i, int from_up, int *D, int *P) {
 	const RGraphNode *vm = NULL, *wm = NULL;
 	const RANode *vma = NULL, *wma = NULL;
 	int j, d = from_up? 1: -1;
@@ -1281,23 +1435,23 @@ static void adjust_directions(const RAGraph *g, int i, int from_up, Sdb *D, Sdb
 			continue;
 		}
 		if (vm) {
-			int p = hash_get_int (P, wm);
+			int p = P[node_idx (g, wm)];
 			int k;
 
 			for (k = wma->pos_in_layer + 1; k < wpa->pos_in_layer; k++) {
 				const RGraphNode *w = g->layers[wma->layer].nodes[k];
 				const RANode *aw = get_anode (w);
 				if (aw && aw->is_dummy) {
-					p &= hash_get_int (P, w);
+					p &= P[node_idx (g, w)];
 				}
 			}
 			if (p) {
-				hash_set (D, vm, from_up);
+				D[node_idx (g, vm)] = from_up;
 				for (k = vma->pos_in_layer + 1; k < vpa->pos_in_layer; k++) {
 					const RGraphNode *v = g->layers[vma->layer].nodes[k];
 					const RANode *av = get_anode (v);
 					if (av && av->is_dummy) {
-						hash_set (D, v, from_up);
+						D[node_idx (g, v)] = from_up;
 					}
 				}
 			}
@@ -1515,7 +1669,7 @@ static void place_sequence(const RAGraph *g, int l, const RGraphNode *bm, const
 /* finds the placements of nodes while traversing the graph in the given
  * direction */
 /* places all the sequences of consecutive original nodes in each layer. */
-static void original_traverse_l(const RAGraph *g, Sdb *D, Sdb *P, int from_up) {
+static void original_traverse_l(const RAGraph *g, int *D, int *P, int from_up) {
 	int i, k, va, vr;
 
 	for (i = from_up? 0: g->n_layers - 1;
@@ -1564,12 +1718,12 @@ static void original_traverse_l(const RAGraph *g, Sdb *D, Sdb *P, int from_up) {
 				if (is_valid_pos (g, i, va)) {
 					set_dist_nodes (g, i, bma->pos_in_layer, va);
 				}
-			} else if (hash_get_int (D, bm) == from_up) {
+			} else if (D[node_idx (g, bm)] == from_up) {
 				bpa = get_anode (bp);
 				va = bma->pos_in_layer + 1;
 				vr = bpa->pos_in_layer;
 				place_sequence (g, i, bm, bp, from_up, va, vr);
-				hash_set (P, bm, true);
+				P[node_idx (g, bm)] = true;
 			}
 			bm = bp;
 		}
@@ -1585,22 +1739,26 @@ static void place_original(RAGraph *g) {
 	const RGraphNode *gn;
 	const RListIter *itn;
 	const RANode *an;
+	int i;
 
-	Sdb *D = sdb_new0 ();
+	int *D = R_NEWS0 (int, g->graph->n_nodes + 1);
 	if (!D) {
 		return;
 	}
-	Sdb *P = sdb_new0 ();
+	int *P = R_NEWS0 (int, g->graph->n_nodes + 1);
 	if (!P) {
-		sdb_free (D);
+		free (D);
 		return;
 	}
-	g->dists = r_list_newf ((RListFree) free);
+	g->dists = R_NEWS (int, g->graph->n_nodes + 1);
 	if (!g->dists) {
-		sdb_free (D);
-		sdb_free (P);
+		free (D);
+		free (P);
 		return;
 	}
+	for (i = 0; i <= g->graph->n_nodes; i++) {
+		g->dists[i] = DIST_UNSET;
+	}
 
 	graph_foreach_anode (nodes, itn, gn, an) {
 		if (!an->is_dummy) {
@@ -1609,19 +1767,18 @@ static void place_original(RAGraph *g) {
 		const RGraphNode *right_v = get_right_dummy (g, gn);
 		const RANode *right = get_anode (right_v);
 		if (right_v && right) {
-			hash_set (D, gn, 0);
+			D[node_idx (g, gn)] = 0;
 			int dt_eq = right->x - an->x == dist_nodes (g, gn, right_v);
-			hash_set (P, gn, dt_eq);
+			P[node_idx (g, gn)] = dt_eq;
 		}
 	}
 
 	original_traverse_l (g, D, P, true);
 	original_traverse_l (g, D, P, false);
 
-	r_list_free (g->dists);
-	g->dists = NULL;
-	sdb_free (P);
-	sdb_free (D);
+	R_FREE (g->dists);
+	free (P);
+	free (D);
 }
 
 static void aedge_free(AEdge *e) {
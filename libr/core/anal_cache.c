@@ -0,0 +1,510 @@
+/* radare2 - LGPL - Copyright 2026 - agent */
+
+#include <r_core.h>
+
+// the results of aa/aaa are stored as an sdb text file named after the hash
+// of the binary and the settings used to analyze it. entries only hold data
+// (functions, basic blocks, variables, xrefs, the data and string meta, the
+// bits hints and the string flags found by the analysis) that is parsed back
+// through the anal api, nothing in them is ever run as a command, and user
+// state like comments or other flags is not stored. types and noreturn info
+// are not stored either, the passes computing them run again after a restore
+
+#define ANAL_CACHE_DIR R_JOIN_2_PATHS (R2_HOME_CACHEDIR, "anal")
+#define ANAL_CACHE_CHUNK (1024 * 1024)
+
+// sha256 of the loaded file, the one listed by `it` is used when the file
+// was hashed on load, the bin info is never modified. returns a new string
+R_IPI char *r_core_file_sha256(RCore *core, RBinFile *bf) {
+	RBinInfo *info = (bf->o)? bf->o->info: NULL;
+	if (info && info->file_hashes) {
+		RListIter *iter;
+		RBinFileHash *fh;
+		r_list_foreach (info->file_hashes, iter, fh) {
+			if (!strcmp (fh->type, "sha256")) {
+				return strdup (fh->hex);
+			}
+		}
+	}
+	RHash *ctx = r_hash_new (false, R_HASH_SHA256);
+	ut8 *buf = malloc (ANAL_CACHE_CHUNK);
+	if (!ctx || !buf) {
+		r_hash_free (ctx);
+		free (buf);
+		return NULL;
+	}
+	r_hash_do_begin (ctx, R_HASH_SHA256);
+	ut64 at, size = r_buf_size (bf->buf);
+	for (at = 0; at < size; at += ANAL_CACHE_CHUNK) {
+		int len = (int)R_MIN (size - at, ANAL_CACHE_CHUNK);
+		if (r_buf_read_at (bf->buf, at, buf, len) != len) {
+			break;
+		}
+		r_hash_do_sha256 (ctx, buf, len);
+	}
+	char *res = NULL;
+	if (at >= size) {
+		r_hash_do_end (ctx, R_HASH_SHA256);
+		res = r_hex_bin2strdup (ctx->digest, R_HASH_SIZE_SHA256);
+	}
+	free (buf);
+	r_hash_free (ctx);
+	return res;
+}
+
+static void hash_settings(RCore *core, RHash *ctx, const char *sha256) {
+	RStrBuf *sb = r_strbuf_new (R2_VERSION "\n");
+	r_strbuf_appendf (sb, "sha256=%s\n", sha256);
+	r_strbuf_appendf (sb, "baddr=0x%"PFMT64x"\n", r_bin_get_baddr (core->bin));
+	const char *keys[] = { "asm.arch", "asm.bits", "asm.cpu", "asm.os", "cfg.bigendian", NULL };
+	int i;
+	for (i = 0; keys[i]; i++) {
+		r_strbuf_appendf (sb, "%s=%s\n", keys[i], r_config_get (core->config, keys[i]));
+	}
+	RListIter *iter;
+	RConfigNode *node;
+	r_list_foreach (core->config->nodes, iter, node) {
+		if (r_str_startswith (node->name, "anal.") && strcmp (node->name, "anal.cache")) {
+			r_strbuf_appendf (sb, "%s=%s\n", node->name, node->value);
+		}
+	}
+	r_hash_do_sha256 (ctx, (const ut8 *)r_strbuf_get (sb), r_strbuf_length (sb));
+	r_strbuf_free (sb);
+}
+
+/**
+ * @brief Path of the analysis cache entry for the current file
+ *
+ * The digest of the file listed by `it` is reused when there is one.
+ *
+ * @return char* NULL if there is no file loaded
+ */
+R_API char *r_core_anal_cache_path(RCore *core) {
+	r_return_val_if_fail (core, NULL);
+	RBinFile *bf = r_bin_cur (core->bin);
+	if (!bf || !bf->buf) {
+		return NULL;
+	}
+	char *sha256 = r_core_file_sha256 (core, bf);
+	RHash *ctx = sha256? r_hash_new (false, R_HASH_SHA256): NULL;
+	if (!ctx) {
+		free (sha256);
+		return NULL;
+	}
+	r_hash_do_begin (ctx, R_HASH_SHA256);
+	hash_settings (core, ctx, sha256);
+	r_hash_do_end (ctx, R_HASH_SHA256);
+	char *path = NULL;
+	char *hex = r_hex_bin2strdup (ctx->digest, R_HASH_SIZE_SHA256);
+	char *dir = r_str_home (ANAL_CACHE_DIR);
+	if (hex && dir) {
+		path = r_str_newf ("%s" R_SYS_DIR "%s.sdb", dir, hex);
+	}
+	free (hex);
+	free (dir);
+	free (sha256);
+	r_hash_free (ctx);
+	return path;
+}
+
+static void save_function(Sdb *db, RAnalFunction *fcn) {
+	r_strf_buffer (64);
+	const ut64 at = fcn->addr;
+	sdb_set_owned (db, r_strf ("0x%"PFMT64x, at), r_str_newf ("%d,%d,%d,%"PFMT64d",%"PFMT64d",%d,%d,%d,%d",
+		fcn->type, fcn->bits, fcn->maxstack, fcn->stack, fcn->bp_off,
+		fcn->bp_frame, fcn->is_noreturn, fcn->folded, fcn->ninstr), 0);
+	sdb_set (db, r_strf ("0x%"PFMT64x".name", at), fcn->name, 0);
+	if (fcn->cc) {
+		sdb_set (db, r_strf ("0x%"PFMT64x".cc", at), fcn->cc, 0);
+	}
+	RStrBuf *sb = r_strbuf_new ("");
+	RListIter *iter;
+	RAnalBlock *bb;
+	// one block per row: addr,size,jump,fail,ninstr and the offsets of the instructions
+	r_list_foreach (fcn->bbs, iter, bb) {
+		r_strbuf_appendf (sb, "0x%"PFMT64x",0x%"PFMT64x",0x%"PFMT64x",0x%"PFMT64x",%d",
+			bb->addr, bb->size, bb->jump, bb->fail, bb->ninstr);
+		int i;
+		for (i = 1; i < bb->ninstr; i++) {
+			r_strbuf_appendf (sb, ",%d", r_anal_bb_offset_inst (bb, i));
+		}
+		r_strbuf_append (sb, ";");
+	}
+	sdb_set_owned (db, r_strf ("0x%"PFMT64x".bbs", at), r_strbuf_drain (sb), 0);
+	RList *prots = r_anal_var_get_prots (fcn);
+	char *vars = prots? r_anal_var_prot_serialize (prots, false): NULL;
+	if (vars) {
+		sdb_set_owned (db, r_strf ("0x%"PFMT64x".vars", at), vars, 0);
+	}
+	r_list_free (prots);
+	sb = r_strbuf_new ("");
+	void **it;
+	r_pvector_foreach (&fcn->vars, it) {
+		RAnalVar *var = *it;
+		RAnalVarAccess *acc;
+		r_vector_foreach (&var->accesses, acc) {
+			if (acc->reg) {
+				r_strbuf_appendf (sb, "%c,%d,0x%"PFMT64x",%d,%"PFMT64d",%s;", var->kind, var->delta,
+					at + acc->offset, acc->type, acc->stackptr, acc->reg);
+			}
+		}
+	}
+	if (r_strbuf_length (sb) > 0) {
+		sdb_set_owned (db, r_strf ("0x%"PFMT64x".acc", at), r_strbuf_drain (sb), 0);
+	} else {
+		r_strbuf_free (sb);
+	}
+}
+
+static void save_refs(Sdb *db, RAnal *anal) {
+	RList *refs = r_anal_refs_get (anal, UT64_MAX);
+	if (!refs) {
+		return;
+	}
+	r_strf_buffer (64);
+	RStrBuf *sb = r_strbuf_new ("");
+	RListIter *iter;
+	RAnalRef *ref;
+	ut64 at = UT64_MAX;
+	// sorted by source address, all the refs from one address go in one key
+	r_list_foreach (refs, iter, ref) {
+		if (ref->at != at && r_strbuf_length (sb) > 0) {
+			sdb_set_owned (db, r_strf ("0x%"PFMT64x, at), r_strbuf_drain (sb), 0);
+			sb = r_strbuf_new ("");
+		}
+		at = ref->at;
+		r_strbuf_appendf (sb, "0x%"PFMT64x",%d,", ref->addr, (int)ref->type);
+	}
+	if (r_strbuf_length (sb) > 0) {
+		sdb_set_owned (db, r_strf ("0x%"PFMT64x, at), r_strbuf_drain (sb), 0);
+	} else {
+		r_strbuf_free (sb);
+	}
+	r_list_free (refs);
+}
+
+// only the kinds of meta made by the analysis passes, comments are user
+// state and R_META_TYPE_RUN holds commands
+static const RAnalMetaType meta_types[] = {
+	R_META_TYPE_DATA, R_META_TYPE_CODE, R_META_TYPE_STRING, R_META_TYPE_VARTYPE
+};
+
+static void save_meta(Sdb *db, RAnal *anal) {
+	r_strf_buffer (64);
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (meta_types); i++) {
+		RAnalMetaIter it;
+		RIntervalNode *node;
+		r_meta_foreach_type (anal, it, node, meta_types[i]) {
+			RAnalMetaItem *mi = node->data;
+			sdb_set_owned (db, r_strf ("0x%"PFMT64x".%c", node->start, mi->type),
+				r_str_newf ("%d,%"PFMT64d",%s", mi->subtype,
+				r_meta_item_size (node->start, node->end), r_str_get (mi->str)), 0);
+		}
+	}
+}
+
+static bool save_bits_hint_cb(ut64 addr, int bits, void *user) {
+	r_strf_buffer (64);
+	sdb_num_set (user, r_strf ("0x%"PFMT64x, addr), bits, 0);
+	return true;
+}
+
+static bool save_string_flag_cb(RFlagItem *fi, void *user) {
+	sdb_set_owned (user, fi->name, r_str_newf ("0x%"PFMT64x",%"PFMT64d, fi->offset, fi->size), 0);
+	return true;
+}
+
+// parses up to n comma separated numbers, returns how many were read
+static int parse_nums(const char *s, ut64 *out, int n) {
+	int i;
+	for (i = 0; i < n && s && *s; i++) {
+		char *end;
+		out[i] = strtoull (s, &end, 0);
+		if (end == s || (*end && *end != ',')) {
+			break;
+		}
+		s = *end? end + 1: end;
+	}
+	return i;
+}
+
+static void load_blocks(RAnal *anal, RAnalFunction *fcn, const char *s) {
+	char *str = strdup (s);
+	RList *list = r_str_split_list (str, ";", 0);
+	RListIter *iter;
+	char *row;
+	r_list_foreach (list, iter, row) {
+		ut64 v[5];
+		if (parse_nums (row, v, 5) != 5 || !r_anal_function_add_bb (anal, fcn, v[0], v[1], v[2], v[3], NULL)) {
+			continue;
+		}
+		RAnalBlock *bb = r_anal_get_block_at (anal, v[0]);
+		if (!bb || v[4] > bb->size) {
+			continue;
+		}
+		// skip the five block fields, then one offset per instruction
+		int i;
+		for (i = 0; i < 5 && row; i++) {
+			row = strchr (row, ',');
+			row = row? row + 1: NULL;
+		}
+		bb->ninstr = v[4]? 1: 0;
+		while (row && bb->ninstr < (int)v[4]) {
+			char *end;
+			ut64 off = strtoull (row, &end, 0);
+			if (end == row || off >= bb->size || !r_anal_bb_set_offset (bb, bb->ninstr, (ut16)off)) {
+				break;
+			}
+			bb->ninstr++;
+			row = (*end == ',')? end + 1: NULL;
+		}
+	}
+	r_list_free (list);
+	free (str);
+}
+
+static void load_accesses(RAnalFunction *fcn, const char *s) {
+	char *str = strdup (s);
+	RList *list = r_str_split_list (str, ";", 0);
+	RListIter *iter;
+	char *row;
+	r_list_foreach (list, iter, row) {
+		// kind,delta,addr,type,stackptr,reg
+		char *reg = (strlen (row) > 2)? (char *)r_str_lchr (row, ','): NULL;
+		if (!reg || row[1] != ',' || !reg[1]) {
+			continue;
+		}
+		*reg++ = 0;
+		ut64 v[4];
+		if (parse_nums (row + 2, v, 4) != 4) {
+			continue;
+		}
+		RAnalVar *var = r_anal_function_get_var (fcn, row[0], (int)v[0]);
+		if (var) {
+			r_anal_var_set_access (var, reg, v[1], (int)v[2], (st64)v[3]);
+		}
+	}
+	r_list_free (list);
+	free (str);
+}
+
+static bool load_function(RCore *core, Sdb *db, ut64 at, const char *v) {
+	r_strf_buffer (64);
+	ut64 n[9];
+	const char *name = sdb_const_get (db, r_strf ("0x%"PFMT64x".name", at), 0);
+	if (parse_nums (v, n, 9) != 9 || !name || !r_name_check (name)) {
+		return false;
+	}
+	RAnal *anal = core->anal;
+	RAnalFunction *fcn = r_anal_create_function (anal, name, at, (int)n[0], NULL);
+	if (!fcn) {
+		return false;
+	}
+	fcn->bits = (int)n[1];
+	fcn->maxstack = (int)n[2];
+	fcn->stack = (st64)n[3];
+	fcn->bp_off = (st64)n[4];
+	fcn->bp_frame = n[5];
+	fcn->is_noreturn = n[6];
+	fcn->folded = n[7];
+	fcn->ninstr = (int)n[8];
+	const char *cc = sdb_const_get (db, r_strf ("0x%"PFMT64x".cc", at), 0);
+	if (cc && r_anal_cc_exist (anal, cc)) {
+		fcn->cc = r_str_constpool_get (&anal->constpool, cc);
+	}
+	const char *bbs = sdb_const_get (db, r_strf ("0x%"PFMT64x".bbs", at), 0);
+	if (bbs) {
+		load_blocks (anal, fcn, bbs);
+	}
+	const char *vars = sdb_const_get (db, r_strf ("0x%"PFMT64x".vars", at), 0);
+	RList *prots = vars? r_anal_var_deserialize (vars): NULL;
+	if (prots) {
+		r_anal_function_set_var_prot (fcn, prots);
+		r_list_free (prots);
+	}
+	const char *acc = sdb_const_get (db, r_strf ("0x%"PFMT64x".acc", at), 0);
+	if (acc) {
+		load_accesses (fcn, acc);
+	}
+	return true;
+}
+
+static bool load_function_cb(void *user, const char *k, const char *v) {
+	void **u = user;
+	// per function rows are "<addr>", the details are in "<addr>.<field>"
+	if (!strchr (k, '.')) {
+		char *end;
+		ut64 at = strtoull (k, &end, 0);
+		if (end != k && !*end) {
+			load_function (u[0], u[1], at, v);
+		}
+	}
+	return true;
+}
+
+static bool load_refs_cb(void *user, const char *k, const char *v) {
+	RAnal *anal = user;
+	char *end;
+	ut64 at = strtoull (k, &end, 0);
+	if (end == k || *end) {
+		return true;
+	}
+	ut64 ref[2];
+	while (v && parse_nums (v, ref, 2) == 2) {
+		r_anal_xrefs_set (anal, at, ref[0], (RAnalRefType)ref[1]);
+		v = strchr (v, ',');
+		v = v? strchr (v + 1, ','): NULL;
+		v = v? v + 1: NULL;
+	}
+	return true;
+}
+
+static bool load_meta_cb(void *user, const char *k, const char *v) {
+	// "<addr>.<type>" = "subtype,size,str"
+	char *end;
+	ut64 at = strtoull (k, &end, 0);
+	ut64 n[2];
+	const char *str = (end != k && *end == '.' && end[1] && !end[2])? strchr (v, ','): NULL;
+	str = str? strchr (str + 1, ','): NULL;
+	if (!str || parse_nums (v, n, 2) != 2 || !n[1]) {
+		return true;
+	}
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (meta_types); i++) {
+		if (end[1] == meta_types[i]) {
+			r_meta_set_with_subtype (user, meta_types[i], (int)n[0], at, n[1], str + 1);
+			break;
+		}
+	}
+	return true;
+}
+
+static bool load_bits_hint_cb(void *user, const char *k, const char *v) {
+	char *end, *end2;
+	ut64 at = strtoull (k, &end, 0);
+	int bits = (int)strtol (v, &end2, 0);
+	if (end != k && !*end && end2 != v && !*end2) {
+		r_anal_hint_set_bits (user, at, bits);
+	}
+	return true;
+}
+
+static bool load_string_flag_cb(void *user, const char *k, const char *v) {
+	ut64 n[2];
+	if (r_name_check (k) && parse_nums (v, n, 2) == 2) {
+		r_flag_set (user, k, n[0], n[1]);
+	}
+	return true;
+}
+
+static Sdb *restored_db(RCore *core) {
+	return sdb_ns (core->sdb, "anal_cache", true);
+}
+
+/**
+ * @brief Restore the analysis from the cache entry for the current file
+ *
+ * Does nothing when this level, or a deeper one, was already restored or
+ * saved in this session.
+ *
+ * @param level number of 'a' after "aa" in the analysis command
+ * @return true if the analysis for that level is in place
+ */
+R_API bool r_core_anal_cache_load(RCore *core, int level) {
+	r_return_val_if_fail (core, false);
+	char *path = r_core_anal_cache_path (core);
+	if (!path) {
+		return false;
+	}
+	ut64 done = sdb_num_get (restored_db (core), path, 0);
+	if ((int)done > level && !r_list_empty (core->anal->fcns)) {
+		free (path);
+		return true;
+	}
+	bool ret = false;
+	Sdb *db = r_file_exists (path)? sdb_new0 (): NULL;
+	if (db && sdb_text_load (db, path)) {
+		int entry_level = (int)sdb_num_get (db, "level", 0);
+		Sdb *fcns = sdb_ns (db, "fcns", false);
+		Sdb *refs = sdb_ns (db, "refs", false);
+		if (entry_level >= level && fcns) {
+			void *user[2] = { core, fcns };
+			sdb_foreach (fcns, load_function_cb, user);
+			if (refs) {
+				sdb_foreach (refs, load_refs_cb, core->anal);
+			}
+			Sdb *meta = sdb_ns (db, "meta", false);
+			if (meta) {
+				sdb_foreach (meta, load_meta_cb, core->anal);
+			}
+			Sdb *hints = sdb_ns (db, "hints", false);
+			if (hints) {
+				sdb_foreach (hints, load_bits_hint_cb, core->anal);
+			}
+			RListIter *iter;
+			RAnalFunction *fcn;
+			r_flag_space_push (core->flags, R_FLAGS_FS_FUNCTIONS);
+			r_list_foreach (core->anal->fcns, iter, fcn) {
+				r_flag_set (core->flags, fcn->name, fcn->addr, r_anal_function_size_from_entry (fcn));
+			}
+			r_flag_space_pop (core->flags);
+			Sdb *strings = sdb_ns (db, "strings", false);
+			if (strings) {
+				r_flag_space_push (core->flags, R_FLAGS_FS_STRINGS);
+				sdb_foreach (strings, load_string_flag_cb, core->flags);
+				r_flag_space_pop (core->flags);
+			}
+			sdb_num_set (restored_db (core), path, entry_level + 1, 0);
+			ret = true;
+		}
+	} else if (db) {
+		R_LOG_WARN ("Cannot load the analysis cache %s", path);
+	}
+	sdb_free (db);
+	free (path);
+	return ret;
+}
+
+R_API bool r_core_anal_cache_save(RCore *core, int level) {
+	r_return_val_if_fail (core, false);
+	char *path = r_core_anal_cache_path (core);
+	if (!path) {
+		return false;
+	}
+	char *dir = r_file_dirname (path);
+	if (!dir || !r_sys_mkdirp (dir)) {
+		free (dir);
+		free (path);
+		return false;
+	}
+	free (dir);
+	Sdb *db = sdb_new0 ();
+	sdb_num_set (db, "level", level, 0);
+	Sdb *fcns = sdb_ns (db, "fcns", true);
+	RListIter *iter;
+	RAnalFunction *fcn;
+	r_list_foreach (core->anal->fcns, iter, fcn) {
+		save_function (fcns, fcn);
+	}
+	save_refs (sdb_ns (db, "refs", true), core->anal);
+	save_meta (sdb_ns (db, "meta", true), core->anal);
+	r_anal_bits_hints_foreach (core->anal, save_bits_hint_cb, sdb_ns (db, "hints", true));
+	RSpace *strings = r_flag_space_get (core->flags, R_FLAGS_FS_STRINGS);
+	if (strings) {
+		r_flag_foreach_space (core->flags, strings, save_string_flag_cb, sdb_ns (db, "strings", true));
+	}
+	// write and rename, so concurrent runs never read a partial entry
+	char *tmp = r_str_newf ("%s.%d", path, r_sys_getpid ());
+	bool ret = tmp && sdb_text_save (db, tmp, true) && r_file_move (tmp, path);
+	if (!ret && tmp) {
+		r_file_rm (tmp);
+	}
+	if (ret) {
+		sdb_num_set (restored_db (core), path, level + 1, 0);
+	}
+	free (tmp);
+	sdb_free (db);
+	free (path);
+	return ret;
+}
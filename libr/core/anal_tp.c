@@ -4,6 +4,7 @@
 #include <r_anal.h>
 #include <r_util.h>
 #include <r_core.h>
+#include <ht_uu.h>
 #define LOOP_MAX 10
 
 static bool anal_emul_init(RCore *core, RConfigHold *hc, RDebugTrace **dt, RAnalEsilTrace **et) {
@@ -38,17 +39,80 @@ static void anal_emul_restore(RCore *core, RConfigHold *hc, RDebugTrace *dt, RAn
 	core->dbg->trace = dt;
 }
 
-static bool regwrite_contains(Sdb *trace, int i, const char *place) {
-	r_strf_var (rwv, 32, "%d.reg.write", i);
-	return sdb_array_contains (trace, rwv, place, 0);
+// index of the last traced instruction
+static int trace_last_idx(RAnalEsilTrace *trace) {
+	return R_MAX (0, trace->idx - 1);
 }
 
-static bool type_pos_hit(RAnal *anal, Sdb *trace, bool in_stack, int idx, int size, const char *place) {
+static ut64 trace_addr(RAnalEsilTrace *trace, int idx) {
+	RAnalEsilTraceStep *step = r_anal_esil_trace_get_step (trace, idx);
+	return step? step->addr: 0;
+}
+
+static bool regwrite_contains(RAnalEsilTrace *trace, int i, const char *place) {
+	return place && r_anal_esil_trace_get_access (trace, i, R_ANAL_ESIL_TRACE_REG_WRITE, place);
+}
+
+// substring match of name against any register written at step idx
+static bool regwrite_match(RAnalEsilTrace *trace, int idx, const char *name) {
+	RAnalEsilTraceStep *step = r_anal_esil_trace_get_step (trace, idx);
+	if (!step) {
+		return false;
+	}
+	ut32 i;
+	for (i = 0; i < step->count; i++) {
+		RAnalEsilTraceAccess *a = r_vector_index_ptr (&trace->accesses, step->start + i);
+		if (a->type == R_ANAL_ESIL_TRACE_REG_WRITE && strstr (a->reg, name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// comma separated list of the registers written at step idx
+static char *regwrite_list(RAnalEsilTrace *trace, int idx) {
+	RAnalEsilTraceStep *step = r_anal_esil_trace_get_step (trace, idx);
+	if (!step) {
+		return NULL;
+	}
+	RStrBuf *sb = r_strbuf_new ("");
+	ut32 i, j;
+	for (i = 0; i < step->count; i++) {
+		RAnalEsilTraceAccess *a = r_vector_index_ptr (&trace->accesses, step->start + i);
+		if (a->type != R_ANAL_ESIL_TRACE_REG_WRITE) {
+			continue;
+		}
+		for (j = 0; j < i; j++) {
+			RAnalEsilTraceAccess *b = r_vector_index_ptr (&trace->accesses, step->start + j);
+			if (b->type == R_ANAL_ESIL_TRACE_REG_WRITE && b->reg == a->reg) {
+				break;
+			}
+		}
+		if (j == i) {
+			r_strbuf_appendf (sb, "%s%s", r_strbuf_is_empty (sb)? "": ",", a->reg);
+		}
+	}
+	if (r_strbuf_is_empty (sb)) {
+		r_strbuf_free (sb);
+		return NULL;
+	}
+	return r_strbuf_drain (sb);
+}
+
+static bool type_pos_hit(RAnal *anal, RAnalEsilTrace *trace, bool in_stack, int idx, int size, const char *place) {
 	if (in_stack) {
 		const char *sp_name = r_reg_get_name (anal->reg, R_REG_NAME_SP);
 		ut64 sp = r_reg_getv (anal->reg, sp_name);
-		r_strf_var (k, 32, "%d.mem.write", idx);
-		ut64 write_addr = sdb_num_get (trace, k, 0);
+		RAnalEsilTraceStep *step = r_anal_esil_trace_get_step (trace, idx);
+		ut64 write_addr = 0;
+		ut32 i;
+		for (i = 0; step && i < step->count; i++) {
+			RAnalEsilTraceAccess *a = r_vector_index_ptr (&trace->accesses, step->start + i);
+			if (a->type == R_ANAL_ESIL_TRACE_MEM_WRITE) {
+				write_addr = a->addr;
+				break;
+			}
+		}
 		return (write_addr == sp + size);
 	}
 	return regwrite_contains (trace, idx, place);
@@ -174,12 +238,12 @@ static void get_src_regname(RCore *core, ut64 addr, char *regname, int size) {
 	r_anal_op_free (op);
 }
 
-static ut64 get_addr(Sdb *trace, const char *regname, int idx) {
+static ut64 get_addr(RAnalEsilTrace *trace, const char *regname, int idx) {
 	if (!regname || !*regname) {
 		return UT64_MAX;
 	}
-	r_strf_var (query, 64, "%d.reg.read.%s", idx, regname);
-	return r_num_math (NULL, sdb_const_get (trace, query, 0));
+	RAnalEsilTraceAccess *a = r_anal_esil_trace_get_access (trace, idx, R_ANAL_ESIL_TRACE_REG_READ, regname);
+	return a? a->value: 0;
 }
 
 static _RAnalCond cond_invert(RAnal *anal, _RAnalCond cond) {
@@ -285,11 +349,11 @@ static void retype_callee_arg(RAnal *anal, const char *callee_name, bool in_stac
  */
 static void type_match(RCore *core, char *fcn_name, ut64 addr, ut64 baddr, const char* cc,
 		int prev_idx, bool userfnc, ut64 caddr) {
-	Sdb *trace = core->anal->esil->trace->db;
+	RAnalEsilTrace *trace = core->anal->esil->trace;
 	Sdb *TDB = core->anal->sdb_types;
 	RAnal *anal = core->anal;
 	RList *types = NULL;
-	int idx = sdb_num_get (trace, "idx", 0);
+	int idx = trace_last_idx (trace);
 	bool verbose = r_config_get_b (core->config, "anal.types.verbose");
 	bool stack_rev = false, in_stack = false, format = false;
 
@@ -352,8 +416,7 @@ static void type_match(RCore *core, char *fcn_name, ut64 addr, ut64 baddr, const
 		bool res = false;
 		// Backtrace instruction from source sink to prev source sink
 		for (j = idx; j >= prev_idx; j--) {
-			r_strf_var (k, 32, "%d.addr", j);
-			ut64 instr_addr = sdb_num_get (trace, k, 0);
+			ut64 instr_addr = trace_addr (trace, j);
 			if (instr_addr < baddr) {
 				break;
 			}
@@ -370,8 +433,7 @@ static void type_match(RCore *core, char *fcn_name, ut64 addr, ut64 baddr, const
 				break;
 			}
 			RAnalVar *var = r_anal_get_used_function_var (anal, op->addr);
-			r_strf_var (query, 32, "%d.mem.read", j);
-			if (op->type == R_ANAL_OP_TYPE_MOV && sdb_const_get (trace, query, 0)) {
+			if (op->type == R_ANAL_OP_TYPE_MOV && r_anal_esil_trace_get_access (trace, j, R_ANAL_ESIL_TRACE_MEM_READ, NULL)) {
 				memref = ! (!memref && var && (var->kind != R_ANAL_VAR_KIND_REG));
 			}
 			// Match type from function param to instr
@@ -538,14 +600,12 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 		anal_emul_restore (core, hc, dt, et);
 		return;
 	}
-	// Reserve bigger ht to avoid rehashing
-	Sdb *etracedb = core->anal->esil->trace->db;
-	HtPPOptions opt = etracedb->ht->opt;
-	ht_pp_free (etracedb->ht);
-	etracedb->ht = ht_pp_new_size (fcn->ninstr * 0xf, opt.dupvalue, opt.freefn, opt.calcsizeV);
-	etracedb->ht->opt = opt;
+	// Reserve bigger storage to avoid reallocations
+	RAnalEsilTrace *etrace = core->anal->esil->trace;
+	r_vector_reserve (&etrace->steps, fcn->ninstr);
+	r_vector_reserve (&etrace->accesses, fcn->ninstr * 4);
 	RDebugTrace *dtrace = core->dbg->trace;
-	opt = dtrace->ht->opt;
+	HtPPOptions opt = dtrace->ht->opt;
 	ht_pp_free (dtrace->ht);
 	dtrace->ht = ht_pp_new_size (fcn->ninstr, opt.dupvalue, opt.freefn, opt.calcsizeV);
 	dtrace->ht->opt = opt;
@@ -556,7 +616,7 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 	bool prop = false;
 	bool prev_var = false;
 	char prev_type[256] = {0};
-	const char *prev_dest = NULL;
+	int prev_dest = -1;
 	char *ret_reg = NULL;
 	const char *_pc = r_reg_get_name (core->dbg->reg, R_REG_NAME_PC);
 	if (!_pc) {
@@ -564,9 +624,11 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 	}
 	int retries = 2;
 	char *pc = strdup (_pc);
+	HtUU *loop_counts = ht_uu_new0 ();
 	r_cons_break_push (NULL, NULL);
 repeat:
 	if (retries < 0) {
+		ht_uu_free (loop_counts);
 		free (pc);
 		return;
 	}
@@ -616,13 +678,12 @@ repeat:
 				r_anal_op_fini (&aop);
 				continue;
 			}
-			r_strf_var (addr_count, 32, "0x%"PFMT64x".count", addr);
-			int loop_count = sdb_num_get (anal->esil->trace->db, addr_count, 0);
+			ut64 loop_count = ht_uu_find (loop_counts, addr, NULL);
 			if (loop_count > LOOP_MAX || aop.type == R_ANAL_OP_TYPE_RET) {
 				r_anal_op_fini (&aop);
 				break;
 			}
-			sdb_num_set (anal->esil->trace->db, addr_count, loop_count + 1, 0);
+			ht_uu_update (loop_counts, addr, loop_count + 1);
 			if (r_anal_op_nonlinear (aop.type)) {   // skip the instr
 				// just analyze statically the instruction if its a call, dont emulate it
 				r_reg_setv (core->dbg->reg, pc, addr + ret);
@@ -642,8 +703,8 @@ repeat:
 			}
 
 			bool userfnc = false;
-			Sdb *trace = anal->esil->trace->db;
-			cur_idx = sdb_num_get (trace, "idx", 0);
+			RAnalEsilTrace *trace = anal->esil->trace;
+			cur_idx = trace_last_idx (trace);
 			RAnalVar *var = r_anal_get_used_function_var (anal, aop.addr);
 			RAnalOp *next_op = r_core_anal_op (core, addr + ret, R_ANAL_OP_MASK_BASIC); // | _VAL ?
 			ut32 type = aop.type & R_ANAL_OP_TYPE_MASK;
@@ -692,8 +753,7 @@ repeat:
 						free (cc);
 					}
 					if (!strcmp (fcn_name, "__stack_chk_fail")) {
-						r_strf_var (query, 32, "%d.addr", cur_idx - 1);
-						ut64 mov_addr = sdb_num_get (trace, query, 0);
+						ut64 mov_addr = trace_addr (trace, cur_idx - 1);
 						RAnalOp *mop = r_core_anal_op (core, mov_addr, R_ANAL_OP_MASK_VAL | R_ANAL_OP_MASK_BASIC);
 						if (mop) {
 							RAnalVar *mopvar = r_anal_get_used_function_var (anal, mop->addr);
@@ -709,8 +769,7 @@ repeat:
 			} else if (!resolved && ret_type && ret_reg) {
 				// Forward propgation of function return type
 				char src[REGNAME_SIZE] = {0};
-				r_strf_var (query, 32, "%d.reg.write", cur_idx);
-				const char *cur_dest = sdb_const_get (trace, query, 0);
+				char *cur_dest = regwrite_list (trace, cur_idx);
 				get_src_regname (core, aop.addr, src, sizeof (src));
 				if (ret_reg && *src && strstr (ret_reg, src)) {
 					if (var && aop.direction == R_ANAL_OP_DIR_WRITE) {
@@ -744,6 +803,7 @@ repeat:
 					}
 					free (foo);
 				}
+				free (cur_dest);
 			}
 			// Type propagation using instruction access pattern
 			if (var) {
@@ -762,10 +822,10 @@ repeat:
 				}
 				// lea rax , str.hello  ; mov [local_ch], rax;
 				// mov rdx , [local_4h] ; mov [local_8h], rdx;
-				if (prev_dest && (type == R_ANAL_OP_TYPE_MOV || type == R_ANAL_OP_TYPE_STORE)) {
+				if (prev_dest >= 0 && (type == R_ANAL_OP_TYPE_MOV || type == R_ANAL_OP_TYPE_STORE)) {
 					char reg[REGNAME_SIZE] = {0};
 					get_src_regname (core, addr, reg, sizeof (reg));
-					bool match = strstr (prev_dest, reg);
+					bool match = regwrite_match (trace, prev_dest, reg);
 					if (str_flag && match) {
 						__var_retype (anal, var, NULL, "const char *", false, false);
 					}
@@ -805,7 +865,7 @@ repeat:
 			prev_var = (var && aop.direction == R_ANAL_OP_DIR_READ);
 			str_flag = false;
 			prop = false;
-			prev_dest = NULL;
+			prev_dest = -1;
 			switch (type) {
 			case R_ANAL_OP_TYPE_MOV:
 			case R_ANAL_OP_TYPE_LEA:
@@ -829,8 +889,9 @@ repeat:
 				if (var && str_flag) {
 					__var_retype (anal, var, NULL, "const char *", false, false);
 				}
-				r_strf_var (query, 32, "%d.reg.write", cur_idx);
-				prev_dest = sdb_const_get (trace, query, 0);
+				if (r_anal_esil_trace_get_access (trace, cur_idx, R_ANAL_ESIL_TRACE_REG_WRITE, NULL)) {
+					prev_dest = cur_idx;
+				}
 				if (var) {
 					strncpy (prev_type, var->type, sizeof (prev_type) - 1);
 					prop = true;
@@ -863,6 +924,7 @@ repeat:
 	}
 	r_list_free (list);
 out_function:
+	ht_uu_free (loop_counts);
 	R_FREE (ret_reg);
 	R_FREE (ret_type);
 	r_cons_break_pop();
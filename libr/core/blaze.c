@@ -36,6 +36,25 @@ static bool __is_data_block_cb(RAnalBlock *block, void *user) {
 	return false;
 }
 
+typedef struct {
+	ut64 addr;
+	int result;
+} IsDataCtx;
+
+static bool __is_data_meta_cb(RIntervalNode *node, void *user) {
+	IsDataCtx *ctx = user;
+	RAnalMetaItem *meta = node->data;
+	switch (meta->type) {
+	case R_META_TYPE_DATA:
+	case R_META_TYPE_STRING:
+	case R_META_TYPE_FORMAT:
+		ctx->result = node->end - ctx->addr + 1;
+		return false;
+	default:
+		return true;
+	}
+}
+
 static int __isdata(RCore *core, ut64 addr) {
 	if (!r_io_is_valid_offset (core->io, addr, false)) {
 		// eprintf ("Warning: Invalid memory address at 0x%08"PFMT64x"\n", addr);
@@ -49,25 +68,9 @@ static int __isdata(RCore *core, ut64 addr) {
 		return 1;
 	}
 
-	RPVector *list = r_meta_get_all_in (core->anal, addr, R_META_TYPE_ANY);
-	void **it;
-	int result = 0;
-	r_pvector_foreach (list, it) {
-		RIntervalNode *node = *it;
-		RAnalMetaItem *meta = node->data;
-		switch (meta->type) {
-		case R_META_TYPE_DATA:
-		case R_META_TYPE_STRING:
-		case R_META_TYPE_FORMAT:
-			result = node->end - addr + 1;
-			goto exit;
-		default:
-			break;
-		}
-	}
-exit:
-	r_pvector_free (list);
-	return result;
+	IsDataCtx ctx = { addr, 0 };
+	r_meta_foreach_in (core->anal, addr, R_META_TYPE_ANY, __is_data_meta_cb, &ctx);
+	return ctx.result;
 }
 
 static bool fcnAddBB(fcn_t *fcn, bb_t* block) {
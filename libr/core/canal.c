@@ -4373,6 +4373,7 @@ R_API int r_core_anal_data(RCore *core, ut64 addr, int count, int depth, int wor
 struct block_flags_stat_t {
 	ut64 step;
 	ut64 from;
+	ut64 to;
 	RCoreAnalStats *as;
 };
 
@@ -4383,6 +4384,21 @@ static bool block_flags_stat(RFlagItem *fi, void *user) {
 	return true;
 }
 
+static bool block_meta_stat(RIntervalNode *node, void *user) {
+	struct block_flags_stat_t *u = (struct block_flags_stat_t *)user;
+	if (node->start < u->from || node->end > u->to) {
+		return true;
+	}
+	RAnalMetaItem *mi = node->data;
+	int piece = (node->start - u->from) / u->step;
+	if (mi->type == R_META_TYPE_STRING) {
+		u->as->block[piece].strings++;
+	} else {
+		u->as->block[piece].comments++;
+	}
+	return true;
+}
+
 /* core analysis stats */
 /* stats --- colorful bar */
 R_API RCoreAnalStats* r_core_anal_get_stats(RCore *core, ut64 from, ut64 to, ut64 step) {
@@ -4419,7 +4435,7 @@ R_API RCoreAnalStats* r_core_anal_get_stats(RCore *core, ut64 from, ut64 to, ut6
 		as->block[piece].perm = map ? map->perm: (core->io->desc ? core->io->desc->perm: 0);
 	}
 	// iter all flags
-	struct block_flags_stat_t u = { .step = step, .from = from, .as = as };
+	struct block_flags_stat_t u = { .step = step, .from = from, .to = to, .as = as };
 	r_flag_foreach_range (core->flags, from, to + 1, block_flags_stat, &u);
 	// iter all functions
 	r_list_foreach (core->anal->fcns, iter, F) {
@@ -4449,28 +4465,10 @@ R_API RCoreAnalStats* r_core_anal_get_stats(RCore *core, ut64 from, ut64 to, ut6
 		piece = (S->vaddr - from) / step;
 		as->block[piece].symbols++;
 	}
-	RPVector *metas = to > from ? r_meta_get_all_intersect (core->anal, from, to - from, R_META_TYPE_ANY) : NULL;
-	if (metas) {
-		void **it;
-		r_pvector_foreach (metas, it) {
-			RIntervalNode *node = *it;
-			RAnalMetaItem *mi = node->data;
-			if (node->start < from || node->end > to) {
-				continue;
-			}
-			piece = (node->start - from) / step;
-			switch (mi->type) {
-			case R_META_TYPE_STRING:
-				as->block[piece].strings++;
-				break;
-			case R_META_TYPE_COMMENT:
-				as->block[piece].comments++;
-				break;
-			default:
-				break;
-			}
-		}
-		r_pvector_free (metas);
+	// iter strings and comments only
+	if (to > from) {
+		r_meta_foreach_intersect (core->anal, from, to - from, R_META_TYPE_STRING, block_meta_stat, &u);
+		r_meta_foreach_intersect (core->anal, from, to - from, R_META_TYPE_COMMENT, block_meta_stat, &u);
 	}
 	return as;
 }
@@ -1075,6 +1075,97 @@ static void file_lines_free_kv(HtPPKv *kv) {
 	file_lines_free (kv->value);
 }
 
+/**
+ * @brief Loads the debug info of the units covering the given addresses
+ *
+ * Only does something when bin.dbginfo.lazy deferred the parsing of the
+ * DWARF information, units are processed once.
+ *
+ * @return int number of units loaded
+ */
+R_API int r_core_bin_dwarf_load(RCore *core, const ut64 *addrs, size_t count) {
+	r_return_val_if_fail (core && (addrs || !count), 0);
+	RBinFile *binfile = r_bin_cur (core->bin);
+	RBinDwarfIndex *idx = binfile? binfile->dwarf_index: NULL;
+	if (!idx) {
+		return 0;
+	}
+	RVector units;
+	r_vector_init (&units, sizeof (ut64), NULL, NULL);
+	size_t i;
+	for (i = 0; i < count; i++) {
+		ut64 unit = r_bin_dwarf_index_unit_at (idx, addrs[i]);
+		if (unit != UT64_MAX && !ht_up_find (idx->loaded, unit, NULL)) {
+			ht_up_insert (idx->loaded, unit, (void *)(size_t)1);
+			r_vector_push (&units, &unit);
+		}
+	}
+	int n = r_vector_len (&units);
+	if (n > 0) {
+		RBinDwarfDebugAbbrev *da = r_bin_dwarf_parse_abbrev (core->bin, R_MODE_SET);
+		RBinDwarfDebugInfo *info = da? r_bin_dwarf_parse_units (da, core->bin, units.a, n): NULL;
+		if (info) {
+			HtUP *loc_table = r_bin_dwarf_parse_loc (core->bin, core->anal->config->bits / 8);
+			RAnalDwarfContext ctx = {
+				.info = info,
+				.loc = loc_table
+			};
+			r_anal_dwarf_process_info (core->anal, &ctx);
+			if (loc_table) {
+				r_bin_dwarf_free_loc (loc_table);
+			}
+			r_bin_dwarf_free_debug_info (info);
+		}
+		r_bin_dwarf_free_debug_abbrev (da);
+	}
+	r_vector_fini (&units);
+	return n;
+}
+
+/**
+ * @brief Applies the debug info to the function at addr, or to all of them
+ *
+ * Loads the units covering the functions the first time they are analyzed
+ * or shown, each function gets the DWARF names and variables only once.
+ *
+ * @param addr address of the function, UT64_MAX for every function
+ */
+R_API void r_core_bin_dwarf_apply(RCore *core, ut64 addr) {
+	r_return_if_fail (core);
+	RBinFile *binfile = r_bin_cur (core->bin);
+	RBinDwarfIndex *idx = binfile? binfile->dwarf_index: NULL;
+	if (!idx) {
+		return;
+	}
+	RVector addrs;
+	r_vector_init (&addrs, sizeof (ut64), NULL, NULL);
+	if (addr != UT64_MAX) {
+		if (!ht_up_find (idx->applied, addr, NULL)) {
+			r_vector_push (&addrs, &addr);
+		}
+	} else {
+		RListIter *iter;
+		RAnalFunction *fcn;
+		r_list_foreach (core->anal->fcns, iter, fcn) {
+			if (!ht_up_find (idx->applied, fcn->addr, NULL)) {
+				r_vector_push (&addrs, &fcn->addr);
+			}
+		}
+	}
+	if (!r_vector_empty (&addrs)) {
+		r_core_bin_dwarf_load (core, addrs.a, r_vector_len (&addrs));
+		Sdb *dwarf_sdb = sdb_ns (core->anal->sdb, "dwarf", 0);
+		ut64 *at;
+		r_vector_foreach (&addrs, at) {
+			ht_up_insert (idx->applied, *at, (void *)(size_t)1);
+			if (dwarf_sdb) {
+				r_anal_dwarf_integrate_function (core->anal, core->flags, dwarf_sdb, *at);
+			}
+		}
+	}
+	r_vector_fini (&addrs);
+}
+
 static bool bin_dwarf(RCore *core, PJ *pj, int mode) {
 	RBinDwarfRow *row;
 	RListIter *iter;
@@ -1097,24 +1188,33 @@ static bool bin_dwarf(RCore *core, PJ *pj, int mode) {
 		if (!da) {
 			return false;
 		}
-		RBinDwarfDebugInfo *info = r_bin_dwarf_parse_info (da, core->bin, mode);
-		HtUP /*<offset, List *<LocListEntry>*/ *loc_table = r_bin_dwarf_parse_loc (core->bin, core->anal->config->bits / 8);
-		// I suppose there is no reason the parse it for a printing purposes
-		if (info && mode != R_MODE_PRINT) {
-			/* Should we do this by default? */
-			RAnalDwarfContext ctx = {
-				.info = info,
-				.loc = loc_table
-			};
-			r_anal_dwarf_process_info (core->anal, &ctx);
-		}
-		if (loc_table) {
-			if (mode == R_MODE_PRINT) {
-				r_bin_dwarf_print_loc (loc_table, core->anal->config->bits / 8, r_cons_printf);
+		bool lazy = false;
+		if (IS_MODE_SET (mode) && r_config_get_b (core->config, "bin.dbginfo.lazy")) {
+			// the units are parsed by r_core_bin_dwarf_load when needed
+			r_bin_dwarf_index_free (binfile->dwarf_index);
+			binfile->dwarf_index = r_bin_dwarf_parse_index (core->bin);
+			lazy = binfile->dwarf_index != NULL;
+		}
+		if (!lazy) {
+			RBinDwarfDebugInfo *info = r_bin_dwarf_parse_info (da, core->bin, mode);
+			HtUP /*<offset, List *<LocListEntry>*/ *loc_table = r_bin_dwarf_parse_loc (core->bin, core->anal->config->bits / 8);
+			// I suppose there is no reason the parse it for a printing purposes
+			if (info && mode != R_MODE_PRINT) {
+				/* Should we do this by default? */
+				RAnalDwarfContext ctx = {
+					.info = info,
+					.loc = loc_table
+				};
+				r_anal_dwarf_process_info (core->anal, &ctx);
+			}
+			if (loc_table) {
+				if (mode == R_MODE_PRINT) {
+					r_bin_dwarf_print_loc (loc_table, core->anal->config->bits / 8, r_cons_printf);
+				}
+				r_bin_dwarf_free_loc (loc_table);
 			}
-			r_bin_dwarf_free_loc (loc_table);
+			r_bin_dwarf_free_debug_info (info);
 		}
-		r_bin_dwarf_free_debug_info (info);
 		r_bin_dwarf_parse_aranges (core->bin, mode);
 		list = ownlist = r_bin_dwarf_parse_line (core->bin, mode);
 		r_bin_dwarf_free_debug_abbrev (da);
@@ -1315,12 +1415,19 @@ static int bin_source(RCore *r, PJ *pj, int mode) {
 		}
 		r_list_free (list);
 	}
+	if (binfile->addrlines) {
+		void **it;
+		r_pvector_foreach (&binfile->addrlines->files, it) {
+			r_list_append (final_list, *it);
+		}
+	}
 	r_cons_printf ("[Source file]\n");
 	r_list_uniq_inplace (final_list, srclineVal);
 	r_list_foreach (final_list, iter2, srcline) {
 		r_cons_printf ("%s\n", srcline);
 	}
 	r_list_free (final_list);
+	ls_free (ls);
 	return true;
 }
 
@@ -1762,6 +1869,7 @@ static int bin_relocs(RCore *r, PJ *pj, int mode, int va) {
 		pj_a (pj);
 	} else if (IS_MODE_SET (mode)) {
 		r_flag_space_set (r->flags, R_FLAGS_FS_RELOCS);
+		r_flag_bulk_begin (r->flags);
 	}
 
 	RRBNode *node;
@@ -1868,7 +1976,9 @@ static int bin_relocs(RCore *r, PJ *pj, int mode, int va) {
 		}
 		i++;
 	}
-	if (IS_MODE_JSON (mode)) {
+	if (IS_MODE_SET (mode)) {
+		r_flag_bulk_end (r->flags);
+	} else if (IS_MODE_JSON (mode)) {
 		pj_end (pj);
 	}
 	if (IS_MODE_NORMAL (mode)) {
@@ -2161,7 +2271,8 @@ typedef struct {
 	char *methflag;  // methods flag sym.[class].[method]
 } SymName;
 
-static void snInit(RCore *r, SymName *sn, RBinSymbol *sym, const char *lang) {
+// demname, if not NULL, points to the already demangled name, which is taken
+static void snInit(RCore *r, SymName *sn, RBinSymbol *sym, const char *lang, char **demname) {
 	bool bin_demangle = !!lang;
 	bool keep_lib = r_config_get_b (r->config, "bin.demangle.libs");
 	if (!r || !sym || !sym->name) {
@@ -2195,7 +2306,12 @@ static void snInit(RCore *r, SymName *sn, RBinSymbol *sym, const char *lang) {
 	sn->demname = NULL;
 	sn->demflag = NULL;
 	if (bin_demangle && sym->paddr) {
-		sn->demname = r_bin_demangle (r->bin->cur, lang, sn->name, sym->vaddr, keep_lib);
+		if (demname) {
+			sn->demname = *demname;
+			*demname = NULL;
+		} else {
+			sn->demname = r_bin_demangle (r->bin->cur, lang, sn->name, sym->vaddr, keep_lib);
+		}
 		if (sn->demname) {
 			sn->demflag = construct_symbol_flagname (pfx, sym->libname, sn->demname, -1);
 		}
@@ -2282,6 +2398,47 @@ static void select_flag_space(RCore *core, RBinSymbol *symbol) {
 	}
 }
 
+// returns the demangled names of the symbols in order, as snInit would compute them.
+// with exponly only the exports are demangled, the others are not listed
+static char **batch_demangle_symbols(RCore *r, RList *symbols, const char *lang, bool exponly) {
+	bool keep_lib = r_config_get_b (r->config, "bin.demangle.libs");
+	size_t i = 0, count = r_list_length (symbols);
+	const char **names = R_NEWS0 (const char *, count);
+	ut64 *vaddrs = R_NEWS0 (ut64, count);
+	char **imps = R_NEWS0 (char *, count);
+	char **res = R_NEWS0 (char *, count);
+	RListIter *iter;
+	RBinSymbol *sym;
+	if (names && vaddrs && imps && res) {
+		r_list_foreach (symbols, iter, sym) {
+			vaddrs[i] = sym->vaddr;
+			if (sym->name && sym->paddr && (!exponly || isAnExport (sym))) {
+				if (sym->is_imported) {
+					imps[i] = r_str_newf ("imp.%s", sym->name);
+					names[i] = imps[i];
+				} else {
+					names[i] = sym->name;
+				}
+			}
+			i++;
+		}
+		if (!r_bin_demangle_batch (r->bin->cur, lang, names, vaddrs, res, count, keep_lib)) {
+			R_FREE (res);
+		}
+	} else {
+		R_FREE (res);
+	}
+	if (imps) {
+		for (i = 0; i < count; i++) {
+			free (imps[i]);
+		}
+	}
+	free (imps);
+	free (names);
+	free (vaddrs);
+	return res;
+}
+
 static int bin_symbols(RCore *r, PJ *pj, int mode, ut64 laddr, int va, ut64 at, const char *name, bool exponly, const char *args) {
 	RBinInfo *info = r_bin_get_info (r->bin);
 	RList *entries = r_bin_get_entries (r->bin);
@@ -2336,8 +2493,19 @@ static int bin_symbols(RCore *r, PJ *pj, int mode, ut64 laddr, int va, ut64 at,
 		r_table_set_columnsf (table, "dXXssdss", "nth", "paddr","vaddr","bind", "type", "size", "lib", "name");
 	}
 
+	if (IS_MODE_SET (mode)) {
+		r_flag_bulk_begin (r->flags);
+	}
+	// when listing them all, demangle the names in one batch
+	char **demnames = NULL;
+	size_t nth = 0, nsyms = r_list_length (symbols);
+	if (lang && !name && !printHere && at == UT64_MAX && nsyms > 0 && r->bin->cur) {
+		demnames = batch_demangle_symbols (r, symbols, lang, exponly);
+	}
 	size_t count = 0;
 	r_list_foreach (symbols, iter, symbol) {
+		char **demname = demnames? &demnames[nth]: NULL;
+		nth++;
 		if (!symbol->name) {
 			continue;
 		}
@@ -2358,7 +2526,7 @@ static int bin_symbols(RCore *r, PJ *pj, int mode, ut64 laddr, int va, ut64 at,
 		}
 		SymName sn = {0};
 		count ++;
-		snInit (r, &sn, symbol, lang);
+		snInit (r, &sn, symbol, lang, demname);
 		char *r_symbol_name = r_str_escape_utf8 (sn.name, false, true);
 
 		if (IS_MODE_SET (mode) && (is_section_symbol (symbol) || is_file_symbol (symbol))) {
@@ -2393,7 +2561,7 @@ static int bin_symbols(RCore *r, PJ *pj, int mode, ut64 laddr, int va, ut64 at,
 					}
 				} else {
 					fi = r_flag_set (r->flags, sn.methflag, addr, symbol->size);
-					char *comment = (fi && fi->comment) ? strdup (fi->comment) : NULL;
+					char *comment = (fi && r_flag_item_comment (fi)) ? strdup (r_flag_item_comment (fi)) : NULL;
 					if (comment) {
 						r_flag_item_set_comment (fi, comment);
 						R_FREE (comment);
@@ -2529,6 +2697,15 @@ next:
 			break;
 		}
 	}
+	if (demnames) {
+		for (nth = 0; nth < nsyms; nth++) {
+			free (demnames[nth]);
+		}
+		free (demnames);
+	}
+	if (IS_MODE_SET (mode)) {
+		r_flag_bulk_end (r->flags);
+	}
 	if (IS_MODE_NORMAL (mode)){
 		if (r->table_query) {
 			r_table_query (table, r->table_query);
@@ -2384,6 +2384,14 @@ static bool cb_fps(void *user, void *data) {
 	return true;
 }
 
+static bool cb_scrdamage(void *user, void *data) {
+	RConfigNode *node = (RConfigNode *) data;
+	RCons *cons = r_cons_singleton ();
+	cons->damage = node->i_value;
+	r_cons_frame_reset ();
+	return true;
+}
+
 static bool cb_scrtheme(void* user, void* data) {
 	RCore *core = (RCore*) user;
 	RConfigNode *node = (RConfigNode*) data;
@@ -2852,6 +2860,15 @@ static bool cb_binprefix(void *user, void *data) {
 	return true;
 }
 
+static bool cb_bindbginfothreads(void *user, void *data) {
+	RCore *core = (RCore *) user;
+	RConfigNode *node = (RConfigNode *) data;
+	if (core->bin) {
+		core->bin->dwarf_threads = R_MAX (0, (int)node->i_value);
+	}
+	return true;
+}
+
 static bool cb_binmaxstrbuf(void *user, void *data) {
 	RCore *core = (RCore *) user;
 	RConfigNode *node = (RConfigNode *) data;
@@ -3328,7 +3345,7 @@ R_API int r_core_config_init(RCore *core) {
 	SETI ("pdb.autoload", false, "automatically load the required pdb files for loaded DLLs");
 
 	/* anal */
-	SETBPREF ("anal.onchange", "false", "automatically reanalyze function if any byte has changed (EXPERIMENTAL)");
+	SETBPREF ("anal.onchange", "false", "reanalyze the blocks touched by io writes and the code reachable from them");
 	SETPREF ("anal.fcnprefix", "fcn",  "prefix new function names with this");
 	const char *analcc = r_anal_cc_default (core->anal);
 	SETCB ("anal.cc", analcc? analcc: "", (RConfigCallback)&cb_analcc, "specify default calling convention");
@@ -3355,6 +3372,7 @@ R_API int r_core_config_init(RCore *core) {
 		"anal.fcn", "anal.bb",
 	NULL);
 	SETI ("anal.timeout", 0, "stop analyzing after a couple of seconds");
+	SETBPREF ("anal.cache", "false", "restore the functions and xrefs found by aa/aaa for the same binary and settings from ~/.cache/radare2/anal");
 	SETCB ("anal.jmp.retpoline", "true", &cb_anal_jmpretpoline, "analyze retpolines, may be slower if not needed");
 	SETICB ("anal.jmp.tailcall", 0, &cb_anal_jmptailcall, "consume a branch as a call if delta is big");
 
@@ -3635,6 +3653,8 @@ R_API int r_core_config_init(RCore *core) {
 	SETI ("bin.baddr", -1, "base address of the binary");
 	SETI ("bin.laddr", 0, "base address for loading library ('*.so')");
 	SETCB ("bin.dbginfo", "true", &cb_bindbginfo, "load debug information at startup if available");
+	SETICB ("bin.dbginfo.threads", 0, &cb_bindbginfothreads, "threads parsing the DWARF units (0 = one per cpu when .debug_info is over 512K)");
+	SETBPREF ("bin.dbginfo.lazy", "false", "use .debug_names/.gdb_index to parse the DWARF units of a function when it is analyzed or shown (types and vars of units without an analyzed function are not loaded)");
 	SETBPREF ("bin.relocs", "true", "load relocs information at startup if available");
 	SETICB ("bin.minstr", 0, &cb_binminstr, "minimum string length for r_bin");
 	SETICB ("bin.maxstr", 0, &cb_binmaxstr, "maximum string length for r_bin");
@@ -4065,7 +4085,9 @@ R_API int r_core_config_init(RCore *core) {
 	SETCB ("scr.rows", "0", &cb_scrrows, "force console row count (height) ");
 	SETI ("scr.notch", 0, "force console row count (height) (duplicate?)");
 	SETICB ("scr.rows", 0, &cb_rows, "force console row count (height) (duplicate?)");
-	SETCB ("scr.fps", "false", &cb_fps, "show FPS in Visual");
+	SETCB ("scr.fps", "false", &cb_fps, "show FPS and bytes written per frame in Visual");
+	SETCB ("scr.damage", "false", &cb_scrdamage, "only redraw the rows that changed in Visual and panels");
+	SETBPREF ("scr.dropframes", "false", "skip or abort Visual frames while there are keys waiting to be handled");
 	SETICB ("scr.fix.rows", 0, &cb_fixrows, "Workaround for Linux TTY");
 	SETICB ("scr.fix.columns", 0, &cb_fixcolumns, "workaround for Prompt iOS SSH client");
 	SETCB ("scr.highlight", "", &cb_scrhighlight, "highlight that word at RCons level");
@@ -4148,6 +4170,8 @@ R_API int r_core_config_init(RCore *core) {
 	SETBPREF ("rop.subchains", "false", "display every length gadget from rop.len=X to 2 in /Rl");
 	SETBPREF ("rop.conditional", "false", "include conditional jump, calls and returns in ropsearch");
 	SETBPREF ("rop.comments", "false", "display comments in rop search output");
+	SETBPREF ("rop.cache", "false", "keep the gadgets found by /R in an index on disk, reused while the file and the bytes of the map are the same");
+	SETI ("rop.threads", 0, "threads decoding the maps in /R (0 = one per cpu, only with thread safe anal plugins)");
 
 	/* io */
 	SETCB ("io.cache", "false", &cb_io_cache, "change both of io.cache.{read,write}");
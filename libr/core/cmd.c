@@ -4595,15 +4595,12 @@ static RList *foreach3list(RCore *core, char type, const char *glob) {
 	switch (type) {
 	case 'C':
 		{
-			RIntervalTreeIter it;
-			RAnalMetaItem *meta;
-			r_interval_tree_foreach (&core->anal->meta, it, meta) {
-				if (meta->type != R_META_TYPE_COMMENT) {
-					continue;
-				}
+			RAnalMetaIter it;
+			RIntervalNode *node;
+			r_meta_foreach_type (core->anal, it, node, R_META_TYPE_COMMENT) {
+				RAnalMetaItem *meta = node->data;
 				if (!glob || (meta->str && r_str_glob (meta->str, glob))) {
-					ut64 addr = r_interval_tree_iter_get (&it)->start;
-					append_item (list, NULL, addr, UT64_MAX);
+					append_item (list, NULL, node->start, UT64_MAX);
 				}
 			}
 		}
@@ -1612,6 +1612,9 @@ static int var_cmd(RCore *core, const char *str) {
 	int delta, type = *str, res = true;
 	RAnalVar *v1;
 	RAnalFunction *fcn = r_anal_get_fcn_in (core->anal, core->offset, -1);
+	if (fcn) {
+		r_core_bin_dwarf_apply (core, fcn->addr);
+	}
 	if (!str[0]) {
 		if (fcn) {
 			// "afv"
@@ -4305,6 +4308,7 @@ static int cmd_af(RCore *core, const char *input) {
 				if (fcn) {
 					r_list_free (fcn->imports);
 					fcn->imports = NULL;
+					R_DIRTY (core->anal);
 				}
 			} else if (input[3] == ' ') {
 				RAnalFunction *fcn = r_anal_get_fcn_in (core->anal, core->offset, R_ANAL_FCN_TYPE_NULL);
@@ -4313,6 +4317,7 @@ static int cmd_af(RCore *core, const char *input) {
 						fcn->imports = r_list_newf ((RListFree)free);
 					}
 					r_list_append (fcn->imports, r_str_trim_dup (input + 4));
+					R_DIRTY (core->anal);
 				} else {
 					eprintf ("No function found\n");
 				}
@@ -4439,6 +4444,10 @@ static int cmd_af(RCore *core, const char *input) {
 		case '=': // "afl="
 		case '*': // "afl*"
 		case '.': // "afl*"
+			if (input[2] == 'j' || input[2] == 'l') {
+				// the verbose listings show the variables
+				r_core_bin_dwarf_apply (core, UT64_MAX);
+			}
 			r_core_anal_fcn_list (core, NULL, input + 2);
 			break;
 		case 'c': // "aflc"
@@ -4996,6 +5005,10 @@ static int cmd_af(RCore *core, const char *input) {
 				// disable hasnext
 			}
 			r_core_af (core, addr, name, anal_calls);
+			RAnalFunction *fcn = r_anal_get_function_at (core->anal, addr);
+			if (fcn) {
+				r_core_bin_dwarf_apply (core, fcn->addr);
+			}
 		}
 		break;
 	default:
@@ -10846,12 +10859,10 @@ static void _CbInRangeAav(RCore *core, ut64 from, ut64 to, int vsize, void *user
 }
 
 static void cmd_anal_aaw(RCore *core, const char *input) {
-	RIntervalTreeIter it;
-	RAnalMetaItem *item;
-	r_interval_tree_foreach (&core->anal->meta, it, item) {
-		RIntervalNode *node = r_interval_tree_iter_get (&it);
-		ut64 size = r_meta_item_size (node->start, node->end);
-		if (item->type == R_META_TYPE_DATA && size == core->anal->config->bits / 8) {
+	RAnalMetaIter it;
+	RIntervalNode *node;
+	r_meta_foreach_type (core->anal, it, node, R_META_TYPE_DATA) {
+		if (r_meta_node_size (node) == core->anal->config->bits / 8) {
 			ut8 buf[8] = {0};
 			r_io_read_at (core->io, node->start, buf, 8);
 			ut64 n = r_read_ble (buf, core->print->big_endian, core->anal->config->bits);
@@ -11196,6 +11207,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 		} else {
 			bool didAap = false;
 			char *dh_orig = NULL;
+			const bool use_cache = r_config_get_b (core->config, "anal.cache");
+			const int level = strspn (input, "a");
+			bool cached = false;
 			if (!strncmp (input, "aaaaa", 5)) {
 				eprintf ("An r2 developer is coming to your place to manually analyze this program. Please wait for it\n");
 				if (r_cons_is_interactive ()) {
@@ -11203,19 +11217,27 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				}
 				goto jacuzzi;
 			}
+			// a restored entry replaces the passes finding functions, refs, strings
+			// and vars, the ones computing types and noreturn info still run
+			cached = use_cache && r_core_anal_cache_load (core, level);
 			ut64 curseek = core->offset;
-			oldstr = r_print_rowlog (core->print, "Analyze all flags starting with sym. and entry0 (aa)");
 			r_cons_break_push (NULL, NULL);
 			r_cons_break_timeout (r_config_get_i (core->config, "anal.timeout"));
-			r_core_anal_all (core);
-			r_print_rowlog_done (core->print, oldstr);
-			r_core_task_yield (&core->tasks);
-
-			// Run afvn in all fcns
-			if (r_config_get_b (core->config, "anal.vars")) {
-				oldstr = r_print_rowlog (core->print, "Analyze all functions arguments/locals");
-				r_core_cmd0 (core, "afva@@f");
+			if (cached) {
+				oldstr = r_print_rowlog (core->print, "Restore the analysis from the cache (anal.cache)");
+				r_print_rowlog_done (core->print, oldstr);
+			} else {
+				oldstr = r_print_rowlog (core->print, "Analyze all flags starting with sym. and entry0 (aa)");
+				r_core_anal_all (core);
 				r_print_rowlog_done (core->print, oldstr);
+				r_core_task_yield (&core->tasks);
+
+				// Run afvn in all fcns
+				if (r_config_get_b (core->config, "anal.vars")) {
+					oldstr = r_print_rowlog (core->print, "Analyze all functions arguments/locals");
+					r_core_cmd0 (core, "afva@@f");
+					r_print_rowlog_done (core->print, oldstr);
+				}
 			}
 
 			// Run pending analysis immediately after analysis
@@ -11233,7 +11255,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 			r_cons_clear_line (1);
 			bool cfg_debug = r_config_get_b (core->config, "cfg.debug");
 			if (*input == 'a') { // "aaa" .. which is checked just in the case above
-				if (r_str_startswith (r_config_get (core->config, "bin.lang"), "go")) {
+				if (!cached && r_str_startswith (r_config_get (core->config, "bin.lang"), "go")) {
 					oldstr = r_print_rowlog (core->print, "Find function and symbol names from golang binaries (aang)");
 					r_print_rowlog_done (core->print, oldstr);
 					r_core_anal_autoname_all_golang_fcns (core);
@@ -11255,34 +11277,36 @@ static int cmd_anal_all(RCore *core, const char *input) {
 					goto jacuzzi;
 				}
 
-				oldstr = r_print_rowlog (core->print, "Analyze function calls (aac)");
-				(void)cmd_anal_calls (core, "", false, false); // "aac"
-				r_core_seek (core, curseek, true);
-				// oldstr = r_print_rowlog (core->print, "Analyze data refs as code (LEA)");
-				// (void) cmd_anal_aad (core, NULL); // "aad"
-				r_print_rowlog_done (core->print, oldstr);
-				r_core_task_yield (&core->tasks);
-				if (r_cons_is_breaked ()) {
-					goto jacuzzi;
-				}
-
-				if (is_unknown_file (core)) {
-					oldstr = r_print_rowlog (core->print, "find and analyze function preludes (aap)");
-					(void)r_core_search_preludes (core, false); // "aap"
-					didAap = true;
+				if (!cached) {
+					oldstr = r_print_rowlog (core->print, "Analyze function calls (aac)");
+					(void)cmd_anal_calls (core, "", false, false); // "aac"
+					r_core_seek (core, curseek, true);
+					// oldstr = r_print_rowlog (core->print, "Analyze data refs as code (LEA)");
+					// (void) cmd_anal_aad (core, NULL); // "aad"
 					r_print_rowlog_done (core->print, oldstr);
 					r_core_task_yield (&core->tasks);
 					if (r_cons_is_breaked ()) {
 						goto jacuzzi;
 					}
-				}
 
-				oldstr = r_print_rowlog (core->print, "Analyze len bytes of instructions for references (aar)");
-				(void)r_core_anal_refs (core, ""); // "aar"
-				r_print_rowlog_done (core->print, oldstr);
-				r_core_task_yield (&core->tasks);
-				if (r_cons_is_breaked ()) {
-					goto jacuzzi;
+					if (is_unknown_file (core)) {
+						oldstr = r_print_rowlog (core->print, "find and analyze function preludes (aap)");
+						(void)r_core_search_preludes (core, false); // "aap"
+						didAap = true;
+						r_print_rowlog_done (core->print, oldstr);
+						r_core_task_yield (&core->tasks);
+						if (r_cons_is_breaked ()) {
+							goto jacuzzi;
+						}
+					}
+
+					oldstr = r_print_rowlog (core->print, "Analyze len bytes of instructions for references (aar)");
+					(void)r_core_anal_refs (core, ""); // "aar"
+					r_print_rowlog_done (core->print, oldstr);
+					r_core_task_yield (&core->tasks);
+					if (r_cons_is_breaked ()) {
+						goto jacuzzi;
+					}
 				}
 				if (is_apple_target (core)) {
 					oldstr = r_print_rowlog (core->print, "Check for objc references (aao)");
@@ -11301,14 +11325,14 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				}
 				bool isPreludableArch = core->rasm->config->bits == 64 && r_str_startswith (r_config_get (core->config, "asm.arch"), "arm");
 				
-				if (!didAap && isPreludableArch) {
+				if (!cached && !didAap && isPreludableArch) {
 					didAap = true;
 					oldstr = r_print_rowlog (core->print, "Finding function preludes");
 					(void)r_core_search_preludes (core, false); // "aap"
 					r_print_rowlog_done (core->print, oldstr);
 					r_core_task_yield (&core->tasks);
 				}
-				if (!r_str_startswith (r_config_get (core->config, "asm.arch"), "x86")) {
+				if (!cached && !r_str_startswith (r_config_get (core->config, "asm.arch"), "x86")) {
 					r_core_cmd0 (core, "aav");
 					r_core_task_yield (&core->tasks);
 					if (cfg_debug) {
@@ -11328,7 +11352,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 						goto jacuzzi;
 					}
 				}
-				if (r_config_get_i (core->config, "anal.autoname")) {
+				if (!cached && r_config_get_i (core->config, "anal.autoname")) {
 					oldstr = r_print_rowlog (core->print,
 							"Speculatively constructing a function name "
 							"for fcn.* and sym.func.* functions (aan)");
@@ -11336,7 +11360,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 					r_print_rowlog_done (core->print, oldstr);
 					r_core_task_yield (&core->tasks);
 				}
-				if (core->anal->opt.vars) {
+				if (!cached && core->anal->opt.vars) {
 					RAnalFunction *fcni;
 					RListIter *iter;
 					r_list_foreach (core->anal->fcns, iter, fcni) {
@@ -11360,6 +11384,19 @@ static int cmd_anal_all(RCore *core, const char *input) {
 					r_print_rowlog_done (core->print, oldstr);
 					r_core_task_yield (&core->tasks);
 				}
+				RBinFile *bf = r_bin_cur (core->bin);
+				if (bf && bf->dwarf_index) {
+					// load only the units of the analyzed functions, aaft needs their types
+					RVector addrs;
+					RListIter *it;
+					RAnalFunction *fcn;
+					r_vector_init (&addrs, sizeof (ut64), NULL, NULL);
+					r_list_foreach (core->anal->fcns, it, fcn) {
+						r_vector_push (&addrs, &fcn->addr);
+					}
+					r_core_bin_dwarf_load (core, addrs.a, r_vector_len (&addrs));
+					r_vector_fini (&addrs);
+				}
 				if (cfg_debug) {
 					oldstr = r_print_rowlog (core->print, "Skipping type matching analysis in debugger mode (aaft)");
 					// nothing to do
@@ -11377,6 +11414,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				r_core_task_yield (&core->tasks);
 
 				// apply dwarf function information
+				r_core_bin_dwarf_apply (core, UT64_MAX);
 				Sdb *dwarf_sdb = sdb_ns (core->anal->sdb, "dwarf", 0);
 				if (dwarf_sdb) {
 					oldstr = r_print_rowlog (core->print, "Integrate dwarf function information.");
@@ -11385,7 +11423,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				}
 
 				if (input[1] == 'a') { // "aaaa"
-					if (!didAap) {
+					if (!cached && !didAap) {
 						didAap = true;
 						oldstr = r_print_rowlog (core->print, "Finding function preludes");
 						(void)r_core_search_preludes (core, false); // "aap"
@@ -11410,6 +11448,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 			// XXX this shouldnt be called. flags muts be created wheen the function is registered
 			flag_every_function (core);
 			r_core_anal_propagate_noreturn (core, UT64_MAX);
+			if (use_cache && !cached && !r_cons_is_breaked ()) {
+				r_core_anal_cache_save (core, level);
+			}
 			r_cons_break_pop ();
 			R_FREE (dh_orig);
 		}
@@ -11621,7 +11662,7 @@ static void cmd_avg(RCore *core, const char* input) {
 			} else {
 				RFlagItem *fi = r_anal_global_get (core->anal, core->offset);
 				if (fi) {
-					eprintf ("type %s\n", fi->type);
+					eprintf ("type %s\n", r_flag_item_type (fi));
 				}
 			}
 			free (a);
@@ -5298,9 +5298,8 @@ static int cmd_debug(void *data, const char *input) {
 			} break;
 			case '-': // "dte-"
 				if (!strcmp (input + 3, "*")) {
-					if (core->anal->esil) {
-						sdb_free (core->anal->esil->trace->db);
-						core->anal->esil->trace->db = sdb_new0 ();
+					if (core->anal->esil->trace) {
+						r_anal_esil_trace_clear (core->anal->esil->trace);
 					}
 				} else {
 					eprintf ("TODO: dte- cannot delete specific logs. Use dte-*\n");
@@ -5313,10 +5312,13 @@ static int cmd_debug(void *data, const char *input) {
 			} break;
 			case 'k': // "dtek"
 				if (input[3] == ' ') {
-					char *s = sdb_querys (core->anal->esil->trace->db,
-							NULL, 0, input + 4);
-					r_cons_println (s);
-					free (s);
+					if (core->anal->esil->trace) {
+						Sdb *db = r_anal_esil_trace_sdb (core->anal->esil->trace);
+						char *s = sdb_querys (db, NULL, 0, input + 4);
+						r_cons_println (s);
+						free (s);
+						sdb_free (db);
+					}
 				} else {
 					eprintf ("Usage: dtek [query]\n");
 				}
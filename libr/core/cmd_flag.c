@@ -1296,12 +1296,13 @@ rep:
 			RListIter *iter;
 			RFlagItem *fi;
 			r_list_foreach (list, iter, fi) {
-				if (fi->color) {
+				const char *color = r_flag_item_color (fi);
+				if (color) {
 					if (input[1] && input[2] == '*') {
-						r_cons_printf ("fc %s=%s\n", fi->name, fi->color);
+						r_cons_printf ("fc %s=%s\n", fi->name, color);
 					} else {
 						const char *pad = r_str_pad (' ', 10- strlen (fi->name));
-						r_cons_printf ("0x%08"PFMT64x"  %s%s%s\n", fi->offset, fi->name, pad, fi->color);
+						r_cons_printf ("0x%08"PFMT64x"  %s%s%s\n", fi->offset, fi->name, pad, color);
 					}
 				}
 			}
@@ -1313,17 +1314,16 @@ rep:
 				r_flag_all_list (core->flags, false)
 				: r_flag_get_list (core->flags, addr);
 			r_list_foreach (list, iter, fi) {
-				if (fi->color) {
-					R_FREE (fi->color);
-				}
+				r_flag_item_set_color (fi, NULL);
 			}
 		} else if (input[1] == '*') {
 			RListIter *iter;
 			RFlagItem *fi;
 			const RList *list = r_flag_all_list (core->flags, false);
 			r_list_foreach (list, iter, fi) {
-				if (fi->color) {
-					r_cons_printf ("fc %s=%s\n", fi->name, fi->color);
+				const char *color = r_flag_item_color (fi);
+				if (color) {
+					r_cons_printf ("fc %s=%s\n", fi->name, color);
 				}
 			}
 		} else if (input[1] == ' ') {
@@ -1385,8 +1385,9 @@ rep:
 				}
 			} else {
 				item = r_flag_get_i (core->flags, r_num_math (core->num, p));
-				if (item && item->comment) {
-					r_cons_println (item->comment);
+				const char *comment = item? r_flag_item_comment (item): NULL;
+				if (comment) {
+					r_cons_println (comment);
 				} else {
 					eprintf ("Cannot find item\n");
 				}
@@ -68,6 +68,8 @@ static const char *help_msg_id[] = {
 	"idpi", " [file.pdb]", "show pdb file information",
 	"idpi*", "", "show symbols from pdb as flags (prefix with dot to import)",
 	"idpd", "", "download pdb file on remote server",
+	"idn", " [name]", "show the DWARF units defining a name (bin.dbginfo.lazy)",
+	"idu", " [addr]", "load the DWARF unit covering the address (bin.dbginfo.lazy)",
 	NULL
 };
 
@@ -132,6 +134,26 @@ static bool demangle(RCore *core, const char *s) {
 	return true;
 }
 
+static void cmd_info_dwarf_name(RCore *core, const char *name) {
+	RBinFile *bf = r_bin_cur (core->bin);
+	RBinDwarfIndex *idx = bf? bf->dwarf_index: NULL;
+	if (!idx) {
+		eprintf ("No DWARF index loaded, see bin.dbginfo.lazy\n");
+		return;
+	}
+	const RVector *entries = r_bin_dwarf_index_find (idx, name);
+	if (entries) {
+		RBinDwarfNameEntry *e;
+		r_vector_foreach (entries, e) {
+			if (e->die != UT64_MAX) {
+				r_cons_printf ("unit 0x%08"PFMT64x" die 0x%08"PFMT64x" tag 0x%"PFMT64x"\n", e->unit, e->die, e->tag);
+			} else {
+				r_cons_printf ("unit 0x%08"PFMT64x" tag 0x%"PFMT64x"\n", e->unit, e->tag);
+			}
+		}
+	}
+}
+
 static void cmd_info_here(RCore *core, PJ *pj, int mode) {
 	RCoreItem *item = r_core_item_at (core, core->offset);
 	// fixme: other modes
@@ -991,6 +1013,13 @@ static int cmd_info(void *data, const char *input) {
 			} else if (input[1] == '?') { // "id?"
 				r_core_cmd_help (core, help_msg_id);
 				input++;
+			} else if (input[1] == 'n') { // "idn"
+				cmd_info_dwarf_name (core, r_str_trim_head_ro (input + 2));
+				goto done;
+			} else if (input[1] == 'u') { // "idu"
+				ut64 addr = input[2]? r_num_math (core->num, input + 2): core->offset;
+				r_cons_printf ("%d\n", r_core_bin_dwarf_load (core, &addr, 1));
+				goto done;
 			} else { // "id"
 				RBININFO ("dwarf", R_CORE_BIN_ACC_DWARF, NULL, -1);
 			}
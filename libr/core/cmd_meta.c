@@ -14,6 +14,7 @@ static R_TH_LOCAL ut64 filter_offset = UT64_MAX;
 static R_TH_LOCAL int filter_format = 0;
 static R_TH_LOCAL size_t filter_count = 0;
 static R_TH_LOCAL Sdb *fscache = NULL;
+static R_TH_LOCAL RBinAddrLineTable *filter_table = NULL; // listed before the sdb entries
 
 static const char *help_msg_C[] = {
 	"Usage:", "C[-LCvsdfm*?][*?] [...]", " # Metadata management",
@@ -160,6 +161,9 @@ static int remove_meta_offset(RCore *core, ut64 offset) {
 		eprintf ("Failed to convert %"PFMT64x" to a key", offset);
 		return -1;
 	}
+	if (core->bin->cur->addrlines) {
+		r_bin_addrline_del (core->bin->cur->addrlines, offset);
+	}
 	return sdb_unset (core->bin->cur->sdb_addrinfo, aoffsetptr, 0);
 }
 
@@ -225,6 +229,9 @@ static bool print_addrinfo_json(void *user, const char *k, const char *v) {
 	if (!offset || offset == UT64_MAX) {
 		return true;
 	}
+	if (filter_table && r_bin_addrline_get (filter_table, offset)) {
+		return true;
+	}
 	char *subst = strdup (v);
 	char *colonpos = strchr (subst, '|'); // XXX keep only : for simplicity?
 	if (!colonpos) {
@@ -279,6 +286,9 @@ static bool print_addrinfo(void *user, const char *k, const char *v) {
 	if (!offset || offset == UT64_MAX) {
 		return true;
 	}
+	if (filter_table && r_bin_addrline_get (filter_table, offset)) {
+		return true;
+	}
 	char *subst = strdup (v);
 	char *colonpos = strchr (subst, '|'); // XXX keep only : for simplicity?
 	if (!colonpos) {
@@ -302,6 +312,46 @@ static bool print_addrinfo(void *user, const char *k, const char *v) {
 	return true;
 }
 
+static bool print_addrline(void *user, const RBinAddrLine *row, const char *file) {
+	char key[32];
+	snprintf (key, sizeof (key), "0x%"PFMT64x, row->addr);
+	char *v = r_str_newf ("%s|%u", file, row->line);
+	bool ret = user? print_addrinfo_json (user, key, v): print_addrinfo (NULL, key, v);
+	free (v);
+	return ret;
+}
+
+static void foreach_addrline(RBinFile *bf, void *user) {
+	if (!bf || !bf->addrlines) {
+		return;
+	}
+	if (filter_offset != UT64_MAX) {
+		const RBinAddrLine *row = r_bin_addrline_get (bf->addrlines, filter_offset);
+		if (row) {
+			print_addrline (user, row, r_bin_addrline_file (bf->addrlines, row));
+		}
+		return;
+	}
+	r_bin_addrline_foreach (bf->addrlines, print_addrline, user);
+}
+
+// file:line entries go to the line table, so they are listed and found only once
+static bool cmd_meta_add_addrline(RBinAddrLineTable *t, const char *fileline, ut64 offset) {
+	const char *sep = strrchr (fileline, '|');
+	if (!sep) {
+		sep = strrchr (fileline, ':');
+	}
+	if (!sep || sep == fileline || !IS_DIGIT (sep[1])) {
+		return false;
+	}
+	char *file = r_str_ndup (fileline, sep - fileline);
+	// the new entry replaces the rows loaded from the debug info
+	r_bin_addrline_del (t, offset);
+	bool ret = file && r_bin_addrline_add (t, offset, file, atoi (sep + 1), 0);
+	free (file);
+	return ret;
+}
+
 static int cmd_meta_add_fileline(Sdb *s, char *fileline, ut64 offset) {
 	char aoffset[64];
 	char *aoffsetptr = sdb_itoa (offset, aoffset, 16);
@@ -361,8 +411,15 @@ static int cmd_meta_lineinfo(RCore *core, const char *input) {
 	if (all) {
 		if (remove) {
 			sdb_reset (core->bin->cur->sdb_addrinfo);
+			if (core->bin->cur->addrlines) {
+				r_bin_addrline_reset (core->bin->cur->addrlines);
+			}
 		} else {
+			filter_offset = UT64_MAX;
+			foreach_addrline (core->bin->cur, NULL);
+			filter_table = core->bin->cur->addrlines;
 			sdb_foreach (core->bin->cur->sdb_addrinfo, print_addrinfo, NULL);
+			filter_table = NULL;
 		}
 		return 0;
 	}
@@ -389,7 +446,9 @@ static int cmd_meta_lineinfo(RCore *core, const char *input) {
 		}
 		RBinFile *bf = r_bin_cur (core->bin);
 		ret = 0;
-		if (bf && bf->sdb_addrinfo) {
+		if (bf && bf->addrlines && cmd_meta_add_addrline (bf->addrlines, sp, offset)) {
+			ret = 0;
+		} else if (bf && bf->sdb_addrinfo) {
 			ret = cmd_meta_add_fileline (bf->sdb_addrinfo, sp, offset);
 		} else {
 			eprintf ("TODO: Support global SdbAddrinfo or dummy rbinfile to handlee this case\n");
@@ -411,14 +470,19 @@ static int cmd_meta_lineinfo(RCore *core, const char *input) {
 		if (use_json) {
 			pj = r_core_pj_new (core);
 			pj_a (pj);
+			foreach_addrline (core->bin->cur, pj);
 			if (core->bin->cur && core->bin->cur->sdb_addrinfo) {
+				filter_table = core->bin->cur->addrlines;
 				sdb_foreach (core->bin->cur->sdb_addrinfo, print_addrinfo_json, pj);
 			}
 		} else {
+			foreach_addrline (core->bin->cur, NULL);
 			if (core->bin->cur && core->bin->cur->sdb_addrinfo) {
+				filter_table = core->bin->cur->addrlines;
 				sdb_foreach (core->bin->cur->sdb_addrinfo, print_addrinfo, NULL);
 			}
 		}
+		filter_table = NULL;
 		if (filter_count == 0) {
 			print_meta_offset (core, offset, pj);
 		}
@@ -8,6 +8,7 @@
 #include <limits.h>
 
 #define R_CORE_MAX_DISASM (1024 * 1024 * 8)
+#define ENTROPY_BATCH_SIZE (64 * 1024 * 1024)
 #define PF_USAGE_STR "pf[.k[.f[=v]]|[v]]|[n]|[0|cnt][fmt] [a0 a1 ...]"
 
 static int printzoomcallback(void *user, int mode, ut64 addr, ut8 *bufz, ut64 size);
@@ -1079,10 +1080,8 @@ static void cmd_print_eq_dict(RCore *core, const ut8 *block, int bsz) {
 	int max = 0;
 	int dict = 0;
 	int range = 0;
-	bool histogram[256] = {0};
-	for (i = 0; i < bsz; i++) {
-		histogram[block[i]] = true;
-	}
+	ut64 histogram[256];
+	r_hash_histogram (block, bsz, histogram);
 	for (i = 0; i < 256; i++) {
 		if (histogram[i]) {
 			if (min == -1) {
@@ -1979,7 +1978,7 @@ static void annotated_hexdump(RCore *core, const char *str, int len) {
 							free (flagname);
 							flagname = fnear->name;
 						}
-						if (fnear->color) {
+						if (r_flag_item_color (fnear)) {
 							curflag = fnear;
 						}
 						if (!curflag) {
@@ -1991,16 +1990,16 @@ static void annotated_hexdump(RCore *core, const char *str, int len) {
 			} else {
 				r_list_foreach (list, iter, fi) {
 					flagsize = R_MAX (flagsize, fi->size);
-					if (fi->color) {
+					if (r_flag_item_color (fi)) {
 						curflag = fi;
 					}
-					if (!flagaddr || fi->color) {
+					if (!flagaddr || r_flag_item_color (fi)) {
 						flagaddr = fi->offset;
 						if (fi->offset == at) {
 							free (flagname);
 							flagname = strdup (fi->name);
 						}
-						if (!fi->color) {
+						if (!r_flag_item_color (fi)) {
 							curflag = fi;
 						}
 					}
@@ -2064,8 +2063,8 @@ static void annotated_hexdump(RCore *core, const char *str, int len) {
 					}
 				} else if (!hascolor) {
 					hascolor = true;
-					if (curflag && curflag->color) {
-						char *ansicolor = r_cons_pal_parse (curflag->color, NULL);
+					if (curflag && r_flag_item_color (curflag)) {
+						char *ansicolor = r_cons_pal_parse (r_flag_item_color (curflag), NULL);
 						if (ansicolor) {
 							append (ebytes, ansicolor);
 							append (echars, ansicolor);
@@ -2332,9 +2331,29 @@ static bool count_pzf(RFlagItem *fi, void *u) {
 	return true;
 }
 
+// number of bytes of the class counted by the p= and pz modes
+static ut64 histogram_count(const ut64 *count, int mode) {
+	ut64 n = 0;
+	int i;
+	switch (mode) {
+	case '0':
+		return count[0];
+	case 'f':
+	case 'F':
+		return count[0xff];
+	case 'p':
+		for (i = ' '; i <= '~'; i++) {
+			n += count[i];
+		}
+		break;
+	}
+	return n;
+}
+
 static int printzoomcallback(void *user, int mode, ut64 addr, ut8 *bufz, ut64 size) {
 	RCore *core = (RCore *) user;
-	int j, ret = 0;
+	ut64 histogram[256];
+	int ret = 0;
 	struct count_pz_t u;
 
 	switch (mode) {
@@ -2368,11 +2387,10 @@ static int printzoomcallback(void *user, int mode, ut64 addr, ut8 *bufz, ut64 si
 		}
 		break;
 	case '0': // "pz0"
-		for (j = 0; j < size; j++) {
-			if (bufz[j] == 0) {
-				ret++;
-			}
-		}
+	case 'F': // "pzF"
+	case 'p': // "pzp"
+		r_hash_histogram (bufz, size, histogram);
+		ret = histogram_count (histogram, mode);
 		break;
 	case 'e': // "pze"
 		ret = (ut8) (r_hash_entropy_fraction (bufz, size) * 255);
@@ -2382,20 +2400,6 @@ static int printzoomcallback(void *user, int mode, ut64 addr, ut8 *bufz, ut64 si
 		u.ret = &ret;
 		r_flag_foreach (core->flags, count_pzf, &u);
 		break;
-	case 'F': // "pzF"
-		for (j = 0; j < size; j++) {
-			if (bufz[j] == 0xff) {
-				ret++;
-			}
-		}
-		break;
-	case 'p': // "pzp"
-		for (j = 0; j < size; j++) {
-			if (IS_PRINTABLE (bufz[j])) {
-				ret++;
-			}
-		}
-		break;
 	case 's': // "pzs"
 		u.flagspace = r_flag_space_get (core->flags, R_FLAGS_FS_STRINGS);
 		u.addr = addr;
@@ -3770,6 +3774,32 @@ static ut8 *analBars(RCore *core, size_t type, size_t nblocks, size_t blocksize,
 	return ptr;
 }
 
+// read the blocks in batches and compute their entropy in parallel
+static ut8 *entropy_bars(RCore *core, ut64 from, int nblocks, ut64 blocksize) {
+	size_t batch = R_MAX (1, R_MIN ((ut64)nblocks, ENTROPY_BATCH_SIZE / blocksize));
+	ut8 *bars = calloc (1, nblocks);
+	ut8 *buf = malloc (batch * blocksize);
+	double *e = R_NEWS (double, batch);
+	if (!bars || !buf || !e) {
+		free (bars);
+		free (buf);
+		free (e);
+		return NULL;
+	}
+	size_t i, k, n;
+	for (i = 0; i < nblocks; i += n) {
+		n = R_MIN (batch, nblocks - i);
+		r_io_read_at (core->io, from + blocksize * i, buf, n * blocksize);
+		r_hash_entropy_fraction_blocks (buf, blocksize, n, e);
+		for (k = 0; k < n; k++) {
+			bars[i + k] = (ut8) (255 * e[k]);
+		}
+	}
+	free (buf);
+	free (e);
+	return bars;
+}
+
 static void cmd_print_bars(RCore *core, const char *input) {
 	bool print_bars = false;
 	ut8 *ptr = NULL;
@@ -3909,6 +3939,12 @@ static void cmd_print_bars(RCore *core, const char *input) {
 				} else for (i = 0; i < nblocks; i++) {
 					ut64 off = from + blocksize * (i + skipblocks);
 					r_io_read_at (core->io, off, p, blocksize);
+					if (submode == '0' || submode == 'f' || submode == 'F' || submode == 'p') {
+						ut64 histogram[256];
+						r_hash_histogram (p, blocksize, histogram);
+						ptr[i] = 256 * histogram_count (histogram, submode) / blocksize;
+						continue;
+					}
 					for (j = k = 0; j < blocksize; j++) {
 						switch (submode) {
 						case 'a':
@@ -3920,16 +3956,6 @@ static void cmd_print_bars(RCore *core, const char *input) {
 								}
 							}
 							break;
-						case '0':
-							if (!p[j]) {
-								k++;
-							}
-							break;
-						case 'f':
-							if (p[j] == 0xff) {
-								k++;
-							}
-							break;
 						case 'z':
 							if ((IS_PRINTABLE (p[j]))) {
 								if ((j + 1) < blocksize && p[j + 1] == 0) {
@@ -3943,11 +3969,6 @@ static void cmd_print_bars(RCore *core, const char *input) {
 								len = 0;
 							}
 							break;
-						case 'p':
-							if ((IS_PRINTABLE (p[j]))) {
-								k++;
-							}
-							break;
 						}
 					}
 					ptr[i] = 256 * k / blocksize;
@@ -3957,28 +3978,12 @@ static void cmd_print_bars(RCore *core, const char *input) {
 			}
 			break;
 		case 'e': // "p=e"
-		{
-			ut8 *p;
-			int i = 0;
-			ptr = calloc (1, nblocks);
+			ptr = entropy_bars (core, from + blocksize * skipblocks, nblocks, blocksize);
 			if (!ptr) {
 				eprintf ("Error: failed to malloc memory");
 				goto beach;
 			}
-			p = malloc (blocksize);
-			if (!p) {
-				R_FREE (ptr);
-				eprintf ("Error: failed to malloc memory");
-				goto beach;
-			}
-			for (i = 0; i < nblocks; i++) {
-				ut64 off = from + (blocksize * (i + skipblocks));
-				r_io_read_at (core->io, off, p, blocksize);
-				ptr[i] = (ut8) (255 * r_hash_entropy_fraction (p, blocksize));
-			}
-			free (p);
 			r_print_columns (core->print, ptr, nblocks, 14);
-		}
 			break;
 		default:
 			r_print_columns (core->print, core->block, core->blocksize, 14);
@@ -4060,29 +4065,13 @@ static void cmd_print_bars(RCore *core, const char *input) {
 	}
 		break;
 	case 'e': // "p=e" entropy
-	{
-		ut8 *p;
-		int i = 0;
-		ptr = calloc (1, nblocks);
+		ptr = entropy_bars (core, from + blocksize * skipblocks, nblocks, blocksize);
 		if (!ptr) {
 			eprintf ("Error: failed to malloc memory");
 			goto beach;
 		}
-		p = malloc (blocksize);
-		if (!p) {
-			R_FREE (ptr);
-			eprintf ("Error: failed to malloc memory");
-			goto beach;
-		}
-		for (i = 0; i < nblocks; i++) {
-			ut64 off = from + (blocksize * (i + skipblocks));
-			r_io_read_at (core->io, off, p, blocksize);
-			ptr[i] = (ut8) (255 * r_hash_entropy_fraction (p, blocksize));
-		}
-		free (p);
 		print_bars = true;
-	}
-	break;
+		break;
 	case '0': // 0x00 bytes
 	case 'F': // 0xff bytes
 	case 'p': // printable chars
@@ -4105,18 +4094,14 @@ static void cmd_print_bars(RCore *core, const char *input) {
 		for (i = 0; i < nblocks; i++) {
 			ut64 off = from + blocksize * (i + skipblocks);
 			r_io_read_at (core->io, off, p, blocksize);
+			if (mode != 'z') {
+				ut64 histogram[256];
+				r_hash_histogram (p, blocksize, histogram);
+				ptr[i] = 256 * histogram_count (histogram, mode) / blocksize;
+				continue;
+			}
 			for (j = k = 0; j < blocksize; j++) {
 				switch (mode) {
-				case '0':
-					if (!p[j]) {
-						k++;
-					}
-					break;
-				case 'f':
-					if (p[j] == 0xff) {
-						k++;
-					}
-					break;
 				case 'z':
 					if ((IS_PRINTABLE (p[j]))) {
 						if ((j + 1) < blocksize && p[j + 1] == 0) {
@@ -4130,11 +4115,6 @@ static void cmd_print_bars(RCore *core, const char *input) {
 						len = 0;
 					}
 					break;
-				case 'p':
-					if ((IS_PRINTABLE (p[j]))) {
-						k++;
-					}
-					break;
 				}
 			}
 			ptr[i] = 256 * k / blocksize;
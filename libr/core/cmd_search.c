@@ -235,6 +235,8 @@ struct search_parameters {
 	RList *boundaries;
 	const char *mode;
 	const char *cmd_hit;
+	RConfigHandle cfg_prefix; // read for every hit, commands may change them
+	RConfigHandle cfg_cmdhit;
 	PJ *pj;
 	int outmode; // 0 or R_MODE_RADARE or R_MODE_JSON
 	bool inverse;
@@ -1135,139 +1137,247 @@ static bool insert_into(void *user, const ut64 k, const ut64 v) {
 	return true;
 }
 
-// TODO: follow unconditional jumps
-static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int buflen, int idx, const char *grep, int regex, RList *rx_list, struct endlist_pair *end_gadget, HtUU *badstart) {
-	int endaddr = end_gadget->instr_offset;
-	int branch_delay = end_gadget->delay_size;
-	RAnalOp aop = {0};
-	const char *start = NULL, *end = NULL;
-	char *grep_str = NULL;
-	RCoreAsmHit *hit = NULL;
-	RList *hitlist = r_core_asm_hit_list_new ();
-	ut8 nb_instr = 0;
-	const ut8 max_instr = r_config_get_i (core->config, "rop.len");
-	bool valid = false;
-	int grep_find;
-	int search_hit;
-	char *rx = NULL;
-	HtUUOptions opt = {0};
-	HtUU *localbadstart = ht_uu_new_opt (&opt);
-	int count = 0;
+// decoded instructions are memoized per buffer offset during a /R sweep,
+// overlapping gadgets walk the same bytes so each offset is decoded once
+typedef struct {
+	int idx;
+	int size;
+	bool valid;
+	bool badstart; // end gadget or nop, can't start a gadget
+	char *mnemonic;
+} RopCacheOp;
 
-	if (grep) {
-		start = grep;
-		end = strchr (grep, ';');
-		if (!end) { // We filter on a single opcode, so no ";"
-			end = start + strlen (grep);
-		}
-		grep_str = calloc (1, end - start + 1);
-		strncpy (grep_str, start, end - start);
-		if (regex) {
-			// get the first regexp.
-			if (r_list_length (rx_list) > 0) {
-				rx = r_list_get_n (rx_list, count++);
-			}
-		}
+typedef struct {
+	RopCacheOp *ops;
+	int mask;
+	bool caller; // used by the calling thread, which polls for ^C
+} RopCache;
+
+// the range of a map being swept, shared by the threads decoding it
+typedef struct {
+	RCore *core;
+	const ut8 *buf;
+	int delta;
+	ut64 from;
+	int increment;
+	int ropdepth;
+	int max_instr;
+	ut8 crop;
+	RThreadLock *lock; // only set when decoding in threads
+	volatile bool stop;
+} RopSweep;
+
+typedef struct {
+	ut64 addr;
+	RList *hits; // RCoreAsmHit
+	RList *opstrs; // mnemonic of each hit, for the grep
+} RopGadget;
+
+static RopGadget *rop_gadget_new(ut64 addr) {
+	RopGadget *g = R_NEW0 (RopGadget);
+	if (g) {
+		g->addr = addr;
+		g->hits = r_core_asm_hit_list_new ();
+		g->opstrs = r_list_newf (free);
+	}
+	return g;
+}
+
+static void rop_gadget_free(RopGadget *g) {
+	if (g) {
+		r_list_free (g->hits);
+		r_list_free (g->opstrs);
+		free (g);
+	}
+}
+
+static bool rop_stopped(RopSweep *s, RopCache *rc) {
+	// only the calling thread polls for ^C
+	if (rc->caller && r_cons_is_breaked ()) {
+		s->stop = true;
 	}
+	return s->stop;
+}
 
-	bool found;
-	ht_uu_find (badstart, idx, &found);
-	if (found) {
-		valid = false;
-		goto ret;
+static void rop_cache_reset(RopCache *rc) {
+	int i;
+	for (i = 0; i <= rc->mask; i++) {
+		R_FREE (rc->ops[i].mnemonic);
+		rc->ops[i].idx = -1;
+		rc->ops[i].valid = false;
 	}
-	while (nb_instr < max_instr) {
-		ht_uu_insert (localbadstart, idx, 1);
-		int error = r_anal_op (core->anal, &aop, addr, buf + idx, buflen - idx, R_ANAL_OP_MASK_DISASM);
-		if (error < 0 || (nb_instr == 0 && (is_end_gadget (&aop, 0) || aop.type == R_ANAL_OP_TYPE_NOP))) {
-			valid = false;
-			goto ret;
-		}
-		const int opsz = aop.size;
-		// opsz = r_strbuf_length (asmop.buf);
+}
+
+static bool rop_cache_init(RopCache *rc, int window) {
+	int n = 64;
+	while (n < window) {
+		n <<= 1;
+	}
+	rc->ops = R_NEWS0 (RopCacheOp, n);
+	if (!rc->ops) {
+		return false;
+	}
+	rc->mask = n - 1;
+	rc->caller = true;
+	rop_cache_reset (rc);
+	return true;
+}
+
+static void rop_cache_fini(RopCache *rc) {
+	if (rc->ops) {
+		rop_cache_reset (rc);
+		R_FREE (rc->ops);
+	}
+}
+
+// direct-mapped: the sweep only looks ahead up to the next end gadget, so
+// a window slightly larger than the rop depth holds every live offset
+static RopCacheOp *rop_cache_get(RopSweep *s, RopCache *rc, int idx) {
+	RopCacheOp *op = &rc->ops[idx & rc->mask];
+	if (op->idx == idx) {
+		return op->valid? op: NULL;
+	}
+	R_FREE (op->mnemonic);
+	op->idx = idx;
+	op->valid = false;
+	RCore *core = s->core;
+	const ut64 addr = s->from + idx;
+	RAnalOp aop = {0};
+	if (r_anal_op (core->anal, &aop, addr, s->buf + idx, s->delta - idx, R_ANAL_OP_MASK_DISASM) >= 0) {
 		char *opst = aop.mnemonic;
+		aop.mnemonic = NULL;
 		if (!opst) {
-			eprintf ("Missing mnemonic after disasm with '%s'\n", core->anal->cur->name);
+			R_LOG_DEBUG ("Missing mnemonic after disasm with '%s'", core->anal->cur->name);
+			if (s->lock) {
+				r_th_lock_enter (s->lock);
+			}
 			RAsmOp asmop;
 			r_asm_set_pc (core->rasm, addr);
-			if (r_asm_disassemble (core->rasm, &asmop, buf + idx, buflen - idx) < 0) {
-				valid = false;
-				goto ret;
+			if (r_asm_disassemble (core->rasm, &asmop, s->buf + idx, s->delta - idx) >= 0) {
+				opst = strdup (r_asm_op_get_asm (&asmop));
 			}
-			opst = strdup (r_asm_op_get_asm (&asmop));
 			r_asm_op_fini (&asmop);
+			if (s->lock) {
+				r_th_lock_leave (s->lock);
+			}
 		}
-		if (!r_str_ncasecmp (opst, "invalid", strlen ("invalid")) ||
-		    !r_str_ncasecmp (opst, ".byte", strlen (".byte"))) {
-			valid = false;
-			goto ret;
+		if (opst && r_str_ncasecmp (opst, "invalid", strlen ("invalid")) &&
+		    r_str_ncasecmp (opst, ".byte", strlen (".byte"))) {
+			op->size = aop.size;
+			op->badstart = is_end_gadget (&aop, 0) || aop.type == R_ANAL_OP_TYPE_NOP;
+			op->mnemonic = opst;
+			op->valid = true;
+		} else {
+			free (opst);
 		}
+	}
+	r_anal_op_fini (&aop);
+	return op->valid? op: NULL;
+}
 
-		hit = r_core_asm_hit_new ();
-		if (hit) {
-			hit->addr = addr;
-			hit->len = opsz;
-			r_list_append (hitlist, hit);
+// TODO: follow unconditional jumps
+static RopGadget *construct_rop_gadget(RopSweep *s, RopCache *rc, int idx, const struct endlist_pair *end_gadget, HtUU *badstart) {
+	const int endaddr = end_gadget->instr_offset;
+	const int branch_delay = end_gadget->delay_size;
+	ut64 addr = s->from + idx;
+	int nb_instr = 0;
+	bool valid = false;
+	bool found;
+
+	ht_uu_find (badstart, idx, &found);
+	if (found) {
+		return NULL;
+	}
+	RopGadget *g = rop_gadget_new (addr);
+	if (!g) {
+		return NULL;
+	}
+	HtUUOptions opt = {0};
+	HtUU *localbadstart = ht_uu_new_opt (&opt);
+	while (nb_instr < s->max_instr) {
+		ht_uu_insert (localbadstart, idx, 1);
+		RopCacheOp *op = rop_cache_get (s, rc, idx);
+		if (!op || (nb_instr == 0 && op->badstart)) {
+			break;
 		}
+		const int opsz = op->size;
+		RCoreAsmHit *hit = r_core_asm_hit_new ();
+		if (!hit) {
+			break;
+		}
+		hit->addr = addr;
+		hit->len = opsz;
+		r_list_append (g->hits, hit);
+		r_list_append (g->opstrs, strdup (op->mnemonic));
 
 		// Move on to the next instruction
 		idx += opsz;
 		addr += opsz;
-		if (rx) {
-			grep_find = !r_regex_match (rx, "e", opst);
-			search_hit = (end && grep && (grep_find < 1));
-		} else {
-			search_hit = (end && grep && strstr (opst, grep_str));
-		}
-
-		// Handle (possible) grep
-		if (search_hit) {
-			if (end[0] == ';') { // fields are semicolon-separated
-				start = end + 1; // skip the ;
-				end = strchr (start, ';');
-				end = end? end: start + strlen (start); // latest field?
-				free (grep_str);
-				grep_str = calloc (1, end - start + 1);
-				if (grep_str) {
-					strncpy (grep_str, start, end - start);
-				}
-			} else {
-				end = NULL;
-			}
-			if (regex) {
-				rx = r_list_get_n (rx_list, count++);
-			}
-		}
 		if (endaddr <= (idx - opsz)) {
 			valid = (endaddr == idx - opsz);
-			goto ret;
+			break;
 		}
-		free (opst);
-		aop.mnemonic = NULL;
-		r_strbuf_fini (&aop.esil);
 		nb_instr++;
 	}
-ret:
-	r_anal_op_fini (&aop);
-	free (grep_str);
-	if (regex && rx) {
-		r_list_free (hitlist);
-		ht_uu_free (localbadstart);
-		return NULL;
+	if (valid) {
+		ht_uu_foreach (localbadstart, insert_into, badstart);
+		// If our arch has bds then we better be including them
+		valid = !branch_delay || r_list_length (g->hits) >= (1 + branch_delay);
 	}
-	if (!valid || (grep && end)) {
-		r_list_free (hitlist);
-		ht_uu_free (localbadstart);
-		return NULL;
-	}
-	ht_uu_foreach (localbadstart, insert_into, badstart);
 	ht_uu_free (localbadstart);
-	// If our arch has bds then we better be including them
-	if (branch_delay && r_list_length (hitlist) < (1 + branch_delay)) {
-		r_list_free (hitlist);
+	if (!valid) {
+		rop_gadget_free (g);
 		return NULL;
 	}
-	return hitlist;
+	return g;
+}
+
+// grep fields are separated by ';' and must match the instructions in order,
+// a gadget matching a grep implies the longer gadgets containing it match too
+static bool rop_gadget_match(RopGadget *g, const char *grep, int regex, RList *rx_list) {
+	if (!grep) {
+		return true;
+	}
+	const char *start = grep;
+	const char *end = strchr (grep, ';');
+	if (!end) { // We filter on a single opcode, so no ";"
+		end = start + strlen (grep);
+	}
+	char *grep_str = r_str_ndup (start, end - start);
+	const char *rx = NULL;
+	int count = 0;
+	if (regex) {
+		// get the first regexp.
+		rx = r_list_get_n (rx_list, count++);
+	}
+	RListIter *iter;
+	const char *opst;
+	r_list_foreach (g->opstrs, iter, opst) {
+		bool search_hit;
+		if (rx) {
+			int grep_find = !r_regex_match (rx, "e", opst);
+			search_hit = end && grep_find < 1;
+		} else {
+			search_hit = end && grep_str && strstr (opst, grep_str);
+		}
+		if (!search_hit) {
+			continue;
+		}
+		if (end[0] == ';') { // fields are semicolon-separated
+			start = end + 1; // skip the ;
+			end = strchr (start, ';');
+			end = end? end: start + strlen (start); // latest field?
+			free (grep_str);
+			grep_str = r_str_ndup (start, end - start);
+		} else {
+			end = NULL;
+		}
+		if (regex) {
+			rx = r_list_get_n (rx_list, count++);
+		}
+	}
+	free (grep_str);
+	return !(regex && rx) && !end;
 }
 
 static void print_rop(RCore *core, RList *hitlist, PJ *pj, int mode) {
@@ -1430,24 +1540,601 @@ static void print_rop(RCore *core, RList *hitlist, PJ *pj, int mode) {
 	r_list_free (ropList);
 }
 
+#define ROP_CHUNK 0x10000
+#define ROP_THREADS_MAX 16
+#define ROP_INDEX_DIR R_JOIN_2_PATHS (R2_HOME_CACHEDIR, "rop")
+
+typedef bool (*RopGadgetCb)(RopGadget *g, void *user);
+typedef bool (*RopJob)(RopSweep *s, RopCache *rc, size_t idx, void *user);
+
+typedef struct {
+	RopSweep *s;
+	RopCache rc;
+	RopJob job;
+	void *user;
+	size_t njobs;
+	int nthreads;
+	int tid;
+} RopWorker;
+
+// what /R prints, gadgets are filtered after they are built so the ones
+// kept in the index can answer any later grep
+typedef struct {
+	RCore *core;
+	PJ *pj;
+	int mode;
+	bool subchain;
+	int align;
+	const char *grep;
+	int regexp;
+	RList *rx_list;
+	Sdb *gadget_sdb;
+	int max_count;
+	bool done;
+	RList *found; // every gadget of the swept range when building the index
+} RopQuery;
+
+// end gadgets in [start, end) of the range, in order
+static bool rop_find_ends(RopSweep *s, RopCache *rc, int start, int end, RVector *ends) {
+	RAnal *anal = s->core->anal;
+	int i;
+	for (i = start; i < end; i += s->increment) {
+		RAnalOp end_gadget = {0};
+		// Disassemble one.
+		if (r_anal_op (anal, &end_gadget, s->from + i, s->buf + i,
+			    s->delta - i, R_ANAL_OP_MASK_BASIC) < 1) {
+			r_anal_op_fini (&end_gadget);
+			continue;
+		}
+		if (is_end_gadget (&end_gadget, s->crop)) {
+			struct endlist_pair epair = {
+				// If this arch has branch delay slots, add the next instr as well
+				.instr_offset = end_gadget.delay? i + s->increment: i,
+				.delay_size = end_gadget.delay
+			};
+			r_vector_push (ends, &epair);
+		}
+		r_anal_op_fini (&end_gadget);
+		if (rop_stopped (s, rc)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// constructs the gadgets before each of the given end gadgets, cb takes
+// ownership of them and returns false to stop. returns true when done
+static bool rop_build(RopSweep *s, RopCache *rc, const struct endlist_pair *ends, size_t count, RopGadgetCb cb, void *user) {
+	const int max_inst_size_x86 = 15;
+	const int increment = s->increment;
+	if (!count) {
+		return true;
+	}
+	HtUUOptions opt = {0};
+	HtUU *badstart = ht_uu_new_opt (&opt);
+	int next = ends[0].instr_offset;
+	int prev = 0;
+	size_t k = 0;
+	bool ret = true;
+	int i;
+	// Start at just before the first end gadget.
+	for (i = next - s->ropdepth; i < (s->delta - max_inst_size_x86); i += increment) {
+		if (increment == 1) {
+			// give in-boundary instructions a shot
+			if (i < prev - max_inst_size_x86) {
+				i = prev - max_inst_size_x86;
+			}
+		} else {
+			if (i < prev) {
+				i = prev;
+			}
+		}
+		if (i < 0) {
+			i = 0;
+		}
+		if (rop_stopped (s, rc)) {
+			ret = false;
+			break;
+		}
+		if (i >= next) {
+			// We've exhausted the first end-gadget section,
+			// move to the next one.
+			if (++k >= count) {
+				break;
+			}
+			prev = i;
+			next = ends[k].instr_offset;
+			i = next - s->ropdepth;
+			if (i < 0) {
+				i = 0;
+			}
+		}
+		if (rop_cache_get (s, rc, i)) {
+			RopGadget *g = construct_rop_gadget (s, rc, i, &ends[k], badstart);
+			if (!g) {
+				continue;
+			}
+			if (!cb (g, user)) {
+				ret = false;
+				break;
+			}
+		}
+		if (increment != 1) {
+			i = next;
+		}
+	}
+	ht_uu_free (badstart);
+	return ret;
+}
+
+// anal and asm plugins that keep no decoder state between calls, or keep
+// it per thread, so a range can be decoded from several threads at once
+static bool rop_reentrant(const char *name) {
+	const char *names[] = { "x86", "gb", NULL };
+	int i;
+	for (i = 0; name && names[i]; i++) {
+		if (!strcmp (name, names[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// their fini only closes the capstone handle of the calling thread, the
+// workers run it before exiting or each /R would leak one per thread
+static void rop_thread_fini(RCore *core) {
+	RAnalPlugin *ap = core->anal->cur;
+	RAsmPlugin *sp = core->rasm->cur;
+	if (ap && ap->fini && rop_reentrant (ap->name)) {
+		ap->fini (NULL);
+	}
+	if (sp && sp->fini && rop_reentrant (sp->name)) {
+		sp->fini (NULL);
+	}
+}
+
+static void rop_worker_run(RopWorker *w) {
+	size_t i;
+	for (i = w->tid; i < w->njobs && !rop_stopped (w->s, &w->rc); i += w->nthreads) {
+		if (!w->job (w->s, &w->rc, i, w->user)) {
+			w->s->stop = true;
+		}
+	}
+}
+
+static RThreadFunctionRet rop_worker_thread(RThread *th) {
+	RopWorker *w = th->user;
+	rop_worker_run (w);
+	rop_thread_fini (w->s->core);
+	return R_TH_STOP;
+}
+
+// jobs are split between the threads as in r_hash_entropy_fraction_blocks,
+// each thread decodes into its own memo
+static bool rop_run_jobs(RopWorker *workers, int nthreads, size_t njobs, RopJob job, void *user) {
+	RThread *threads[ROP_THREADS_MAX] = {0};
+	int i;
+	for (i = 0; i < nthreads; i++) {
+		workers[i].job = job;
+		workers[i].user = user;
+		workers[i].njobs = njobs;
+		workers[i].nthreads = nthreads;
+		workers[i].tid = i;
+		workers[i].rc.caller = !i;
+		if (i > 0) {
+			threads[i] = r_th_new (rop_worker_thread, &workers[i], 0);
+			if (!threads[i]) {
+				workers[i].rc.caller = true;
+			}
+		}
+	}
+	// the calling thread takes its share too, and the ones of failed threads
+	for (i = 0; i < nthreads; i++) {
+		if (!threads[i]) {
+			rop_worker_run (&workers[i]);
+		}
+	}
+	for (i = 1; i < nthreads; i++) {
+		if (threads[i]) {
+			r_th_wait (threads[i]);
+			r_th_free (threads[i]);
+		}
+	}
+	return !workers[0].s->stop;
+}
+
+static bool rop_find_ends_job(RopSweep *s, RopCache *rc, size_t idx, void *user) {
+	RVector *chunk_ends = user;
+	const int start = (int)idx * ROP_CHUNK;
+	const int end = R_MIN (start + ROP_CHUNK, s->delta - 32);
+	return rop_find_ends (s, rc, start, end, &chunk_ends[idx]);
+}
+
+typedef struct {
+	const struct endlist_pair *ends;
+	const size_t *groups;
+	RList **found;
+} RopBuildJobs;
+
+static bool rop_collect(RopGadget *g, void *user) {
+	return r_list_append (user, g) != NULL;
+}
+
+static bool rop_build_job(RopSweep *s, RopCache *rc, size_t idx, void *user) {
+	RopBuildJobs *b = user;
+	const size_t first = b->groups[idx];
+	return rop_build (s, rc, b->ends + first, b->groups[idx + 1] - first, rop_collect, b->found[idx]);
+}
+
+// the end gadgets are found in chunks of the range. the walk building the
+// gadgets only depends on the previous end gadgets when they are closer than
+// ropdepth, so it is split where they are further apart and gives the same
+// gadgets in the same order as the single threaded sweep
+static bool rop_sweep_threads(RopSweep *s, RopWorker *workers, int nthreads, RopGadgetCb cb, void *user) {
+	const int last = s->delta - 32;
+	const size_t nchunks = (last > 0)? (last + ROP_CHUNK - 1) / ROP_CHUNK: 0;
+	RVector *chunk_ends = R_NEWS0 (RVector, R_MAX (nchunks, 1));
+	RVector ends, groups;
+	size_t i;
+	if (!chunk_ends) {
+		return false;
+	}
+	r_vector_init (&ends, sizeof (struct endlist_pair), NULL, NULL);
+	r_vector_init (&groups, sizeof (size_t), NULL, NULL);
+	for (i = 0; i < nchunks; i++) {
+		r_vector_init (&chunk_ends[i], sizeof (struct endlist_pair), NULL, NULL);
+	}
+	bool ok = rop_run_jobs (workers, nthreads, nchunks, rop_find_ends_job, chunk_ends);
+	for (i = 0; i < nchunks; i++) {
+		if (ok && !r_vector_empty (&chunk_ends[i])) {
+			r_vector_insert_range (&ends, ends.len, chunk_ends[i].a, chunk_ends[i].len);
+		}
+		r_vector_fini (&chunk_ends[i]);
+	}
+	free (chunk_ends);
+	if (!ok || r_vector_empty (&ends)) {
+		r_vector_fini (&ends);
+		return ok;
+	}
+	const struct endlist_pair *e = ends.a;
+	size_t first = 0;
+	r_vector_push (&groups, &first);
+	for (i = 1; i < ends.len; i++) {
+		if (e[i].instr_offset - e[i - 1].instr_offset > s->ropdepth + s->increment
+				&& e[i].instr_offset - e[first].instr_offset >= ROP_CHUNK) {
+			first = i;
+			r_vector_push (&groups, &first);
+		}
+	}
+	r_vector_push (&groups, &ends.len);
+	const size_t ngroups = groups.len - 1;
+	RList **found = R_NEWS0 (RList *, ngroups);
+	if (!found) {
+		r_vector_fini (&groups);
+		r_vector_fini (&ends);
+		return false;
+	}
+	for (i = 0; i < ngroups; i++) {
+		found[i] = r_list_newf ((RListFree)rop_gadget_free);
+	}
+	RopBuildJobs b = { e, groups.a, found };
+	ok = rop_run_jobs (workers, nthreads, ngroups, rop_build_job, &b);
+	for (i = 0; i < ngroups; i++) {
+		RopGadget *g;
+		while (ok && (g = r_list_pop_head (found[i]))) {
+			if (!cb (g, user)) {
+				ok = false;
+			}
+		}
+		r_list_free (found[i]);
+	}
+	free (found);
+	r_vector_fini (&groups);
+	r_vector_fini (&ends);
+	return ok;
+}
+
+static bool rop_sweep(RopSweep *s, RopWorker *workers, int nthreads, RopGadgetCb cb, void *user) {
+	if (nthreads > 1) {
+		return rop_sweep_threads (s, workers, nthreads, cb, user);
+	}
+	RVector ends;
+	r_vector_init (&ends, sizeof (struct endlist_pair), NULL, NULL);
+	bool ok = rop_find_ends (s, &workers[0].rc, 0, s->delta - 32, &ends)
+		&& rop_build (s, &workers[0].rc, ends.a, ends.len, cb, user);
+	r_vector_fini (&ends);
+	return ok;
+}
+
+typedef struct {
+	RInterval itv;
+	bool found;
+} RopHints;
+
+static bool rop_hint_in(ut64 addr, void *user) {
+	RopHints *h = user;
+	h->found = r_itv_contain (h->itv, addr);
+	return !h->found;
+}
+
+static bool rop_arch_hint_cb(ut64 addr, const char *arch, void *user) {
+	return rop_hint_in (addr, user);
+}
+
+static bool rop_bits_hint_cb(ut64 addr, int bits, void *user) {
+	return rop_hint_in (addr, user);
+}
+
+// r_anal_op switches asm.bits and asm.arch at each address from the hints
+// and sections, which threads can't do. they are only used on ranges where
+// those are the same everywhere
+static bool rop_uniform_arch(RCore *core, ut64 from, ut64 to) {
+	RopHints h = { { from, to - from }, false };
+	r_anal_arch_hints_foreach (core->anal, rop_arch_hint_cb, &h);
+	if (!h.found) {
+		r_anal_bits_hints_foreach (core->anal, rop_bits_hint_cb, &h);
+	}
+	if (h.found) {
+		return false;
+	}
+	int bits = 0;
+	const char *arch = NULL;
+	r_core_arch_bits_at (core, from, &bits, &arch);
+	RListIter *iter;
+	RBinSection *sec;
+	r_list_foreach (r_bin_get_sections (core->bin), iter, sec) {
+		if (sec->vaddr <= from || sec->vaddr >= to) {
+			continue;
+		}
+		int sbits = 0;
+		const char *sarch = NULL;
+		r_core_arch_bits_at (core, sec->vaddr, &sbits, &sarch);
+		if (sbits != bits || (sarch != arch && (!sarch || !arch || strcmp (sarch, arch)))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// the gadgets of each swept range are kept in an sdb text file named after
+// the hash of the file and of the settings that change which gadgets exist
+static char *rop_index_path(RCore *core) {
+	RBinFile *bf = r_bin_cur (core->bin);
+	char *sha256 = (bf && bf->buf)? r_core_file_sha256 (core, bf): NULL;
+	RHash *ctx = sha256? r_hash_new (false, R_HASH_SHA256): NULL;
+	if (!ctx) {
+		free (sha256);
+		return NULL;
+	}
+	RStrBuf *sb = r_strbuf_new (R2_VERSION "\n");
+	r_strbuf_appendf (sb, "sha256=%s\n", sha256);
+	free (sha256);
+	r_strbuf_appendf (sb, "baddr=0x%"PFMT64x"\n", r_bin_get_baddr (core->bin));
+	const char *keys[] = { "asm.arch", "asm.bits", "asm.cpu", "asm.os", "cfg.bigendian", "rop.len", "rop.conditional", NULL };
+	int i;
+	for (i = 0; keys[i]; i++) {
+		r_strbuf_appendf (sb, "%s=%s\n", keys[i], r_config_get (core->config, keys[i]));
+	}
+	r_hash_do_begin (ctx, R_HASH_SHA256);
+	r_hash_do_sha256 (ctx, (const ut8 *)r_strbuf_get (sb), r_strbuf_length (sb));
+	r_hash_do_end (ctx, R_HASH_SHA256);
+	r_strbuf_free (sb);
+	char *path = NULL;
+	char *hex = r_hex_bin2strdup (ctx->digest, R_HASH_SIZE_SHA256);
+	char *dir = r_str_home (ROP_INDEX_DIR);
+	if (hex && dir) {
+		path = r_str_newf ("%s" R_SYS_DIR "%s.sdb", dir, hex);
+	}
+	free (hex);
+	free (dir);
+	r_hash_free (ctx);
+	return path;
+}
+
+// "0x<addr>" followed by a "\n<size>:<mnemonic>" line per instruction
+static char *rop_gadget_tostring(RopGadget *g) {
+	RStrBuf *sb = r_strbuf_new (NULL);
+	r_strbuf_appendf (sb, "0x%"PFMT64x, g->addr);
+	RListIter *iter, *iter2 = r_list_iterator (g->opstrs);
+	RCoreAsmHit *hit;
+	r_list_foreach (g->hits, iter, hit) {
+		const char *opst = iter2? iter2->data: "";
+		r_strbuf_appendf (sb, "\n%d:%s", hit->len, opst);
+		iter2 = iter2? iter2->n: NULL;
+	}
+	return r_strbuf_drain (sb);
+}
+
+static RopGadget *rop_gadget_parse(const char *s) {
+	char *end = NULL;
+	ut64 addr = strtoull (s, &end, 16);
+	if (!end || end == s || *end != '\n') {
+		return NULL;
+	}
+	RopGadget *g = rop_gadget_new (addr);
+	if (!g) {
+		return NULL;
+	}
+	while (*end == '\n') {
+		const char *p = end + 1;
+		int len = (int)strtol (p, &end, 10);
+		if (end == p || len < 1 || *end != ':') {
+			rop_gadget_free (g);
+			return NULL;
+		}
+		const char *opst = end + 1;
+		const char *eol = strchr (opst, '\n');
+		RCoreAsmHit *hit = r_core_asm_hit_new ();
+		if (!hit) {
+			rop_gadget_free (g);
+			return NULL;
+		}
+		hit->addr = addr;
+		hit->len = len;
+		r_list_append (g->hits, hit);
+		r_list_append (g->opstrs, eol? r_str_ndup (opst, eol - opst): strdup (opst));
+		addr += len;
+		end = (char *)(eol? eol: opst + strlen (opst));
+	}
+	if (r_list_empty (g->hits)) {
+		rop_gadget_free (g);
+		return NULL;
+	}
+	return g;
+}
+
+// sha256 of the bytes a range was swept from, patches and io.cache
+// writes change what is read without changing the file
+static char *rop_range_digest(const ut8 *buf, int len) {
+	RHash *ctx = r_hash_new (false, R_HASH_SHA256);
+	if (!ctx) {
+		return NULL;
+	}
+	r_hash_do_begin (ctx, R_HASH_SHA256);
+	r_hash_do_sha256 (ctx, buf, len);
+	r_hash_do_end (ctx, R_HASH_SHA256);
+	char *hex = r_hex_bin2strdup (ctx->digest, R_HASH_SIZE_SHA256);
+	r_hash_free (ctx);
+	return hex;
+}
+
+// feeds the indexed gadgets of the range, false if it was never swept
+// from the same bytes
+static bool rop_index_query(Sdb *db, const char *range, const char *digest, RopGadgetCb cb, void *user) {
+	const char *v = sdb_const_get (db, range, 0);
+	r_strf_var (dkey, 80, "%s.sha256", range);
+	const char *d = sdb_const_get (db, dkey, 0);
+	if (!v || !d || !digest || strcmp (d, digest)) {
+		return false;
+	}
+	const int count = (int)sdb_num_get (db, range, 0);
+	Sdb *gadgets = sdb_ns (db, range, false);
+	int i;
+	for (i = 0; gadgets && i < count; i++) {
+		r_strf_var (key, 32, "%d", i);
+		const char *s = sdb_const_get (gadgets, key, 0);
+		RopGadget *g = s? rop_gadget_parse (s): NULL;
+		if (g && !cb (g, user)) {
+			break;
+		}
+	}
+	return true;
+}
+
+static void rop_index_add(Sdb *db, const char *range, const char *digest, RList *found) {
+	Sdb *gadgets = sdb_ns (db, range, true);
+	RListIter *iter;
+	RopGadget *g;
+	int i = 0;
+	sdb_reset (gadgets);
+	r_list_foreach (found, iter, g) {
+		r_strf_var (key, 32, "%d", i++);
+		char *s = rop_gadget_tostring (g);
+		sdb_set_owned (gadgets, key, s, 0);
+	}
+	sdb_num_set (db, range, i, 0);
+	r_strf_var (dkey, 80, "%s.sha256", range);
+	sdb_set (db, dkey, digest, 0);
+}
+
+static bool rop_index_save(Sdb *db, const char *path) {
+	char *dir = r_file_dirname (path);
+	if (!dir || !r_sys_mkdirp (dir)) {
+		free (dir);
+		return false;
+	}
+	free (dir);
+	// write and rename, so concurrent runs never read a partial index
+	char *tmp = r_str_newf ("%s.%d", path, r_sys_getpid ());
+	bool ret = tmp && sdb_text_save (db, tmp, true) && r_file_move (tmp, path);
+	if (!ret && tmp) {
+		r_file_rm (tmp);
+	}
+	free (tmp);
+	return ret;
+}
+
+static void rop_emit(RopQuery *q, RopGadget *g) {
+	if (q->align && (g->addr % q->align)) {
+		return;
+	}
+	if (!rop_gadget_match (g, q->grep, q->regexp, q->rx_list)) {
+		return;
+	}
+	RListIter *iter;
+	RCoreAsmHit *hit;
+	if (q->gadget_sdb) {
+		r_strf_var (head, 32, "%"PFMT64x, g->addr);
+		r_list_foreach (g->hits, iter, hit) {
+			r_strf_var (addr, 64, "%"PFMT64x"(%"PFMT32d")", hit->addr, hit->len);
+			sdb_concat (q->gadget_sdb, head, addr, 0);
+		}
+	}
+	if ((q->mode == 'q') && q->subchain) {
+		// every tail of the gadget, from the longest one
+		RList *tail = r_list_new ();
+		r_list_foreach (g->hits, iter, hit) {
+			r_list_append (tail, hit);
+		}
+		do {
+			print_rop (q->core, tail, NULL, q->mode);
+			r_list_pop_head (tail);
+		} while (r_list_length (tail) > 1);
+		r_list_free (tail);
+	} else {
+		print_rop (q->core, g->hits, q->pj, q->mode);
+	}
+	if (q->max_count > 0) {
+		q->max_count--;
+		if (q->max_count < 1) {
+			q->done = true;
+		}
+	}
+}
+
+static bool rop_gadget_found(RopGadget *g, void *user) {
+	RopQuery *q = user;
+	if (!q->done) {
+		rop_emit (q, g);
+	}
+	if (q->found) {
+		// the index needs the whole range
+		r_list_append (q->found, g);
+		return true;
+	}
+	rop_gadget_free (g);
+	return !q->done;
+}
+
+static int rop_threads(RCore *core) {
+	int n = r_config_get_i (core->config, "rop.threads");
+	if (!rop_reentrant (core->anal->cur? core->anal->cur->name: NULL)) {
+		return 1;
+	}
+	if (n < 1) {
+		n = r_th_ncpus ();
+	}
+	return R_MAX (1, R_MIN (n, ROP_THREADS_MAX));
+}
+
 static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const char *grep, int regexp, struct search_parameters *param) {
 	const ut8 crop = r_config_get_i (core->config, "rop.conditional");      // decide if cjmp, cret, and ccall should be used too for the gadget-search
 	const ut8 subchain = r_config_get_i (core->config, "rop.subchains");
 	const ut8 max_instr = r_config_get_i (core->config, "rop.len");
 	const char *arch = r_config_get (core->config, "asm.arch");
 	int max_count = r_config_get_i (core->config, "search.maxhits");
-	int i = 0, end = 0, mode = 0, increment = 1, ret, result = true;
-	RList /*<endlist_pair>*/ *end_list = r_list_newf (free);
+	int mode = 0, increment = 1, result = true;
 	RList /*<RRegex>*/ *rx_list = NULL;
-	int align = core->search->align;
 	RListIter *itermap = NULL;
 	char *tok, *gregexp = NULL;
 	char *grep_arg = NULL;
 	char *rx = NULL;
-	int delta = 0;
-	ut8 *buf;
+	char *index_path = NULL;
+	Sdb *index = NULL;
+	bool index_dirty = false;
 	RIOMap *map;
-	RAsmOp asmop;
+	RopWorker *workers = NULL;
+	int i, nthreads = 1;
 
 	Sdb *gadgetSdb = NULL;
 	if (r_config_get_i (core->config, "rop.sdb")) {
@@ -1459,7 +2146,6 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 		max_count = -1;
 	}
 	if (max_instr <= 1) {
-		r_list_free (end_list);
 		eprintf ("ROP length (rop.len) must be greater than 1.\n");
 		if (max_instr == 1) {
 			eprintf ("For rop.len = 1, use /c to search for single "
@@ -1513,184 +2199,119 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 			tok = strtok (NULL, ";");
 		}
 	}
+	if (param->outmode == R_MODE_JSON) {
+		mode = 'j';
+	}
+	RopQuery q = {
+		.core = core,
+		.pj = param->pj,
+		.mode = mode,
+		.subchain = subchain,
+		.align = core->search->align,
+		.grep = grep,
+		.regexp = regexp,
+		.rx_list = rx_list,
+		.gadget_sdb = gadgetSdb,
+		.max_count = max_count,
+	};
+	// Get the depth of rop search, should just be max_instr
+	// instructions, x86 and friends are weird length instructions, so
+	// we'll just assume 15 byte instructions.
+	const int ropdepth = (increment == 1)
+		? max_instr * 15 /* wow, x86 is long */
+		: max_instr * increment;
+	RopSweep s = {
+		.core = core,
+		.increment = increment,
+		.ropdepth = ropdepth,
+		.max_instr = max_instr,
+		.crop = crop,
+	};
+	nthreads = rop_threads (core);
+	workers = R_NEWS0 (RopWorker, nthreads);
+	if (!workers) {
+		result = false;
+		goto bad;
+	}
+	for (i = 0; i < nthreads; i++) {
+		workers[i].s = &s;
+		// every offset between the current candidate and its end gadget must fit
+		if (!rop_cache_init (&workers[i].rc, max_instr * 15 + 64)) {
+			result = false;
+			goto bad;
+		}
+	}
+	if (nthreads > 1) {
+		s.lock = r_th_lock_new (false);
+		if (!s.lock) {
+			nthreads = 1;
+		}
+	}
+	if (r_config_get_b (core->config, "rop.cache")) {
+		index_path = rop_index_path (core);
+		if (index_path) {
+			index = sdb_new0 ();
+			if (r_file_exists (index_path)) {
+				sdb_text_load (index, index_path);
+			}
+		}
+	}
 	if (param->outmode == R_MODE_JSON) {
 		pj_a (param->pj);
 	}
 	r_cons_break_push (NULL, NULL);
 
 	r_list_foreach (param->boundaries, itermap, map) {
-		HtUUOptions opt = {0};
-		HtUU *badstart = ht_uu_new_opt (&opt);
 		if (!r_itv_overlap (search_itv, map->itv)) {
 			continue;
 		}
 		RInterval itv = r_itv_intersect (search_itv, map->itv);
 		ut64 from = itv.addr, to = r_itv_end (itv);
-		if (r_cons_is_breaked ()) {
+		if (r_cons_is_breaked () || (q.done && !index)) {
 			break;
 		}
-		delta = to - from;
-		buf = calloc (1, delta);
+		r_strf_var (range, 64, "0x%08"PFMT64x"-0x%08"PFMT64x, from, to);
+		const int delta = to - from;
+		ut8 *buf = calloc (1, delta);
 		if (!buf) {
 			result = false;
-			goto bad;
+			break;
 		}
 		(void) r_io_read_at (core->io, from, buf, delta);
-
-		// Find the end gadgets.
-		for (i = 0; i + 32 < delta; i += increment) {
-			RAnalOp end_gadget = {0};
-			// Disassemble one.
-			if (r_anal_op (core->anal, &end_gadget, from + i, buf + i,
-				    delta - i, R_ANAL_OP_MASK_BASIC) < 1) {
-				r_anal_op_fini (&end_gadget);
-				continue;
-			}
-			if (is_end_gadget (&end_gadget, crop)) {
-#if 0
-				if (search->maxhits && r_list_length (end_list) >= search->maxhits) {
-					// limit number of high level rop gadget results
-					r_anal_op_fini (&end_gadget);
-					break;
-				}
-#endif
-				struct endlist_pair *epair = R_NEW0 (struct endlist_pair);
-				if (epair) {
-					// If this arch has branch delay slots, add the next instr as well
-					if (end_gadget.delay) {
-						epair->instr_offset = i + increment;
-						epair->delay_size = end_gadget.delay;
-					} else {
-						epair->instr_offset = (intptr_t) i;
-						epair->delay_size = end_gadget.delay;
-					}
-					r_list_append (end_list, (void *) (intptr_t) epair);
-				}
-			}
-			r_anal_op_fini (&end_gadget);
-			if (r_cons_is_breaked ()) {
-				break;
-			}
-			// Right now we have a list of all of the end/stop gadgets.
-			// We can just construct gadgets from a little bit before them.
-		}
-		r_list_reverse (end_list);
-		// If we have no end gadgets, just skip all of this search nonsense.
-		if (!r_list_empty (end_list)) {
-			int prev, next, ropdepth;
-			const int max_inst_size_x86 = 15;
-			// Get the depth of rop search, should just be max_instr
-			// instructions, x86 and friends are weird length instructions, so
-			// we'll just assume 15 byte instructions.
-			ropdepth = (increment == 1)
-				? max_instr * max_inst_size_x86 /* wow, x86 is long */
-				: max_instr * increment;
-			if (r_cons_is_breaked ()) {
-				break;
-			}
-			struct endlist_pair *end_gadget = (struct endlist_pair *) r_list_pop (end_list);
-			next = end_gadget->instr_offset;
-			prev = 0;
-			// Start at just before the first end gadget.
-			for (i = next - ropdepth; i < (delta - max_inst_size_x86) && max_count; i += increment) {
-				if (increment == 1) {
-					// give in-boundary instructions a shot
-					if (i < prev - max_inst_size_x86) {
-						i = prev - max_inst_size_x86;
-					}
-				} else {
-					if (i < prev) {
-						i = prev;
-					}
-				}
-				if (i < 0) {
-					i = 0;
-				}
-				if (r_cons_is_breaked ()) {
-					break;
-				}
-				if (i >= next) {
-					// We've exhausted the first end-gadget section,
-					// move to the next one.
-					free (end_gadget);
-					if (r_list_get_n (end_list, 0)) {
-						prev = i;
-						end_gadget = (struct endlist_pair *) r_list_pop (end_list);
-						next = end_gadget->instr_offset;
-						i = next - ropdepth;
-						if (i < 0) {
-							i = 0;
-						}
-					} else {
-						break;
-					}
-				}
-				if (i >= end) { // read by chunk of 4k
-					r_io_read_at (core->io, from + i, buf + i,
-						R_MIN ((delta - i), 4096));
-					end = i + 2048;
-				}
-				ret = r_asm_disassemble (core->rasm, &asmop, buf + i, delta - i);
-				if (ret) {
-					r_asm_set_pc (core->rasm, from + i);
-					RList *hitlist = construct_rop_gadget (core,
-						from + i, buf, delta, i, grep, regexp,
-						rx_list, end_gadget, badstart);
-					if (!hitlist) {
-						continue;
-					}
-					if (align && (0 != ((from + i) % align))) {
-						continue;
-					}
-					if (gadgetSdb) {
-						RListIter *iter;
-
-						RCoreAsmHit *hit = (RCoreAsmHit *) hitlist->head->data;
-						char *headAddr = r_str_newf ("%"PFMT64x, hit->addr);
-						if (!headAddr) {
-							result = false;
-							goto bad;
-						}
-
-						r_list_foreach (hitlist, iter, hit) {
-							char *addr = r_str_newf ("%"PFMT64x"(%"PFMT32d")", hit->addr, hit->len);
-							if (!addr) {
-								free (headAddr);
-								result = false;
-								goto bad;
-							}
-							sdb_concat (gadgetSdb, headAddr, addr, 0);
-							free (addr);
-						}
-						free (headAddr);
-					}
-
-					if (param->outmode == R_MODE_JSON) {
-						mode = 'j';
-					}
-					if ((mode == 'q') && subchain) {
-						do {
-							print_rop (core, hitlist, NULL, mode);
-							hitlist->head = hitlist->head->n;
-						} while (hitlist->head->n);
-					} else {
-						print_rop (core, hitlist, param->pj, mode);
-					}
-					r_list_free (hitlist);
-					if (max_count > 0) {
-						max_count--;
-						if (max_count < 1) {
-							break;
-						}
-					}
-				}
-				if (increment != 1) {
-					i = next;
-				}
-			}
+		char *digest = index? rop_range_digest (buf, delta): NULL;
+		if (index && rop_index_query (index, range, digest, rop_gadget_found, &q)) {
+			// answered from the index, nothing is decoded
+			free (digest);
+			free (buf);
+			continue;
 		}
+		s.buf = buf;
+		s.delta = delta;
+		s.from = from;
+		s.stop = false;
+		int n = 1;
+		if (nthreads > 1 && rop_uniform_arch (core, from, to)) {
+			n = nthreads;
+		}
+		RCoreSeekArchBits archbits = core->anal->coreb.archbits;
+		if (n > 1) {
+			r_core_seek_arch_bits (core, from);
+			core->anal->coreb.archbits = NULL;
+		}
+		for (i = 0; i < n; i++) {
+			rop_cache_reset (&workers[i].rc);
+		}
+		q.found = index? r_list_newf ((RListFree)rop_gadget_free): NULL;
+		bool complete = rop_sweep (&s, workers, n, rop_gadget_found, &q);
+		core->anal->coreb.archbits = archbits;
+		if (complete && q.found && digest) {
+			rop_index_add (index, range, digest, q.found);
+			index_dirty = true;
+		}
+		r_list_free (q.found);
+		q.found = NULL;
+		free (digest);
 		free (buf);
-		ht_uu_free (badstart);
 	}
 	if (r_cons_is_breaked ()) {
 		eprintf ("\n");
@@ -1700,9 +2321,20 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 	if (param->outmode == R_MODE_JSON) {
 		pj_end (param->pj);
 	}
+	if (index_dirty && !rop_index_save (index, index_path)) {
+		R_LOG_WARN ("Cannot save the gadget index in %s", index_path);
+	}
 bad:
+	if (workers) {
+		for (i = 0; i < nthreads; i++) {
+			rop_cache_fini (&workers[i].rc);
+		}
+		free (workers);
+	}
+	r_th_lock_free (s.lock);
+	sdb_free (index);
+	free (index_path);
 	r_list_free (rx_list);
-	r_list_free (end_list);
 	free (grep_arg);
 	free (gregexp);
 	return result;
@@ -2794,9 +3426,7 @@ static bool isArm(RCore *core) {
 void _CbInRangeSearchV(RCore *core, ut64 from, ut64 to, int vsize, void *user) {
 	struct search_parameters *param = user;
 	bool isarm = isArm (core);
-	// this is expensive operation that could be cached but is a callback
-	// and for not messing adding a new param
-	const char *prefix = r_config_get (core->config, "search.prefix");
+	const char *prefix = r_config_handle_s (&param->cfg_prefix);
 	if (isarm) {
 		if (to & 1) {
 			to--;
@@ -2812,7 +3442,7 @@ void _CbInRangeSearchV(RCore *core, ut64 from, ut64 to, int vsize, void *user) {
 	}
 	r_core_cmdf (core, "f %s.value.0x%08"PFMT64x" %d = 0x%08"PFMT64x" \n", prefix, to, vsize, to); // flag at value of hit
 	r_core_cmdf (core, "f %s.offset.0x%08"PFMT64x" %d = 0x%08"PFMT64x " \n", prefix, from, vsize, from); // flag at offset of hit
-	const char *cmdHit = r_config_get (core->config, "cmd.hit");
+	const char *cmdHit = r_config_handle_s (&param->cfg_cmdhit);
 	if (cmdHit && *cmdHit) {
 		ut64 addr = core->offset;
 		r_core_seek (core, from, true);
@@ -3241,6 +3871,8 @@ static int cmd_search(void *data, const char *input) {
 	if (!param.cmd_hit) {
 		param.cmd_hit = "";
 	}
+	r_config_handle_init (&param.cfg_prefix, core->config, "search.prefix");
+	r_config_handle_init (&param.cfg_cmdhit, core->config, "cmd.hit");
 	RSearch *search = core->search;
 	int ignorecase = false;
 	int param_offset = 2;
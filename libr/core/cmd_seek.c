@@ -398,11 +398,12 @@ static int cmd_seek(void *data, const char *input) {
 		if (input[1] == '*') { // "sC*"
 			r_core_cmd0 (core, "C*~^\"CC");
 		} else if (input[1] == ' ') {
-			RIntervalTreeIter it;
-			RAnalMetaItem *meta;
+			RAnalMetaIter it;
+			RIntervalNode *node;
 			bool seeked = false;
-			r_interval_tree_foreach (&core->anal->meta, it, meta) {
-				if (meta->type == R_META_TYPE_COMMENT && !strcmp (meta->str, input + 2)) {
+			r_meta_foreach_type (core->anal, it, node, R_META_TYPE_COMMENT) {
+				RAnalMetaItem *meta = node->data;
+				if (!strcmp (meta->str, input + 2)) {
 					if (!silent) {
 						r_io_sundo_push (core->io, core->offset, r_print_get_cursor (core->print));
 					}
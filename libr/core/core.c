@@ -2603,9 +2603,9 @@ R_API const char *r_core_anal_optype_colorfor(RCore *core, ut64 addr, ut8 ch, bo
 	if (!verbose) {
 		// check for flag colors
 		RFlagItem *fi = r_flag_get_at (core->flags, addr, true);
-		if (fi && fi->offset + fi->size >= addr && fi->color) {
+		if (fi && fi->offset + fi->size >= addr && r_flag_item_color (fi)) {
 			free (const_color);
-			const_color = r_cons_pal_parse (fi->color, NULL);
+			const_color = r_cons_pal_parse (r_flag_item_color (fi), NULL);
 			return const_color;
 		}
 		return NULL;
@@ -2901,17 +2901,24 @@ static int win_eprintf(const char *format, ...) {
 static void ev_iowrite_cb(REvent *ev, int type, void *user, void *data) {
 	RCore *core = user;
 	REventIOWrite *iow = data;
-	if (r_config_get_i (core->config, "anal.onchange")) {
-		// works, but loses varnames and such, but at least is not crashing
-		char *cmd = r_str_newf ("af-0x%08"PFMT64x";af 0x%08"PFMT64x, iow->addr, iow->addr);
-		r_list_append (core->cmdqueue, cmd);
-#if 0
-		r_anal_update_analysis_range (core->anal, iow->addr, iow->len);
+	if (core->anal_onchange_busy || !r_config_get_b (core->config, "anal.onchange")) {
+		return;
+	}
+	// reanalyzing may write to the io cache (esil), don't recurse on that
+	core->anal_onchange_busy = true;
+	RList *fcns = r_anal_update_analysis_range (core->anal, iow->addr, iow->len);
+	core->anal_onchange_busy = false;
+	if (fcns) {
+		RListIter *iter;
+		RAnalFunction *fcn;
+		r_list_foreach (fcns, iter, fcn) {
+			R_LOG_INFO ("Reanalyzed %s at 0x%08"PFMT64x, fcn->name, fcn->addr);
+		}
+		r_list_free (fcns);
 		if (core->cons->event_resize && core->cons->event_data) {
 			// Force a reload of the graph
 			core->cons->event_resize (core->cons->event_data);
 		}
-#endif
 	}
 }
 
@@ -3195,6 +3202,7 @@ R_API void r_core_fini(RCore *c) {
 
 	r_list_free (c->gadgets);
 	r_list_free (c->undos);
+	r_core_disasm_cache_free (c->disasm_cache);
 	r_num_free (c->num);
 	// TODO: sync or not? sdb_sync (c->sdb);
 	// TODO: sync all dbs?
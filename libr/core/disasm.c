@@ -184,7 +184,7 @@ typedef struct {
 	int lbytes;
 	int show_comment_right;
 	int pre;
-	char *ocomment;
+	const char *ocomment;
 	int linesopts;
 	int lastfail;
 	int ocols;
@@ -298,6 +298,15 @@ typedef struct {
 	int buf_line_begin;
 	const char *strip;
 	int maxflags;
+
+	// settings read for every line, resolved once in ds_init
+	RConfigHandle cfg_arch;
+	RConfigHandle cfg_bits;
+	RConfigHandle cfg_seggrn;
+	RConfigHandle cfg_marks;
+	RConfigHandle cfg_html;
+	RConfigHandle cfg_lang;
+	RConfigHandle cfg_demangle_libs;
 	int asm_types;
 } RDisasmState;
 
@@ -595,6 +604,17 @@ static void ds_print_esil_anal_fini(RDisasmState *ds) {
 	}
 }
 
+static void ds_init_config(RDisasmState *ds) {
+	RConfig *cfg = ds->core->config;
+	r_config_handle_init (&ds->cfg_arch, cfg, "asm.arch");
+	r_config_handle_init (&ds->cfg_bits, cfg, "asm.bits");
+	r_config_handle_init (&ds->cfg_seggrn, cfg, "asm.seggrn");
+	r_config_handle_init (&ds->cfg_marks, cfg, "asm.marks");
+	r_config_handle_init (&ds->cfg_html, cfg, "scr.html");
+	r_config_handle_init (&ds->cfg_lang, cfg, "bin.lang");
+	r_config_handle_init (&ds->cfg_demangle_libs, cfg, "bin.demangle.libs");
+}
+
 static RDisasmState *ds_init(RCore *core) {
 	RDisasmState *ds = R_NEW0 (RDisasmState);
 	if (!ds) {
@@ -877,6 +897,7 @@ static RDisasmState *ds_init(RCore *core) {
 			ds->linesopts |= R_ANAL_REFLINE_TYPE_UTF8;
 		}
 	}
+	ds_init_config (ds);
 	return ds;
 }
 
@@ -1023,6 +1044,16 @@ static char *get_op_ireg(void *user, ut64 addr) {
 	return res;
 }
 
+// only installed while build_op_str runs subvar with ds as the parser user
+static char *ds_get_op_ireg(void *user, ut64 addr) {
+	RDisasmState *ds = (RDisasmState *)user;
+	// the instruction being printed is already analyzed
+	if (ds->analop.addr == addr) {
+		return ds->analop.ireg? strdup (ds->analop.ireg): NULL;
+	}
+	return get_op_ireg (ds->core, addr);
+}
+
 static st64 get_ptr_at(RAnalFunction *fcn, st64 delta, ut64 addr) {
 	return r_anal_function_get_var_stackptr_at (fcn, delta, addr);
 }
@@ -1031,7 +1062,158 @@ static const char *get_reg_at(RAnalFunction *fcn, st64 delta, ut64 addr) {
 	return r_anal_function_get_var_reg_at (fcn, delta, addr);
 }
 
+#define DISASM_CACHE_BYTES 32
+#define DISASM_CACHE_MAX 8192
+
+// the operand string of an instruction only depends on its bytes, the
+// config, the analysis, the flags and the palette, so it can be reused
+// until one of their generation counters moves
+typedef struct {
+	ut32 cfg_gen;
+	ut32 anal_gen;
+	ut32 flag_gen;
+	ut32 pal_gen;
+	int nbytes;
+	ut8 bytes[DISASM_CACHE_BYTES];
+	// indexed by print_color | line_highlighted << 1
+	bool valid[4];
+	char *pre[4]; // what colorize_asm_string wrote to the cons buffer
+	char *opstr[4];
+	char *str[4];
+} DisasmCacheItem;
+
+struct r_core_disasm_cache_t {
+	HtUP *items;
+	RConfig *cfg;
+	RConfigWatch *watch;
+	ut32 cfg_gen;
+};
+
+static void disasm_cache_config_changed(void *user, RConfigNode *node) {
+	RCoreDisasmCache *dc = user;
+	// emulation toggles io.cache for every instruction, the bytes are in the key
+	if (strcmp (node->name, "io.cache")) {
+		dc->cfg_gen++;
+	}
+}
+
+static void disasm_cache_item_free(HtUPKv *kv) {
+	DisasmCacheItem *it = kv->value;
+	int i;
+	for (i = 0; i < 4; i++) {
+		free (it->pre[i]);
+		free (it->opstr[i]);
+		free (it->str[i]);
+	}
+	free (it);
+}
+
+R_IPI void r_core_disasm_cache_free(RCoreDisasmCache *dc) {
+	if (dc) {
+		r_config_unwatch (dc->cfg, dc->watch);
+		ht_up_free (dc->items);
+		free (dc);
+	}
+}
+
+static bool ds_cache_key(RDisasmState *ds, DisasmCacheItem *key) {
+	RCore *core = ds->core;
+	if (ds->use_esil || ds->decode || ds->opstr) {
+		return false;
+	}
+	// only when the bytes of the instruction are at hand
+	if (!ds->buf || ds->at != ds->addr + ds->index || ds_left (ds) < 1) {
+		return false;
+	}
+	if (ds->analop.refptr && r_config_get_b (core->config, "asm.sub.rel")) {
+		// subrel reads the pointed memory, which is not part of the key
+		return false;
+	}
+	int n = R_MAX (ds->asmop.size, ds->analop.size);
+	if (n < 1 || n > DISASM_CACHE_BYTES || n > ds_left (ds)) {
+		return false;
+	}
+	key->cfg_gen = core->disasm_cache->cfg_gen;
+	key->anal_gen = R_DIRTY_GEN (core->anal);
+	key->flag_gen = R_DIRTY_GEN (core->flags);
+	key->pal_gen = r_cons_context ()->pal_gen;
+	key->nbytes = n;
+	memcpy (key->bytes, ds_bufat (ds), n);
+	return true;
+}
+
+static bool ds_cache_same(DisasmCacheItem *a, DisasmCacheItem *b) {
+	return a->cfg_gen == b->cfg_gen && a->anal_gen == b->anal_gen
+		&& a->flag_gen == b->flag_gen && a->pal_gen == b->pal_gen
+		&& a->nbytes == b->nbytes && !memcmp (a->bytes, b->bytes, a->nbytes);
+}
+
+static void build_op_str(RDisasmState *ds, bool print_color);
+
 static void ds_build_op_str(RDisasmState *ds, bool print_color) {
+	RCore *core = ds->core;
+	RConsContext *ctx = r_cons_context ();
+	RCoreDisasmCache *dc = core->disasm_cache;
+	if (!dc) {
+		dc = R_NEW0 (RCoreDisasmCache);
+		if (dc) {
+			dc->cfg = core->config;
+			dc->watch = r_config_watch (core->config, "", disasm_cache_config_changed, dc);
+			if (!dc->watch) {
+				R_FREE (dc);
+			}
+		}
+		core->disasm_cache = dc;
+	}
+	DisasmCacheItem key = {0};
+	if (!dc || !ds_cache_key (ds, &key)) {
+		build_op_str (ds, print_color);
+		return;
+	}
+	const int v = (print_color? 1: 0) | (line_highlighted (ds)? 2: 0);
+	DisasmCacheItem *it = dc->items? ht_up_find (dc->items, ds->at, NULL): NULL;
+	if (it && ds_cache_same (it, &key) && it->valid[v]) {
+		if (it->pre[v]) {
+			r_cons_strcat (it->pre[v]);
+		}
+		ds->opstr = it->opstr[v]? strdup (it->opstr[v]): NULL;
+		if (it->str[v]) {
+			r_str_ncpy (ds->str, it->str[v], sizeof (ds->str));
+		}
+		return;
+	}
+	size_t olen = ctx->buffer_len;
+	build_op_str (ds, print_color);
+	if (ctx->buffer_len < olen) {
+		// the cons buffer was flushed meanwhile
+		return;
+	}
+	if (!dc->items || dc->items->count >= DISASM_CACHE_MAX) {
+		ht_up_free (dc->items);
+		dc->items = ht_up_new (NULL, disasm_cache_item_free, NULL);
+		it = NULL;
+		if (!dc->items) {
+			return;
+		}
+	}
+	if (!it || !ds_cache_same (it, &key)) {
+		DisasmCacheItem *nit = R_NEW0 (DisasmCacheItem);
+		if (!nit) {
+			return;
+		}
+		*nit = key;
+		ht_up_update (dc->items, ds->at, nit);
+		it = nit;
+	}
+	size_t plen = ctx->buffer_len - olen;
+	it->pre[v] = plen? r_str_ndup (ctx->buffer + olen, plen): NULL;
+	it->opstr[v] = ds->opstr? strdup (ds->opstr): NULL;
+	// str is only rewritten when substituting names
+	it->str[v] = ds->subnames? strdup (ds->str): NULL;
+	it->valid[v] = true;
+}
+
+static void build_op_str(RDisasmState *ds, bool print_color) {
 	RCore *core = ds->core;
 	if (ds->use_esil) {
 		free (ds->opstr);
@@ -1064,11 +1246,14 @@ static void ds_build_op_str(RDisasmState *ds, bool print_color) {
 	if (ds->subvar && ds->opstr) {
 		ut64 at = ds->vat;
 		RAnalFunction *f = fcnIn (ds, at, R_ANAL_FCN_TYPE_NULL);
-		core->parser->get_op_ireg = get_op_ireg;
+		core->parser->get_op_ireg = ds_get_op_ireg;
 		core->parser->get_ptr_at = get_ptr_at;
 		core->parser->get_reg_at = get_reg_at;
+		core->parser->user = ds;
 		r_parse_subvar (core->parser, f, at, ds->analop.size,
 			ds->opstr, ds->strsub, sizeof (ds->strsub));
+		core->parser->get_op_ireg = get_op_ireg;
+		core->parser->user = core;
 		if (*ds->strsub) {
 			free (ds->opstr);
 			ds->opstr = strdup (ds->strsub);
@@ -1282,7 +1467,7 @@ static void ds_begin_line(RDisasmState *ds) {
 
 static void ds_newline(RDisasmState *ds) {
 	if (ds->pj) {
-		const bool is_html = r_config_get_b (ds->core->config, "scr.html");
+		const bool is_html = r_config_handle_b (&ds->cfg_html);
 		if (is_html) {
 			char *s = r_cons_html_filter (r_cons_get_buffer (), NULL);
 			pj_s (ds->pj, s);
@@ -2207,9 +2392,9 @@ static void ds_show_comments_right(RDisasmState *ds) {
 	if (!comment) {
 		if (vartype) {
 			ds->comment = r_str_newf ("%s; %s", COLOR_ARG (ds, color_func_var_type), vartype);
-		} else if (item && item->comment && *item->comment) {
-			ds->ocomment = item->comment;
-			ds->comment = strdup (item->comment);
+		} else if (item && R_STR_ISNOTEMPTY (r_flag_item_comment (item))) {
+			ds->ocomment = r_flag_item_comment (item);
+			ds->comment = strdup (ds->ocomment);
 		}
 	} else if (vartype) {
 		ds->comment = r_str_newf ("%s; %s %s%s; %s", COLOR_ARG (ds, color_func_var_type), vartype, Color_RESET, COLOR (ds, color_usrcmt), comment);
@@ -2260,7 +2445,7 @@ static void ds_show_comments_right(RDisasmState *ds) {
 		R_FREE (ds->comment);
 		ds_newline (ds);
 		/* flag one */
-		if (item && item->comment && ds->ocomment != item->comment) {
+		if (item && r_flag_item_comment (item) && ds->ocomment != r_flag_item_comment (item)) {
 			ds_begin_line (ds);
 			ds_newline (ds);
 			ds_begin_line (ds);
@@ -2268,7 +2453,7 @@ static void ds_show_comments_right(RDisasmState *ds) {
 				r_cons_strcat (ds->pal_comment);
 			}
 			r_cons_strcat ("  ;  ");
-			r_cons_strcat_justify (item->comment, mycols, ';');
+			r_cons_strcat_justify (r_flag_item_comment (item), mycols, ';');
 			ds_newline (ds);
 			if (ds->show_color) {
 				ds_print_color_reset (ds);
@@ -2300,8 +2485,9 @@ static void __preline_flag(RDisasmState *ds, RFlagItem *flag) {
 	ds_pre_line (ds);
 	if (ds->show_color) {
 		bool hasColor = false;
-		if (flag->color) {
-			char *color = r_cons_pal_parse (flag->color, NULL);
+		const char *flag_color = r_flag_item_color (flag);
+		if (flag_color) {
+			char *color = r_cons_pal_parse (flag_color, NULL);
 			if (color) {
 				r_cons_strcat (color);
 				free (color);
@@ -2390,7 +2576,7 @@ static void ds_show_flags(RDisasmState *ds, bool overlapped) {
 	int count = 0;
 	bool outline = !ds->flags_inline;
 	const char *comma = "";
-	bool keep_lib = r_config_get_i (core->config, "bin.demangle.libs");
+	bool keep_lib = r_config_handle_b (&ds->cfg_demangle_libs);
 	bool docolon = true;
 	int nth = 0;
 #if 0
@@ -2464,8 +2650,9 @@ static void ds_show_flags(RDisasmState *ds, bool overlapped) {
 		bool hasColor = false;
 		char *color = NULL;
 		if (ds->show_color) {
-			if (flag->color) {
-				color = r_cons_pal_parse (flag->color, NULL);
+			const char *flag_color = r_flag_item_color (flag);
+			if (flag_color) {
+				color = r_cons_pal_parse (flag_color, NULL);
 				if (color) {
 					r_cons_strcat (color);
 					ds->lastflag = flag;
@@ -2504,7 +2691,7 @@ static void ds_show_flags(RDisasmState *ds, bool overlapped) {
 				outline = false;
 				docolon = false;
 			} else {
-				const char *lang = r_config_get (core->config, "bin.lang");
+				const char *lang = r_config_handle_s (&ds->cfg_lang);
 				char *name = r_bin_demangle (core->bin->cur, lang, flag->realname, flag->offset, keep_lib);
 				if (!name) {
 					const char *n = flag->realname? flag->realname: flag->name;
@@ -2599,35 +2786,39 @@ static void ds_update_ref_lines(RDisasmState *ds) {
 	}
 }
 
+typedef struct {
+	RAnalMetaItem *item;
+	ut64 size;
+} DataMetaCtx;
+
+static bool data_meta_cb(RIntervalNode *node, void *user) {
+	DataMetaCtx *ctx = user;
+	RAnalMetaItem *mi = node->data;
+	switch (mi->type) {
+	case R_META_TYPE_DATA:
+	case R_META_TYPE_STRING:
+	case R_META_TYPE_FORMAT:
+	case R_META_TYPE_MAGIC:
+	case R_META_TYPE_HIDE:
+	case R_META_TYPE_RUN:
+		ctx->item = mi;
+		ctx->size = r_meta_node_size (node);
+		break;
+	default:
+		break;
+	}
+	return true;
+}
+
 static int ds_disassemble(RDisasmState *ds, ut8 *buf, int len) {
 	RCore *core = ds->core;
 	int ret;
 
 	// find the meta item at this offset if any
-	RPVector *metas = r_meta_get_all_at (ds->core->anal, ds->at); // TODO: do in range
-	RAnalMetaItem *meta = NULL;
-	ut64 meta_size = UT64_MAX;
-	if (metas) {
-		void **it;
-		r_pvector_foreach (metas, it) {
-			RIntervalNode *node = *it;
-			RAnalMetaItem *mi = node->data;
-			switch (mi->type) {
-			case R_META_TYPE_DATA:
-			case R_META_TYPE_STRING:
-			case R_META_TYPE_FORMAT:
-			case R_META_TYPE_MAGIC:
-			case R_META_TYPE_HIDE:
-			case R_META_TYPE_RUN:
-				meta = mi;
-				meta_size = r_meta_item_size (node->start, node->end);
-				break;
-			default:
-				break;
-			}
-		}
-		r_pvector_free (metas);
-	}
+	DataMetaCtx dm = { NULL, UT64_MAX };
+	r_meta_foreach_at (core->anal, ds->at, R_META_TYPE_ANY, data_meta_cb, &dm); // TODO: do in range
+	RAnalMetaItem *meta = dm.item;
+	ut64 meta_size = dm.size;
 	if (ds->hint && ds->hint->bits) {
 		if (!ds->core->anal->opt.ignbithints) {
 			r_config_set_i (core->config, "asm.bits", ds->hint->bits);
@@ -2805,12 +2996,13 @@ static void ds_control_flow_comments(RDisasmState *ds) {
 		case R_ANAL_OP_TYPE_CJMP:
 		case R_ANAL_OP_TYPE_CALL:
 			item = r_flag_get_i (ds->core->flags, ds->analop.jump);
-			if (item && item->comment) {
+			const char *comment = item? r_flag_item_comment (item): NULL;
+			if (comment) {
 				if (ds->show_color) {
 					r_cons_strcat (ds->pal_comment);
 				}
 				ds_align_comment (ds);
-				r_cons_printf ("  ; ref to %s: %s\n", item->name, item->comment);
+				r_cons_printf ("  ; ref to %s: %s\n", item->name, comment);
 				ds_print_color_reset (ds);
 			}
 			break;
@@ -2940,11 +3132,11 @@ static void ds_print_offset(RDisasmState *ds) {
 	// probably tooslow
 	RFlagItem *f = r_flag_get_at (core->flags, at, 1);
 	if (ds->show_color && f) { // ds->lastflag) {
-		const char *color = f->color;
+		const char *color = r_flag_item_color (f);
 		if (ds->at >= f->offset && ds->at < f->offset + f->size) {
 		//	if (r_itv_inrange (f->itv, ds->at))
 			if (color && *color) {
-				char *k = r_cons_pal_parse (f->color, NULL);
+				char *k = r_cons_pal_parse (color, NULL);
 				if (k) {
 					r_cons_printf ("%s", k);
 					hasCustomColor = true;
@@ -2960,7 +3152,7 @@ static void ds_print_offset(RDisasmState *ds) {
 		RFlagItem *fi;
 		int delta = -1;
 		bool show_trace = false;
-		unsigned int seggrn = r_config_get_i (core->config, "asm.seggrn");
+		unsigned int seggrn = r_config_handle_i (&ds->cfg_seggrn);
 
 		if (ds->show_reloff) {
 			RAnalFunction *f = r_anal_get_function_at (core->anal, at);
@@ -3090,7 +3282,7 @@ static bool ds_print_data_type(RDisasmState *ds, const ut8 *obuf, int ib, int si
 	if (ds->asm_hint_imm) { // thats not really an imm.. but well dont add more hints for now
 		(void) ds_print_shortcut (ds, n, ds->asm_hint_pos);
 	}
-	if (r_config_get_b (core->config, "asm.marks")) {
+	if (r_config_handle_b (&ds->cfg_marks)) {
 		r_cons_printf ("  ");
 		int q = core->print->cur_enabled &&
 			ds->cursor >= ds->index &&
@@ -3144,8 +3336,8 @@ static bool ds_print_data_type(RDisasmState *ds, const ut8 *obuf, int ib, int si
 	}
 
 	if (size == 4 || size == 8) {
-		if (r_str_startswith (r_config_get (core->config, "asm.arch"), "arm")) {
-			ut64 bits = r_config_get_i (core->config, "asm.bits");
+		if (r_str_startswith (r_config_handle_s (&ds->cfg_arch), "arm")) {
+			ut64 bits = r_config_handle_i (&ds->cfg_bits);
 			//adjust address for arm/thumb address
 			if (bits < 64) {
 				if (n & 1) {
@@ -3172,6 +3364,10 @@ static bool ds_print_meta_infos(RDisasmState *ds, ut8* buf, int len, int idx, in
 	if (!ds->asm_meta) {
 		return false;
 	}
+	// most instructions have no meta, find that out without allocating
+	if (!r_meta_get_in (core->anal, ds->at, R_META_TYPE_ANY)) {
+		return false;
+	}
 	RPVector *metas = r_meta_get_all_in (core->anal, ds->at, R_META_TYPE_ANY);
 	if (!metas) {
 		return false;
@@ -3648,7 +3844,7 @@ static void ds_print_fcn_name(RDisasmState *ds) {
 				&& ds->opstr && !strstr (ds->opstr, flag->name)
 				&& (r_str_startswith (flag->name, "sym.")
 					|| r_str_startswith (flag->name, "method."))
-				&& (arch = r_config_get (ds->core->config, "asm.arch"))
+				&& (arch = r_config_handle_s (&ds->cfg_arch))
 				&& strcmp (arch, "dalvik")) {
 			RFlagItem *flag_sym = flag;
 			if (ds->core->vmode && ds->asm_demangle
@@ -4095,7 +4291,7 @@ static void ds_print_str(RDisasmState *ds, const char *str, int len, ut64 refadd
 	}
 	// do not resolve strings on arm64 pointed with ADRP
 	if (ds->analop.type == R_ANAL_OP_TYPE_LEA) {
-		if (ds->core->rasm->config->bits == 64 && r_str_startswith (r_config_get (ds->core->config, "asm.arch"), "arm")) {
+		if (ds->core->rasm->config->bits == 64 && r_str_startswith (r_config_handle_s (&ds->cfg_arch), "arm")) {
 			return;
 		}
 	}
@@ -4197,7 +4393,7 @@ static void ds_print_ptr(RDisasmState *ds, int len, int idx) {
 	if (ds->analop.type == (R_ANAL_OP_TYPE_MOV | R_ANAL_OP_TYPE_REG)
 	    && ds->analop.stackop == R_ANAL_STACK_SET
 	    && ds->analop.val != UT64_MAX && ds->analop.val > 10) {
-		const char *arch = r_config_get (core->config, "asm.arch");
+		const char *arch = r_config_handle_s (&ds->cfg_arch);
 		if (arch && !strcmp (arch, "x86")) {
 			p = refaddr = ds->analop.val;
 			refptr = 0;
@@ -4468,9 +4664,9 @@ static void ds_print_relocs(RDisasmState *ds) {
 		return;
 	}
 	RCore *core = ds->core;
-	const char *lang = r_config_get (core->config, "bin.lang");
-	bool demangle = r_config_get_i (core->config, "asm.demangle");
-	bool keep_lib = r_config_get_i (core->config, "bin.demangle.libs");
+	const char *lang = r_config_handle_s (&ds->cfg_lang);
+	bool demangle = ds->asm_demangle;
+	bool keep_lib = r_config_handle_b (&ds->cfg_demangle_libs);
 	RBinReloc *rel = r_core_getreloc (core, ds->at, ds->analop.size);
 	if (rel) {
 		int cstrlen = 0;
@@ -4866,26 +5062,21 @@ static void delete_last_comment(RDisasmState *ds) {
 	}
 }
 
+static bool emu_skip_meta_cb(RIntervalNode *node, void *user) {
+	const char *emuskipmeta = user;
+	RAnalMetaItem *item = node->data;
+	return !strchr (emuskipmeta, (char)item->type);
+}
+
 static bool can_emulate_metadata(RCore *core, ut64 at) {
 	// check if there is a meta at the addr that is unemulateable
 	const char *emuskipmeta = r_config_get (core->config, "emu.skip");
-	bool ret = true;
-	RPVector *metas = r_meta_get_all_at (core->anal, at);
-	void **it;
-	r_pvector_foreach (metas, it) {
-		RAnalMetaItem *item = ((RIntervalNode *)*it)->data;
-		if (strchr (emuskipmeta, (char)item->type)) {
-			ret = false;
-			break;
-		}
-	}
-	r_pvector_free (metas);
-	return ret;
+	return r_meta_foreach_at (core->anal, at, R_META_TYPE_ANY, emu_skip_meta_cb, (void *)emuskipmeta);
 }
 
 static void mipsTweak(RDisasmState *ds) {
 	RCore *core = ds->core;
-	const char *asm_arch = r_config_get (core->config, "asm.arch");
+	const char *asm_arch = r_config_handle_s (&ds->cfg_arch);
 	if (asm_arch && *asm_arch && strstr (asm_arch, "mips")) {
 		if (r_config_get_i (core->config, "anal.gpfixed")) {
 			ut64 gp = r_config_get_i (core->config, "anal.gp");
@@ -5404,10 +5595,10 @@ static char *ds_sub_jumps(RDisasmState *ds, char *str) {
 		ptr = str;
 		while ((nptr = _find_next_number (ptr))) {
 			ptr = nptr;
-			const char* arch = r_config_get (ds->core->config, "asm.arch");
+			const char* arch = r_config_handle_s (&ds->cfg_arch);
 			const bool x86 = !strncmp (arch, "x86", 3);
-			const int bits = r_config_get_i (ds->core->config, "asm.bits");
-			const int seggrn = r_config_get_i (ds->core->config, "asm.seggrn");
+			const int bits = r_config_handle_i (&ds->cfg_bits);
+			const int seggrn = r_config_handle_i (&ds->cfg_seggrn);
 			char* colon = strchr (ptr, ':');
 			if (x86 && bits == 16 && colon) {
 				*colon = '\0';
@@ -6855,6 +7046,7 @@ toro:
 					int size = R_MIN (meta_size, nb_bytes - i);
 					RDisasmState ds = {0};
 					ds.core = core;
+					ds_init_config (&ds);
 					ut8 *b = malloc (meta_size);
 					if (b) {
 						r_io_read_at (core->io, at, b, meta_size);
@@ -6023,7 +6023,7 @@ static void __panels_refresh(RCore *core) {
 		r_core_cmd0 (core, "pg");
 	}
 	show_cursor (core);
-	r_cons_flush ();
+	r_cons_frame_flush ();
 	if (r_cons_singleton ()->fps) {
 		r_cons_print_fps (40);
 	}
@@ -234,6 +234,7 @@ R_API int r_core_pseudo_code(RCore *core, const char *input) {
 		r_config_hold_free (hc);
 		return false;
 	}
+	r_core_bin_dwarf_apply (core, fcn->addr);
 	r_config_set_i (core->config, "scr.color", 0);
 	r_config_set_b (core->config, "asm.stackptr", false);
 	r_config_set_b (core->config, "asm.pseudo", true);
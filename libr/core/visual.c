@@ -4133,6 +4133,34 @@ static void show_cursor(RCore *core) {
 	}
 }
 
+// frames are only worth rendering when there are no keys waiting, the
+// cursor needs complete frames to know where the rows are. user commands
+// in cmd.visual and cmd.vprompt may have side effects, they always run
+static bool visual_can_drop_frame(RCore *core) {
+	if (!r_config_get_b (core->config, "scr.dropframes") || core->print->cur_enabled) {
+		return false;
+	}
+	const char *vcmd = r_config_get (core->config, "cmd.visual");
+	const char *vprompt = r_config_get (core->config, "cmd.vprompt");
+	return R_STR_ISEMPTY (vcmd) && R_STR_ISEMPTY (vprompt);
+}
+
+static bool frame_cancelled = false;
+
+// called from r_cons_is_breaked() while a frame is rendered
+static void visual_break_on_input(void *user) {
+	RCore *core = (RCore *)user;
+	static ut64 last = 0;
+	ut64 now = r_time_now_mono ();
+	if (now - last > 10000) {
+		last = now;
+		if (r_cons_input_pending ()) {
+			frame_cancelled = true;
+			r_cons_context_break (core->cons->context);
+		}
+	}
+}
+
 static void visual_refresh(RCore *core) {
 	static ut64 oseek = UT64_MAX;
 	const char *vi, *vcmd, *cmd_str;
@@ -4145,12 +4173,23 @@ static void visual_refresh(RCore *core) {
 
 	int w = visual_responsive (core);
 
-	if (autoblocksize) {
-		r_cons_gotoxy (0, 0);
-	} else {
-		r_cons_clear ();
-	}
+	vi = r_config_get (core->config, "cmd.cprompt");
+	bool vsplit = (vi && *vi);
 	r_cons_flush ();
+	// with scr.damage the rows are redrawn in place, clearing would flicker.
+	// otherwise the clear goes out with the frame, dropped frames keep the
+	// last one on screen
+	if (!core->cons->damage || vsplit) {
+		if (autoblocksize) {
+			r_cons_gotoxy (0, 0);
+		} else {
+			r_cons_clear ();
+		}
+		if (vsplit) {
+			// the column is made from the buffer contents
+			r_cons_flush ();
+		}
+	}
 	r_cons_print_clear ();
 	core->cons->context->noflush = true;
 
@@ -4158,9 +4197,6 @@ static void visual_refresh(RCore *core) {
 	int split_w = 12 + 4 + hex_cols + (hex_cols * 3);
 	bool ce = core->print->cur_enabled;
 
-	vi = r_config_get (core->config, "cmd.cprompt");
-	bool vsplit = (vi && *vi);
-
 	if (vsplit) {
 		// XXX: slow
 		core->cons->blankline = false;
@@ -4234,6 +4270,13 @@ static void visual_refresh(RCore *core) {
 			cmd_str = (zoom ? "pz" : __core_visual_print_command (core));
 		}
 	}
+	// slow views like pd with asm.emu are aborted when a key is pressed
+	const bool can_drop = visual_can_drop_frame (core);
+	RConsBreakCallback cb_break = core->cons->cb_break;
+	if (can_drop) {
+		core->cons->cb_break = visual_break_on_input;
+		r_cons_break_push (NULL, NULL);
+	}
 	if (cmd_str && *cmd_str) {
 		if (vsplit) {
 			char *cmd_result = r_core_cmd_str (core, cmd_str);
@@ -4246,6 +4289,15 @@ static void visual_refresh(RCore *core) {
 			free (res);
 		}
 	}
+	if (can_drop) {
+		r_cons_break_pop ();
+		core->cons->cb_break = cb_break;
+		if (frame_cancelled) {
+			frame_cancelled = false;
+			core->cons->context->breaked = false;
+			core->cons->context->was_breaked = false;
+		}
+	}
 	core->print->cur_enabled = ce;
 #if 0
 	if (core->print->screen_bounds != 1LL) {
@@ -4255,8 +4307,12 @@ static void visual_refresh(RCore *core) {
 #endif
 	blocksize = core->num->value? core->num->value: core->blocksize;
 	core->cons->context->noflush = false;
-	/* this is why there's flickering */
-	if (core->print->vflush) {
+	if (can_drop && r_cons_input_pending ()) {
+		// this frame is already outdated, handle the keys first
+		core->print->screen_bounds = 0;
+		r_cons_reset ();
+	} else if (core->print->vflush) {
+		/* this is why there's flickering */
 		r_cons_visual_flush ();
 	} else {
 		r_cons_reset ();
@@ -4486,7 +4542,12 @@ dodo:
 #endif
 		core->print->vflush = !skip;
 
-		visual_refresh (core);
+		if (!skip && visual_can_drop_frame (core) && r_cons_input_pending ()) {
+			// under key repeat only the frame after the last key is rendered
+			core->print->screen_bounds = 0;
+		} else {
+			visual_refresh (core);
+		}
 		if (insert_mode_enabled (core)) {
 			goto dodo;
 		}
@@ -965,14 +965,13 @@ R_API bool r_core_visual_hudstuff(RCore *core) {
 	}
 	list->free = free;
 	r_flag_foreach (core->flags, hudstuff_append, list);
-	RIntervalTreeIter it;
-	RAnalMetaItem *mi;
-	r_interval_tree_foreach (&core->anal->meta, it, mi) {
-		if (mi->type == R_META_TYPE_COMMENT) {
-			char *s = r_str_newf ("0x%08"PFMT64x" %s", r_interval_tree_iter_get (&it)->start, mi->str);
-			if (s) {
-				r_list_push (list, s);
-			}
+	RAnalMetaIter it;
+	RIntervalNode *node;
+	r_meta_foreach_type (core->anal, it, node, R_META_TYPE_COMMENT) {
+		RAnalMetaItem *mi = node->data;
+		char *s = r_str_newf ("0x%08"PFMT64x" %s", node->start, mi->str);
+		if (s) {
+			r_list_push (list, s);
 		}
 	}
 	res = r_cons_hud (list, NULL);
@@ -2228,15 +2227,13 @@ R_API int r_core_visual_comments(RCore *core) {
 	for (;;) {
 		r_cons_clear00 ();
 		r_cons_strcat ("Comments:\n");
-		RIntervalTreeIter it;
-		RAnalMetaItem *item;
+		RAnalMetaIter it;
+		RIntervalNode *node;
 		i = 0;
-		r_interval_tree_foreach (&core->anal->meta, it, item) {
-			if (item->type != R_META_TYPE_COMMENT) {
-				continue;
-			}
+		r_meta_foreach_type (core->anal, it, node, R_META_TYPE_COMMENT) {
+			RAnalMetaItem *item = node->data;
 			str = item->str;
-			addr = r_interval_tree_iter_get (&it)->start;
+			addr = node->start;
 			if (option==i) {
 				from = addr;
 				size = 1; // XXX: remove this thing size for comments is useless d->size;
@@ -29,18 +29,211 @@ static const char *str_callback(RNum *user, ut64 off, int *ok) {
 	return NULL;
 }
 
-static void flag_skiplist_free(void *data) {
-	RFlagsAtOffset *item = (RFlagsAtOffset *)data;
-	r_list_free (item->flags);
-	free (data);
+static void flags_at_offset_free(RFlagsAtOffset *fao) {
+	r_list_free (fao->flags);
+	free (fao);
 }
 
-static int flag_skiplist_cmp(const void *va, const void *vb) {
-	const RFlagsAtOffset *a = (RFlagsAtOffset *)va, *b = (RFlagsAtOffset *)vb;
-	if (a->off == b->off) {
-		return 0;
+static void offidx_block_free(void *data) {
+	RFlagOffBlock *b = (RFlagOffBlock *)data;
+	ut32 i;
+	for (i = 0; i < b->len; i++) {
+		flags_at_offset_free (b->fao[i]);
 	}
-	return a->off < b->off? -1: 1;
+	free (b);
+}
+
+static void offidx_init(RFlagOffIndex *x) {
+	r_pvector_init (&x->blocks, offidx_block_free);
+	x->count = 0;
+	x->gen++;
+	x->cur_valid = false;
+}
+
+static inline RFlagOffBlock *offidx_block(RFlagOffIndex *x, size_t b) {
+	return b < r_pvector_len (&x->blocks)? r_pvector_at (&x->blocks, b): NULL;
+}
+
+// last slot in the block with a key <= off, the first key must be <= off
+static ut32 offidx_block_leq(RFlagOffBlock *blk, ut64 off) {
+	ut32 lo = 1, hi = blk->len;
+	while (lo < hi) {
+		ut32 mid = lo + (hi - lo) / 2;
+		if (blk->off[mid] <= off) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo - 1;
+}
+
+// check if the slot at (b, i) is the last one with a key <= off
+static bool offidx_is_leq(RFlagOffIndex *x, size_t b, ut32 i, ut64 off) {
+	RFlagOffBlock *blk = offidx_block (x, b);
+	if (!blk || i >= blk->len || blk->off[i] > off) {
+		return false;
+	}
+	if (i + 1 < blk->len) {
+		return blk->off[i + 1] > off;
+	}
+	RFlagOffBlock *next = offidx_block (x, b + 1);
+	return !next || next->off[0] > off;
+}
+
+/* find the position of the last key <= off, false if all keys are greater.
+ * Sequential scans (like the disassembler does) are resolved by looking at
+ * the neighbours of the previous lookup before doing a binary search. */
+static bool offidx_seek(RFlagOffIndex *x, ut64 off, size_t *pb, ut32 *pi) {
+	size_t b, nb = r_pvector_len (&x->blocks);
+	ut32 i;
+	if (!nb) {
+		return false;
+	}
+	if (x->cur_valid) {
+		b = x->cur_block;
+		i = x->cur_idx;
+		if (offidx_is_leq (x, b, i, off)) {
+			goto found;
+		}
+		RFlagOffBlock *blk = offidx_block (x, b);
+		if (blk && i < blk->len && blk->off[i] < off) {
+			// step forward
+			if (i + 1 < blk->len) {
+				i++;
+			} else {
+				b++;
+				i = 0;
+			}
+		} else if (i > 0) {
+			i--;
+		} else if (b > 0) {
+			b--;
+			blk = offidx_block (x, b);
+			i = blk->len - 1;
+		}
+		if (offidx_is_leq (x, b, i, off)) {
+			goto found;
+		}
+	}
+	size_t lo = 0, hi = nb;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		RFlagOffBlock *blk = r_pvector_at (&x->blocks, mid);
+		if (blk->off[0] <= off) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (!lo) {
+		return false;
+	}
+	b = lo - 1;
+	i = offidx_block_leq (r_pvector_at (&x->blocks, b), off);
+found:
+	x->cur_valid = true;
+	x->cur_block = *pb = b;
+	x->cur_idx = *pi = i;
+	return true;
+}
+
+static RFlagsAtOffset *offidx_at(RFlagOffIndex *x, size_t b, ut32 i) {
+	RFlagOffBlock *blk = offidx_block (x, b);
+	return (blk && i < blk->len)? blk->fao[i]: NULL;
+}
+
+static RFlagsAtOffset *offidx_next(RFlagOffIndex *x, size_t *b, ut32 *i) {
+	RFlagOffBlock *blk = offidx_block (x, *b);
+	if (blk && *i + 1 < blk->len) {
+		(*i)++;
+	} else {
+		(*b)++;
+		*i = 0;
+	}
+	return offidx_at (x, *b, *i);
+}
+
+// first entry with a key > off
+static RFlagsAtOffset *offidx_after(RFlagOffIndex *x, ut64 off, size_t *b, ut32 *i) {
+	if (offidx_seek (x, off, b, i)) {
+		return offidx_next (x, b, i);
+	}
+	*b = 0;
+	*i = 0;
+	return offidx_at (x, 0, 0);
+}
+
+static bool offidx_insert(RFlagOffIndex *x, RFlagsAtOffset *fao) {
+	size_t b = 0;
+	ut32 i = 0;
+	if (offidx_seek (x, fao->off, &b, &i)) {
+		i++;
+	}
+	RFlagOffBlock *blk = offidx_block (x, b);
+	if (!blk) {
+		blk = R_NEW0 (RFlagOffBlock);
+		if (!blk || !r_pvector_insert (&x->blocks, b, blk)) {
+			free (blk);
+			return false;
+		}
+	}
+	if (blk->len == R_FLAG_OFF_BLOCK) {
+		bool tail = i == blk->len && b + 1 == r_pvector_len (&x->blocks);
+		RFlagOffBlock *nblk = R_NEW0 (RFlagOffBlock);
+		if (!nblk || !r_pvector_insert (&x->blocks, b + 1, nblk)) {
+			free (nblk);
+			return false;
+		}
+		if (tail) {
+			// appending in order, keep the blocks full
+			blk = nblk;
+			b++;
+			i = 0;
+		} else {
+			ut32 half = blk->len / 2;
+			nblk->len = blk->len - half;
+			memcpy (nblk->off, blk->off + half, nblk->len * sizeof (ut64));
+			memcpy (nblk->fao, blk->fao + half, nblk->len * sizeof (RFlagsAtOffset *));
+			blk->len = half;
+			if (i > half) {
+				blk = nblk;
+				b++;
+				i -= half;
+			}
+		}
+	}
+	memmove (blk->off + i + 1, blk->off + i, (blk->len - i) * sizeof (ut64));
+	memmove (blk->fao + i + 1, blk->fao + i, (blk->len - i) * sizeof (RFlagsAtOffset *));
+	blk->off[i] = fao->off;
+	blk->fao[i] = fao;
+	blk->len++;
+	x->count++;
+	x->gen++;
+	x->cur_valid = true;
+	x->cur_block = b;
+	x->cur_idx = i;
+	return true;
+}
+
+static void offidx_delete(RFlagOffIndex *x, RFlagsAtOffset *fao) {
+	size_t b;
+	ut32 i;
+	if (!offidx_seek (x, fao->off, &b, &i) || offidx_at (x, b, i) != fao) {
+		return;
+	}
+	RFlagOffBlock *blk = offidx_block (x, b);
+	blk->len--;
+	memmove (blk->off + i, blk->off + i + 1, (blk->len - i) * sizeof (ut64));
+	memmove (blk->fao + i, blk->fao + i + 1, (blk->len - i) * sizeof (RFlagsAtOffset *));
+	if (!blk->len) {
+		r_pvector_remove_at (&x->blocks, b);
+		free (blk);
+	}
+	flags_at_offset_free (fao);
+	x->count--;
+	x->gen++;
+	x->cur_valid = false;
 }
 
 static ut64 num_callback(RNum *user, const char *name, int *ok) {
@@ -51,7 +244,7 @@ static ut64 num_callback(RNum *user, const char *name, int *ok) {
 	RFlagItem *item = ht_pp_find (f->ht_name, name, NULL);
 	if (item) {
 		// NOTE: to avoid warning infinite loop here we avoid recursivity
-		if (item->alias) {
+		if (r_flag_item_alias (item)) {
 			return 0LL;
 		}
 		if (ok) {
@@ -74,16 +267,70 @@ static void free_item_name(RFlagItem *item) {
 	}
 }
 
+typedef struct {
+	RFlagItem *item;
+	size_t seq;
+} PendingFlag;
+
+static int pending_cmp(const void *a, const void *b) {
+	const PendingFlag *pa = a, *pb = b;
+	if (pa->item->offset != pb->item->offset) {
+		return pa->item->offset < pb->item->offset? -1: 1;
+	}
+	return (pa->seq > pb->seq) - (pa->seq < pb->seq);
+}
+
+static RFlagsAtOffset *flags_at_offset(RFlag *f, ut64 off);
+
+// add the items created in bulk mode to the offset index, sorted by address
+// so consecutive items at the same offset share a single index lookup
+static void flag_bulk_flush(RFlag *f) {
+	size_t i, n = r_pvector_len (&f->pending);
+	if (!n) {
+		return;
+	}
+	PendingFlag *sorted = R_NEWS (PendingFlag, n);
+	if (sorted) {
+		for (i = 0; i < n; i++) {
+			sorted[i].item = r_pvector_at (&f->pending, i);
+			sorted[i].seq = i;
+		}
+		qsort (sorted, n, sizeof (PendingFlag), pending_cmp);
+	}
+	// the pending list must be empty before touching by_off again
+	RPVector pending = f->pending;
+	r_pvector_init (&f->pending, NULL);
+	RFlagsAtOffset *fao = NULL;
+	for (i = 0; i < n; i++) {
+		RFlagItem *item = sorted? sorted[i].item: r_pvector_at (&pending, i);
+		if (!fao || fao->off != (f->mask? item->offset & f->mask: item->offset)) {
+			fao = flags_at_offset (f, item->offset);
+			if (!fao) {
+				continue;
+			}
+		}
+		r_list_append (fao->flags, item);
+	}
+	free (sorted);
+	r_pvector_fini (&pending);
+}
+
 /* return the list of flag at the nearest position.
    dir == -1 -> result <= off
    dir == 0 ->  result == off
    dir == 1 ->  result >= off*/
 static RFlagsAtOffset *r_flag_get_nearest_list(RFlag *f, ut64 off, int dir) {
-	RFlagsAtOffset key = { .off = off };
-	RFlagsAtOffset *flags = (dir >= 0)
-		? r_skiplist_get_geq (f->by_off, &key)
-		: r_skiplist_get_leq (f->by_off, &key);
-	return (dir == 0 && flags && flags->off != off)? NULL: flags;
+	flag_bulk_flush (f);
+	size_t b;
+	ut32 i;
+	if (!offidx_seek (&f->by_off, off, &b, &i)) {
+		return dir > 0? offidx_at (&f->by_off, 0, 0): NULL;
+	}
+	RFlagsAtOffset *flags = offidx_at (&f->by_off, b, i);
+	if (flags->off == off || dir < 0) {
+		return flags;
+	}
+	return dir > 0? offidx_next (&f->by_off, &b, &i): NULL;
 }
 
 static void remove_offsetmap(RFlag *f, RFlagItem *item) {
@@ -92,7 +339,7 @@ static void remove_offsetmap(RFlag *f, RFlagItem *item) {
 	if (flags) {
 		r_list_delete_data (flags->flags, item);
 		if (r_list_empty (flags->flags)) {
-			r_skiplist_delete (f->by_off, flags);
+			offidx_delete (&f->by_off, flags);
 		}
 		R_DIRTY (f);
 	}
@@ -120,10 +367,38 @@ static RFlagsAtOffset *flags_at_offset(RFlag *f, ut64 off) {
 	}
 
 	res->off = off;
-	r_skiplist_insert (f->by_off, res);
+	if (!offidx_insert (&f->by_off, res)) {
+		flags_at_offset_free (res);
+		return NULL;
+	}
 	return res;
 }
 
+static void flag_item_meta_free(RFlagItemMeta *meta) {
+	if (meta) {
+		free (meta->color);
+		free (meta->comment);
+		free (meta->alias);
+		free (meta->type);
+		free (meta);
+	}
+}
+
+static RFlagItemMeta *flag_item_meta(RFlagItem *item) {
+	if (!item->meta) {
+		item->meta = R_NEW0 (RFlagItemMeta);
+	}
+	return item->meta;
+}
+
+// drop the meta block once all its fields are unset
+static void flag_item_meta_gc(RFlagItem *item) {
+	RFlagItemMeta *m = item->meta;
+	if (m && !m->color && !m->comment && !m->alias && !m->type) {
+		R_FREE (item->meta);
+	}
+}
+
 static char *filter_item_name(const char *name) {
 	char *res = strdup (name);
 	if (!res) {
@@ -148,6 +423,11 @@ static bool update_flag_item_offset(RFlag *f, RFlagItem *item, ut64 newoff, bool
 			remove_offsetmap (f, item);
 		}
 		item->offset = newoff;
+		if (is_new && f->bulk) {
+			r_pvector_push (&f->pending, item);
+			R_DIRTY (f);
+			return true;
+		}
 
 		RFlagsAtOffset *flagsAtOffset = flags_at_offset (f, newoff);
 		if (!flagsAtOffset) {
@@ -162,17 +442,8 @@ static bool update_flag_item_offset(RFlag *f, RFlagItem *item, ut64 newoff, bool
 	return false;
 }
 
-static bool update_flag_item_name(RFlag *f, RFlagItem *item, const char *newname, bool force) {
-	if (!f || !item || !newname) {
-		return false;
-	}
-	if (!force && (item->name == newname || (item->name && !strcmp (item->name, newname)))) {
-		return false;
-	}
-	char *fname = filter_item_name (newname);
-	if (!fname) {
-		return false;
-	}
+// takes ownership of the already filtered name
+static bool set_flag_item_name(RFlag *f, RFlagItem *item, char *fname) {
 	bool res = (item->name)
 		? ht_pp_update_key (f->ht_name, item->name, fname)
 		: ht_pp_insert (f->ht_name, fname, item);
@@ -185,11 +456,33 @@ static bool update_flag_item_name(RFlag *f, RFlagItem *item, const char *newname
 	return false;
 }
 
+static bool update_flag_item_name(RFlag *f, RFlagItem *item, const char *newname, bool force) {
+	if (!f || !item || !newname) {
+		return false;
+	}
+	if (!force && (item->name == newname || (item->name && !strcmp (item->name, newname)))) {
+		return false;
+	}
+	char *fname = filter_item_name (newname);
+	return fname && set_flag_item_name (f, item, fname);
+}
+
+// the keys of ht_name are borrowed from item->name, only the items are owned
 static void ht_free_flag(HtPPKv *kv) {
-	free (kv->key);
 	r_flag_item_free (kv->value);
 }
 
+static HtPP *new_ht_name(void) {
+	HtPPOptions opt = {
+		.cmp = (HtPPListComparator)strcmp,
+		.hashfn = (HtPPHashFunction)sdb_hash,
+		.calcsizeK = (HtPPCalcSizeK)strlen,
+		.freefn = ht_free_flag,
+		.elem_size = sizeof (HtPPKv),
+	};
+	return ht_pp_new_opt (&opt);
+}
+
 static bool count_flags(RFlagItem *fi, void *user) {
 	int *count = (int *)user;
 	(*count)++;
@@ -235,8 +528,9 @@ R_API RFlag *r_flag_new(void) {
 	f->cb_printf = (PrintfCallback)printf;
 	f->zones = r_list_newf (r_flag_zone_item_free);
 	f->tags = sdb_new0 ();
-	f->ht_name = ht_pp_new (NULL, ht_free_flag, NULL);
-	f->by_off = r_skiplist_new (flag_skiplist_free, flag_skiplist_cmp);
+	f->ht_name = new_ht_name ();
+	offidx_init (&f->by_off);
+	r_pvector_init (&f->pending, NULL);
 	new_spaces (f);
 	R_DIRTY (f);
 	return f;
@@ -249,9 +543,15 @@ R_API RFlagItem *r_flag_item_clone(RFlagItem *item) {
 	if (!n) {
 		return NULL;
 	}
-	n->color = STRDUP_OR_NULL (item->color);
-	n->comment = STRDUP_OR_NULL (item->comment);
-	n->alias = STRDUP_OR_NULL (item->alias);
+	if (item->meta) {
+		n->meta = R_NEW0 (RFlagItemMeta);
+		if (n->meta) {
+			n->meta->color = STRDUP_OR_NULL (item->meta->color);
+			n->meta->comment = STRDUP_OR_NULL (item->meta->comment);
+			n->meta->alias = STRDUP_OR_NULL (item->meta->alias);
+			n->meta->type = STRDUP_OR_NULL (item->meta->type);
+		}
+	}
 	n->name = STRDUP_OR_NULL (item->name);
 	n->realname = STRDUP_OR_NULL (item->realname);
 	n->offset = item->offset;
@@ -264,9 +564,7 @@ R_API void r_flag_item_free(RFlagItem *item) {
 	if (!item) {
 		return;
 	}
-	free (item->color);
-	free (item->comment);
-	free (item->alias);
+	flag_item_meta_free (item->meta);
 	/* release only one of the two pointers if they are the same */
 	free_item_name (item);
 	free (item->realname);
@@ -275,7 +573,8 @@ R_API void r_flag_item_free(RFlagItem *item) {
 
 R_API RFlag *r_flag_free(RFlag *f) {
 	r_return_val_if_fail (f, NULL);
-	r_skiplist_free (f->by_off);
+	r_pvector_fini (&f->pending);
+	r_pvector_fini (&f->by_off.blocks);
 	ht_pp_free (f->ht_name);
 	sdb_free (f->tags);
 	r_spaces_fini (&f->spaces);
@@ -313,13 +612,15 @@ static bool print_flag_json(RFlagItem *flag, void *user) {
 		pj_ks (u->pj, "realname", flag->realname);
 	}
 	pj_ki (u->pj, "size", flag->size);
-	if (flag->alias) {
-		pj_ks (u->pj, "alias", flag->alias);
+	const char *alias = r_flag_item_alias (flag);
+	if (alias) {
+		pj_ks (u->pj, "alias", alias);
 	} else {
 		pj_kn (u->pj, "offset", flag->offset);
 	}
-	if (flag->comment) {
-		pj_ks (u->pj, "comment", flag->comment);
+	const char *comment = r_flag_item_comment (flag);
+	if (comment) {
+		pj_ks (u->pj, "comment", comment);
 	}
 	pj_end (u->pj);
 	return true;
@@ -335,8 +636,10 @@ static bool print_flag_rad(RFlagItem *flag, void *user) {
 		u->fs = flag->space;
 		u->f->cb_printf ("fs %s\n", u->fs? u->fs->name: "*");
 	}
-	if (flag->comment && *flag->comment) {
-		comment_b64 = r_base64_encode_dyn (flag->comment, -1);
+	const char *comment = r_flag_item_comment (flag);
+	const char *alias = r_flag_item_alias (flag);
+	if (comment && *comment) {
+		comment_b64 = r_base64_encode_dyn (comment, -1);
 		// prefix the armored string with "base64:"
 		if (comment_b64) {
 			tmp = r_str_newf ("base64:%s", comment_b64);
@@ -344,8 +647,8 @@ static bool print_flag_rad(RFlagItem *flag, void *user) {
 			comment_b64 = tmp;
 		}
 	}
-	if (flag->alias) {
-		u->f->cb_printf ("fa %s %s\n", flag->name, flag->alias);
+	if (alias) {
+		u->f->cb_printf ("fa %s %s\n", flag->name, alias);
 		if (comment_b64) {
 			u->f->cb_printf ("\"fC %s %s\"\n",
 				flag->name, r_str_get (comment_b64));
@@ -366,9 +669,10 @@ static bool print_flag_orig_name(RFlagItem *flag, void *user) {
 	if (u->in_range && (flag->offset < u->range_from || flag->offset >= u->range_to)) {
 		return true;
 	}
-	if (flag->alias) {
+	const char *alias = r_flag_item_alias (flag);
+	if (alias) {
 		const char *n = u->real? flag->realname: flag->name;
-		u->f->cb_printf ("%s %"PFMT64d" %s\n", flag->alias, flag->size, n);
+		u->f->cb_printf ("%s %"PFMT64d" %s\n", alias, flag->size, n);
 	} else {
 		const char *n = u->real? flag->realname: (u->f->realnames? flag->realname: flag->name);
 		u->f->cb_printf ("0x%08" PFMT64x " %" PFMT64d " %s\n", flag->offset, flag->size, n);
@@ -472,8 +776,9 @@ R_API void r_flag_list(RFlag *f, int rad, const char *pfx) {
 
 static RFlagItem *evalFlag(RFlag *f, RFlagItem *item) {
 	r_return_val_if_fail (f && item, NULL);
-	if (item->alias) {
-		item->offset = r_num_math (f->num, item->alias);
+	const char *alias = r_flag_item_alias (item);
+	if (alias) {
+		item->offset = r_num_math (f->num, alias);
 	}
 	return item;
 }
@@ -764,8 +1069,8 @@ R_API RFlagItem *r_flag_set(RFlag *f, const char *name, ut64 off, ut32 size) {
 	}
 
 	RFlagItem *item = r_flag_get (f, itemname);
-	free (itemname);
 	if (item && item->offset == off) {
+		free (itemname);
 		item->size = size;
 		return item;
 	}
@@ -773,7 +1078,8 @@ R_API RFlagItem *r_flag_set(RFlag *f, const char *name, ut64 off, ut32 size) {
 	if (!item) {
 		item = R_NEW0 (RFlagItem);
 		if (!item) {
-			goto err;
+			free (itemname);
+			return NULL;
 		}
 		is_new = true;
 	}
@@ -782,25 +1088,55 @@ R_API RFlagItem *r_flag_set(RFlag *f, const char *name, ut64 off, ut32 size) {
 	item->size = size;
 
 	update_flag_item_offset (f, item, off + f->base, is_new, true);
-	update_flag_item_name (f, item, name, true);
+	if (is_new) {
+		set_flag_item_name (f, item, itemname);
+	} else {
+		free (itemname);
+	}
 	return item;
-err:
-	r_flag_item_free (item);
-	return NULL;
+}
+
+/* defer the offset index updates of the new flags until r_flag_bulk_end,
+ * meant to be wrapped around loops that create lots of flags. Lookups by
+ * offset done in between are still correct, but flush the pending items. */
+R_API void r_flag_bulk_begin(RFlag *f) {
+	r_return_if_fail (f);
+	f->bulk++;
+}
+
+R_API void r_flag_bulk_end(RFlag *f) {
+	r_return_if_fail (f && f->bulk > 0);
+	if (!--f->bulk) {
+		flag_bulk_flush (f);
+	}
 }
 
 /* add/replace/remove the alias of a flag item */
 R_API void r_flag_item_set_alias(RFlagItem *item, const char *alias) {
 	r_return_if_fail (item);
-	free (item->alias);
-	item->alias = R_STR_ISEMPTY (alias)? NULL: strdup (alias);
+	if (R_STR_ISEMPTY (alias) && !item->meta) {
+		return;
+	}
+	RFlagItemMeta *m = flag_item_meta (item);
+	if (m) {
+		free (m->alias);
+		m->alias = R_STR_ISEMPTY (alias)? NULL: strdup (alias);
+		flag_item_meta_gc (item);
+	}
 }
 
 /* add/replace/remove the comment of a flag item */
 R_API void r_flag_item_set_comment(RFlagItem *item, const char *comment) {
 	r_return_if_fail (item);
-	free (item->comment);
-	item->comment = R_STR_ISEMPTY (comment)? NULL: strdup (comment);
+	if (R_STR_ISEMPTY (comment) && !item->meta) {
+		return;
+	}
+	RFlagItemMeta *m = flag_item_meta (item);
+	if (m) {
+		free (m->comment);
+		m->comment = R_STR_ISEMPTY (comment)? NULL: strdup (comment);
+		flag_item_meta_gc (item);
+	}
 }
 
 /* add/replace/remove the realname of a flag item */
@@ -813,9 +1149,17 @@ R_API void r_flag_item_set_realname(RFlagItem *item, const char *realname) {
 /* add/replace/remove the color of a flag item */
 R_API const char *r_flag_item_set_color(RFlagItem *item, const char *color) {
 	r_return_val_if_fail (item, NULL);
-	free (item->color);
-	item->color = (color && *color) ? strdup (color) : NULL;
-	return item->color;
+	if (R_STR_ISEMPTY (color) && !item->meta) {
+		return NULL;
+	}
+	RFlagItemMeta *m = flag_item_meta (item);
+	if (!m) {
+		return NULL;
+	}
+	free (m->color);
+	m->color = (color && *color) ? strdup (color) : NULL;
+	flag_item_meta_gc (item);
+	return r_flag_item_color (item);
 }
 
 /* change the name of a flag item, if the new name is available.
@@ -827,8 +1171,11 @@ R_API int r_flag_rename(RFlag *f, RFlagItem *item, const char *name) {
 
 R_API void r_flag_item_set_type(RFlagItem *fi, const char *type) {
 	r_return_if_fail (fi && type);
-	free (fi->type);
-	fi->type = strdup (type);
+	RFlagItemMeta *m = flag_item_meta (fi);
+	if (m) {
+		free (m->type);
+		m->type = strdup (type);
+	}
 }
 
 /* unset the given flag item.
@@ -893,9 +1240,11 @@ R_API bool r_flag_unset_name(RFlag *f, const char *name) {
 /* unset all flag items in the RFlag f */
 R_API void r_flag_unset_all(RFlag *f) {
 	r_return_if_fail (f);
+	r_pvector_clear (&f->pending);
 	ht_pp_free (f->ht_name);
-	f->ht_name = ht_pp_new (NULL, ht_free_flag, NULL);
-	r_skiplist_purge (f->by_off);
+	f->ht_name = new_ht_name ();
+	r_pvector_fini (&f->by_off.blocks);
+	offidx_init (&f->by_off);
 	r_spaces_fini (&f->spaces);
 	new_spaces (f);
 	R_DIRTY (f);
@@ -977,21 +1326,30 @@ R_API int r_flag_count(RFlag *f, const char *glob) {
 	return count;
 }
 
+// callbacks can add or remove flags, so the position is looked up again
+// by offset when the index changes under our feet
 #define FOREACH_BODY(condition) \
-	RSkipListNode *it, *tmp; \
 	RFlagsAtOffset *flags_at; \
 	RListIter *it2, *tmp2;	  \
 	RFlagItem *fi; \
-	r_skiplist_foreach_safe (f->by_off, it, tmp, flags_at) { \
-		if (flags_at) { \
-			r_list_foreach_safe (flags_at->flags, it2, tmp2, fi) {	\
-				if (condition) { \
-					if (!cb (fi, user)) { \
-						return; \
-					} \
+	size_t b = 0; \
+	ut32 i = 0; \
+	flag_bulk_flush (f); \
+	flags_at = offidx_at (&f->by_off, 0, 0); \
+	while (flags_at) { \
+		ut32 gen = f->by_off.gen; \
+		ut64 off = flags_at->off; \
+		r_list_foreach_safe (flags_at->flags, it2, tmp2, fi) {	\
+			if (condition) { \
+				if (!cb (fi, user)) { \
+					return; \
 				} \
 			} \
 		} \
+		flag_bulk_flush (f); \
+		flags_at = (gen == f->by_off.gen) \
+			? offidx_next (&f->by_off, &b, &i) \
+			: offidx_after (&f->by_off, off, &b, &i); \
 	}
 
 R_API void r_flag_foreach(RFlag *f, RFlagItemCb cb, void *user) {
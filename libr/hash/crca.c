@@ -3,6 +3,7 @@
 //some definitions and test cases borrowed from http://www.nightmare.com/~ryb/code/CrcMoose.py (Ray Burr)
 
 #include <r_hash.h>
+#include "hw.h"
 
 void crc_init (R_CRC_CTX *ctx, utcrc crc, ut32 size, int reflect, utcrc poly, utcrc xout) {
 	ctx->crc = crc;
@@ -12,10 +13,69 @@ void crc_init (R_CRC_CTX *ctx, utcrc crc, ut32 size, int reflect, utcrc poly, ut
 	ctx->xout = xout;
 }
 
+static utcrc crc_reflect(utcrc crc, ut32 size) {
+	utcrc r = 0;
+	ut32 i;
+	for (i = 0; i < size; i++, crc >>= 1) {
+		r = (r << 1) | (crc & 1);
+	}
+	return r;
+}
+
+// byte at a time with a 256 entry table, same result as the bitwise loop
+static void crc_update_table(R_CRC_CTX *ctx, const ut8 *data, ut32 sz) {
+	const utcrc mask = (((UTCRC_C(1) << (ctx->size - 1)) - 1) << 1) | 1;
+	const ut32 shift = ctx->size - 8;
+	utcrc table[256], crc, c;
+	ut32 i, j;
+
+	if (ctx->reflect) {
+		const utcrc poly = crc_reflect (ctx->poly, ctx->size);
+		for (i = 0; i < 256; i++) {
+			for (c = i, j = 0; j < 8; j++) {
+				c = (c & 1)? (c >> 1) ^ poly: c >> 1;
+			}
+			table[i] = c;
+		}
+		crc = crc_reflect (ctx->crc & mask, ctx->size);
+		i = 0;
+		// the common 32 bit polynomials have cpu instructions
+		if (ctx->size == 32 && ctx->poly == 0x04C11DB7) {
+			ut32 r = (ut32)crc;
+			i = r_hash_hw_crc32 (&r, data, sz);
+			crc = r;
+		} else if (ctx->size == 32 && ctx->poly == 0x1EDC6F41) {
+			ut32 r = (ut32)crc;
+			i = r_hash_hw_crc32c (&r, data, sz);
+			crc = r;
+		}
+		for (; i < sz; i++) {
+			crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xff];
+		}
+		ctx->crc = crc_reflect (crc, ctx->size);
+	} else {
+		for (i = 0; i < 256; i++) {
+			for (c = (utcrc)i << shift, j = 0; j < 8; j++) {
+				c = ((c >> (ctx->size - 1)) & 1)? (c << 1) ^ ctx->poly: c << 1;
+			}
+			table[i] = c & mask;
+		}
+		crc = ctx->crc & mask;
+		for (i = 0; i < sz; i++) {
+			crc = ((crc << 8) & mask) ^ table[((crc >> shift) ^ data[i]) & 0xff];
+		}
+		ctx->crc = crc;
+	}
+}
+
 void crc_update (R_CRC_CTX *ctx, const ut8 *data, ut32 sz) {
 	utcrc crc, d;
 	int i, j;
 
+	if (sz >= 256 && ctx->size >= 8) {
+		crc_update_table (ctx, data, sz);
+		return;
+	}
 	crc = ctx->crc;
 	for (i = 0; i < sz; i++) {
 		d = data[i];
@@ -8,16 +8,60 @@
 #include <stdlib.h>
 #include <math.h>
 #include "r_types.h"
+#include "r_util.h"
+#include "r_hash.h"
+
+#define ENTROPY_THREADS_MAX 16
+// below this amount of data threads cost more than they save
+#define ENTROPY_THREADS_MIN_SIZE (1024 * 1024)
+
+/**
+ * @brief Count the occurrences of each byte value
+ *
+ * Uses four interleaved sub-histograms and 8 byte loads, so runs of
+ * the same byte do not stall on a single counter.
+ */
+R_API void r_hash_histogram(const ut8 *data, ut64 size, ut64 count[256]) {
+	ut32 sub[4][256];
+	ut64 i, j;
+	memset (count, 0, 256 * sizeof (ut64));
+	if (!data) {
+		return;
+	}
+	while (size > 0) {
+		// keep the 32 bit counters from overflowing
+		ut64 n = R_MIN (size, (ut64)1 << 30);
+		memset (sub, 0, sizeof (sub));
+		for (i = 0; i + 8 <= n; i += 8) {
+			ut64 w;
+			memcpy (&w, data + i, sizeof (w));
+			sub[0][w & 0xff]++;
+			sub[1][(w >> 8) & 0xff]++;
+			sub[2][(w >> 16) & 0xff]++;
+			sub[3][(w >> 24) & 0xff]++;
+			sub[0][(w >> 32) & 0xff]++;
+			sub[1][(w >> 40) & 0xff]++;
+			sub[2][(w >> 48) & 0xff]++;
+			sub[3][w >> 56]++;
+		}
+		for (; i < n; i++) {
+			sub[0][data[i]]++;
+		}
+		for (j = 0; j < 256; j++) {
+			count[j] += (ut64)sub[0][j] + sub[1][j] + sub[2][j] + sub[3][j];
+		}
+		data += n;
+		size -= n;
+	}
+}
 
 R_API double r_hash_entropy(const ut8 *data, ut64 size) {
 	if (!data || !size) {
 		return 0;
 	}
-	ut64 i, count[256] = {0};
+	ut64 i, count[256];
 	double h = 0;
-	for (i = 0; i < size; i++) {
-		count[data[i]]++;
-	}
+	r_hash_histogram (data, size, count);
 	for (i = 0; i < 256; i++) {
 		if (count[i]) {
 			double p = (double) count[i] / size;
@@ -30,3 +74,64 @@ R_API double r_hash_entropy_fraction(const ut8 *data, ut64 size) {
 	return size ? r_hash_entropy (data, size) / \
 		log2 ((double) R_MIN (size, 256)) : 0;
 }
+
+typedef struct {
+	const ut8 *data;
+	ut64 blocksize;
+	size_t nblocks;
+	double *out;
+	int nthreads;
+	int tid;
+} EntropyBlocks;
+
+static void entropy_blocks(EntropyBlocks *b) {
+	size_t i;
+	for (i = b->tid; i < b->nblocks; i += b->nthreads) {
+		b->out[i] = r_hash_entropy_fraction (b->data + i * b->blocksize, b->blocksize);
+	}
+}
+
+static RThreadFunctionRet entropy_blocks_thread(RThread *th) {
+	entropy_blocks (th->user);
+	return R_TH_STOP;
+}
+
+/**
+ * @brief Entropy fraction of each of the nblocks consecutive blocks in data
+ *
+ * Big inputs are split between a few threads.
+ */
+R_API void r_hash_entropy_fraction_blocks(const ut8 *data, ut64 blocksize, size_t nblocks, double *out) {
+	r_return_if_fail (data && out);
+	RThread *threads[ENTROPY_THREADS_MAX] = {0};
+	EntropyBlocks ctx[ENTROPY_THREADS_MAX];
+	int i, nthreads = 1;
+	if (blocksize * nblocks >= ENTROPY_THREADS_MIN_SIZE) {
+		nthreads = R_MAX (1, R_MIN (R_MIN ((size_t)r_th_ncpus (), nblocks), ENTROPY_THREADS_MAX));
+	}
+	for (i = 0; i < nthreads; i++) {
+		ctx[i] = (EntropyBlocks) {
+			.data = data,
+			.blocksize = blocksize,
+			.nblocks = nblocks,
+			.out = out,
+			.nthreads = nthreads,
+			.tid = i,
+		};
+		if (i > 0) {
+			threads[i] = r_th_new (entropy_blocks_thread, &ctx[i], 0);
+		}
+	}
+	// the calling thread takes its share too, and the ones of failed threads
+	for (i = 0; i < nthreads; i++) {
+		if (!threads[i]) {
+			entropy_blocks (&ctx[i]);
+		}
+	}
+	for (i = 1; i < nthreads; i++) {
+		if (threads[i]) {
+			r_th_wait (threads[i]);
+			r_th_free (threads[i]);
+		}
+	}
+}
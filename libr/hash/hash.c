@@ -117,15 +117,14 @@ static const struct {
 
 /* returns 0-100 */
 R_API int r_hash_pcprint(const ut8 *buffer, ut64 len) {
-	const ut8 *end = buffer + len;
-	int n;
+	ut64 count[256], n = 0;
+	int i;
 	if (len < 1) {
 		return 0;
 	}
-	for (n = 0; buffer < end; buffer++) {
-		if (IS_PRINTABLE (*buffer)) {
-			n++;
-		}
+	r_hash_histogram (buffer, len, count);
+	for (i = ' '; i <= '~'; i++) {
+		n += count[i];
 	}
 	return ((100 * n) / len);
 }
@@ -0,0 +1,331 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include <r_util.h>
+#include "hw.h"
+
+// runtime dispatched backends, set R2_HASH_NOHW=1 to use the portable code
+
+#if (__x86_64__ || __i386__) && ((__GNUC__ >= 5) || __clang__)
+#define HW_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define HW_TARGET(x) __attribute__((target (x)))
+#ifndef bit_SHA
+#define bit_SHA (1 << 29)
+#endif
+#elif __aarch64__ && __ARM_FEATURE_CRC32
+#define HW_ARM 1
+#include <arm_acle.h>
+#endif
+
+// detected once, the lock is taken because several threads may hash at once
+static RThreadLock hw_lock = R_THREAD_LOCK_INIT;
+static int hw_features = -1;
+
+static int hw_detect(void) {
+	int f = 0;
+#if HW_X86
+	unsigned int a, b, c, d;
+	if (__get_cpuid (1, &a, &b, &c, &d)) {
+		if ((c & bit_SSSE3) && (c & bit_SSE4_1) && (c & bit_SSE4_2)) {
+			f |= R_HASH_HW_SSE42;
+			if (c & bit_PCLMUL) {
+				f |= R_HASH_HW_PCLMUL;
+			}
+		}
+	}
+	if ((f & R_HASH_HW_SSE42) && __get_cpuid_max (0, NULL) >= 7) {
+		__cpuid_count (7, 0, a, b, c, d);
+		if (b & bit_SHA) {
+			f |= R_HASH_HW_SHA;
+		}
+	}
+#elif HW_ARM
+	f |= R_HASH_HW_ARMCRC;
+#endif
+	if (r_sys_getenv_asbool ("R2_HASH_NOHW")) {
+		f = 0;
+	}
+	return f;
+}
+
+R_IPI int r_hash_hw(void) {
+	r_th_lock_enter (&hw_lock);
+	if (hw_features == -1) {
+		hw_features = hw_detect ();
+	}
+	const int f = hw_features;
+	r_th_lock_leave (&hw_lock);
+	return f;
+}
+
+#if HW_X86
+// fold 64 bytes at a time with carry-less multiplies, see "Fast CRC
+// Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+// (Gopal et al, Intel 2009). len must be at least 64 and a multiple of 16
+HW_TARGET ("sse4.1,pclmul")
+static ut32 crc32_pclmul(ut32 crc, const ut8 *buf, size_t len) {
+	const __m128i k1k2 = _mm_set_epi64x (0x01c6e41596ULL, 0x0154442bd4ULL);
+	const __m128i k3k4 = _mm_set_epi64x (0x00ccaa009eULL, 0x01751997d0ULL);
+	const __m128i k5k0 = _mm_set_epi64x (0, 0x0163cd6124ULL);
+	const __m128i poly = _mm_set_epi64x (0x01f7011641ULL, 0x01db710641ULL);
+	const __m128i mask32 = _mm_setr_epi32 (~0, 0, ~0, 0);
+	__m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128 ((const __m128i *)(buf + 0x00));
+	x2 = _mm_loadu_si128 ((const __m128i *)(buf + 0x10));
+	x3 = _mm_loadu_si128 ((const __m128i *)(buf + 0x20));
+	x4 = _mm_loadu_si128 ((const __m128i *)(buf + 0x30));
+	x1 = _mm_xor_si128 (x1, _mm_cvtsi32_si128 (crc));
+	buf += 64;
+	len -= 64;
+	while (len >= 64) {
+		x5 = _mm_clmulepi64_si128 (x1, k1k2, 0x00);
+		x6 = _mm_clmulepi64_si128 (x2, k1k2, 0x00);
+		x7 = _mm_clmulepi64_si128 (x3, k1k2, 0x00);
+		x8 = _mm_clmulepi64_si128 (x4, k1k2, 0x00);
+		x1 = _mm_clmulepi64_si128 (x1, k1k2, 0x11);
+		x2 = _mm_clmulepi64_si128 (x2, k1k2, 0x11);
+		x3 = _mm_clmulepi64_si128 (x3, k1k2, 0x11);
+		x4 = _mm_clmulepi64_si128 (x4, k1k2, 0x11);
+		x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x5), _mm_loadu_si128 ((const __m128i *)(buf + 0x00)));
+		x2 = _mm_xor_si128 (_mm_xor_si128 (x2, x6), _mm_loadu_si128 ((const __m128i *)(buf + 0x10)));
+		x3 = _mm_xor_si128 (_mm_xor_si128 (x3, x7), _mm_loadu_si128 ((const __m128i *)(buf + 0x20)));
+		x4 = _mm_xor_si128 (_mm_xor_si128 (x4, x8), _mm_loadu_si128 ((const __m128i *)(buf + 0x30)));
+		buf += 64;
+		len -= 64;
+	}
+	// fold the four lanes into one
+	x5 = _mm_clmulepi64_si128 (x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128 (x1, k3k4, 0x11);
+	x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x2), x5);
+	x5 = _mm_clmulepi64_si128 (x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128 (x1, k3k4, 0x11);
+	x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x3), x5);
+	x5 = _mm_clmulepi64_si128 (x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128 (x1, k3k4, 0x11);
+	x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x4), x5);
+	while (len >= 16) {
+		x2 = _mm_loadu_si128 ((const __m128i *)buf);
+		x5 = _mm_clmulepi64_si128 (x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128 (x1, k3k4, 0x11);
+		x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x2), x5);
+		buf += 16;
+		len -= 16;
+	}
+	// 128 to 64 bits
+	x2 = _mm_clmulepi64_si128 (x1, k3k4, 0x10);
+	x1 = _mm_xor_si128 (_mm_srli_si128 (x1, 8), x2);
+	x2 = _mm_srli_si128 (x1, 4);
+	x1 = _mm_and_si128 (x1, mask32);
+	x1 = _mm_clmulepi64_si128 (x1, k5k0, 0x00);
+	x1 = _mm_xor_si128 (x1, x2);
+	// barrett reduction to 32 bits
+	x2 = _mm_and_si128 (x1, mask32);
+	x2 = _mm_clmulepi64_si128 (x2, poly, 0x10);
+	x2 = _mm_and_si128 (x2, mask32);
+	x2 = _mm_clmulepi64_si128 (x2, poly, 0x00);
+	x1 = _mm_xor_si128 (x1, x2);
+	return _mm_extract_epi32 (x1, 1);
+}
+
+HW_TARGET ("sse4.2")
+static ut32 crc32c_sse42(ut32 crc, const ut8 *buf, size_t len) {
+#if __x86_64__
+	ut64 c = crc;
+	for (; len >= 8; buf += 8, len -= 8) {
+		ut64 w;
+		memcpy (&w, buf, sizeof (w));
+		c = _mm_crc32_u64 (c, w);
+	}
+	crc = (ut32)c;
+#endif
+	for (; len >= 4; buf += 4, len -= 4) {
+		ut32 w;
+		memcpy (&w, buf, sizeof (w));
+		crc = _mm_crc32_u32 (crc, w);
+	}
+	for (; len > 0; buf++, len--) {
+		crc = _mm_crc32_u8 (crc, *buf);
+	}
+	return crc;
+}
+
+// the round function selector must be an immediate
+HW_TARGET ("sha,sse4.1,ssse3")
+static inline __m128i sha1_rnds4(__m128i abcd, __m128i e, int f) {
+	switch (f) {
+	case 0: return _mm_sha1rnds4_epu32 (abcd, e, 0);
+	case 1: return _mm_sha1rnds4_epu32 (abcd, e, 1);
+	case 2: return _mm_sha1rnds4_epu32 (abcd, e, 2);
+	}
+	return _mm_sha1rnds4_epu32 (abcd, e, 3);
+}
+
+HW_TARGET ("sha,sse4.1,ssse3")
+static void sha1_ni(ut32 state[5], const ut8 *data, size_t nblocks) {
+	const __m128i mask = _mm_set_epi64x (0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+	__m128i abcd, abcd_save, e0, e0_save, e1, msg[4];
+	int g;
+
+	abcd = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *)state), 0x1b);
+	e0 = _mm_set_epi32 (state[4], 0, 0, 0);
+	for (; nblocks > 0; nblocks--, data += 64) {
+		abcd_save = abcd;
+		e0_save = e0;
+		e1 = e0;
+		// 20 groups of 4 rounds, the message schedule runs a few groups ahead
+		for (g = 0; g < 20; g++) {
+			__m128i *w = &msg[g % 4];
+			if (g < 4) {
+				*w = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *)(data + g * 16)), mask);
+			}
+			if (g == 0) {
+				e0 = _mm_add_epi32 (e0, *w);
+				e1 = abcd;
+				abcd = sha1_rnds4 (abcd, e0, 0);
+			} else if (g & 1) {
+				e1 = _mm_sha1nexte_epu32 (e1, *w);
+				e0 = abcd;
+				abcd = sha1_rnds4 (abcd, e1, g / 5);
+			} else {
+				e0 = _mm_sha1nexte_epu32 (e0, *w);
+				e1 = abcd;
+				abcd = sha1_rnds4 (abcd, e0, g / 5);
+			}
+			if (g >= 3 && g <= 18) {
+				msg[(g + 1) % 4] = _mm_sha1msg2_epu32 (msg[(g + 1) % 4], *w);
+			}
+			if (g >= 1 && g <= 16) {
+				msg[(g + 3) % 4] = _mm_sha1msg1_epu32 (msg[(g + 3) % 4], *w);
+			}
+			if (g >= 2 && g <= 17) {
+				msg[(g + 2) % 4] = _mm_xor_si128 (msg[(g + 2) % 4], *w);
+			}
+		}
+		e0 = _mm_sha1nexte_epu32 (e0, e0_save);
+		abcd = _mm_add_epi32 (abcd, abcd_save);
+	}
+	_mm_storeu_si128 ((__m128i *)state, _mm_shuffle_epi32 (abcd, 0x1b));
+	state[4] = _mm_extract_epi32 (e0, 3);
+}
+
+static const ut32 sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+HW_TARGET ("sha,sse4.1,ssse3")
+static void sha256_ni(ut32 state[8], const ut8 *data, size_t nblocks) {
+	const __m128i mask = _mm_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0, state1, abef_save, cdgh_save, m, tmp, msg[4];
+	int g;
+
+	tmp = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *)&state[0]), 0xb1); // CDAB
+	state1 = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *)&state[4]), 0x1b); // EFGH
+	state0 = _mm_alignr_epi8 (tmp, state1, 8); // ABEF
+	state1 = _mm_blend_epi16 (state1, tmp, 0xf0); // CDGH
+	for (; nblocks > 0; nblocks--, data += 64) {
+		abef_save = state0;
+		cdgh_save = state1;
+		// 16 groups of 4 rounds, the message schedule runs a few groups ahead
+		for (g = 0; g < 16; g++) {
+			__m128i *w = &msg[g % 4];
+			if (g < 4) {
+				*w = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *)(data + g * 16)), mask);
+			}
+			m = _mm_add_epi32 (*w, _mm_loadu_si128 ((const __m128i *)&sha256_k[g * 4]));
+			state1 = _mm_sha256rnds2_epu32 (state1, state0, m);
+			if (g >= 3 && g <= 14) {
+				__m128i *next = &msg[(g + 1) % 4];
+				tmp = _mm_alignr_epi8 (*w, msg[(g + 3) % 4], 4);
+				*next = _mm_sha256msg2_epu32 (_mm_add_epi32 (*next, tmp), *w);
+			}
+			m = _mm_shuffle_epi32 (m, 0x0e);
+			state0 = _mm_sha256rnds2_epu32 (state0, state1, m);
+			if (g >= 1 && g <= 12) {
+				msg[(g + 3) % 4] = _mm_sha256msg1_epu32 (msg[(g + 3) % 4], *w);
+			}
+		}
+		state0 = _mm_add_epi32 (state0, abef_save);
+		state1 = _mm_add_epi32 (state1, cdgh_save);
+	}
+	tmp = _mm_shuffle_epi32 (state0, 0x1b); // FEBA
+	state1 = _mm_shuffle_epi32 (state1, 0xb1); // DCHG
+	state0 = _mm_blend_epi16 (tmp, state1, 0xf0); // DCBA
+	state1 = _mm_alignr_epi8 (state1, tmp, 8); // ABEF
+	_mm_storeu_si128 ((__m128i *)&state[0], state0);
+	_mm_storeu_si128 ((__m128i *)&state[4], state1);
+}
+#endif
+
+#if HW_ARM
+static ut32 crc32_arm(ut32 crc, const ut8 *buf, size_t len, bool castagnoli) {
+	for (; len >= 8; buf += 8, len -= 8) {
+		ut64 w;
+		memcpy (&w, buf, sizeof (w));
+		crc = castagnoli? __crc32cd (crc, w): __crc32d (crc, w);
+	}
+	for (; len > 0; buf++, len--) {
+		crc = castagnoli? __crc32cb (crc, *buf): __crc32b (crc, *buf);
+	}
+	return crc;
+}
+#endif
+
+R_IPI size_t r_hash_hw_crc32(ut32 *crc, const ut8 *data, size_t len) {
+#if HW_X86
+	if (len >= 64 && (r_hash_hw () & R_HASH_HW_PCLMUL)) {
+		len &= ~(size_t)15;
+		*crc = crc32_pclmul (*crc, data, len);
+		return len;
+	}
+#elif HW_ARM
+	if (r_hash_hw () & R_HASH_HW_ARMCRC) {
+		*crc = crc32_arm (*crc, data, len, false);
+		return len;
+	}
+#endif
+	return 0;
+}
+
+R_IPI size_t r_hash_hw_crc32c(ut32 *crc, const ut8 *data, size_t len) {
+#if HW_X86
+	if (r_hash_hw () & R_HASH_HW_SSE42) {
+		*crc = crc32c_sse42 (*crc, data, len);
+		return len;
+	}
+#elif HW_ARM
+	if (r_hash_hw () & R_HASH_HW_ARMCRC) {
+		*crc = crc32_arm (*crc, data, len, true);
+		return len;
+	}
+#endif
+	return 0;
+}
+
+R_IPI bool r_hash_hw_sha1(ut32 state[5], const ut8 *data, size_t nblocks) {
+#if HW_X86
+	if (r_hash_hw () & R_HASH_HW_SHA) {
+		sha1_ni (state, data, nblocks);
+		return true;
+	}
+#endif
+	return false;
+}
+
+R_IPI bool r_hash_hw_sha256(ut32 state[8], const ut8 *data, size_t nblocks) {
+#if HW_X86
+	if (r_hash_hw () & R_HASH_HW_SHA) {
+		sha256_ni (state, data, nblocks);
+		return true;
+	}
+#endif
+	return false;
+}
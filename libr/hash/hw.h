@@ -0,0 +1,23 @@
+#ifndef R_HASH_HW_H
+#define R_HASH_HW_H
+
+#include <r_types.h>
+
+// cpu features used by the accelerated hash backends
+#define R_HASH_HW_SSE42 1
+#define R_HASH_HW_PCLMUL 2
+#define R_HASH_HW_SHA 4
+#define R_HASH_HW_ARMCRC 8
+
+R_IPI int r_hash_hw(void);
+
+// crc functions take the bit-reflected register and return how many
+// bytes they consumed, the caller finishes the rest
+R_IPI size_t r_hash_hw_crc32(ut32 *crc, const ut8 *data, size_t len);
+R_IPI size_t r_hash_hw_crc32c(ut32 *crc, const ut8 *data, size_t len);
+
+// process nblocks 64 byte blocks, false if there is no hardware support
+R_IPI bool r_hash_hw_sha1(ut32 state[5], const ut8 *data, size_t nblocks);
+R_IPI bool r_hash_hw_sha256(ut32 state[8], const ut8 *data, size_t nblocks);
+
+#endif
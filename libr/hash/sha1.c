@@ -35,6 +35,7 @@
 
 #include "r_hash.h"
 #include "sha1.h"
+#include "hw.h"
 
 #define SHA_ROT(X, n) (((X) << (n)) | ((X) >> (32 - (n))))
 
@@ -97,8 +98,26 @@ void r_SHA1_Init(R_SHA_CTX *ctx) {
 
 void r_SHA1_Update(R_SHA_CTX *ctx, const void *_dataIn, int len) {
 	const ut8 *dataIn = _dataIn;
-	int i;
-
+	int i, t;
+
+	// Whole blocks skip the byte at a time shuffling through W
+	if (ctx->lenW == 0 && len >= 64) {
+		int nblocks = len / 64;
+		if (!r_hash_hw_sha1 (ctx->H, dataIn, nblocks)) {
+			for (i = 0; i < nblocks; i++) {
+				const ut8 *p = dataIn + i * 64;
+				for (t = 0; t < 16; t++) {
+					ctx->W[t] = r_read_be32 (p + t * 4);
+				}
+				shaHashBlock (ctx);
+			}
+		}
+		ut32 bits = (ut32)nblocks << 9;
+		ctx->sizeLo += bits;
+		ctx->sizeHi += (ctx->sizeLo < bits) + ((ut32)nblocks >> 23);
+		dataIn += nblocks * 64;
+		len -= nblocks * 64;
+	}
 	// Read the data into W and process blocks as they get full
 	for (i = 0; i < len; i++) {
 		ctx->W[ctx->lenW / 4] <<= 8;
@@ -35,6 +35,7 @@
 #include <string.h>     /* memcpy()/memset() or bcopy()/bzero() */
 #include "r_hash.h"
 #include "sha2.h"
+#include "hw.h"
 
 #define WEAK_ALIASING 0
 
@@ -494,6 +495,13 @@ void r_SHA256_Update(R_SHA256_CTX *context, const ut8 *data, size_t len) {
 			return;
 		}
 	}
+	if (len >= SHA256_BLOCK_LENGTH && r_hash_hw_sha256 (context->state, data, len / SHA256_BLOCK_LENGTH)) {
+		/* The cpu did all complete blocks */
+		size_t done = len - (len % SHA256_BLOCK_LENGTH);
+		context->bitcount += (ut64)done << 3;
+		len -= done;
+		data += done;
+	}
 	while (len >= SHA256_BLOCK_LENGTH) {
 		/* Process as many complete blocks as we can */
 		SHA256_Transform (context, (ut32 *) data);
@@ -91,7 +91,7 @@ typedef struct r_ascii_graph_t {
 	RList *long_edges;
 	struct layer_t *layers;
 	unsigned int n_layers;
-	RList *dists; /* RList<struct dist_t> */
+	int *dists; /* distance to the next node in the layer, by node index */
 	RList *edges; /* RList<AEdge> */
 	RAGraphHits ghits;
 } RAGraph;
@@ -349,6 +349,9 @@ typedef enum {
 	R_META_TYPE_VARTYPE = 't',
 } RAnalMetaType;
 
+// number of types above that have their own index in RAnal.meta_index
+#define R_META_TYPE_COUNT 10
+
 /* meta */
 typedef struct r_anal_meta_item_t {
 	RAnalMetaType type;
@@ -660,6 +663,7 @@ typedef struct r_anal_t {
 	RBTree/*<RAnalArchBitsRecord>*/ bits_hints;
 	RHintCb hint_cbs;
 	RIntervalTree meta;
+	RIntervalTree meta_index[R_META_TYPE_COUNT]; // same items as meta, one tree per type
 	RSpaces meta_spaces;
 	Sdb *sdb_cc; // calling conventions
 	Sdb *sdb_classes;
@@ -1137,6 +1141,27 @@ typedef struct r_anal_esil_change_mem_t {
 	ut8 data;
 } RAnalEsilMemChange;
 
+typedef enum {
+	R_ANAL_ESIL_TRACE_REG_READ,
+	R_ANAL_ESIL_TRACE_REG_WRITE,
+	R_ANAL_ESIL_TRACE_MEM_READ,
+	R_ANAL_ESIL_TRACE_MEM_WRITE,
+} RAnalEsilTraceAccessType;
+
+typedef struct r_anal_esil_trace_access_t {
+	RAnalEsilTraceAccessType type;
+	const char *reg; // interned in RAnalEsilTrace.regnames
+	ut64 addr;
+	ut64 value; // register value or offset of the bytes in RAnalEsilTrace.data
+	ut32 len;
+} RAnalEsilTraceAccess;
+
+typedef struct r_anal_esil_trace_step_t {
+	ut64 addr;
+	ut32 start; // first access of this step in RAnalEsilTrace.accesses
+	ut32 count;
+} RAnalEsilTraceStep;
+
 typedef struct r_anal_esil_trace_t {
 	int idx;
 	int end_idx;
@@ -1146,8 +1171,11 @@ typedef struct r_anal_esil_trace_t {
 	ut64 stack_addr;
 	ut64 stack_size;
 	ut8 *stack_data;
-	//TODO remove `db` and reuse info above
-	Sdb *db;
+	int log_start; // trace idx of the first step in steps
+	RVector steps; // RAnalEsilTraceStep, indexed by trace idx - log_start
+	RVector accesses; // RAnalEsilTraceAccess
+	RVector data; // ut8, bytes of the memory accesses
+	RStrConstPool regnames;
 } RAnalEsilTrace;
 
 typedef bool (*RAnalEsilHookRegWriteCB)(ESIL *esil, const char *name, ut64 *val);
@@ -1665,6 +1693,10 @@ R_API void r_anal_esil_trace_op(RAnalEsil *esil, RAnalOp *op);
 R_API void r_anal_esil_trace_list(RAnalEsil *esil);
 R_API void r_anal_esil_trace_show(RAnalEsil *esil, int idx);
 R_API void r_anal_esil_trace_restore(RAnalEsil *esil, int idx);
+R_API RAnalEsilTraceStep *r_anal_esil_trace_get_step(RAnalEsilTrace *trace, int idx);
+R_API RAnalEsilTraceAccess *r_anal_esil_trace_get_access(RAnalEsilTrace *trace, int idx, RAnalEsilTraceAccessType type, const char *reg);
+R_API void r_anal_esil_trace_clear(RAnalEsilTrace *trace);
+R_API Sdb *r_anal_esil_trace_sdb(RAnalEsilTrace *trace);
 
 /* pin */
 R_API void r_anal_pin_init(RAnal *a);
@@ -1690,7 +1722,7 @@ R_API bool r_anal_check_fcn(RAnal *anal, ut8 *buf, ut16 bufsz, ut64 addr, ut64 l
 R_API void r_anal_function_invalidate_read_ahead_cache(void);
 
 R_API void r_anal_function_check_bp_use(RAnalFunction *fcn);
-R_API void r_anal_update_analysis_range(RAnal *anal, ut64 addr, int size);
+R_API RList *r_anal_update_analysis_range(RAnal *anal, ut64 addr, int size);
 R_API void r_anal_function_update_analysis(RAnalFunction *fcn);
 
 #define R_ANAL_FCN_VARKIND_LOCAL 'v'
@@ -1909,8 +1941,15 @@ R_API char *r_anal_data_to_string(RAnalData *d, RConsPrintablePalette *pal);
  * Meta items are allowed to overlap and the internal data structure allows for multiple meta items
  * starting at the same address.
  * Meta items are saved in an RIntervalTree. To access the interval of an item, use the members of RIntervalNode.
+ * Every item is also indexed in a tree for its type, so queries for a single type skip all the others.
  */
 
+// Cursor over meta items ordered by address, see r_meta_iter_first()
+typedef struct r_anal_meta_iter_t {
+	RIntervalTreeIter it;
+	RAnalMetaType type;
+} RAnalMetaIter;
+
 static inline ut64 r_meta_item_size(ut64 start, ut64 end) {
 	// meta items use inclusive/inclusive intervals
 	return end - start + 1;
@@ -1956,6 +1995,20 @@ R_API RPVector/*<RIntervalNode<RMetaItem> *>*/ *r_meta_get_all_in(RAnal *a, ut64
 // Returns all nodes for items with the given type intersecting the given interval in the current space.
 R_API RPVector/*<RIntervalNode<RMetaItem> *>*/ *r_meta_get_all_intersect(RAnal *a, ut64 start, ut64 size, RAnalMetaType type);
 
+// Allocation-free versions of the above: call cb for every meta item of the given type (or R_META_TYPE_ANY) in the
+// current space, until it returns false. The nodes may belong to a per-type index, only read them.
+R_API bool r_meta_foreach_at(RAnal *a, ut64 at, RAnalMetaType type, RIntervalIterCb cb, void *user);
+R_API bool r_meta_foreach_in(RAnal *a, ut64 at, RAnalMetaType type, RIntervalIterCb cb, void *user);
+R_API bool r_meta_foreach_intersect(RAnal *a, ut64 start, ut64 size, RAnalMetaType type, RIntervalIterCb cb, void *user);
+
+// Start a cursor over the meta items of the given type in all spaces, from the first one starting at or after from.
+// Returns NULL at the end. Meta must not be modified while the cursor is in use.
+R_API RIntervalNode *r_meta_iter_first(RAnal *a, RAnalMetaIter *it, RAnalMetaType type, ut64 from);
+R_API RIntervalNode *r_meta_iter_next(RAnalMetaIter *it);
+
+#define r_meta_foreach_type(a, it, node, type) \
+	for ((node) = r_meta_iter_first ((a), &(it), (type), 0); (node); (node) = r_meta_iter_next (&(it)))
+
 // Delete all meta items in the given space
 R_API void r_meta_space_unset_for(RAnal *a, const RSpace *space);
 
@@ -2203,6 +2256,7 @@ R_API void r_anal_base_type_free(RAnalBaseType *type);
 R_API RAnalBaseType *r_anal_base_type_new(RAnalBaseTypeKind kind);
 R_API void r_anal_dwarf_process_info(const RAnal *anal, RAnalDwarfContext *ctx);
 R_API void r_anal_dwarf_integrate_functions(RAnal *anal, RFlag *flags, Sdb *dwarf_sdb);
+R_API bool r_anal_dwarf_integrate_function(RAnal *anal, RFlag *flags, Sdb *dwarf_sdb, ut64 addr);
 /* global.c */
 R_API RFlagItem *r_anal_global_get(RAnal *anal, ut64 addr);
 R_API bool r_anal_global_add(RAnal *anal, ut64 addr, const char *type_name, const char *name);
@@ -277,6 +277,32 @@ typedef struct r_bin_object_t {
 	void *bin_obj; // internal pointer used by formats
 } RBinObject;
 
+typedef struct r_bin_addrline_t {
+	ut64 addr;
+	ut32 file; // index into RBinAddrLineTable.files
+	ut32 line;
+	ut32 column;
+	ut32 seq; // insertion order, the first row for an address wins
+} RBinAddrLine;
+
+typedef struct r_bin_addrline_key_t {
+	ut64 addr;
+	ut32 file;
+	ut32 line;
+	ut32 seq; // the first address inserted for a line wins
+} RBinAddrLineKey;
+
+typedef struct r_bin_addrline_table_t {
+	RVector rows; // RBinAddrLine sorted by address and insertion order
+	RVector by_line; // RBinAddrLineKey sorted by file, line and insertion order
+	RPVector files;
+	HtPP *file_ids;
+	ut32 seq; // next insertion order, it never goes back after removals
+	bool sorted;
+} RBinAddrLineTable;
+
+typedef bool (*RBinAddrLineCallback)(void *user, const RBinAddrLine *row, const char *file);
+
 // XXX: RbinFile may hold more than one RBinObject
 /// XX curplugin == o->plugin
 typedef struct r_bin_file_t {
@@ -302,6 +328,8 @@ typedef struct r_bin_file_t {
 // #warning RBinFile.sdb_info will be removed in r2-5.7.0
 	Sdb *sdb_info;
 	Sdb *sdb_addrinfo;
+	RBinAddrLineTable *addrlines; // line table loaded from the debug info
+	RBinDwarfIndex *dwarf_index; // set when the debug info is loaded on demand
 	struct r_bin_t *rbin;
 } RBinFile;
 
@@ -340,6 +368,7 @@ struct r_bin_t {
 	RConsBind consb;
 	char *force;
 	bool want_dbginfo;
+	int dwarf_threads; // threads parsing the .debug_info units, 0 picks them by size
 	int filter; // symbol filtering
 	char strfilter; // string filtering
 	char *strpurge; // purge false positive strings
@@ -349,6 +378,8 @@ struct r_bin_t {
 	ut64 filter_rules;
 	bool demangle_usecmd;
 	bool demangle_trylib;
+	HtPP *demangle_cache; // "type.mode.name" => demangled name or NULL
+	size_t demangle_cache_size;
 	bool verbose;
 	bool use_xtr; // use extract plugins when loading a file?
 	bool use_ldr; // use loader plugins when loading a file?
@@ -665,6 +696,7 @@ R_API void r_bin_string_free(void *_str);
 
 R_API RBinImport *r_bin_import_clone(RBinImport *o);
 typedef void (*RBinSymbolCallback)(RBinObject *obj, RBinSymbol *symbol);
+typedef bool (*RBinJobCallback)(void *user, size_t idx, int tid);
 
 // options functions
 R_API void r_bin_file_options_init(RBinFileOptions *opt, int fd, ut64 baseaddr, ut64 loadaddr, int rawstr);
@@ -776,8 +808,14 @@ R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o);
 R_API bool r_bin_object_delete(RBin *bin, ut32 binfile_id);
 R_API void r_bin_mem_free(void *data);
 
+// job functions
+R_API int r_bin_jobs_threads(size_t count);
+R_API bool r_bin_jobs_run(RBin *bin, size_t count, int nthreads, RBinJobCallback cb, void *user);
+
 // demangle functions
 R_API char *r_bin_demangle(RBinFile *binfile, const char *lang, const char *str, ut64 vaddr, bool libs);
+R_API bool r_bin_demangle_batch(RBinFile *bf, const char *lang, const char **names, const ut64 *vaddrs, char **out, size_t count, bool libs);
+R_API void r_bin_demangle_cache_clear(RBin *bin);
 R_API char *r_bin_demangle_java(const char *str);
 R_API char *r_bin_demangle_cxx(RBinFile *binfile, const char *str, ut64 vaddr);
 R_API char *r_bin_demangle_msvc(const char *str);
@@ -796,6 +834,17 @@ R_API bool r_bin_addr2line(RBin *bin, ut64 addr, char *file, int len, int *line)
 R_API bool r_bin_addr2line2(RBin *bin, ut64 addr, char *file, int len, int *line);
 R_API char *r_bin_addr2text(RBin *bin, ut64 addr, int origin);
 R_API char *r_bin_addr2fileline(RBin *bin, ut64 addr);
+/* addrline.c */
+R_API RBinAddrLineTable *r_bin_addrline_new(void);
+R_API void r_bin_addrline_free(RBinAddrLineTable *t);
+R_API void r_bin_addrline_reset(RBinAddrLineTable *t);
+R_API bool r_bin_addrline_add(RBinAddrLineTable *t, ut64 addr, const char *file, ut32 line, ut32 column);
+R_API bool r_bin_addrline_del(RBinAddrLineTable *t, ut64 addr);
+R_API const RBinAddrLine *r_bin_addrline_get(RBinAddrLineTable *t, ut64 addr);
+R_API ut64 r_bin_addrline_find(RBinAddrLineTable *t, const char *file, ut32 line);
+R_API const char *r_bin_addrline_file(RBinAddrLineTable *t, const RBinAddrLine *row);
+R_API bool r_bin_addrline_foreach(RBinAddrLineTable *t, RBinAddrLineCallback cb, void *user);
+R_API size_t r_bin_addrline_count(RBinAddrLineTable *t);
 /* bin_write.c */
 R_API bool r_bin_wr_addlib(RBin *bin, const char *lib);
 R_API ut64 r_bin_wr_scn_resize(RBin *bin, const char *name, ut64 size);
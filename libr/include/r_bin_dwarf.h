@@ -760,6 +760,9 @@ typedef struct {
 	size_t	count;
 	size_t	capacity;
 	RBinDwarfDie *dies;
+	RPVector attr_chunks; // arena backing the attr_values of the dies
+	RBinDwarfAttrValue *attr_next;
+	size_t	attr_left;
 } RBinDwarfCompUnit;
 
 #define COMP_UNIT_CAPACITY	8
@@ -845,12 +848,44 @@ typedef struct r_bin_dwarf_loc_list_t {
 	ut64 offset;
 } RBinDwarfLocList;
 
+/* .debug_names index attributes */
+#define DW_IDX_compile_unit	0x01
+#define DW_IDX_type_unit	0x02
+#define DW_IDX_die_offset	0x03
+#define DW_IDX_parent		0x04
+#define DW_IDX_type_hash	0x05
+
+typedef struct r_bin_dwarf_name_entry_t {
+	ut64 unit; // offset of the compilation unit in .debug_info
+	ut64 die; // offset of the die in .debug_info, UT64_MAX if unknown
+	ut64 tag; // 0 if unknown
+} RBinDwarfNameEntry;
+
+typedef struct r_bin_dwarf_addr_range_t {
+	ut64 from;
+	ut64 to;
+	ut64 unit;
+} RBinDwarfAddrRange;
+
+// accelerator tables from .debug_names or .gdb_index (+ .debug_aranges)
+typedef struct r_bin_dwarf_index_t {
+	HtPP/*<char *name, RVector<RBinDwarfNameEntry> *>*/ *names;
+	RVector/*<RBinDwarfAddrRange>*/ ranges; // sorted by address
+	HtUP/*<ut64 unit, bool>*/ *loaded; // units already parsed by the user
+	HtUP/*<ut64 addr, bool>*/ *applied; // functions the loaded units were applied to
+} RBinDwarfIndex;
+
 #define r_bin_dwarf_line_new(o,a,f,l) o->address=a, o->file = strdup (r_str_get (f)), o->line = l, o->column =0,o
 
 R_API RList *r_bin_dwarf_parse_aranges(RBin *a, int mode);
 R_API RList *r_bin_dwarf_parse_line(RBin *a, int mode);
 R_API RBinDwarfDebugAbbrev *r_bin_dwarf_parse_abbrev(RBin *a, int mode);
 R_API RBinDwarfDebugInfo *r_bin_dwarf_parse_info(RBinDwarfDebugAbbrev *da, RBin *a, int mode);
+R_API RBinDwarfDebugInfo *r_bin_dwarf_parse_units(RBinDwarfDebugAbbrev *da, RBin *a, const ut64 *units, size_t count);
+R_API RBinDwarfIndex *r_bin_dwarf_parse_index(RBin *a);
+R_API void r_bin_dwarf_index_free(RBinDwarfIndex *idx);
+R_API const RVector *r_bin_dwarf_index_find(RBinDwarfIndex *idx, const char *name);
+R_API ut64 r_bin_dwarf_index_unit_at(RBinDwarfIndex *idx, ut64 addr);
 R_API HtUP/*<offset, RBinDwarfLocList*>*/  *r_bin_dwarf_parse_loc(RBin *bin, int addr_size);
 R_API void r_bin_dwarf_print_loc(HtUP /*<offset, RBinDwarfLocList*>*/  *loc_table, int addr_size, PrintfCallback print);
 R_API void r_bin_dwarf_free_loc(HtUP /*<offset, RBinDwarfLocList*>*/  *loc_table);
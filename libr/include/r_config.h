@@ -43,6 +43,14 @@ typedef struct r_config_node_t {
 
 R_API const char *r_config_node_type(RConfigNode *node);
 
+typedef void (*RConfigWatchCallback)(void *user, RConfigNode *node);
+
+typedef struct r_config_watch_t {
+	char *prefix;
+	RConfigWatchCallback cb;
+	void *user;
+} RConfigWatch;
+
 typedef struct r_config_t {
 	void *user;
 	RNum *num;
@@ -50,10 +58,23 @@ typedef struct r_config_t {
 	RList *nodes;
 	HtPP *ht;
 	bool lock;
+	ut32 gen; // bumped on every change, invalidates the handles
+	RList/*<RConfigWatch>*/ *watchers;
 	/*was the struct modified after the last project save*/
 	R_DIRTY_VAR;
 } RConfig;
 
+// pre-resolved variable to read a setting in loops without a hashtable lookup
+typedef struct r_config_handle_t {
+	RConfig *cfg;
+	const char *name; // must outlive the handle
+	RConfigNode *node;
+	ut32 gen;
+	bool dynamic; // the node has a getter, values are computed on every read
+	bool eval; // the int value depends on r_num_math, computed on every read
+	ut64 i;
+} RConfigHandle;
+
 typedef struct r_config_hold_t {
 	RConfig *cfg;
 	RList *list;
@@ -89,6 +110,25 @@ R_API void r_config_list(RConfig *cfg, const char *str, int rad);
 R_API bool r_config_toggle(RConfig *cfg, const char *name);
 R_API bool r_config_readonly(RConfig *cfg, const char *key);
 
+R_API void r_config_handle_init(RConfigHandle *h, RConfig *cfg, const char *name);
+R_API void r_config_handle_refresh(RConfigHandle *h);
+R_API RConfigWatch *r_config_watch(RConfig *cfg, const char *prefix, RConfigWatchCallback cb, void *user);
+R_API void r_config_unwatch(RConfig *cfg, RConfigWatch *w);
+
+static inline bool r_config_handle_stale(RConfigHandle *h) {
+	return h->gen != h->cfg->gen || h->dynamic;
+}
+static inline ut64 r_config_handle_i(RConfigHandle *h) {
+	if (r_config_handle_stale (h)) {
+		r_config_handle_refresh (h);
+	}
+	return h->eval? r_config_get_i (h->cfg, h->name): h->i;
+}
+static inline bool r_config_handle_b(RConfigHandle *h) {
+	return r_config_handle_i (h) != 0;
+}
+R_API const char *r_config_handle_s(RConfigHandle *h);
+
 // TODO Move to RConfigNode for consistency
 R_API bool r_config_set_setter(RConfig *cfg, const char *key, RConfigCallback cb);
 R_API bool r_config_set_getter(RConfig *cfg, const char *key, RConfigCallback cb);
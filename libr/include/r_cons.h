@@ -413,6 +413,7 @@ typedef struct r_cons_context_t {
 	int color_mode;
 	RConsPalette cpal;
 	RConsPrintablePalette pal;
+	ut32 pal_gen; // bumped when pal is recomputed
 
 	RList *sorted_lines;
 	RList *unsorted_lines;
@@ -441,6 +442,12 @@ typedef struct r_cons_t {
 	int rows;
 	int echo; // dump to stdout in realtime
 	int fps;
+	bool damage; // only redraw the rows that changed between visual frames
+	char **frame; // rows of the last frame, with the attributes they start with
+	int frame_rows;
+	int frame_cols;
+	ut64 frame_end; // bytes_written after the last frame, anything else invalidates it
+	ut64 bytes_written; // total bytes written to fdout
 	int columns;
 	int force_rows;
 	int force_columns;
@@ -890,6 +897,9 @@ R_API void r_cons_2048(bool color);
 R_API void r_cons_memset(char ch, int len);
 R_API void r_cons_visual_flush(void);
 R_API void r_cons_visual_write(char *buffer);
+R_API bool r_cons_frame_write(const char *buf, int len);
+R_API void r_cons_frame_flush(void);
+R_API void r_cons_frame_reset(void);
 R_API bool r_cons_is_utf8(void);
 R_API bool r_cons_is_windows(void);
 R_API void r_cons_cmd_help(const char *help[], bool use_color);
@@ -902,6 +912,7 @@ R_API void r_cons_log_stub(const char *output, const char *funcname, const char
 R_API int r_cons_controlz(int ch);
 R_API int r_cons_readchar(void);
 R_API bool r_cons_readpush(const char *str, int len);
+R_API bool r_cons_input_pending(void);
 R_API void r_cons_readflush(void);
 R_API void r_cons_switchbuf(bool active);
 R_API int r_cons_readchar_timeout(ut32 usec);
@@ -260,6 +260,8 @@ R_API void r_project_free(RProject *p);
 R_API bool r_project_is_loaded(RProject *p);
 R_API bool r_core_project_is_saved(RCore *core);
 
+typedef struct r_core_disasm_cache_t RCoreDisasmCache;
+
 struct r_core_t {
 	RBin *bin;
 	RConfig *config;
@@ -273,6 +275,7 @@ struct r_core_t {
 	ut64 yank_addr;
 	bool tmpseek;
 	bool vmode;
+	bool anal_onchange_busy; // reanalyzing after an io write
 	int interrupted; // XXX IS THIS DUPPED SOMEWHERE?
 	/* files */
 	RCons *cons;
@@ -356,6 +359,7 @@ struct r_core_t {
 	bool allbins;
 	bool marks_init;
 	ut64 marks[UT8_MAX + 1];
+	RCoreDisasmCache *disasm_cache; // operand strings reused across pd calls
 
 	RMainCallback r_main_radare2;
 	// int (*r_main_radare2)(int argc, char **argv);
@@ -682,6 +686,7 @@ R_API int r_core_print_disasm_json(RCore *core, ut64 addr, ut8 *buf, int len, in
 R_API int r_core_print_disasm_instructions_with_buf(RCore *core, ut64 address, ut8 *buf, int nb_bytes, int nb_opcodes);
 R_API int r_core_print_disasm_instructions(RCore *core, int nb_bytes, int nb_opcodes);
 R_API int r_core_print_disasm_all(RCore *core, ut64 addr, int l, int len, int mode);
+R_IPI void r_core_disasm_cache_free(RCoreDisasmCache *dc);
 
 R_API int r_core_disasm_pdi_with_buf(RCore *core, ut64 address, ut8 *buf, ut32 nb_opcodes, ut32 nb_bytes, int fmt);
 R_API int r_core_disasm_pdi(RCore *core, int nb_opcodes, int nb_bytes, int fmt);
@@ -723,6 +728,13 @@ R_API bool r_core_project_save(RCore *core, const char *file);
 R_API char *r_core_project_name(RCore *core, const char *file);
 R_API char *r_core_project_notes_file(RCore *core, const char *file);
 R_API void r_core_project_undirty(RCore *core);
+
+/* anal_cache.c */
+R_API char *r_core_anal_cache_path(RCore *core);
+R_API bool r_core_anal_cache_load(RCore *core, int level);
+R_API bool r_core_anal_cache_save(RCore *core, int level);
+R_IPI char *r_core_file_sha256(RCore *core, RBinFile *bf);
+
 R_API char *r_core_sysenv_begin(RCore *core, const char *cmd);
 R_API void r_core_sysenv_end(RCore *core, const char *cmd);
 
@@ -778,6 +790,8 @@ typedef struct r_core_bin_filter_t {
 } RCoreBinFilter;
 
 R_API bool r_core_bin_info(RCore *core, int action, PJ *pj, int mode, int va, RCoreBinFilter *filter, const char *chksum);
+R_API int r_core_bin_dwarf_load(RCore *core, const ut64 *addrs, size_t count);
+R_API void r_core_bin_dwarf_apply(RCore *core, ut64 addr);
 R_API bool r_core_bin_set_arch_bits(RCore *r, const char *name, const char *arch, ut16 bits);
 R_API bool r_core_bin_update_arch_bits(RCore *r);
 R_API char *r_core_bin_method_flags_str(ut64 flags, int mode);
@@ -35,17 +35,40 @@ typedef struct r_flags_at_offset_t {
 	RList *flags;   /* list of RFlagItem at offset */
 } RFlagsAtOffset;
 
+#define R_FLAG_OFF_BLOCK 256
+
+/* chunk of the offset index, keys are packed to keep lookups cache friendly */
+typedef struct r_flag_off_block_t {
+	ut32 len;
+	ut64 off[R_FLAG_OFF_BLOCK];
+	RFlagsAtOffset *fao[R_FLAG_OFF_BLOCK];
+} RFlagOffBlock;
+
+typedef struct r_flag_off_index_t {
+	RPVector blocks;  /* RFlagOffBlock, sorted and not overlapping */
+	size_t count;
+	ut32 gen;         /* bumped on every insertion or removal */
+	bool cur_valid;   /* position of the last lookup */
+	size_t cur_block;
+	ut32 cur_idx;
+} RFlagOffIndex;
+
+/* rarely used attributes, allocated on demand */
+typedef struct r_flag_item_meta_t {
+	char *color;    /* item color */
+	char *comment;  /* item comment */
+	char *alias;    /* used to define a flag based on a math expression (e.g. foo + 3) */
+	char *type;
+} RFlagItemMeta;
+
 typedef struct r_flag_item_t {
 	char *name;     /* unique name, escaped to avoid issues with r2 shell */
 	char *realname; /* real name, without any escaping */
-	bool demangled; /* real name from demangling? */
 	ut64 offset;    /* offset flagged by this item */
 	ut64 size;      /* size of the flag item */
 	RSpace *space;  /* flag space this item belongs to */
-	char *color;    /* item color */
-	char *comment;  /* item comment */
-	char *alias;    /* used to define a flag based on a math expression (e.g. foo + 3) */
-	char *type;
+	RFlagItemMeta *meta; /* color, comment, alias and type, NULL if none is set */
+	bool demangled; /* real name from demangling? */
 } RFlagItem;
 
 typedef struct r_flag_t {
@@ -54,11 +77,13 @@ typedef struct r_flag_t {
 	bool realnames;
 	Sdb *tags;
 	RNum *num;
-	RSkipList *by_off; /* flags sorted by offset, value=RFlagsAtOffset */
+	RFlagOffIndex by_off; /* flags sorted by offset, value=RFlagsAtOffset */
 	HtPP *ht_name; /* hashmap key=item name, value=RFlagItem * */
 	PrintfCallback cb_printf;
 	RList *zones;
 	ut64 mask;
+	int bulk;          /* nesting level of r_flag_bulk_begin */
+	RPVector pending;  /* new items not yet in by_off while in bulk mode */
 	R_DIRTY_VAR;
 } RFlag;
 
@@ -112,18 +137,20 @@ R_API const RList* /*<RFlagItem*>*/ r_flag_get_list(RFlag *f, ut64 off);
 R_API char *r_flag_get_liststr(RFlag *f, ut64 off);
 R_API bool r_flag_unset(RFlag *f, RFlagItem *item);
 R_API bool r_flag_unset_name(RFlag *f, const char *name);
-R_API void r_flag_item_set_type(RFlagItem *fi, const char *type);
 R_API bool r_flag_unset_off(RFlag *f, ut64 addr);
 R_API void r_flag_unset_all(RFlag *f);
 R_API RFlagItem *r_flag_set(RFlag *fo, const char *name, ut64 addr, ut32 size);
 R_API RFlagItem *r_flag_set_inspace(RFlag *f, const char *space, const char *name, ut64 off, ut32 size);
 R_API RFlagItem *r_flag_set_next(RFlag *fo, const char *name, ut64 addr, ut32 size);
+R_API void r_flag_bulk_begin(RFlag *f);
+R_API void r_flag_bulk_end(RFlag *f);
 R_API void r_flag_item_set_alias(RFlagItem *item, const char *alias);
 R_API void r_flag_item_free(RFlagItem *item);
 R_API void r_flag_item_set_comment(RFlagItem *item, const char *comment);
 R_API void r_flag_item_set_realname(RFlagItem *item, const char *realname);
 R_API const char *r_flag_item_set_color(RFlagItem *item, const char *color);
 R_API RFlagItem *r_flag_item_clone(RFlagItem *item);
+R_API void r_flag_item_set_type(RFlagItem *fi, const char *type);
 R_API int r_flag_unset_glob(RFlag *f, const char *name);
 R_API int r_flag_rename(RFlag *f, RFlagItem *item, const char *name);
 R_API int r_flag_relocate(RFlag *f, ut64 off, ut64 off_mask, ut64 to);
@@ -136,6 +163,22 @@ R_API void r_flag_foreach_glob(RFlag *f, const char *glob, RFlagItemCb cb, void
 R_API void r_flag_foreach_space(RFlag *f, const RSpace *space, RFlagItemCb cb, void *user);
 R_API void r_flag_foreach_space_glob(RFlag *f, const char *glob, const RSpace *space, RFlagItemCb cb, void *user);
 
+static inline const char *r_flag_item_color(const RFlagItem *fi) {
+	return fi->meta? fi->meta->color: NULL;
+}
+
+static inline const char *r_flag_item_comment(const RFlagItem *fi) {
+	return fi->meta? fi->meta->comment: NULL;
+}
+
+static inline const char *r_flag_item_alias(const RFlagItem *fi) {
+	return fi->meta? fi->meta->alias: NULL;
+}
+
+static inline const char *r_flag_item_type(const RFlagItem *fi) {
+	return fi->meta? fi->meta->type: NULL;
+}
+
 /* spaces */
 static inline RSpace *r_flag_space_get(RFlag *f, const char *name) {
 	return r_spaces_get (&f->spaces, name);
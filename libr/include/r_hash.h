@@ -525,6 +525,8 @@ R_API utcrc r_hash_crc_preset(const ut8 *data, ut32 size, enum CRC_PRESETS prese
 R_API ut8  r_hash_hamdist(const ut8 *buf, int len);
 R_API double r_hash_entropy(const ut8 *data, ut64 len);
 R_API double r_hash_entropy_fraction(const ut8 *data, ut64 len);
+R_API void r_hash_entropy_fraction_blocks(const ut8 *data, ut64 blocksize, size_t nblocks, double *out);
+R_API void r_hash_histogram(const ut8 *data, ut64 len, ut64 count[256]);
 R_API int r_hash_pcprint(const ut8 *buffer, ut64 len);
 
 /* lifecycle */
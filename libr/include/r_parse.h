@@ -15,6 +15,23 @@ R_LIB_VERSION_HEADER(r_parse);
 
 typedef RList* (*RAnalVarList)(RAnalFunction *fcn, int kind);
 
+typedef enum {
+	R_PARSE_TOKEN_MNEMONIC,
+	R_PARSE_TOKEN_REGISTER,
+	R_PARSE_TOKEN_NUMBER,
+	R_PARSE_TOKEN_SYMBOL,
+	R_PARSE_TOKEN_SEPARATOR,
+	R_PARSE_TOKEN_ANSI,
+} RParseTokenType;
+
+// a token is a slice of the opcode string, it never owns memory
+typedef struct r_parse_token_t {
+	RParseTokenType type;
+	int off;
+	int len;
+	int role; // R_REG_NAME_* alias of a register token, or -1
+} RParseToken;
+
 typedef struct r_parse_t {
 	void *user;
 	RSpace *flagspace;
@@ -38,6 +55,7 @@ typedef struct r_parse_t {
 	RAnalBind analb;
 	RFlagGetAtAddr flag_get; // XXX
 	RAnalLabelAt label_get;
+	RVector tokens; // scratch RParseToken stream reused across filter calls
 } RParse;
 
 typedef struct r_parse_plugin_t {
@@ -69,6 +87,8 @@ R_API bool r_parse_assemble(RParse *p, char *data, char *str); // XXX deprecate,
 R_API bool r_parse_filter(RParse *p, ut64 addr, RFlag *f, RAnalHint *hint, char *data, char *str, int len, bool big_endian);
 R_API bool r_parse_subvar(RParse *p, RAnalFunction *f, ut64 addr, int oplen, char *data, char *str, int len);
 R_API char *r_parse_immtrim(char *opstr);
+R_API bool r_parse_tokenize(RParse *p, const char *str, RVector *tokens);
+R_IPI bool r_parse_tokens(RReg *reg, const char *str, RVector *tokens);
 
 /* c */
 // why we have anal scoped things in rparse
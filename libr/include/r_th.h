@@ -159,6 +159,7 @@ R_API R_TH_TID r_th_self(void);
 R_API bool r_th_setname(RThread *th, const char *name);
 R_API bool r_th_getname(RThread *th, char *name, size_t len);
 R_API bool r_th_setaffinity(RThread *th, int cpuid);
+R_API int r_th_ncpus(void);
 
 R_API RThreadSemaphore *r_th_sem_new(unsigned int initial);
 R_API void r_th_sem_free(RThreadSemaphore *sem);
@@ -91,7 +91,9 @@ R_LIB_VERSION_HEADER (r_util);
 #ifdef __cplusplus
 }
 #endif
-#define R_DIRTY(x) (x)->is_dirty = true
+// dirty_gen keeps counting after is_dirty is reset, caches compare it
+#define R_DIRTY(x) ((x)->is_dirty = true, (x)->dirty_gen++)
 #define R_IS_DIRTY(x) (x)->is_dirty
-#define R_DIRTY_VAR bool is_dirty
+#define R_DIRTY_GEN(x) (x)->dirty_gen
+#define R_DIRTY_VAR bool is_dirty; ut32 dirty_gen
 #endif
@@ -66,6 +66,7 @@ R_API RBuffer *r_buf_new_file(const char *file, int perm, int mode);
 R_API RBuffer *r_buf_new_with_buf(RBuffer *b);
 R_API RBuffer *r_buf_new_slurp(const char *file);
 R_API RBuffer *r_buf_new_slice(RBuffer *b, ut64 offset, ut64 size);
+R_API RBuffer *r_buf_new_inflate(RBuffer *b, int wbits);
 R_API RBuffer *r_buf_new_empty(ut64 len);
 R_API RBuffer *r_buf_new_mmap(const char *file, int flags);
 R_API RBuffer *r_buf_new_sparse(ut8 Oxff);
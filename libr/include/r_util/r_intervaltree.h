@@ -60,6 +60,9 @@ R_API bool r_interval_tree_resize(RIntervalTree *tree, RIntervalNode *node, ut64
 // Iterating over it will yield all nodes with given start, then all with a higher one.
 R_API RBIter r_interval_tree_first_at(RIntervalTree *tree, ut64 start);
 
+// Returns an iterator that starts at the leftmost node with a start greater or equal than the given one
+R_API RBIter r_interval_tree_first_from(RIntervalTree *tree, ut64 start);
+
 // Returns a node that starts at exactly start or NULL
 R_API RIntervalNode *r_interval_tree_node_at(RIntervalTree *tree, ut64 start);
 
@@ -223,6 +223,7 @@ static char *__system(RIO *io, RIODesc *fd, const char *cmd) {
 			                     " to target interpreter\n"
 			 " =!detach [pid]    - detach from remote/detach specific pid\n"
 			 " =!inv.reg         - invalidate reg cache\n"
+			 " =!inv.mem         - invalidate memory cache\n"
 			 " =!pktsz           - get max packet size used\n"
 			 " =!pktsz bytes     - set max. packet size as 'bytes' bytes\n"
 			 " =!exec_file [pid] - get file which was executed for"
@@ -242,6 +243,8 @@ static char *__system(RIO *io, RIODesc *fd, const char *cmd) {
 			return NULL;
 		}
 		desc->stub_features.pkt_sz = R_MAX (pktsz, 8); // min = 64
+		// the cache line size depends on the packet size
+		gdbr_invalidate_mem_cache (desc);
 		return NULL;
 	}
 	if (r_str_startswith (cmd, "detach")) {
@@ -262,6 +265,9 @@ static char *__system(RIO *io, RIODesc *fd, const char *cmd) {
 	}
 	if (r_str_startswith (cmd, "pkt ")) {
 		gdbr_lock_enter (desc);
+		// the packet may change the target in any way
+		gdbr_invalidate_reg_cache ();
+		gdbr_invalidate_mem_cache (desc);
 		if (send_msg (desc, cmd + 4) >= 0) {
 			(void)read_packet (desc, false);
 			desc->data[desc->data_len] = '\0';
@@ -302,6 +308,7 @@ static char *__system(RIO *io, RIODesc *fd, const char *cmd) {
 				}
 			}
 			gdbr_invalidate_reg_cache ();
+			gdbr_invalidate_mem_cache (desc);
 		}
 		gdbr_lock_leave (desc);
 		return NULL;
@@ -325,6 +332,7 @@ static char *__system(RIO *io, RIODesc *fd, const char *cmd) {
 				}
 			}
 			gdbr_invalidate_reg_cache ();
+			gdbr_invalidate_mem_cache (desc);
 		}
 		gdbr_lock_leave (desc);
 		return NULL;
@@ -351,6 +359,10 @@ static char *__system(RIO *io, RIODesc *fd, const char *cmd) {
 		gdbr_invalidate_reg_cache ();
 		return NULL;
 	}
+	if (r_str_startswith (cmd, "inv.mem")) {
+		gdbr_invalidate_mem_cache (desc);
+		return NULL;
+	}
 	if (r_str_startswith (cmd, "exec_file")) {
 		const char *ptr = cmd + strlen ("exec_file");
 		char *file;
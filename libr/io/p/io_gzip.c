@@ -1,4 +1,4 @@
-/* radare - LGPL - Copyright 2008-2021 - pancake */
+/* radare - LGPL - Copyright 2008-2022 - pancake */
 
 #include "r_io.h"
 #include "r_lib.h"
@@ -6,105 +6,57 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+// the inflated data is read on demand, writes turn it into a copy in memory
 typedef struct {
-	ut8 *buf;
-	ut32 size;
+	RBuffer *b;
 	ut64 offset;
 	bool has_changed;
 } RIOGzip;
 
-static inline ut32 _io_malloc_sz(RIODesc *desc) {
-	if (!desc) {
-		return 0;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal? mal->size: 0;
-}
-
-static inline void _io_malloc_set_sz(RIODesc *desc, ut32 sz) {
-	if (!desc) {
-		return;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	if (mal) {
-		mal->size = sz;
-	}
-}
-
-static inline ut8* _io_malloc_buf(RIODesc *desc) {
-	if (!desc) {
-		return NULL;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal->buf;
-}
-
-
-static inline ut8* _io_malloc_set_buf(RIODesc *desc, ut8* buf) {
-	if (!desc) {
-		return NULL;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal->buf = buf;
-}
-
-static inline ut64 _io_malloc_off(RIODesc *desc) {
-	if (!desc) {
-		return 0;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal->offset;
-}
-
-static inline void _io_malloc_set_off(RIODesc *desc, ut64 off) {
-	if (!desc) {
-		return;
+static bool gzip_materialize(RIOGzip *gz) {
+	if (gz->b->readonly) {
+		RBuffer *b = r_buf_new_with_buf (gz->b);
+		if (!b) {
+			return false;
+		}
+		r_buf_free (gz->b);
+		gz->b = b;
 	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	mal->offset = off;
+	return true;
 }
 
 static int __write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 	if (!fd || !buf || count < 0 || !fd->data) {
 		return -1;
 	}
-	if (_io_malloc_off (fd) > _io_malloc_sz (fd)) {
+	RIOGzip *gz = fd->data;
+	ut64 size = r_buf_size (gz->b);
+	if (gz->offset > size) {
 		return -1;
 	}
-	if (_io_malloc_off (fd) + count > _io_malloc_sz (fd)) {
-		count -= (_io_malloc_off (fd) + count -_io_malloc_sz (fd));
+	if (gz->offset + count > size) {
+		count = size - gz->offset;
 	}
-	if (count > 0) {
-		RIOGzip *riom = fd->data;
-		riom->has_changed = true;
-		memcpy (_io_malloc_buf (fd) + _io_malloc_off (fd), buf, count);
-		_io_malloc_set_off (fd, _io_malloc_off (fd) + count);
-		return count;
+	if (count > 0 && gzip_materialize (gz)) {
+		gz->has_changed = true;
+		st64 r = r_buf_write_at (gz->b, gz->offset, buf, count);
+		if (r > 0) {
+			gz->offset += r;
+		}
+		return (int)r;
 	}
 	return -1;
 }
 
 static bool __resize(RIO *io, RIODesc *fd, ut64 count) {
-	ut8 * new_buf = NULL;
 	if (!fd || !fd->data || count == 0) {
 		return false;
 	}
-	ut32 mallocsz = _io_malloc_sz (fd);
-	if (_io_malloc_off (fd) > mallocsz) {
-		return false;
-	}
-	new_buf = malloc (count);
-	if (!new_buf) {
+	RIOGzip *gz = fd->data;
+	if (gz->offset > r_buf_size (gz->b) || !gzip_materialize (gz)) {
 		return false;
 	}
-	memcpy (new_buf, _io_malloc_buf (fd), R_MIN (count, mallocsz));
-	if (count > mallocsz) {
-		memset (new_buf + mallocsz, 0, count - mallocsz);
-	}
-	free (_io_malloc_buf (fd));
-	_io_malloc_set_buf (fd, new_buf);
-	_io_malloc_set_sz (fd, count);
-	return true;
+	return r_buf_resize (gz->b, count);
 }
 
 static int __read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
@@ -112,26 +64,27 @@ static int __read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	if (!fd || !fd->data) {
 		return -1;
 	}
-	ut32 mallocsz = _io_malloc_sz (fd);
-	if (_io_malloc_off (fd) > mallocsz) {
+	RIOGzip *gz = fd->data;
+	ut64 size = r_buf_size (gz->b);
+	if (gz->offset > size) {
 		return -1;
 	}
-	if (_io_malloc_off (fd) + count >= mallocsz) {
-		count = mallocsz - _io_malloc_off (fd);
+	if (gz->offset + count >= size) {
+		count = size - gz->offset;
 	}
-	memcpy (buf, _io_malloc_buf (fd) + _io_malloc_off (fd), count);
-	return count;
+	st64 r = r_buf_read_at (gz->b, gz->offset, buf, count);
+	return r < 0? -1: (int)r;
 }
 
 static bool __close(RIODesc *fd) {
 	if (!fd || !fd->data) {
 		return false;
 	}
-	RIOGzip *riom = fd->data;
-	if (riom->has_changed) {
+	RIOGzip *gz = fd->data;
+	if (gz->has_changed) {
 		eprintf ("TODO: Writing changes into gzipped files is not yet supported\n");
 	}
-	R_FREE (riom->buf);
+	r_buf_free (gz->b);
 	R_FREE (fd->data);
 	return true;
 }
@@ -141,19 +94,20 @@ static ut64 __lseek(RIO* io, RIODesc *fd, ut64 offset, int whence) {
 	if (!fd || !fd->data) {
 		return offset;
 	}
-	ut32 mallocsz = _io_malloc_sz (fd);
+	RIOGzip *gz = fd->data;
+	ut64 size = r_buf_size (gz->b);
 	switch (whence) {
 	case SEEK_SET:
-		r_offset = (offset <= mallocsz) ? offset : mallocsz;
+		r_offset = (offset <= size) ? offset : size;
 		break;
 	case SEEK_CUR:
-		r_offset = (_io_malloc_off (fd) + offset <= mallocsz ) ? _io_malloc_off (fd) + offset : mallocsz;
+		r_offset = (gz->offset + offset <= size) ? gz->offset + offset : size;
 		break;
 	case SEEK_END:
-		r_offset = _io_malloc_sz (fd);
+		r_offset = size;
 		break;
 	}
-	_io_malloc_set_off (fd, r_offset);
+	gz->offset = r_offset;
 	return r_offset;
 }
 
@@ -163,20 +117,21 @@ static bool __plugin_open(RIO *io, const char *pathname, bool many) {
 
 static RIODesc *__open(RIO *io, const char *pathname, int rw, int mode) {
 	if (__plugin_open (io, pathname, 0)) {
-		RIOGzip *mal = R_NEW0 (RIOGzip);
-		if (!mal) {
+		RIOGzip *gz = R_NEW0 (RIOGzip);
+		if (!gz) {
 			return NULL;
 		}
-		size_t len;
-		ut8 *data = (ut8 *)r_file_slurp (pathname+7, &len);	//memleak here?
-		int *size = (int*)&mal->size;
-		mal->buf = r_inflate (data, (int)len, NULL, size);
-		free (data);
-		if (mal->buf) {
-			return r_io_desc_new (io, &r_io_plugin_gzip, pathname, rw, mode, mal);
+		RBuffer *file = r_buf_new_mmap (pathname + 7, R_PERM_R);
+		if (file) {
+			// 15 + 32 accepts both gzip and zlib headers
+			gz->b = r_buf_new_inflate (file, 15 + 32);
+			r_buf_free (file);
+		}
+		if (gz->b) {
+			return r_io_desc_new (io, &r_io_plugin_gzip, pathname, rw, mode, gz);
 		}
-		eprintf ("Cannot allocate (%s) %d byte(s)\n", pathname+9, mal->size);
-		free (mal);
+		eprintf ("Cannot inflate %s\n", pathname + 7);
+		free (gz);
 	}
 	return NULL;
 }
@@ -122,6 +122,100 @@ struct zip *r_io_zip_open_archive(const char *archivename, ut32 perm, int mode,
 	return NULL;
 }
 
+// libzip does not tell where the data of an entry starts, look it up in the central directory
+static ut64 r_io_zip_entry_offset(RBuffer *b, ut64 index, const char *name) {
+	ut8 rec[46];
+	ut64 size = r_buf_size (b);
+	if (size < 22) {
+		return UT64_MAX;
+	}
+	// the end of central directory record can be followed by a comment of up to 64K
+	ut64 min = size > 22 + 0xffff? size - 22 - 0xffff: 0;
+	ut64 at = size - 22;
+	while (r_buf_read_at (b, at, rec, 4) != 4 || r_read_le32 (rec) != 0x06054b50) {
+		if (at == min) {
+			return UT64_MAX;
+		}
+		at--;
+	}
+	if (r_buf_read_at (b, at, rec, 22) != 22) {
+		return UT64_MAX;
+	}
+	ut64 cd = r_read_le32 (rec + 16);
+	if (index >= r_read_le16 (rec + 10) || cd == UT32_MAX) {
+		// zip64 archives are slurped by libzip
+		return UT64_MAX;
+	}
+	ut64 i;
+	for (i = 0; i < index; i++) {
+		if (r_buf_read_at (b, cd, rec, 46) != 46 || r_read_le32 (rec) != 0x02014b50) {
+			return UT64_MAX;
+		}
+		cd += 46 + r_read_le16 (rec + 28) + r_read_le16 (rec + 30) + r_read_le16 (rec + 32);
+	}
+	if (r_buf_read_at (b, cd, rec, 46) != 46 || r_read_le32 (rec) != 0x02014b50) {
+		return UT64_MAX;
+	}
+	size_t namelen = r_read_le16 (rec + 28);
+	char *s = calloc (1, namelen + 1);
+	bool match = s && r_buf_read_at (b, cd + 46, (ut8 *)s, namelen) == namelen && !strcmp (s, name);
+	free (s);
+	if (!match) {
+		return UT64_MAX;
+	}
+	ut64 local = r_read_le32 (rec + 42);
+	if (r_buf_read_at (b, local, rec, 30) != 30 || r_read_le32 (rec) != 0x04034b50) {
+		return UT64_MAX;
+	}
+	return local + 30 + r_read_le16 (rec + 26) + r_read_le16 (rec + 28);
+}
+
+// stored entries are read from the mapped archive and deflated ones are inflated on demand
+static RBuffer *r_io_zip_entry_buf(RIOZipFileObj *zfo, struct zip_stat *sb) {
+	const zip_uint64_t need = ZIP_STAT_COMP_METHOD | ZIP_STAT_ENCRYPTION_METHOD | ZIP_STAT_SIZE | ZIP_STAT_COMP_SIZE;
+	if ((sb->valid & need) != need || sb->encryption_method != ZIP_EM_NONE) {
+		return NULL;
+	}
+	if (sb->comp_method != ZIP_CM_STORE && sb->comp_method != ZIP_CM_DEFLATE) {
+		return NULL;
+	}
+	RBuffer *file = r_buf_new_mmap (zfo->archivename, R_PERM_R);
+	if (!file) {
+		return NULL;
+	}
+	RBuffer *b = NULL;
+	ut64 off = r_io_zip_entry_offset (file, zfo->entry, sb->name);
+	if (off != UT64_MAX && off + sb->comp_size <= r_buf_size (file)) {
+		RBuffer *data = r_buf_new_slice (file, off, sb->comp_size);
+		if (data && sb->comp_method == ZIP_CM_DEFLATE) {
+			b = r_buf_new_inflate (data, -15);
+			r_buf_free (data);
+		} else {
+			b = data;
+		}
+		if (b && r_buf_size (b) != sb->size) {
+			r_buf_free (b);
+			b = NULL;
+		}
+	}
+	r_buf_free (file);
+	return b;
+}
+
+// writes need the whole entry in memory, it is written back to the archive on flush
+static bool r_io_zip_materialize(RIOZipFileObj *zfo) {
+	if (zfo->b->readonly) {
+		RBuffer *b = r_buf_new_with_buf (zfo->b);
+		if (!b) {
+			return false;
+		}
+		r_buf_seek (b, r_buf_tell (zfo->b), R_BUF_SET);
+		r_buf_free (zfo->b);
+		zfo->b = b;
+	}
+	return true;
+}
+
 static int r_io_zip_slurp_file(RIOZipFileObj *zfo) {
 	struct zip_file *zFile = NULL;
 	struct zip *zipArch;
@@ -134,7 +228,18 @@ static int r_io_zip_slurp_file(RIOZipFileObj *zfo) {
 		zfo->archivename, zfo->perm,
 		zfo->mode, zfo->rw);
 
-	if (zipArch && zfo && zfo->entry != -1) {
+	if (zipArch && zfo->entry != -1) {
+		zip_stat_init (&sb);
+		if (!zip_stat_index (zipArch, zfo->entry, 0, &sb)) {
+			RBuffer *b = r_io_zip_entry_buf (zfo, &sb);
+			if (b) {
+				r_buf_free (zfo->b);
+				zfo->b = b;
+				zfo->opened = true;
+				zip_close (zipArch);
+				return true;
+			}
+		}
 		zFile = zip_fopen_index (zipArch, zfo->entry, 0);
 		if (!zFile) {
 			zip_close (zipArch);
@@ -572,11 +677,11 @@ static int r_io_zip_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 }
 
 static int r_io_zip_realloc_buf(RIOZipFileObj *zfo, int count) {
-	return r_buf_resize (zfo->b, r_buf_tell (zfo->b) + count);
+	return r_io_zip_materialize (zfo) && r_buf_resize (zfo->b, r_buf_tell (zfo->b) + count);
 }
 
 static bool r_io_zip_truncate_buf(RIOZipFileObj *zfo, int size) {
-	return r_buf_resize (zfo->b, size > 0? size: 0);
+	return r_io_zip_materialize (zfo) && r_buf_resize (zfo->b, size > 0? size: 0);
 }
 
 static bool r_io_zip_resize(RIO *io, RIODesc *fd, ut64 size) {
@@ -600,7 +705,7 @@ static int r_io_zip_write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 		return -1;
 	}
 	zfo = fd->data;
-	if (!(zfo->perm & R_PERM_W)) {
+	if (!(zfo->perm & R_PERM_W) || !r_io_zip_materialize (zfo)) {
 		return -1;
 	}
 	if (r_buf_tell (zfo->b) + count >= r_buf_size (zfo->b)) {
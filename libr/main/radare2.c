@@ -1377,6 +1377,9 @@ R_API int r_main_radare2(int argc, const char **argv) {
 
 		// no flagspace selected by default the beginning
 		r_flag_space_set (r->flags, NULL);
+		if (r_config_get_b (r->config, "anal.cache")) {
+			r_core_anal_cache_load (r, 0);
+		}
 		/* load <file>.r2 */
 		{
 			char* f = r_str_newf ("%s.r2", pfile);
@@ -1482,6 +1485,9 @@ R_API int r_main_radare2(int argc, const char **argv) {
 
 		// no flagspace selected by default the beginning
 		r_flag_space_set (r->flags, NULL);
+		if (r_config_get_b (r->config, "anal.cache")) {
+			r_core_anal_cache_load (r, 0);
+		}
 		if (!debug && r->bin && r->bin->cur && r->bin->cur->o && r->bin->cur->o->info) {
 			if (r->bin->cur->o->info->arch) {
 				r_core_cmd0 (r, "aeip");
@@ -158,12 +158,370 @@ static int do_hash_internal(RHash *ctx, ut64 hash, const ut8 *buf, int len, PJ *
 	return 1;
 }
 
+#define HASH_THREADS_MAX 16
+// size of the reads shared by the algorithm workers
+#define HASH_CHUNK_SIZE (4 * 1024 * 1024)
+// chunks in flight: one being read while the other one is hashed
+#define HASH_RING 2
+// how much data is hashed in parallel before printing the per-block results
+#define HASH_BATCH_SIZE (64 * 1024 * 1024)
+#define HASH_STREAMING (R_HASH_MD5 | R_HASH_SHA1 | R_HASH_SHA256 | R_HASH_SHA384 | R_HASH_SHA512)
+
+static int hash_threads(ut64 count) {
+	return (int)R_MAX (1, R_MIN (R_MIN ((ut64)r_th_ncpus (), count), HASH_THREADS_MAX));
+}
+
+// the reader thread fills the ring with chunks and each worker feeds
+// them to its own algorithms, so the file is read once for all of them
+typedef struct {
+	ut64 algos[R_HASH_NBITS];
+	RHash *ctxs[R_HASH_NBITS];
+	int nalgos;
+	int nworkers;
+	int bsize;
+	ut8 *bufs[HASH_RING];
+	int lens[HASH_RING];
+	ut64 nchunks;
+	ut64 ready;
+	ut64 done[HASH_THREADS_MAX];
+	RThreadLock *lock;
+	RThreadCond *cond;
+} HashPipe;
+
+typedef struct {
+	HashPipe *p;
+	int id;
+} HashWorker;
+
+static void pipe_begin(HashPipe *p, int id) {
+	int k;
+	for (k = id; k < p->nalgos; k += p->nworkers) {
+		r_hash_do_begin (p->ctxs[k], p->algos[k]);
+		if (s.buf && s.prefix) {
+			r_hash_calculate (p->ctxs[k], p->algos[k], s.buf, s.len);
+		}
+	}
+}
+
+// non-streaming algorithms only see the last block, so keep feeding bsize steps
+static void pipe_update(HashPipe *p, int id, const ut8 *buf, int len) {
+	int k, off;
+	for (off = 0; off < len; off += p->bsize) {
+		int n = R_MIN (p->bsize, len - off);
+		for (k = id; k < p->nalgos; k += p->nworkers) {
+			r_hash_calculate (p->ctxs[k], p->algos[k], buf + off, n);
+		}
+	}
+}
+
+static void pipe_end(HashPipe *p, int id) {
+	int k;
+	for (k = id; k < p->nalgos; k += p->nworkers) {
+		if (s.buf && !s.prefix) {
+			r_hash_calculate (p->ctxs[k], p->algos[k], s.buf, s.len);
+		}
+		r_hash_do_end (p->ctxs[k], p->algos[k]);
+		if (iterations > 0) {
+			r_hash_do_spice (p->ctxs[k], p->algos[k], iterations, _s);
+		}
+	}
+}
+
+static void pipe_set_done(HashPipe *p, int id, ut64 m) {
+	if (p->lock) {
+		r_th_lock_enter (p->lock);
+		p->done[id] = m;
+		r_th_cond_signal_all (p->cond);
+		r_th_lock_leave (p->lock);
+	} else {
+		p->done[id] = m;
+	}
+}
+
+static RThreadFunctionRet pipe_thread(RThread *th) {
+	HashWorker *w = th->user;
+	HashPipe *p = w->p;
+	ut64 m;
+	pipe_begin (p, w->id);
+	for (m = 0; m < p->nchunks; m++) {
+		r_th_lock_enter (p->lock);
+		while (p->ready <= m) {
+			r_th_cond_wait (p->cond, p->lock);
+		}
+		r_th_lock_leave (p->lock);
+		pipe_update (p, w->id, p->bufs[m % HASH_RING], p->lens[m % HASH_RING]);
+		pipe_set_done (p, w->id, m + 1);
+	}
+	pipe_end (p, w->id);
+	return R_TH_STOP;
+}
+
+static ut64 pipe_done(HashPipe *p) {
+	ut64 done = UT64_MAX;
+	int i;
+	for (i = 0; i < p->nworkers; i++) {
+		done = R_MIN (done, p->done[i]);
+	}
+	return done;
+}
+
+static bool pipe_run(HashPipe *p, RIO *io) {
+	RThread *threads[HASH_THREADS_MAX] = {0};
+	HashWorker workers[HASH_THREADS_MAX];
+	ut64 m, chunk = p->bsize;
+	int i;
+	if (chunk < HASH_CHUNK_SIZE) {
+		chunk *= HASH_CHUNK_SIZE / chunk;
+	}
+	p->nchunks = (to - from + chunk - 1) / chunk;
+	for (i = 0; i < R_MIN (HASH_RING, p->nchunks); i++) {
+		p->bufs[i] = malloc (chunk + 1);
+		if (!p->bufs[i]) {
+			return false;
+		}
+	}
+	if (p->nworkers > 1) {
+		p->lock = r_th_lock_new (false);
+		p->cond = r_th_cond_new ();
+		if (p->lock && p->cond) {
+			for (i = 0; i < p->nworkers; i++) {
+				workers[i].p = p;
+				workers[i].id = i;
+				threads[i] = r_th_new (pipe_thread, &workers[i], 0);
+			}
+		}
+	}
+	// workers without a thread run on the reader, between reads
+	for (i = 0; i < p->nworkers; i++) {
+		if (!threads[i]) {
+			pipe_begin (p, i);
+		}
+	}
+	for (m = 0; m < p->nchunks; m++) {
+		int slot = m % HASH_RING;
+		ut64 at = from + m * chunk;
+		if (p->lock) {
+			r_th_lock_enter (p->lock);
+			while (pipe_done (p) + HASH_RING <= m) {
+				r_th_cond_wait (p->cond, p->lock);
+			}
+			r_th_lock_leave (p->lock);
+		}
+		p->lens[slot] = (int)R_MIN (chunk, to - at);
+		r_io_pread_at (io, at, p->bufs[slot], p->lens[slot]);
+		if (p->lock) {
+			r_th_lock_enter (p->lock);
+			p->ready = m + 1;
+			r_th_cond_signal_all (p->cond);
+			r_th_lock_leave (p->lock);
+		}
+		for (i = 0; i < p->nworkers; i++) {
+			if (!threads[i]) {
+				pipe_update (p, i, p->bufs[slot], p->lens[slot]);
+				pipe_set_done (p, i, m + 1);
+			}
+		}
+	}
+	for (i = 0; i < p->nworkers; i++) {
+		if (threads[i]) {
+			r_th_wait (threads[i]);
+			r_th_free (threads[i]);
+		} else {
+			pipe_end (p, i);
+		}
+	}
+	return true;
+}
+
+static bool do_hash_incremental(const char *file, RIO *io, ut64 algobit, int bsize, RHash *ctx, PJ *pj, int rad, int ule) {
+	HashPipe p = { .bsize = bsize };
+	bool streaming = true;
+	bool res = false;
+	ut64 i;
+	int k;
+	for (i = 1; i < R_HASH_ALL; i <<= 1) {
+		if (algobit & i) {
+			p.ctxs[p.nalgos] = r_hash_new (true, i);
+			if (!p.ctxs[p.nalgos]) {
+				goto beach;
+			}
+			p.algos[p.nalgos++] = i;
+			streaming &= (i & HASH_STREAMING) != 0;
+		}
+	}
+	if (streaming) {
+		// block boundaries do not change the result, use larger reads
+		p.bsize = R_MAX (bsize, HASH_CHUNK_SIZE);
+	}
+	p.nworkers = hash_threads (p.nalgos);
+	if (!pipe_run (&p, io)) {
+		goto beach;
+	}
+	for (k = 0; k < p.nalgos; k++) {
+		ut64 hashbit = p.algos[k];
+		int dlen = r_hash_size (hashbit);
+		if (!*r_hash_name (hashbit)) {
+			continue;
+		}
+		if (!quiet && rad != 'j') {
+			printf ("%s: ", file);
+		}
+		do_hash_print (p.ctxs[k], hashbit, dlen, pj, quiet? 'n': rad, ule);
+		if (quiet == 1) {
+			printf (" %s\n", file);
+		} else {
+			if (quiet && !rad) {
+				printf ("\n");
+			}
+		}
+	}
+	// -c compares against the last computed digest
+	if (p.nalgos > 0) {
+		memcpy (ctx->digest, p.ctxs[p.nalgos - 1]->digest, sizeof (ctx->digest));
+	}
+	res = true;
+beach:
+	for (k = 0; k < p.nalgos; k++) {
+		r_hash_free (p.ctxs[k]);
+	}
+	for (k = 0; k < HASH_RING; k++) {
+		free (p.bufs[k]);
+	}
+	r_th_lock_free (p.lock);
+	r_th_cond_free (p.cond);
+	return res;
+}
+
+// per-block hashes are independent, compute a batch of them in parallel
+// and print them in order
+typedef struct {
+	ut64 hashbit;
+	const ut8 *buf;
+	RHash *ctxs;
+	int *dlens;
+	ut64 from;
+	ut64 fsize;
+	int bsize;
+	int count;
+	int nthreads;
+} HashBlocks;
+
+typedef struct {
+	HashBlocks *b;
+	int tid;
+} HashBlocksThread;
+
+static void blocks_hash(HashBlocks *b, int tid) {
+	int k;
+	for (k = tid; k < b->count; k += b->nthreads) {
+		ut64 j = b->from + (ut64)k * b->bsize;
+		int nsize = (j + b->bsize < b->fsize)? b->bsize: (int)(b->fsize - j);
+		b->dlens[k] = -1;
+		if (nsize < 0) {
+			continue;
+		}
+		b->dlens[k] = r_hash_calculate (&b->ctxs[k], b->hashbit, b->buf + (ut64)k * b->bsize, nsize);
+		if (iterations > 0) {
+			r_hash_do_spice (&b->ctxs[k], b->hashbit, iterations, _s);
+		}
+	}
+}
+
+static RThreadFunctionRet blocks_thread(RThread *th) {
+	HashBlocksThread *t = th->user;
+	blocks_hash (t->b, t->tid);
+	return R_TH_STOP;
+}
+
+static void blocks_run(HashBlocks *b) {
+	RThread *threads[HASH_THREADS_MAX] = {0};
+	HashBlocksThread ctx[HASH_THREADS_MAX];
+	int i;
+	for (i = 1; i < b->nthreads; i++) {
+		ctx[i].b = b;
+		ctx[i].tid = i;
+		threads[i] = r_th_new (blocks_thread, &ctx[i], 0);
+	}
+	blocks_hash (b, 0);
+	for (i = 1; i < b->nthreads; i++) {
+		if (threads[i]) {
+			r_th_wait (threads[i]);
+			r_th_free (threads[i]);
+		} else {
+			// could not spawn it, do its share here
+			blocks_hash (b, i);
+		}
+	}
+}
+
+static bool do_hash_blocks(RIO *io, ut64 algobit, int bsize, ut64 fsize, RHash *ctx, PJ *pj, int rad, int ule) {
+	ut64 nblocks = (to > from)? (to - from + bsize - 1) / bsize: 0;
+	int nthreads = hash_threads (nblocks);
+	ut64 batch = R_MAX (HASH_BATCH_SIZE / bsize, 1);
+	if (batch < nthreads) {
+		// big blocks, allow some more memory to keep all threads busy
+		batch = R_MAX (R_MIN ((ut64)nthreads, (4ULL * HASH_BATCH_SIZE) / bsize), 1);
+	}
+	batch = R_MAX (R_MIN (batch, nblocks), 1);
+	HashBlocks b = {
+		.fsize = fsize,
+		.bsize = bsize,
+		.nthreads = nthreads,
+	};
+	ut8 *buf = malloc (batch * bsize + 1);
+	if (!buf && batch > 1) {
+		batch = 1;
+		buf = malloc (bsize + 1);
+	}
+	b.ctxs = R_NEWS (RHash, batch);
+	b.dlens = R_NEWS (int, batch);
+	if (!buf || !b.ctxs || !b.dlens) {
+		free (buf);
+		free (b.ctxs);
+		free (b.dlens);
+		return false;
+	}
+	b.buf = buf;
+	ut64 i, j, ofrom = from, oto = to;
+	int k;
+	for (i = 1; i < R_HASH_ALL; i <<= 1) {
+		if (!(algobit & i)) {
+			continue;
+		}
+		b.hashbit = i & algobit;
+		for (j = ofrom; j < oto; j += (ut64)b.count * bsize) {
+			b.from = j;
+			b.count = (int)R_MIN (batch, (oto - j + bsize - 1) / bsize);
+			for (k = 0; k < b.count; k++) {
+				r_io_pread_at (io, j + (ut64)k * bsize, buf + (ut64)k * bsize, bsize);
+				// same state as the shared context had for every block
+				memcpy (&b.ctxs[k], ctx, sizeof (RHash));
+			}
+			b.nthreads = R_MIN (nthreads, b.count);
+			blocks_run (&b);
+			for (k = 0; k < b.count; k++) {
+				if (b.dlens[k] < 0) {
+					continue;
+				}
+				from = j + (ut64)k * bsize;
+				to = R_MIN (from + bsize, fsize);
+				do_hash_print (&b.ctxs[k], b.hashbit, b.dlens[k], pj, rad, ule);
+			}
+		}
+		from = ofrom;
+		to = oto;
+		do_hash_internal (ctx, b.hashbit, NULL, 0, pj, rad, 1, ule);
+	}
+	free (buf);
+	free (b.ctxs);
+	free (b.dlens);
+	return true;
+}
+
 static int do_hash(const char *file, const char *algo, RIO *io, int bsize, int rad, int ule, const ut8 *compare) {
-	ut64 j, fsize, algobit = r_hash_name_to_bits (algo);
+	ut64 fsize, algobit = r_hash_name_to_bits (algo);
 	RHash *ctx;
-	ut8 *buf;
 	int ret = 0;
-	ut64 i;
 	if (algobit == R_HASH_NONE) {
 		eprintf ("rahash2: Invalid hashing algorithm specified. Use rahash2 -L\n");
 		return 1;
@@ -190,15 +548,10 @@ static int do_hash(const char *file, const char *algo, RIO *io, int bsize, int r
 		eprintf ("rahash2: Unknown file size\n");
 		return 1;
 	}
-	buf = calloc (1, bsize + 1);
-	if (!buf) {
-		return 1;
-	}
 	PJ *pj = NULL;
 	if (rad == 'j' || rad == 'J') {
 		pj = pj_new ();
 		if (!pj) {
-			free (buf);
 			return 1;
 		}
 		if (rad == 'J') {
@@ -208,74 +561,23 @@ static int do_hash(const char *file, const char *algo, RIO *io, int bsize, int r
 		}
 	}
 	ctx = r_hash_new (true, algobit);
-
+	if (!ctx) {
+		pj_free (pj);
+		return 1;
+	}
 	if (incremental) {
-		for (i = 1; i < R_HASH_ALL; i <<= 1) {
-			if (algobit & i) {
-				ut64 hashbit = i & algobit;
-				int dlen = r_hash_size (hashbit);
-				r_hash_do_begin (ctx, i);
-				if (s.buf && s.prefix) {
-					do_hash_internal (ctx, hashbit, s.buf, s.len, pj, rad, 0, ule);
-				}
-				for (j = from; j < to; j += bsize) {
-					int len = ((j + bsize) > to)? (to - j): bsize;
-					r_io_pread_at (io, j, buf, len);
-					do_hash_internal (ctx, hashbit, buf, len, pj, rad, 0, ule);
-				}
-				if (s.buf && !s.prefix) {
-					do_hash_internal (ctx, hashbit, s.buf, s.len, pj, rad, 0, ule);
-				}
-				r_hash_do_end (ctx, i);
-				if (iterations > 0) {
-					r_hash_do_spice (ctx, i, iterations, _s);
-				}
-				if (!*r_hash_name (i)) {
-					continue;
-				}
-				if (!quiet && rad != 'j') {
-					printf ("%s: ", file);
-				}
-				do_hash_print (ctx, i, dlen, pj, quiet? 'n': rad, ule);
-				if (quiet == 1) {
-					printf (" %s\n", file);
-				} else {
-					if (quiet && !rad) {
-						printf ("\n");
-					}
-				}
-			}
+		if (!do_hash_incremental (file, io, algobit, bsize, ctx, pj, rad, ule)) {
+			ret = 1;
 		}
 		if (_s) {
 			free (_s->buf);
 		}
 	} else {
-		/* iterate over all algorithm bits */
 		if (s.buf) {
 			eprintf ("Warning: Seed ignored on per-block hashing.\n");
 		}
-		for (i = 1; i < R_HASH_ALL; i <<= 1) {
-			ut64 f, t, ofrom, oto;
-			if (algobit & i) {
-				ut64 hashbit = i & algobit;
-				ofrom = from;
-				oto = to;
-				f = from;
-				t = to;
-				for (j = f; j < t; j += bsize) {
-					int nsize = (j + bsize < fsize)? bsize: (fsize - j);
-					r_io_pread_at (io, j, buf, bsize);
-					from = j;
-					to = j + bsize;
-					if (to > fsize) {
-						to = fsize;
-					}
-					do_hash_internal (ctx, hashbit, buf, nsize, pj, rad, 1, ule);
-				}
-				do_hash_internal (ctx, hashbit, NULL, 0, pj, rad, 1, ule);
-				from = ofrom;
-				to = oto;
-			}
+		if (!do_hash_blocks (io, algobit, bsize, fsize, ctx, pj, rad, ule)) {
+			ret = 1;
 		}
 	}
 	if (rad == 'j') {
@@ -286,7 +588,6 @@ static int do_hash(const char *file, const char *algo, RIO *io, int bsize, int r
 
 	compare_hashes (ctx, compare, r_hash_size (algobit), &ret);
 	r_hash_free (ctx);
-	free (buf);
 	return ret;
 }
 
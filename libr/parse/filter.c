@@ -43,104 +43,133 @@ static void insert(char *dst, const char *src) {
 	free (endNum);
 }
 
-// TODO: move into r_util/r_str
-static void replaceWords(char *s, const char *k, const char *v) {
-	for (;;) {
-		char *p = strstr (s, k);
-		if (!p) {
-			break;
+typedef struct {
+	const char *s;
+	RVector *tokens; // RParseToken stream of s
+	size_t next; // first token not scanned yet
+} NumberScan;
+
+// numbers are filtered when they start an operand: after a space, a comma,
+// a bracket starting an operand or an ansi escape, or at the scan start
+static bool operand_start(NumberScan *ns, size_t i, size_t start) {
+	for (; i != start; i--) {
+		RParseToken *prev = r_vector_index_ptr (ns->tokens, i - 1);
+		if (prev->type == R_PARSE_TOKEN_ANSI) {
+			return true;
+		}
+		if (prev->type != R_PARSE_TOKEN_SEPARATOR) {
+			return false;
+		}
+		const char ch = ns->s[prev->off];
+		if (ch != '[') {
+			return ch == ' ' || ch == ',';
 		}
-		char *s = p + strlen (k);
-		char *d = p + strlen (v);
-		memmove (d, s, strlen (s) + 1);
-		memmove (p, v, strlen (v));
-		s = p + strlen (v);
 	}
+	return true;
 }
 
-static char *findNextNumber(char *op) {
-	if (!op) {
-		return NULL;
+// next number to filter at or after from, negative numbers are matched by
+// their digits
+static char *scan_number(NumberScan *ns, const char *from) {
+	const size_t len = r_vector_len (ns->tokens);
+	size_t i = ns->next;
+	while (i < len && ((RParseToken *)r_vector_index_ptr (ns->tokens, i))->off < from - ns->s) {
+		i++;
 	}
-	bool ansi_found = false;
-	char *p = op;
-	const char *o = NULL;
-	while (*p) {
-		if (p[0] == 0x1b && p[1] == '[') {
-			ansi_found = true;
-			p += 2;
-			for (; *p && *p != 'J' && *p != 'm' && *p != 'H'; p++) {
-				;
-			}
-			if (*p) {
-				p++;
-				if (!*p) {
-					break;
-				}
-			}
-			o = p - 1;
-		} else {
-			bool isSpace = ansi_found;
-			ansi_found = false;
-			if (!isSpace) {
-				isSpace = p == op;
-				if (!isSpace && o) {
-					isSpace = (*o == ' ' || *o == ',' || *o == '[');
-				}
-			}
-			if (*p == '[') {
-				p++;
-				if (!*p) {
-					break;
-				}
-				if (!IS_DIGIT (*p)) {
-					char *t = p;
-					for (; *t && *t != ']'; t++) {
-						;
-					}
-					if (*t == ']') {
-						continue;
-					}
-					p = t;
-					if (!*p) {
-						break;
-					}
-				}
-			}
-			if (isSpace) {
-				if (IS_DIGIT (*p)) {
-					return p;
-				}
-				if ((*p == '-') && IS_DIGIT (p[1])) {
-					return p + 1;
-				}
-			}
-			o = p++;
+	const size_t start = i;
+	for (; i < len; i++) {
+		RParseToken *t = r_vector_index_ptr (ns->tokens, i);
+		if (t->type != R_PARSE_TOKEN_NUMBER) {
+			continue;
+		}
+		bool neg = false;
+		if (i > start) {
+			RParseToken *prev = r_vector_index_ptr (ns->tokens, i - 1);
+			neg = prev->type == R_PARSE_TOKEN_SEPARATOR && ns->s[prev->off] == '-';
+		}
+		if (operand_start (ns, neg? i - 1: i, start)) {
+			ns->next = i + 1;
+			return (char *)ns->s + t->off;
 		}
 	}
+	ns->next = len;
 	return NULL;
 }
 
-static void __replaceRegisters(RReg *reg, char *s, bool x86) {
-	int i;
-	for (i = 0; i < 64; i++) {
-		const char *k = r_reg_get_name (reg, i);
-		if (!k || i == R_REG_NAME_PC) {
+// a tail is at most 18 chars long and it replaces one digit or more
+#define SUBTAIL_GROWTH 17
+
+static int subtail_insert(NumberScan *ns, char *dst, const char *src) {
+	const int oldlen = strlen (ns->s);
+	insert (dst, src);
+	const int delta = (int)strlen (ns->s) - oldlen;
+	size_t i;
+	for (i = ns->next; i < r_vector_len (ns->tokens); i++) {
+		RParseToken *t = r_vector_index_ptr (ns->tokens, i);
+		t->off += delta;
+	}
+	return delta;
+}
+
+// replace registers with their role names in one pass over the token
+// stream, out is NULL when there is nothing to replace. the tokens are
+// left describing the result, returns false if s could not be tokenized
+static bool subreg(RParse *p, const char *s, bool x86, char **out) {
+	RReg *reg = p->analb.anal->reg;
+	*out = NULL;
+	if (!r_parse_tokenize (p, s, &p->tokens)) {
+		return false;
+	}
+	RParseToken *t;
+	size_t n = 0, size = strlen (s) + 1;
+	r_vector_foreach (&p->tokens, t) {
+		if (t->type != R_PARSE_TOKEN_REGISTER) {
 			continue;
 		}
-		const char *v = r_reg_get_role (i);
-		if (!v) {
-			break;
+		if (t->role == -1 && x86 && s[t->off] == 'e') {
+			// eax is replaced like rax
+			char r64[32];
+			r_str_ncpy (r64, s + t->off, R_MIN (t->len + 1, sizeof (r64)));
+			*r64 = 'r';
+			int i;
+			for (i = 0; i < R_REG_NAME_LAST; i++) {
+				const char *k = reg->name[i];
+				if (k && !strcmp (k, r64)) {
+					t->role = i;
+					break;
+				}
+			}
+		}
+		if (t->role == -1 || t->role == R_REG_NAME_PC) {
+			t->role = -1;
+			continue;
 		}
-		if (x86 && *k == 'r') {
-			replaceWords (s, k, v);
-			char *reg32 = strdup (k);
-			*reg32 = 'e';
-			replaceWords (s, reg32, v);
-		} else {
-			replaceWords (s, k, v);
+		size += strlen (r_reg_get_role (t->role));
+		n++;
+	}
+	if (!n) {
+		return true;
+	}
+	char *res = malloc (size);
+	if (!res) {
+		return false;
+	}
+	char *d = res;
+	r_vector_foreach (&p->tokens, t) {
+		const char *v = s + t->off;
+		size_t vlen = t->len;
+		if (t->type == R_PARSE_TOKEN_REGISTER && t->role != -1) {
+			v = r_reg_get_role (t->role);
+			vlen = strlen (v);
 		}
+		memcpy (d, v, vlen);
+		t->off = d - res;
+		t->len = vlen;
+		d += vlen;
 	}
+	*d = 0;
+	*out = res;
+	return true;
 }
 
 static bool filter(RParse *p, ut64 addr, RFlag *f, RAnalHint *hint, char *data, char *str, int len, bool big_endian) {
@@ -167,21 +196,12 @@ static bool filter(RParse *p, ut64 addr, RFlag *f, RAnalHint *hint, char *data,
 	if (!data || !p) {
 		return 0;
 	}
-#if FILTER_DWORD
-	replaceWords (ptr, "dword ", src);
-	replaceWords (ptr, "qword ", src);
-#endif
-	if (p->subreg) {
-		__replaceRegisters (p->analb.anal->reg, ptr, false);
-		if (x86) {
-			__replaceRegisters (p->analb.anal->reg, ptr, true);
-		}
-	}
 	ptr2 = NULL;
 	// remove "dword" 2
+	NumberScan ns = { data, &p->tokens, 0 };
 	char *nptr;
 	int count = 0;
-	for (count = 0; (nptr = findNextNumber (ptr)) ; count++) {
+	for (count = 0; (nptr = scan_number (&ns, ptr)) ; count++) {
 		ptr = nptr;
 		if (x86) {
 			for (ptr2 = ptr; *ptr2 && !isx86separator (*ptr2); ptr2++) {
@@ -373,13 +393,13 @@ static bool filter(RParse *p, ut64 addr, RFlag *f, RAnalHint *hint, char *data,
 				if (p->subtail) { //  && off > UT32_MAX && addr > UT32_MAX)
 					if (off != UT64_MAX) {
 						if (off == addr) {
-							insert (ptr, "$$");
+							ptr2 += subtail_insert (&ns, ptr, "$$");
 						} else {
 							ut64 tail = r_num_tail_base (NULL, addr, off);
 							if (tail != UT64_MAX) {
 								char str[128];
 								snprintf (str, sizeof (str), "..%"PFMT64x, tail);
-								insert (ptr, str);
+								ptr2 += subtail_insert (&ns, ptr, str);
 							}
 						}
 					}
@@ -581,11 +601,47 @@ static bool filter(RParse *p, ut64 addr, RFlag *f, RAnalHint *hint, char *data,
 // TODO: NEW SIGNATURE: R_API char *r_parse_filter(RParse *p, ut64 addr, const char *str)
 // DEPRECATE
 R_API bool r_parse_filter(RParse *p, ut64 addr, RFlag *f, RAnalHint *hint, char *data, char *str, int len, bool big_endian) {
+	char *sub = NULL;
+	if (!data) {
+		return false;
+	}
+	// the number filter walks the same token stream as asm.sub.reg
+	bool tokenized = false;
+	if (p->subreg) {
+		const char *pname = p->cur? p->cur->name: NULL;
+		bool x86 = pname && (strstr (pname, "x86") || strstr (pname, "m68k"));
+		tokenized = subreg (p, data, x86, &sub);
+		if (sub) {
+			data = sub;
+		}
+	}
+	if (!tokenized && !r_parse_tokens (NULL, data, &p->tokens)) {
+		free (sub);
+		return false;
+	}
+	if (p->subtail) {
+		// the tails are written in place, make room for all of them
+		size_t n = 0, size = strlen (data) + 1;
+		RParseToken *t;
+		r_vector_foreach (&p->tokens, t) {
+			n += t->type == R_PARSE_TOKEN_NUMBER;
+		}
+		char *buf = malloc (size + n * SUBTAIL_GROWTH);
+		if (!buf) {
+			free (sub);
+			return false;
+		}
+		memcpy (buf, data, size);
+		free (sub);
+		data = sub = buf;
+	}
 	filter (p, addr, f, hint, data, str, len, big_endian);
+	bool ret = false;
 	if (p->cur && p->cur->filter) {
-		return p->cur->filter (p, addr, f, data, str, len, big_endian);
+		ret = p->cur->filter (p, addr, f, data, str, len, big_endian);
 	}
-	return false;
+	free (sub);
+	return ret;
 }
 
 // easier to use, should replace r_parse_filter(), but its not using rflag, analhint, endian, etc
@@ -25,6 +25,7 @@ R_API RParse *r_parse_new(void) {
 	p->subtail = false;
 	p->minval = 0x100;
 	p->localvar_only = false;
+	r_vector_init (&p->tokens, sizeof (RParseToken), NULL, NULL);
 	size_t i;
 	for (i = 0; parse_static_plugins[i]; i++) {
 		r_parse_add (p, parse_static_plugins[i]);
@@ -35,6 +36,7 @@ R_API RParse *r_parse_new(void) {
 R_API void r_parse_free(RParse *p) {
 	if (p) {
 		r_list_free (p->parsers);
+		r_vector_fini (&p->tokens);
 		free (p);
 	}
 }
@@ -154,6 +156,82 @@ R_API char *r_parse_immtrim(char *opstr) {
 	return opstr;
 }
 
+static inline bool is_word_start(const char ch) {
+	return IS_LOWER (ch) || IS_UPPER (ch) || ch == '_';
+}
+
+static inline bool is_word_char(const char ch) {
+	return is_word_start (ch) || IS_DIGIT (ch);
+}
+
+static int reg_role(RReg *reg, const char *name) {
+	int i;
+	for (i = 0; i < R_REG_NAME_LAST; i++) {
+		const char *k = reg->name[i];
+		if (k && !strcmp (k, name)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// split an opcode string in a single pass, the first word is the mnemonic,
+// words known by the register profile are registers and other words are
+// symbols. ansi escapes are kept as their own tokens so passes can skip them
+R_IPI bool r_parse_tokens(RReg *reg, const char *str, RVector *tokens) {
+	bool mnemonic = true;
+	char word[32];
+	const char *s = str;
+	tokens->len = 0;
+	while (*s) {
+		RParseToken t = { R_PARSE_TOKEN_SEPARATOR, s - str, 1, -1 };
+		const char *e = s + 1;
+		if (*s == 0x1b) {
+			t.type = R_PARSE_TOKEN_ANSI;
+			if (*e == '[') {
+				e++;
+				while (*e && !IS_LOWER (*e) && !IS_UPPER (*e)) {
+					e++;
+				}
+				if (*e) {
+					e++;
+				}
+			}
+		} else if (IS_DIGIT (*s)) {
+			t.type = R_PARSE_TOKEN_NUMBER;
+			while (is_word_char (*e)) {
+				e++;
+			}
+		} else if (is_word_start (*s)) {
+			while (is_word_char (*e)) {
+				e++;
+			}
+			t.type = R_PARSE_TOKEN_SYMBOL;
+			if (mnemonic) {
+				t.type = R_PARSE_TOKEN_MNEMONIC;
+				mnemonic = false;
+			} else if (reg && (size_t)(e - s) < sizeof (word)) {
+				r_str_ncpy (word, s, e - s + 1);
+				t.role = reg_role (reg, word);
+				if (t.role != -1 || r_reg_get (reg, word, -1)) {
+					t.type = R_PARSE_TOKEN_REGISTER;
+				}
+			}
+		}
+		t.len = e - s;
+		if (!r_vector_push (tokens, &t)) {
+			return false;
+		}
+		s = e;
+	}
+	return true;
+}
+
+R_API bool r_parse_tokenize(RParse *p, const char *str, RVector *tokens) {
+	r_return_val_if_fail (p && str && tokens, false);
+	return r_parse_tokens (p->analb.anal? p->analb.anal->reg: NULL, str, tokens);
+}
+
 R_API bool r_parse_subvar(RParse *p, R_NULLABLE RAnalFunction *f, ut64 addr, int oplen, char *data, char *str, int len) {
 	r_return_val_if_fail (p, false);
 	if (p->cur && p->cur->subvar) {
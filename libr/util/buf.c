@@ -11,6 +11,7 @@ typedef enum {
 	R_BUFFER_MMAP,
 	R_BUFFER_SPARSE,
 	R_BUFFER_REF,
+	R_BUFFER_INFLATE,
 } RBufferType;
 
 #include "buf_file.c"
@@ -19,6 +20,7 @@ typedef enum {
 #include "buf_mmap.c"
 #include "buf_io.c"
 #include "buf_ref.c"
+#include "buf_inflate.c"
 
 static bool buf_init(RBuffer *b, const void *user) {
 	r_return_val_if_fail (b && b->methods, false);
@@ -108,6 +110,9 @@ static RBuffer *new_buffer(RBufferType type, const void *user) {
 	case R_BUFFER_REF:
 		b->methods = &buffer_ref_methods;
 		break;
+	case R_BUFFER_INFLATE:
+		b->methods = &buffer_inflate_methods;
+		break;
 	default:
 		r_warn_if_reached ();
 		break;
@@ -172,6 +177,15 @@ R_API RBuffer *r_buf_new_slice(RBuffer *b, ut64 offset, ut64 size) {
 	return new_buffer (R_BUFFER_REF, &u);
 }
 
+// read-only view of the deflate stream in b, wbits as in zlib's inflateInit2
+R_API RBuffer *r_buf_new_inflate(RBuffer *b, int wbits) {
+	r_return_val_if_fail (b, NULL);
+	struct buf_inflate_user u = {0};
+	u.parent = b;
+	u.wbits = wbits;
+	return new_buffer (R_BUFFER_INFLATE, &u);
+}
+
 R_API RBuffer *r_buf_new_with_string(const char *msg) {
 	return r_buf_new_with_bytes ((const ut8 *)msg, (ut64)strlen (msg));
 }
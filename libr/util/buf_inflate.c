@@ -0,0 +1,322 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include <r_util.h>
+#include <zlib.h>
+
+// Seekable view of a deflate stream, based on zlib's examples/zran.c.
+// The stream is inflated once when the buffer is created to record an
+// access point every INFLATE_SPAN bytes of output, reads only inflate
+// the spans they touch and the last INFLATE_CACHE spans are kept around.
+
+#define INFLATE_SPAN (1024 * 1024)
+#define INFLATE_WINDOW 32768
+#define INFLATE_CHUNK 16384
+#define INFLATE_CACHE 8
+
+struct buf_inflate_user {
+	RBuffer *parent;
+	int wbits;
+};
+
+typedef struct {
+	ut64 out; // offset in the inflated data
+	ut64 in; // offset of the first full byte in the compressed data
+	int bits; // bits of the byte at in - 1 that belong to the first block
+	ut8 *window; // last 32K of inflated data before out
+} InflatePoint;
+
+typedef struct {
+	size_t point;
+	ut8 *data;
+	ut64 size;
+	ut32 used;
+} InflateSpan;
+
+struct buf_inflate_priv {
+	RBuffer *parent;
+	RVector points; // InflatePoint
+	ut64 size;
+	ut64 cur;
+	InflateSpan cache[INFLATE_CACHE];
+	ut32 tick;
+};
+
+static inline struct buf_inflate_priv *get_priv_inflate(RBuffer *b) {
+	struct buf_inflate_priv *priv = (struct buf_inflate_priv *)b->priv;
+	r_warn_if_fail (priv);
+	return priv;
+}
+
+static void inflate_point_fini(void *e, void *user) {
+	InflatePoint *p = e;
+	free (p->window);
+}
+
+static bool inflate_point_add(struct buf_inflate_priv *priv, int bits, ut64 in, ut64 out, ut32 left, const ut8 *window) {
+	InflatePoint p = { .out = out, .in = in, .bits = bits };
+	if (out) {
+		// the window is circular, left is how much of its tail is unused
+		p.window = malloc (INFLATE_WINDOW);
+		if (!p.window) {
+			return false;
+		}
+		if (left) {
+			memcpy (p.window, window + INFLATE_WINDOW - left, left);
+		}
+		if (left < INFLATE_WINDOW) {
+			memcpy (p.window + left, window, INFLATE_WINDOW - left);
+		}
+	}
+	if (!r_vector_push (&priv->points, &p)) {
+		free (p.window);
+		return false;
+	}
+	return true;
+}
+
+static bool inflate_index_build(struct buf_inflate_priv *priv, int wbits) {
+	z_stream strm = {0};
+	ut8 *input = malloc (INFLATE_CHUNK);
+	ut8 *window = malloc (INFLATE_WINDOW);
+	if (!input || !window || inflateInit2 (&strm, wbits) != Z_OK) {
+		free (input);
+		free (window);
+		return false;
+	}
+	ut64 at = 0, totin = 0, totout = 0, last = 0;
+	int ret = Z_OK;
+	// raw streams have no header to stop after, their first point is at 0
+	if (wbits < 0 && !inflate_point_add (priv, 0, 0, 0, 0, NULL)) {
+		ret = Z_MEM_ERROR;
+	}
+	while (ret == Z_OK) {
+		if (!strm.avail_in) {
+			// at eof avail_in stays 0, inflate still finds the end of the last block
+			st64 n = r_buf_read_at (priv->parent, at, input, INFLATE_CHUNK);
+			if (n < 0) {
+				ret = Z_DATA_ERROR;
+				break;
+			}
+			at += n;
+			strm.next_in = input;
+			strm.avail_in = (uInt)n;
+		}
+		if (!strm.avail_out) {
+			strm.next_out = window;
+			strm.avail_out = INFLATE_WINDOW;
+		}
+		totin += strm.avail_in;
+		totout += strm.avail_out;
+		ret = inflate (&strm, Z_BLOCK);
+		totin -= strm.avail_in;
+		totout -= strm.avail_out;
+		if (ret == Z_STREAM_END) {
+			break;
+		}
+		if (ret != Z_OK) {
+			// Z_BUF_ERROR means the input was truncated
+			ret = Z_DATA_ERROR;
+			break;
+		}
+		// after the header or a block, unless the next one is the last
+		if ((strm.data_type & 128) && !(strm.data_type & 64)
+				&& (totout? totout - last > INFLATE_SPAN: r_vector_empty (&priv->points))) {
+			if (!inflate_point_add (priv, strm.data_type & 7, totin, totout, strm.avail_out, window)) {
+				ret = Z_MEM_ERROR;
+				break;
+			}
+			last = totout;
+		}
+	}
+	inflateEnd (&strm);
+	free (input);
+	free (window);
+	priv->size = totout;
+	return ret == Z_STREAM_END && !r_vector_empty (&priv->points);
+}
+
+// inflate the data between the access point p and the next one
+static bool inflate_span(struct buf_inflate_priv *priv, size_t p, InflateSpan *span) {
+	InflatePoint *point = r_vector_index_ptr (&priv->points, p);
+	ut64 end = p + 1 < r_vector_len (&priv->points)
+		? ((InflatePoint *)r_vector_index_ptr (&priv->points, p + 1))->out
+		: priv->size;
+	ut64 size = end - point->out;
+	ut8 *data = malloc (size? size: 1);
+	ut8 *input = malloc (INFLATE_CHUNK);
+	z_stream strm = {0};
+	if (!data || !input || inflateInit2 (&strm, -15) != Z_OK) {
+		free (data);
+		free (input);
+		return false;
+	}
+	ut64 at = point->in;
+	int ret = Z_OK;
+	if (point->bits) {
+		ut8 byte;
+		if (r_buf_read_at (priv->parent, at - 1, &byte, 1) != 1) {
+			ret = Z_DATA_ERROR;
+		} else {
+			ret = inflatePrime (&strm, point->bits, byte >> (8 - point->bits));
+		}
+	}
+	if (ret == Z_OK && point->window) {
+		ret = inflateSetDictionary (&strm, point->window, INFLATE_WINDOW);
+	}
+	strm.next_out = data;
+	// avail_out is an uInt, spans end at block boundaries so this only matters for corrupted streams
+	strm.avail_out = (uInt)R_MIN (size, UT32_MAX);
+	while (ret == Z_OK && strm.avail_out) {
+		if (!strm.avail_in) {
+			st64 n = r_buf_read_at (priv->parent, at, input, INFLATE_CHUNK);
+			if (n <= 0) {
+				ret = Z_DATA_ERROR;
+				break;
+			}
+			at += n;
+			strm.next_in = input;
+			strm.avail_in = (uInt)n;
+		}
+		ret = inflate (&strm, Z_NO_FLUSH);
+		if (ret == Z_NEED_DICT) {
+			ret = Z_DATA_ERROR;
+		}
+	}
+	inflateEnd (&strm);
+	free (input);
+	if (strm.avail_out || (ret != Z_OK && ret != Z_STREAM_END)) {
+		free (data);
+		return false;
+	}
+	free (span->data);
+	span->point = p;
+	span->data = data;
+	span->size = size;
+	return true;
+}
+
+static InflateSpan *inflate_span_get(struct buf_inflate_priv *priv, size_t p) {
+	InflateSpan *lru = &priv->cache[0];
+	size_t i;
+	priv->tick++;
+	for (i = 0; i < INFLATE_CACHE; i++) {
+		InflateSpan *span = &priv->cache[i];
+		if (span->data && span->point == p) {
+			span->used = priv->tick;
+			return span;
+		}
+		if (!span->data || span->used < lru->used) {
+			lru = span;
+		}
+	}
+	if (!inflate_span (priv, p, lru)) {
+		return NULL;
+	}
+	lru->used = priv->tick;
+	return lru;
+}
+
+// index of the last access point at or before off
+static size_t inflate_point_at(struct buf_inflate_priv *priv, ut64 off) {
+	size_t lo = 0, hi = r_vector_len (&priv->points);
+	while (hi - lo > 1) {
+		size_t mid = lo + (hi - lo) / 2;
+		InflatePoint *point = r_vector_index_ptr (&priv->points, mid);
+		if (point->out <= off) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+static bool buf_inflate_init(RBuffer *b, const void *user) {
+	const struct buf_inflate_user *u = (const struct buf_inflate_user *)user;
+	struct buf_inflate_priv *priv = R_NEW0 (struct buf_inflate_priv);
+	if (!priv) {
+		return false;
+	}
+	r_vector_init (&priv->points, sizeof (InflatePoint), inflate_point_fini, NULL);
+	priv->parent = r_buf_ref (u->parent);
+	if (!inflate_index_build (priv, u->wbits)) {
+		r_vector_fini (&priv->points);
+		r_buf_free (priv->parent);
+		free (priv);
+		return false;
+	}
+	r_vector_shrink (&priv->points);
+	b->readonly = true;
+	b->priv = priv;
+	return true;
+}
+
+static bool buf_inflate_fini(RBuffer *b) {
+	struct buf_inflate_priv *priv = get_priv_inflate (b);
+	size_t i;
+	for (i = 0; i < INFLATE_CACHE; i++) {
+		free (priv->cache[i].data);
+	}
+	r_vector_fini (&priv->points);
+	r_buf_free (priv->parent);
+	R_FREE (b->priv);
+	return true;
+}
+
+static st64 buf_inflate_read(RBuffer *b, ut8 *buf, ut64 len) {
+	struct buf_inflate_priv *priv = get_priv_inflate (b);
+	if (priv->cur >= priv->size) {
+		return 0;
+	}
+	len = R_MIN (len, priv->size - priv->cur);
+	ut64 done = 0;
+	while (done < len) {
+		size_t p = inflate_point_at (priv, priv->cur);
+		InflateSpan *span = inflate_span_get (priv, p);
+		if (!span) {
+			break;
+		}
+		InflatePoint *point = r_vector_index_ptr (&priv->points, p);
+		ut64 delta = priv->cur - point->out;
+		if (delta >= span->size) {
+			break;
+		}
+		ut64 n = R_MIN (len - done, span->size - delta);
+		memcpy (buf + done, span->data + delta, n);
+		priv->cur += n;
+		done += n;
+	}
+	return done? (st64)done: -1;
+}
+
+static ut64 buf_inflate_get_size(RBuffer *b) {
+	struct buf_inflate_priv *priv = get_priv_inflate (b);
+	return priv->size;
+}
+
+static st64 buf_inflate_seek(RBuffer *b, st64 addr, int whence) {
+	struct buf_inflate_priv *priv = get_priv_inflate (b);
+	switch (whence) {
+	case R_BUF_CUR:
+		priv->cur += addr;
+		break;
+	case R_BUF_SET:
+		priv->cur = addr;
+		break;
+	case R_BUF_END:
+		priv->cur = priv->size + addr;
+		break;
+	default:
+		r_warn_if_reached ();
+		return -1;
+	}
+	return priv->cur;
+}
+
+static const RBufferMethods buffer_inflate_methods = {
+	.init = buf_inflate_init,
+	.fini = buf_inflate_fini,
+	.read = buf_inflate_read,
+	.get_size = buf_inflate_get_size,
+	.seek = buf_inflate_seek,
+};
@@ -205,6 +205,20 @@ R_API RBIter r_interval_tree_first_at(RIntervalTree *tree, ut64 start) {
 	return it;
 }
 
+R_API RBIter r_interval_tree_first_from(RIntervalTree *tree, ut64 start) {
+	RBIter it = {0};
+	RBNode *node = tree->root ? &tree->root->node : NULL;
+	while (node) {
+		if (start <= unwrap (node)->start) {
+			it.path[it.len++] = node;
+			node = node->child[0];
+		} else {
+			node = node->child[1];
+		}
+	}
+	return it;
+}
+
 R_API RIntervalNode *r_interval_tree_node_at_data(RIntervalTree *tree, ut64 start, void *data) {
 	RBIter it = r_interval_tree_first_at (tree, start);
 	while (r_rbtree_iter_has (&it)) {
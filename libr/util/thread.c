@@ -204,6 +204,20 @@ R_API bool r_th_setaffinity(RThread *th, int cpuid) {
 	return true;
 }
 
+// number of online processors, useful to size worker pools
+R_API int r_th_ncpus(void) {
+#if __WINDOWS__
+	SYSTEM_INFO si;
+	GetSystemInfo (&si);
+	return R_MAX (1, (int)si.dwNumberOfProcessors);
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long n = sysconf (_SC_NPROCESSORS_ONLN);
+	return n > 0? (int)n: 1;
+#else
+	return 1;
+#endif
+}
+
 R_API RThread *r_th_new(RThreadFunction fun, void *user, int delay) {
 	RThread *th = R_NEW0 (RThread);
 	if (th) {
@@ -214,11 +228,18 @@ R_API RThread *r_th_new(RThreadFunction fun, void *user, int delay) {
 		th->delay = delay;
 		th->breaked = false;
 		th->ready = false;
+		bool ok = false;
 #if HAVE_PTHREAD
-		pthread_create (&th->tid, NULL, _r_th_launcher, th);
+		ok = !pthread_create (&th->tid, NULL, _r_th_launcher, th);
 #elif __WINDOWS__
 		th->tid = CreateThread (NULL, 0, _r_th_launcher, th, 0, 0);
+		ok = th->tid != NULL;
 #endif
+		// NULL tells the caller to do the work without this thread
+		if (!ok) {
+			r_th_lock_free (th->lock);
+			R_FREE (th);
+		}
 	}
 	return th;
 }
@@ -35,6 +35,11 @@ int gdbr_disconnect(libgdbr_t *g);
  */
 void gdbr_invalidate_reg_cache(void);
 
+/*!
+ * \brief invalidates the memory read cache, needed whenever the target runs
+ */
+void gdbr_invalidate_mem_cache(libgdbr_t *g);
+
 /*!
  * \brief gets reason why remote target stopped
  */
@@ -11,6 +11,7 @@ typedef unsigned int ssize_t;
 #include "r_types_base.h"
 #include "r_socket.h"
 #include "r_th.h"
+#include <ht_up.h>
 
 #define MSG_OK 0
 #define MSG_NOT_SUPPORTED -1
@@ -19,6 +20,13 @@ typedef unsigned int ssize_t;
 #define GDB_REMOTE_TYPE_GDB 0
 #define GDB_REMOTE_TYPE_LLDB 1
 #define GDB_MAX_PKTSZ 4
+// memory read requests sent before waiting for the first reply
+#define GDB_READ_PIPELINE 8
+// size of the cache lines of gdbr_read_memory, and the most it fetches at once
+#define GDB_CACHE_LINE 1024
+#define GDB_CACHE_MAX_FETCH (64 * 1024)
+// cached lines and holes kept before the memory cache starts over
+#define GDB_CACHE_MAX_LINES 4096
 
 /*!
  * Structure that saves a gdb message
@@ -86,6 +94,7 @@ typedef struct libgdbr_stub_features_t {
 	bool EnableDisableTracepoints;
 	bool tracenz;
 	bool BreakpointCommands;
+	bool binary_upload;
 	// lldb-specific features
 	struct {
 		bool g;
@@ -198,6 +207,14 @@ typedef struct libgdbr_t {
 		bool valid;
 	} target;
 
+	// memory read while the target is stopped, kept in lines of mem_cache.line bytes
+	struct {
+		HtUP *lines;
+		HtUP *holes; // lines that cannot be read in full
+		ut64 line;
+		size_t count; // entries in lines and holes
+	} mem_cache;
+
 	bool isbreaked;
 } libgdbr_t;
 
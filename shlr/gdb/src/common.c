@@ -108,6 +108,8 @@ int handle_qSupported(libgdbr_t *g) {
 				g->stub_features.lldb.QListThreadsInStopReply
 					= (tok[strlen ("QListThreadsInStopReply")] == '+');
 			}
+		} else if (r_str_startswith (tok, "binary-upload")) {
+			g->stub_features.binary_upload = (tok[strlen ("binary-upload")] == '+');
 		} else if (r_str_startswith (tok, "multiprocess")) {
 			g->stub_features.multiprocess = (tok[strlen ("multiprocess")] == '+');
 		} else if (r_str_startswith (tok, "qEcho")) {
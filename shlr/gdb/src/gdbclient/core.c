@@ -76,6 +76,18 @@ static struct {
 	bool valid, init;
 } reg_cache;
 
+static void mem_cache_kv_free(HtUPKv *kv) {
+	free (kv->value);
+}
+
+void gdbr_invalidate_mem_cache(libgdbr_t *g) {
+	ht_up_free (g->mem_cache.lines);
+	ht_up_free (g->mem_cache.holes);
+	g->mem_cache.lines = NULL;
+	g->mem_cache.holes = NULL;
+	g->mem_cache.count = 0;
+}
+
 static void reg_cache_init(libgdbr_t *g) {
 	reg_cache.maxlen = g->data_max;
 	reg_cache.buflen = 0;
@@ -291,6 +303,7 @@ int gdbr_disconnect(libgdbr_t *g) {
 		goto end;
 	}
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->stop_reason.is_valid = false;
 	free (reg_cache.buf);
 	if (g->target.valid) {
@@ -311,6 +324,7 @@ int gdbr_select(libgdbr_t *g, int pid, int tid) {
 		goto end;
 	}
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->pid = pid;
 	g->tid = tid;
 	strcpy (cmd, "Hg");
@@ -413,6 +427,7 @@ int gdbr_check_extended_mode(libgdbr_t *g) {
 	}
 	g->stop_reason.is_valid = false;
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	// Activate extended mode if possible.
 	ret = send_msg (g, "!");
 	if (ret < 0) {
@@ -452,6 +467,7 @@ int gdbr_attach(libgdbr_t *g, int pid) {
 	}
 	g->stop_reason.is_valid = false;
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 
 	if (g->stub_features.extended_mode == -1) {
 		gdbr_check_extended_mode (g);
@@ -506,6 +522,7 @@ int gdbr_detach(libgdbr_t *g) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->stop_reason.is_valid = false;
 	ret = send_msg (g, "D");
 	if (ret < 0) {
@@ -533,6 +550,7 @@ int gdbr_detach_pid(libgdbr_t *g, int pid) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->stop_reason.is_valid = false;
 
 	buffer_size = strlen (CMD_DETACH_MP) + (sizeof (pid) * 2) + 1;
@@ -583,6 +601,7 @@ int gdbr_kill(libgdbr_t *g) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->stop_reason.is_valid = false;
 
 	if (g->stub_features.multiprocess) {
@@ -618,6 +637,7 @@ int gdbr_kill_pid(libgdbr_t *g, int pid) {
 	}
 
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->stop_reason.is_valid = false;
 
 	buffer_size = strlen (CMD_KILL_MP) + (sizeof (pid) * 2) + 1;
@@ -726,10 +746,33 @@ end:
 	return ret;
 }
 
+static int read_memory_reply(libgdbr_t *g, bool binary) {
+	if (!binary) {
+		return handle_m (g);
+	}
+	if (handle_x (g) < 0) {
+		if (!g->data_len) {
+			// empty reply, the stub does not know about x packets after all
+			g->stub_features.binary_upload = false;
+		}
+		return -1;
+	}
+	return 0;
+}
+
+// the replies are read in order, so the ones still in flight must be skipped after an error
+static void read_memory_drain(libgdbr_t *g, int pending) {
+	while (pending-- > 0) {
+		if (read_packet (g, false) < 0) {
+			break;
+		}
+		send_ack (g);
+	}
+}
+
 static int gdbr_read_memory_page(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
 	char command[128] = {0};
-	int last, ret_len, pkt;
-	ret_len = 0;
+	int ret_len = 0;
 
 	if (!g) {
 		return -1;
@@ -743,67 +786,44 @@ static int gdbr_read_memory_page(libgdbr_t *g, ut64 address, ut8 *buf, int len)
 	}
 
 	g->stub_features.pkt_sz = R_MAX (g->stub_features.pkt_sz, GDB_MAX_PKTSZ);
+	const bool binary = g->stub_features.binary_upload;
+	// hex doubles the size of the reply, and escaping can do the same to binary ones
 	int data_sz = g->stub_features.pkt_sz / 2;
-	int num_pkts = len / data_sz;
-	last = len % data_sz;
-	ret_len = 0;
+	int num_pkts = (len + data_sz - 1) / data_sz;
+	int sent = 0, pkt;
 	for (pkt = 0; pkt < num_pkts; pkt++) {
-		if (snprintf (command, sizeof (command) - 1,
-			    "%s%"PFMT64x ",%"PFMT64x, CMD_READMEM,
-			    (ut64)address + (pkt * data_sz),
-			    (ut64)data_sz) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (send_msg (g, command) < 0) {
-			ret_len = -1;
-			goto end;
+		// keep a few requests in flight to hide the latency of the link
+		for (; sent < num_pkts && sent - pkt < GDB_READ_PIPELINE; sent++) {
+			int delta = sent * data_sz;
+			if (snprintf (command, sizeof (command) - 1,
+				    "%s%"PFMT64x ",%"PFMT64x, binary? CMD_READMEM_BIN: CMD_READMEM,
+				    (ut64)address + delta,
+				    (ut64)R_MIN (data_sz, len - delta)) < 0
+				    || send_msg (g, command) < 0) {
+				read_memory_drain (g, sent - pkt);
+				ret_len = -1;
+				goto end;
+			}
 		}
 		if (read_packet (g, false) < 0) {
 			ret_len = -1;
 			goto end;
 		}
-		if (handle_m (g) < 0) {
-			ret_len = -1;
+		if (read_memory_reply (g, binary) < 0) {
+			read_memory_drain (g, sent - pkt - 1);
+			ret_len = pkt? ret_len: -1;
 			goto end;
 		}
-		int delta = (pkt * data_sz);
-
-		if (delta > len) {
-			eprintf ("oops\n");
-			break;
-		}
+		int delta = pkt * data_sz;
 		int left = R_MIN (g->data_len, len - delta);
 		if (left > 0) {
 			memcpy (buf + delta, g->data, left);
-			ret_len += g->data_len;
-		}
-	}
-	if (last) {
-		if (snprintf (command, sizeof (command) - 1,
-			    "%s%016"PFMT64x ",%"PFMT64x, CMD_READMEM,
-			    (ut64)(address + (num_pkts * data_sz)),
-			    (ut64)last) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (send_msg (g, command) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (read_packet (g, false) < 0) {
-			ret_len = -1;
-			goto end;
-		}
-		if (handle_m (g) < 0) {
-			ret_len = -1;
-			goto end;
+			ret_len += left;
 		}
-		int delta = num_pkts * data_sz;
-		int left = R_MIN (g->data_len, len - delta);
-		if (left > 0) {
-			memcpy (buf + delta, g->data, left);
-			ret_len += g->data_len;
+		if (left < R_MIN (data_sz, len - delta)) {
+			// short read, the rest of the range is not there
+			read_memory_drain (g, sent - pkt - 1);
+			break;
 		}
 	}
 end:
@@ -811,24 +831,18 @@ end:
 	return ret_len;
 }
 
-int gdbr_read_memory(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+static int gdbr_read_memory_uncached(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
 	int ret_len, ret, tmp;
 	int page_size = g->page_size;
 	ret_len = 0;
 
-	if (!gdbr_lock_enter (g)) {
-		goto end;
-	}
-
 	// Read and round up to page size
 	tmp = page_size - (address & (page_size - 1));
 	if (tmp >= len) {
-		ret_len = gdbr_read_memory_page (g, address, buf, len);
-		goto end;
+		return gdbr_read_memory_page (g, address, buf, len);
 	}
 	if ((ret = gdbr_read_memory_page (g, address, buf, tmp)) != tmp) {
-		ret_len = ret;
-		goto end;
+		return ret;
 	}
 	len -= tmp;
 	address += tmp;
@@ -838,10 +852,9 @@ int gdbr_read_memory(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
 	while (len > page_size) {
 		if ((ret = gdbr_read_memory_page (g, address, buf, page_size)) != page_size) {
 			if (ret < 1) {
-				goto end;
+				return ret_len;
 			}
-			ret_len += ret;
-			goto end;
+			return ret_len + ret;
 		}
 		len -= page_size;
 		address += page_size;
@@ -850,10 +863,91 @@ int gdbr_read_memory(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
 	}
 	// Read left-overs
 	if ((ret = gdbr_read_memory_page (g, address, buf, len)) < 0) {
-		goto end;
+		return ret_len;
 	}
+	return ret_len + ret;
+}
 
-	ret_len += ret;
+// Serve the read from the cache lines, misses next to each other are fetched together
+static int gdbr_read_memory_cached(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+	if (g->mem_cache.count >= GDB_CACHE_MAX_LINES) {
+		// too many lines, start over instead of growing without bound
+		gdbr_invalidate_mem_cache (g);
+	}
+	if (!g->mem_cache.lines) {
+		// a line is what fits in one reply, so small reads do not get any slower
+		g->mem_cache.line = GDB_CACHE_LINE;
+		while (g->mem_cache.line > 16 && g->mem_cache.line > g->stub_features.pkt_sz / 2) {
+			g->mem_cache.line /= 2;
+		}
+		g->mem_cache.lines = ht_up_new (NULL, mem_cache_kv_free, NULL);
+		g->mem_cache.holes = ht_up_new0 ();
+		if (!g->mem_cache.lines || !g->mem_cache.holes) {
+			gdbr_invalidate_mem_cache (g);
+			return gdbr_read_memory_uncached (g, address, buf, len);
+		}
+	}
+	const ut64 line = g->mem_cache.line;
+	const ut64 end = address + len;
+	if (end < address) {
+		return gdbr_read_memory_uncached (g, address, buf, len);
+	}
+	ut64 at = address - (address % line);
+	while (at < end) {
+		ut64 from = R_MAX (at, address);
+		ut64 n = R_MIN (at + line, end) - from;
+		if (ht_up_find (g->mem_cache.holes, at, NULL)) {
+			// partially mapped, read just what was asked
+			int ret = gdbr_read_memory_uncached (g, from, buf + (from - address), n);
+			if (ret != n) {
+				return (int)(from - address) + R_MAX (ret, 0);
+			}
+			at += line;
+			continue;
+		}
+		ut8 *data = ht_up_find (g->mem_cache.lines, at, NULL);
+		if (data) {
+			memcpy (buf + (from - address), data + (from - at), n);
+			at += line;
+			continue;
+		}
+		ut64 to = at + line;
+		while (to < end && to - at < GDB_CACHE_MAX_FETCH
+				&& !ht_up_find (g->mem_cache.lines, to, NULL) && !ht_up_find (g->mem_cache.holes, to, NULL)) {
+			to += line;
+		}
+		ut8 *fetch = malloc (to - at);
+		if (!fetch) {
+			return gdbr_read_memory_uncached (g, address, buf, len);
+		}
+		int ret = gdbr_read_memory_page (g, at, fetch, to - at);
+		if (ret < 0) {
+			ret = 0;
+		}
+		// keep the lines that came back in full
+		ut64 a;
+		for (a = at; a + line <= at + ret; a += line) {
+			ut8 *copy = r_mem_dup (fetch + (a - at), line);
+			if (copy && ht_up_insert (g->mem_cache.lines, a, copy)) {
+				g->mem_cache.count++;
+			} else {
+				free (copy);
+			}
+		}
+		free (fetch);
+		if (a < to && ht_up_insert (g->mem_cache.holes, a, (void *)(size_t)1)) {
+			g->mem_cache.count++;
+		}
+	}
+	return len;
+}
+
+int gdbr_read_memory(libgdbr_t *g, ut64 address, ut8 *buf, int len) {
+	int ret_len = 0;
+	if (!gdbr_lock_enter (g)) {
+		goto end;
+	}
+	ret_len = gdbr_read_memory_cached (g, address, buf, len);
 end:
 	gdbr_lock_leave (g);
 	return ret_len;
@@ -881,6 +975,7 @@ int gdbr_write_memory(libgdbr_t *g, ut64 address, const uint8_t *data, ut64 len)
 	if (!gdbr_lock_enter (g)) {
 		goto end;
 	}
+	gdbr_invalidate_mem_cache (g);
 
 	for (pkt = num_pkts - 1; pkt >= 0; pkt--) {
 		if ((command_len = snprintf (tmp, max_cmd_len,
@@ -1277,6 +1372,7 @@ int send_vcont(libgdbr_t *g, const char *command, const char *thread_id) {
 		goto end;
 	}
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	g->stop_reason.is_valid = false;
 	ret = send_msg (g, tmp);
 	if (ret < 0) {
@@ -1595,6 +1691,7 @@ int gdbr_send_qRcmd(libgdbr_t *g, const char *cmd, PrintfCallback cb_printf) {
 	}
 	g->stop_reason.is_valid = false;
 	reg_cache.valid = false;
+	gdbr_invalidate_mem_cache (g);
 	pack_hex (cmd, strlen (cmd), buf + 6);
 	if ((ret = send_msg (g, buf)) < 0) {
 		goto end;
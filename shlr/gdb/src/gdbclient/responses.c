@@ -45,6 +45,17 @@ int handle_m(libgdbr_t *g) {
 	return send_ack (g);
 }
 
+// binary reads, the data follows a 'b' and comes already unescaped from read_packet
+int handle_x(libgdbr_t *g) {
+	if (!g->data_len || g->data[0] != 'b') {
+		send_ack (g);
+		return -1;
+	}
+	g->data_len--;
+	memmove (g->data, g->data + 1, g->data_len);
+	return send_ack (g);
+}
+
 int handle_qStatus(libgdbr_t *g) {
 	if (!g || !g->data || !*g->data) {
 		return -1;
@@ -2,6 +2,7 @@
 
 #include "libgdbr.h"
 #include "arch.h"
+#include "gdbclient/commands.h"
 
 #include <stdio.h>
 
@@ -144,6 +145,7 @@ int gdbr_cleanup(libgdbr_t *g) {
 	g->send_len = 0;
 	R_FREE (g->send_buff);
 	R_FREE (g->read_buff);
+	gdbr_invalidate_mem_cache (g);
 	r_socket_free (g->sock);
 	r_th_lock_free (g->gdbr_lock);
 	return 0;
@@ -148,8 +148,8 @@ int read_packet(libgdbr_t *g, bool vcont) {
 	}
 	g->data_len = 0;
 	if (g->read_len > 0) {
-		if (unpack (g, &ctx, g->read_len) == 0) {
-			// TODO: Evaluate if partial packets are clubbed
+		ret = unpack (g, &ctx, g->read_len);
+		if (ret == 0) {
 			g->data[g->data_len] = '\0';
 			if (g->server_debug) {
 				eprintf ("getpkt (\"%s\");  %s\n", g->data,
@@ -157,8 +157,12 @@ int read_packet(libgdbr_t *g, bool vcont) {
 			}
 			return 0;
 		}
+		// the leftover is the start of the next packet, keep what was parsed and read the rest
+		g->read_len = 0;
+		if (ret < 0) {
+			return -1;
+		}
 	}
-	g->data_len = 0;
 	for (i = 0; i < g->num_retries && !g->isbreaked; vcont ? 0 : i++) {
 		ret = r_socket_ready (g->sock, 0, READ_TIMEOUT);
 		if (ret == 0 && !vcont) {
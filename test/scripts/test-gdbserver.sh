@@ -0,0 +1,63 @@
+#!/bin/sh
+# usage: test-gdbserver.sh file commands
+# runs the commands connected to the gdbserver of r2 debugging the file.
+# both ends use the r2 running this script, or $R2 when it is set
+
+FILE=$1
+
+if [ -z "${R2}" ]; then
+	R2=radare2
+	pid=$PPID
+	while [ "${pid:-1}" -gt 1 ]; do
+		exe=$(readlink "/proc/${pid}/exe" 2> /dev/null)
+		case "${exe##*/}" in
+		radare2|r2)
+			R2=${exe}
+			break
+			;;
+		esac
+		pid=$(awk '/^PPid:/ { print $2 }' "/proc/${pid}/status" 2> /dev/null)
+	done
+fi
+
+# a port from the ephemeral range that nothing is bound to
+free_port() {
+	while :; do
+		p=$(($(od -An -N2 -tu2 /dev/urandom) % 16384 + 49152))
+		if ! grep -q ":$(printf %04X "$p") " /proc/net/tcp /proc/net/tcp6 2> /dev/null; then
+			echo "$p"
+			return
+		fi
+	done
+}
+
+# true once the listening socket on the port belongs to the server
+listening() {
+	for inode in $(awk -v p=":$(printf %04X "${PORT}")" \
+		'$2 ~ p"$" && $4 == "0A" { print $10 }' /proc/net/tcp /proc/net/tcp6 2> /dev/null); do
+		if ls -l "/proc/${CHILD}/fd" 2> /dev/null | grep -q "socket:\[${inode}\]"; then
+			return 0
+		fi
+	done
+	return 1
+}
+
+# another process can take the port first, then the server exits
+tries=0
+while [ $tries -lt 5 ]; do
+	PORT=$(free_port)
+	"${R2}" -N -qc "=g ${PORT} ${FILE}" "${FILE}" > /dev/null 2>&1 &
+	CHILD=$!
+	i=0
+	while [ $i -lt 30 ] && kill -0 $CHILD 2> /dev/null && ! listening; do
+		sleep 1
+		i=$((i + 1))
+	done
+	if listening; then
+		"${R2}" -N -qc "$2" "gdb://127.0.0.1:${PORT}" 2> /dev/null
+		break
+	fi
+	kill $CHILD 2> /dev/null
+	tries=$((tries + 1))
+done
+kill $CHILD 2> /dev/null
@@ -0,0 +1,73 @@
+#include <r_bin.h>
+#include "minunit.h"
+
+static bool count_cb(void *user, const RBinAddrLine *row, const char *file) {
+	(*(int *)user)++;
+	return true;
+}
+
+bool test_addrline_first_inserted(void) {
+	RBinAddrLineTable *t = r_bin_addrline_new ();
+	r_bin_addrline_add (t, 0x2000, "a.c", 10, 0);
+	r_bin_addrline_add (t, 0x1000, "a.c", 10, 0);
+	r_bin_addrline_add (t, 0x3000, "a.c", 11, 0);
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 10), 0x2000, "first inserted address for the line");
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 11), 0x3000, "other line");
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 12), UT64_MAX, "missing line");
+	mu_assert_eq (r_bin_addrline_find (t, "b.c", 10), UT64_MAX, "missing file");
+	r_bin_addrline_free (t);
+	mu_end;
+}
+
+bool test_addrline_lines_per_addr(void) {
+	RBinAddrLineTable *t = r_bin_addrline_new ();
+	r_bin_addrline_add (t, 0x1000, "a.c", 20, 0);
+	r_bin_addrline_add (t, 0x1000, "b.h", 5, 0);
+	r_bin_addrline_add (t, 0x1000, "a.c", 20, 0);
+	r_bin_addrline_add (t, 0x1004, "a.c", 21, 0);
+	const RBinAddrLine *row = r_bin_addrline_get (t, 0x1000);
+	mu_assert_notnull (row, "row at address");
+	mu_assert_eq (row->line, 20, "first row for the address");
+	mu_assert_streq (r_bin_addrline_file (t, row), "a.c", "first file for the address");
+	mu_assert_eq (r_bin_addrline_count (t), 3, "only the exact copy is dropped");
+	mu_assert_eq (r_bin_addrline_find (t, "b.h", 5), 0x1000, "inlined line is kept");
+	int n = 0;
+	r_bin_addrline_foreach (t, count_cb, &n);
+	mu_assert_eq (n, 3, "every row is listed");
+	r_bin_addrline_free (t);
+	mu_end;
+}
+
+bool test_addrline_del(void) {
+	RBinAddrLineTable *t = r_bin_addrline_new ();
+	r_bin_addrline_add (t, 0x1000, "a.c", 1, 0);
+	r_bin_addrline_add (t, 0x1004, "a.c", 2, 0);
+	r_bin_addrline_add (t, 0x1004, "a.c", 3, 0);
+	r_bin_addrline_add (t, 0x1008, "a.c", 2, 0);
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 2), 0x1004, "first address before del");
+	mu_assert ("deleted", r_bin_addrline_del (t, 0x1004));
+	mu_assert_false (r_bin_addrline_del (t, 0x1004), "nothing left to delete");
+	mu_assert_null (r_bin_addrline_get (t, 0x1004), "rows removed");
+	mu_assert_eq (r_bin_addrline_count (t), 2, "other rows kept");
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 2), 0x1008, "next address for the line");
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 3), UT64_MAX, "line removed");
+	mu_assert_eq (r_bin_addrline_get (t, 0x1008)->line, 2, "lookup after del");
+	// a replaced entry comes after the older rows
+	r_bin_addrline_add (t, 0x1010, "a.c", 1, 0);
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 1), 0x1000, "older row still wins");
+	r_bin_addrline_del (t, 0x1000);
+	mu_assert_eq (r_bin_addrline_find (t, "a.c", 1), 0x1010, "new row after del");
+	r_bin_addrline_free (t);
+	mu_end;
+}
+
+int all_tests(void) {
+	mu_run_test (test_addrline_first_inserted);
+	mu_run_test (test_addrline_lines_per_addr);
+	mu_run_test (test_addrline_del);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
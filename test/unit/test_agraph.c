@@ -99,8 +99,76 @@ bool test_graph_to_agraph() {
 	mu_end;
 }
 
+static int cmp_node_x(const void *a, const void *b) {
+	const RANode *na = *(const RANode **)a;
+	const RANode *nb = *(const RANode **)b;
+	return na->x - nb->x;
+}
+
+bool test_agraph_layout_wide() {
+	RCore *core = r_core_new ();
+	RAGraph *g = r_agraph_new (r_cons_canvas_new (1, 1));
+	RANode *nodes[2100];
+	int i, n = R_ARRAY_SIZE (nodes), width = 10;
+	ut32 seed = 1;
+
+	// enough nodes to use the barycenter ordering, with edges skipping layers
+	for (i = 0; i < n; i++) {
+		char title[16];
+		snprintf (title, sizeof (title), "n%d", i);
+		nodes[i] = r_agraph_add_node (g, title, "", NULL);
+	}
+	for (i = 0; i + width < n; i++) {
+		r_agraph_add_edge (g, nodes[i], nodes[i + width], false);
+		seed = seed * 1103515245 + 12345;
+		int to = (i / width + 1 + (seed >> 8) % 2) * width + (seed >> 16) % width;
+		if (to < n && to != i + width) {
+			r_agraph_add_edge (g, nodes[i], nodes[to], false);
+		}
+	}
+	r_agraph_print (g);
+	r_cons_reset ();
+
+	// nodes of the same row must not overlap
+	RANode **row = R_NEWS (RANode *, r_list_length (g->graph->nodes));
+	int rows = 0, y = INT_MIN;
+	for (;;) {
+		int len = 0, next = INT_MAX;
+		RListIter *iter;
+		RGraphNode *gn;
+		ls_foreach (g->graph->nodes, iter, gn) {
+			RANode *an = gn->data;
+			if (an->is_dummy) {
+				continue;
+			}
+			if (an->y == y) {
+				row[len++] = an;
+			} else if (an->y > y && an->y < next) {
+				next = an->y;
+			}
+		}
+		if (len) {
+			qsort (row, len, sizeof (RANode *), cmp_node_x);
+			for (i = 0; i + 1 < len; i++) {
+				mu_assert ("overlapping nodes", row[i]->x + row[i]->w <= row[i + 1]->x);
+			}
+			rows++;
+		}
+		if (next == INT_MAX) {
+			break;
+		}
+		y = next;
+	}
+	mu_assert_eq (rows, n / width, "wrong number of layers");
+	free (row);
+	r_agraph_free (g);
+	r_core_free (core);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test (test_graph_to_agraph);
+	mu_run_test (test_agraph_layout_wide);
 	return tests_passed != tests_run;
 }
 
@@ -0,0 +1,164 @@
+#include <r_core.h>
+#include "minunit.h"
+
+static char *home = NULL;
+static char *file = NULL;
+
+static RCore *open_core(void) {
+	RCore *core = r_core_new ();
+	r_config_set_b (core->config, "anal.cache", true);
+	r_core_file_open (core, file, R_PERM_R, 0);
+	r_core_bin_load (core, file, 0);
+	return core;
+}
+
+static bool setup(void) {
+	home = r_file_temp ("anal_cache_home");
+	file = r_file_temp ("anal_cache_bin");
+	if (!home || !file || !r_sys_mkdirp (home)) {
+		return false;
+	}
+	r_sys_setenv ("HOME", home);
+	ut8 buf[0x100];
+	int i;
+	for (i = 0; i < sizeof (buf); i++) {
+		buf[i] = i;
+	}
+	return r_file_dump (file, buf, sizeof (buf), false);
+}
+
+static void teardown(void) {
+	r_file_rm_rf (home);
+	r_file_rm (file);
+	R_FREE (home);
+	R_FREE (file);
+}
+
+bool test_anal_cache_roundtrip(void) {
+	RCore *core = open_core ();
+	RAnalFunction *fcn = r_anal_create_function (core->anal, "fcn.cached", 0x10, R_ANAL_FCN_TYPE_FCN, NULL);
+	mu_assert_notnull (fcn, "function created");
+	r_anal_function_add_bb (core->anal, fcn, 0x10, 0x10, 0x30, 0x20, NULL);
+	r_anal_function_add_bb (core->anal, fcn, 0x30, 0x8, UT64_MAX, UT64_MAX, NULL);
+	RAnalBlock *bb = r_anal_get_block_at (core->anal, 0x10);
+	bb->ninstr = 3;
+	r_anal_bb_set_offset (bb, 1, 4);
+	r_anal_bb_set_offset (bb, 2, 8);
+	fcn->is_noreturn = true;
+	fcn->maxstack = 0x20;
+	RAnalVar *var = r_anal_function_set_var (fcn, -8, R_ANAL_VAR_KIND_BPV, "int", 4, false, "var_8h");
+	mu_assert_notnull (var, "var created");
+	r_anal_var_set_access (var, "bp", 0x14, R_ANAL_VAR_ACCESS_TYPE_WRITE, -8);
+	r_anal_xrefs_set (core->anal, 0x18, 0x80, R_ANAL_REF_TYPE_CALL);
+	r_anal_xrefs_set (core->anal, 0x18, 0x90, R_ANAL_REF_TYPE_DATA);
+	r_meta_set_string (core->anal, R_META_TYPE_COMMENT, 0x10, "user comment");
+	r_meta_set_with_subtype (core->anal, R_META_TYPE_STRING, R_STRING_ENC_UTF8, 0x40, 6, "hello, world");
+	r_meta_set (core->anal, R_META_TYPE_RUN, 0x48, 1, "!echo");
+	r_anal_hint_set_bits (core->anal, 0x50, 16);
+	r_flag_space_push (core->flags, R_FLAGS_FS_STRINGS);
+	r_flag_set (core->flags, "str.hello", 0x40, 6);
+	r_flag_space_pop (core->flags);
+	r_flag_set (core->flags, "user.flag", 0x44, 1);
+
+	char *path = r_core_anal_cache_path (core);
+	mu_assert_notnull (path, "cache path");
+	mu_assert ("cache entry in home", r_str_startswith (path, home));
+	RBinInfo *info = r_bin_get_info (core->bin);
+	const int nhashes = info->file_hashes? r_list_length (info->file_hashes): 0;
+	char *path2 = r_core_anal_cache_path (core);
+	mu_assert_streq (path2, path, "same entry");
+	mu_assert_eq (info->file_hashes? r_list_length (info->file_hashes): 0, nhashes, "file hashes listed by it are unchanged");
+	free (path2);
+	mu_assert ("saved", r_core_anal_cache_save (core, 1));
+	mu_assert ("entry written", r_file_exists (path));
+	r_core_free (core);
+
+	core = open_core ();
+	mu_assert ("restored", r_core_anal_cache_load (core, 0));
+	fcn = r_anal_get_function_at (core->anal, 0x10);
+	mu_assert_notnull (fcn, "function restored");
+	mu_assert_streq (fcn->name, "fcn.cached", "function name");
+	mu_assert_eq (r_list_length (fcn->bbs), 2, "blocks");
+	mu_assert ("noreturn", fcn->is_noreturn);
+	mu_assert_eq (fcn->maxstack, 0x20, "maxstack");
+	bb = r_anal_get_block_at (core->anal, 0x10);
+	mu_assert_eq (bb->ninstr, 3, "instructions in block");
+	mu_assert_eq (r_anal_bb_offset_inst (bb, 2), 8, "instruction offset");
+	mu_assert_eq (bb->jump, 0x30, "block jump");
+	var = r_anal_function_get_var_byname (fcn, "var_8h");
+	mu_assert_notnull (var, "var restored");
+	mu_assert_streq (var->type, "int", "var type");
+	mu_assert_eq (var->accesses.len, 1, "var access restored");
+	RList *refs = r_anal_refs_get (core->anal, 0x18);
+	mu_assert_eq (r_list_length (refs), 2, "refs restored");
+	r_list_free (refs);
+	RFlagItem *fi = r_flag_get (core->flags, "fcn.cached");
+	mu_assert_notnull (fi, "function flag");
+	mu_assert_null (r_meta_get_string (core->anal, R_META_TYPE_COMMENT, 0x10), "user comments are not cached");
+	ut64 size = 0;
+	RAnalMetaItem *mi = r_meta_get_at (core->anal, 0x40, R_META_TYPE_STRING, &size);
+	mu_assert_notnull (mi, "string meta restored");
+	mu_assert_streq (mi->str, "hello, world", "string meta text");
+	mu_assert_eq (mi->subtype, R_STRING_ENC_UTF8, "string encoding");
+	mu_assert_eq (size, 6, "string size");
+	mu_assert_null (r_meta_get_at (core->anal, 0x48, R_META_TYPE_RUN, NULL), "commands are not cached");
+	mu_assert_eq (r_anal_hint_bits_at (core->anal, 0x50, NULL), 16, "bits hint restored");
+	fi = r_flag_get (core->flags, "str.hello");
+	mu_assert_notnull (fi, "string flag restored");
+	mu_assert_eq (fi->offset, 0x40, "string flag offset");
+	mu_assert_streq (fi->space->name, R_FLAGS_FS_STRINGS, "string flag space");
+	mu_assert_null (r_flag_get (core->flags, "user.flag"), "other flags are not cached");
+	mu_assert ("deeper level is done", r_core_anal_cache_load (core, 1));
+	r_core_free (core);
+
+	core = open_core ();
+	mu_assert_false (r_core_anal_cache_load (core, 2), "entry is not deep enough");
+	mu_assert_null (r_anal_get_function_at (core->anal, 0x10), "nothing restored");
+	r_core_free (core);
+	free (path);
+	mu_end;
+}
+
+bool test_anal_cache_data_only(void) {
+	RCore *core = open_core ();
+	char *path = r_core_anal_cache_path (core);
+	char *marker = r_str_newf ("%s" R_SYS_DIR "pwned", home);
+	char *dir = r_file_dirname (path);
+	r_sys_mkdirp (dir);
+	char *entry = r_str_newf ("/\nlevel=1\n\n/fcns\n"
+		"0x10=0,32,0,0,0,0,0,0,1\n"
+		"0x10.name=!touch %s\n"
+		"0x20=0,32,0,0,0,0,0,0,1\n"
+		"0x20.name=fcn.good\n"
+		"0x20.cc=!touch %s\n"
+		"0x20.bbs=0x20,zz;\n"
+		"\n/refs\n0x20=0x30,bad,\n", marker, marker);
+	r_file_dump (path, (const ut8 *)entry, strlen (entry), false);
+	mu_assert ("restored", r_core_anal_cache_load (core, 0));
+	mu_assert_false (r_file_exists (marker), "nothing is executed");
+	mu_assert_null (r_anal_get_function_at (core->anal, 0x10), "invalid name rejected");
+	RAnalFunction *fcn = r_anal_get_function_at (core->anal, 0x20);
+	mu_assert_notnull (fcn, "valid function restored");
+	mu_assert_eq (r_list_length (fcn->bbs), 0, "bad blocks skipped");
+	mu_assert_null (r_anal_refs_get (core->anal, 0x20), "bad refs skipped");
+	r_core_free (core);
+	free (entry);
+	free (dir);
+	free (marker);
+	free (path);
+	mu_end;
+}
+
+int all_tests() {
+	if (!setup ()) {
+		return 1;
+	}
+	mu_run_test (test_anal_cache_roundtrip);
+	mu_run_test (test_anal_cache_data_only);
+	teardown ();
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
@@ -591,6 +591,131 @@ bool test_meta_spaces() {
 	mu_end;
 }
 
+static bool count_cb(RIntervalNode *node, void *user) {
+	(*(int *)user)++;
+	return true;
+}
+
+static bool stop_cb(RIntervalNode *node, void *user) {
+	(*(int *)user)++;
+	return false;
+}
+
+bool test_meta_foreach() {
+	RAnal *anal = r_anal_new ();
+
+	r_meta_set (anal, R_META_TYPE_DATA, 0x100, 4, NULL);
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x100, "vera gemini");
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x102, "black hole sun");
+	r_meta_set_with_subtype (anal, R_META_TYPE_STRING, R_STRING_ENC_UTF8, 0x200, 0x30, "true confessions");
+
+	int count = 0;
+	mu_assert ("not stopped", r_meta_foreach_at (anal, 0x100, R_META_TYPE_ANY, count_cb, &count));
+	mu_assert_eq (count, 2, "all at");
+	count = 0;
+	r_meta_foreach_at (anal, 0x100, R_META_TYPE_COMMENT, count_cb, &count);
+	mu_assert_eq (count, 1, "comments at");
+	count = 0;
+	r_meta_foreach_in (anal, 0x102, R_META_TYPE_ANY, count_cb, &count);
+	mu_assert_eq (count, 2, "all in");
+	count = 0;
+	r_meta_foreach_in (anal, 0x103, R_META_TYPE_COMMENT, count_cb, &count);
+	mu_assert_eq (count, 0, "comments in");
+	count = 0;
+	r_meta_foreach_intersect (anal, 0x101, 0x100, R_META_TYPE_ANY, count_cb, &count);
+	mu_assert_eq (count, 3, "all intersect");
+	count = 0;
+	r_meta_foreach_intersect (anal, 0x101, 0x100, R_META_TYPE_STRING, count_cb, &count);
+	mu_assert_eq (count, 1, "strings intersect");
+	count = 0;
+	mu_assert ("stopped", !r_meta_foreach_in (anal, 0x102, R_META_TYPE_ANY, stop_cb, &count));
+	mu_assert_eq (count, 1, "stop");
+
+	r_spaces_set (&anal->meta_spaces, "fear");
+	count = 0;
+	r_meta_foreach_at (anal, 0x100, R_META_TYPE_ANY, count_cb, &count);
+	mu_assert_eq (count, 0, "other space");
+
+	r_anal_free (anal);
+	mu_end;
+}
+
+bool test_meta_iter() {
+	RAnal *anal = r_anal_new ();
+
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x300, "c");
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x100, "a");
+	r_meta_set (anal, R_META_TYPE_DATA, 0x100, 4, NULL);
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x200, "b");
+	r_spaces_set (&anal->meta_spaces, "fear");
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x200, "b2");
+
+	RAnalMetaIter it;
+	RIntervalNode *node;
+	ut64 addrs[8];
+	int count = 0;
+	r_meta_foreach_type (anal, it, node, R_META_TYPE_COMMENT) {
+		mu_assert_eq (((RAnalMetaItem *)node->data)->type, R_META_TYPE_COMMENT, "type");
+		addrs[count++] = node->start;
+		if (count == R_ARRAY_SIZE (addrs)) {
+			break;
+		}
+	}
+	mu_assert_eq (count, 4, "comments in all spaces");
+	mu_assert_eq (addrs[0], 0x100, "ordered");
+	mu_assert_eq (addrs[1], 0x200, "ordered");
+	mu_assert_eq (addrs[2], 0x200, "ordered");
+	mu_assert_eq (addrs[3], 0x300, "ordered");
+
+	node = r_meta_iter_first (anal, &it, R_META_TYPE_ANY, 0x101);
+	mu_assert_notnull (node, "from");
+	mu_assert_eq (node->start, 0x200, "from");
+	node = r_meta_iter_first (anal, &it, R_META_TYPE_DATA, 0x101);
+	mu_assert_null (node, "no data after");
+	node = r_meta_iter_first (anal, &it, R_META_TYPE_DATA, 0);
+	mu_assert_notnull (node, "data");
+	mu_assert_eq (node->end, 0x103, "data end");
+	mu_assert_null (r_meta_iter_next (&it), "one data");
+	mu_assert_null (r_meta_iter_next (&it), "still at the end");
+
+	r_anal_free (anal);
+	mu_end;
+}
+
+bool test_meta_index() {
+	RAnal *anal = r_anal_new ();
+
+	r_meta_set (anal, R_META_TYPE_DATA, 0x100, 4, NULL);
+	r_meta_set (anal, R_META_TYPE_DATA, 0x100, 8, NULL); // resize
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x100, "vera gemini");
+	r_meta_set_string (anal, R_META_TYPE_COMMENT, 0x200, "black hole sun");
+
+	RAnalMetaIter it;
+	RIntervalNode *node = r_meta_iter_first (anal, &it, R_META_TYPE_DATA, 0);
+	mu_assert_notnull (node, "data");
+	mu_assert_eq (node->end, 0x107, "resized in the index");
+	mu_assert_null (r_meta_iter_next (&it), "one data");
+
+	r_meta_del (anal, R_META_TYPE_COMMENT, 0x100, 1);
+	int count = 0;
+	r_meta_foreach_type (anal, it, node, R_META_TYPE_COMMENT) {
+		count++;
+	}
+	mu_assert_eq (count, 1, "deleted from the index");
+
+	r_meta_rebase (anal, 0x1000);
+	node = r_meta_iter_first (anal, &it, R_META_TYPE_COMMENT, 0);
+	mu_assert_notnull (node, "rebased");
+	mu_assert_eq (node->start, 0x1200, "rebased in the index");
+
+	r_meta_del (anal, R_META_TYPE_ANY, 0, UT64_MAX);
+	mu_assert_null (r_meta_iter_first (anal, &it, R_META_TYPE_COMMENT, 0), "all deleted");
+	mu_assert_null (r_meta_iter_first (anal, &it, R_META_TYPE_DATA, 0), "all deleted");
+
+	r_anal_free (anal);
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_meta_set);
 	mu_run_test(test_meta_get_at);
@@ -601,6 +726,9 @@ bool all_tests() {
 	mu_run_test(test_meta_del);
 	mu_run_test(test_meta_rebase);
 	mu_run_test(test_meta_spaces);
+	mu_run_test(test_meta_foreach);
+	mu_run_test(test_meta_iter);
+	mu_run_test(test_meta_index);
 	return tests_passed != tests_run;
 }
 
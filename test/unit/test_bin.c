@@ -22,9 +22,82 @@ bool test_r_bin(void) {
 	mu_end;
 }
 
+bool test_r_bin_demangle_batch(void) {
+	RBin *bin = r_bin_new ();
+	RIO *io = r_io_new ();
+	r_io_bind (io, &bin->iob);
+
+	RBinFileOptions opt = {0};
+	RBuffer *buf = r_buf_new_with_bytes ((const ut8 *)"hello world", 11);
+	bool res = r_bin_open_buf (bin, buf, &opt);
+	mu_assert ("buffer could not be opened", res);
+	RBinFile *bf = r_bin_cur (bin);
+	mu_assert_notnull (bf, "no bin file");
+
+	// enough names to use threads, with duplicates and holes
+	const size_t count = 3000;
+	const char **names = R_NEWS0 (const char *, count);
+	ut64 *vaddrs = R_NEWS0 (ut64, count);
+	char **expect = R_NEWS0 (char *, count);
+	char **out = R_NEWS0 (char *, count);
+	char *pool[1000];
+	size_t i;
+	for (i = 0; i < R_ARRAY_SIZE (pool); i++) {
+		char *fn = r_str_newf ("bar%d", (int)i);
+		pool[i] = r_str_newf ("_ZN3foo%d%sEv", (int)strlen (fn), fn);
+		free (fn);
+	}
+	for (i = 0; i < count; i++) {
+		names[i] = (i % 7)? pool[(i * 31) % R_ARRAY_SIZE (pool)]: NULL;
+		vaddrs[i] = 0x1000 + i;
+		expect[i] = names[i]? r_bin_demangle (NULL, "c++", names[i], 0, false): NULL;
+	}
+	mu_assert_streq (expect[1], "foo::bar31()", "demangled name");
+	res = r_bin_demangle_batch (bf, "c++", names, vaddrs, out, count, false);
+	mu_assert ("batch failed", res);
+	for (i = 0; i < count; i++) {
+		mu_assert_streq (r_str_get (out[i]), r_str_get (expect[i]), "batch differs from r_bin_demangle");
+		free (out[i]);
+	}
+	// methods are registered at the address of their first symbol
+	RBinSymbol *method = ht_pp_find (bf->o->methods_ht, "foo::bar31()", NULL);
+	mu_assert_notnull (method, "method registered");
+	mu_assert_eq (method->vaddr, 0x1001, "method address");
+
+	// another file gets everything from the cache, and its own methods
+	RBuffer *buf2 = r_buf_new_with_bytes ((const ut8 *)"hello again", 11);
+	res = r_bin_open_buf (bin, buf2, &opt);
+	mu_assert ("second buffer could not be opened", res);
+	RBinFile *bf2 = r_bin_cur (bin);
+	mu_assert ("second file", bf2 && bf2 != bf);
+	vaddrs[1] = 0x2001;
+	res = r_bin_demangle_batch (bf2, "c++", names, vaddrs, out, count, false);
+	mu_assert ("cached batch failed", res);
+	method = ht_pp_find (bf2->o->methods_ht, "foo::bar31()", NULL);
+	mu_assert_notnull (method, "cached method registered");
+	mu_assert_eq (method->vaddr, 0x2001, "cached method address");
+	for (i = 0; i < count; i++) {
+		mu_assert_streq (r_str_get (out[i]), r_str_get (expect[i]), "cached batch differs");
+		free (out[i]);
+		free (expect[i]);
+	}
+	for (i = 0; i < R_ARRAY_SIZE (pool); i++) {
+		free (pool[i]);
+	}
+	free (names);
+	free (vaddrs);
+	free (expect);
+	free (out);
+	r_buf_free (buf);
+	r_buf_free (buf2);
+	r_bin_free (bin);
+	r_io_free (io);
+	mu_end;
+}
 
 bool all_tests() {
 	mu_run_test(test_r_bin);
+	mu_run_test(test_r_bin_demangle_batch);
 	return tests_passed != tests_run;
 }
 
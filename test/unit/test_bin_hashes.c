@@ -0,0 +1,67 @@
+#include <r_bin.h>
+#include "minunit.h"
+
+// a bit more than the 4MB chunk the file is hashed in
+#define BIG_SIZE (4 * 1024 * 1024 + 0x1235)
+
+static char *hashes_of(const ut8 *data, int len) {
+	char *path = r_file_temp ("binhashes");
+	if (!path || !r_file_dump (path, data, len, false)) {
+		free (path);
+		return NULL;
+	}
+	RBin *bin = r_bin_new ();
+	RIO *io = r_io_new ();
+	r_io_bind (io, &bin->iob);
+	RBinFileOptions opt = {0};
+	RStrBuf *sb = r_strbuf_new ("");
+	if (r_bin_open (bin, path, &opt)) {
+		RList *hashes = r_bin_file_compute_hashes (bin, UT64_MAX);
+		RListIter *iter;
+		RBinFileHash *fh;
+		r_list_foreach (hashes, iter, fh) {
+			r_strbuf_appendf (sb, "%s %s\n", fh->type, fh->hex);
+		}
+		r_list_free (hashes);
+	}
+	r_bin_free (bin);
+	r_io_free (io);
+	r_file_rm (path);
+	free (path);
+	return r_strbuf_drain (sb);
+}
+
+bool test_bin_hashes_chunks(void) {
+	ut8 *data = malloc (BIG_SIZE);
+	mu_assert_notnull (data, "allocated");
+	int i;
+	for (i = 0; i < BIG_SIZE; i++) {
+		data[i] = (i * 7) + (i >> 12);
+	}
+	mu_assert_streq_free (hashes_of (data, BIG_SIZE),
+		"md5 48494dfe3fc3af923b7f07f4e5dd6d69\n"
+		"sha1 49508f4c699e52d4149708f6a99ba565fe7babab\n"
+		"sha256 e4521336d4ffbd5831e165fb7e7de173c9dc77aa66bfac3363cc06c068cfb158\n",
+		"hashes over more than one chunk");
+	free (data);
+	mu_end;
+}
+
+bool test_bin_hashes_empty(void) {
+	mu_assert_streq_free (hashes_of ((const ut8 *)"", 0),
+		"md5 d41d8cd98f00b204e9800998ecf8427e\n"
+		"sha1 da39a3ee5e6b4b0d3255bfef95601890afd80709\n"
+		"sha256 e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855\n",
+		"hashes of an empty file");
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_bin_hashes_chunks);
+	mu_run_test (test_bin_hashes_empty);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
@@ -0,0 +1,102 @@
+#include <r_bin.h>
+#include "minunit.h"
+
+#define JOBS 1000
+
+typedef struct {
+	int runs[JOBS];
+	int tids[JOBS];
+	size_t order[JOBS];
+	size_t ran; // only used by the serial runs
+	size_t fail;
+	int nthreads;
+} JobsTest;
+
+static bool job(void *user, size_t idx, int tid) {
+	JobsTest *t = user;
+	t->runs[idx]++;
+	t->tids[idx] = tid;
+	if (t->nthreads == 1) {
+		t->order[t->ran++] = idx;
+	}
+	return idx != t->fail;
+}
+
+static bool breaked(void) {
+	return true;
+}
+
+bool test_bin_jobs_threads(void) {
+	mu_assert_eq (r_bin_jobs_threads (0), 1, "at least one thread");
+	mu_assert_eq (r_bin_jobs_threads (1), 1, "no more threads than jobs");
+	int n = r_bin_jobs_threads (1000);
+	mu_assert ("bounded thread count", n >= 1 && n <= 16 && n <= r_th_ncpus ());
+	mu_end;
+}
+
+bool test_bin_jobs_serial(void) {
+	JobsTest t = { .fail = SIZE_MAX, .nthreads = 1 };
+	mu_assert ("all jobs done", r_bin_jobs_run (NULL, JOBS, 1, job, &t));
+	mu_assert_eq (t.ran, JOBS, "every job ran");
+	size_t i;
+	for (i = 0; i < JOBS; i++) {
+		mu_assert_eq (t.order[i], i, "jobs run in order");
+		mu_assert_eq (t.tids[i], 0, "on the calling thread");
+	}
+	mu_assert ("no jobs", r_bin_jobs_run (NULL, 0, 1, job, &t));
+	mu_assert_eq (t.ran, JOBS, "nothing ran");
+	mu_end;
+}
+
+bool test_bin_jobs_parallel(void) {
+	JobsTest t = { .fail = SIZE_MAX, .nthreads = 4 };
+	mu_assert ("all jobs done", r_bin_jobs_run (NULL, JOBS, 4, job, &t));
+	size_t i;
+	for (i = 0; i < JOBS; i++) {
+		mu_assert_eq (t.runs[i], 1, "every job ran once");
+		mu_assert ("thread index in range", t.tids[i] >= 0 && t.tids[i] < 4);
+	}
+	JobsTest t2 = { .fail = SIZE_MAX, .nthreads = 64 };
+	mu_assert ("more threads than the limit", r_bin_jobs_run (NULL, JOBS, 64, job, &t2));
+	for (i = 0; i < JOBS; i++) {
+		mu_assert_eq (t2.runs[i], 1, "every job ran once");
+		mu_assert ("thread index below the limit", t2.tids[i] >= 0 && t2.tids[i] < 16);
+	}
+	mu_end;
+}
+
+bool test_bin_jobs_stop(void) {
+	JobsTest t = { .fail = 10, .nthreads = 1 };
+	mu_assert_false (r_bin_jobs_run (NULL, JOBS, 1, job, &t), "a failed job fails the run");
+	mu_assert_eq (t.ran, 11, "nothing runs after the failure");
+
+	JobsTest t2 = { .fail = 10, .nthreads = 4 };
+	mu_assert_false (r_bin_jobs_run (NULL, JOBS, 4, job, &t2), "a failed job fails the threaded run");
+	size_t i;
+	for (i = 0; i < JOBS; i++) {
+		mu_assert ("no job runs twice", t2.runs[i] <= 1);
+	}
+	mu_assert_eq (t2.runs[10], 1, "the failed job ran");
+
+	RBin *bin = r_bin_new ();
+	bin->consb.is_breaked = breaked;
+	JobsTest t3 = { .fail = SIZE_MAX, .nthreads = 1 };
+	mu_assert_false (r_bin_jobs_run (bin, JOBS, 1, job, &t3), "interrupted");
+	mu_assert_eq (t3.ran, 0, "interrupted before the first job");
+	JobsTest t4 = { .fail = SIZE_MAX, .nthreads = 4 };
+	mu_assert_false (r_bin_jobs_run (bin, JOBS, 4, job, &t4), "interrupted threaded run");
+	r_bin_free (bin);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_bin_jobs_threads);
+	mu_run_test (test_bin_jobs_serial);
+	mu_run_test (test_bin_jobs_parallel);
+	mu_run_test (test_bin_jobs_stop);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
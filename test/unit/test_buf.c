@@ -401,6 +401,157 @@ bool test_r_buf_slice_too_big(void) {
 	mu_end;
 }
 
+// fixed huffman deflate writer, enough to build big raw streams
+typedef struct {
+	ut8 *buf;
+	ut64 bits;
+} DeflateWriter;
+
+static void deflate_bits(DeflateWriter *w, ut32 v, int n) {
+	int i;
+	for (i = 0; i < n; i++, w->bits++) {
+		if (v & (1U << i)) {
+			w->buf[w->bits / 8] |= 1 << (w->bits % 8);
+		}
+	}
+}
+
+// huffman codes go most significant bit first
+static void deflate_code(DeflateWriter *w, ut32 code, int n) {
+	while (n-- > 0) {
+		deflate_bits (w, (code >> n) & 1, 1);
+	}
+}
+
+static void deflate_symbol(DeflateWriter *w, int sym) {
+	if (sym < 144) {
+		deflate_code (w, 0x30 + sym, 8);
+	} else if (sym < 256) {
+		deflate_code (w, 0x190 + sym - 144, 9);
+	} else if (sym < 280) {
+		deflate_code (w, sym - 256, 7);
+	} else {
+		deflate_code (w, 0xc0 + sym - 280, 8);
+	}
+}
+
+#define DEFLATE_SIZE (10 * 1024 * 1024)
+#define DEFLATE_DIST 20000
+
+// blocks of random literals and 258 byte copies from 20000 bytes back,
+// the blocks end in the middle of a byte and the copies cross the spans
+static ut8 *deflate_build(ut8 *out, ut64 *len) {
+	// at most 9 bits per byte and 10 bits per block
+	DeflateWriter w = { calloc (1, DEFLATE_SIZE / 8 * 9 + 0x1000), 0 };
+	if (!w.buf) {
+		return NULL;
+	}
+	ut32 seed = 31337;
+	ut64 n = 0;
+	int i;
+	while (n < DEFLATE_SIZE) {
+		deflate_bits (&w, n + 0x8000 >= DEFLATE_SIZE, 1);
+		deflate_bits (&w, 1, 2);
+		ut64 end = R_MIN (n + 0x8000, DEFLATE_SIZE);
+		while (n < end) {
+			if (n >= DEFLATE_DIST && n + 258 <= end && (seed >> 24) & 1) {
+				deflate_symbol (&w, 285);
+				deflate_code (&w, 28, 5);
+				deflate_bits (&w, DEFLATE_DIST - 16385, 13);
+				for (i = 0; i < 258; i++, n++) {
+					out[n] = out[n - DEFLATE_DIST];
+				}
+			}
+			for (i = 0; i < 16 && n < end; i++, n++) {
+				seed = seed * 1103515245 + 12345;
+				out[n] = seed >> 16;
+				deflate_symbol (&w, out[n]);
+			}
+		}
+		deflate_symbol (&w, 256);
+	}
+	*len = (w.bits + 7) / 8;
+	return w.buf;
+}
+
+bool test_r_buf_inflate(void) {
+	// "radare2 " * 512
+	const ut8 gz[] = {
+		0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0xc5, 0x31, 0x0d, 0x00, 0x30,
+		0x0c, 0x03, 0x30, 0x2a, 0xc3, 0x30, 0x46, 0x91, 0x5a, 0x02, 0xe1, 0x7f, 0x8c, 0xc7, 0x64, 0x3f,
+		0x6e, 0x26, 0xdd, 0x7b, 0x6a, 0xdb, 0xb6, 0x6d, 0xdb, 0xb6, 0xbf, 0xfd, 0x01, 0x4b, 0xd2, 0x42,
+		0xfc, 0x00, 0x10, 0x00, 0x00
+	};
+	// raw deflate of "hello world"
+	const ut8 raw[] = { 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57, 0x28, 0xcf, 0x2f, 0xca, 0x49, 0x01, 0x00 };
+	ut8 out[16] = {0};
+
+	RBuffer *src = r_buf_new_with_bytes (gz, sizeof (gz));
+	RBuffer *b = r_buf_new_inflate (src, 15 + 32);
+	r_buf_free (src);
+	mu_assert_notnull (b, "gzip stream should be accepted");
+	mu_assert_eq (r_buf_size (b), 4096, "inflated size");
+	st64 r = r_buf_read_at (b, 4090, out, sizeof (out));
+	mu_assert_eq (r, 6, "reads are clamped to the inflated size");
+	mu_assert_memeq (out, (ut8 *)"dare2 ", 6, "read at the end");
+	r = r_buf_read_at (b, 9, out, 7);
+	mu_assert_eq (r, 7, "read in the middle");
+	mu_assert_memeq (out, (ut8 *)"adare2 ", 7, "read in the middle");
+	r_buf_free (b);
+
+	src = r_buf_new_with_bytes (raw, sizeof (raw));
+	b = r_buf_new_inflate (src, -15);
+	mu_assert_notnull (b, "raw deflate stream should be accepted");
+	mu_assert_eq (r_buf_size (b), 11, "inflated size");
+	r = r_buf_read_at (b, 6, out, 5);
+	mu_assert_memeq (out, (ut8 *)"world", 5, "raw deflate content");
+	r_buf_free (b);
+
+	b = r_buf_new_inflate (src, 15 + 32);
+	mu_assert_null (b, "raw deflate has no gzip header");
+	r_buf_free (src);
+
+	// ten spans: access points, their windows, unaligned blocks and evictions
+	ut8 *data = malloc (DEFLATE_SIZE);
+	ut8 *chunk = malloc (0x20000);
+	ut64 len = 0;
+	ut8 *stream = data? deflate_build (data, &len): NULL;
+	mu_assert_notnull (stream, "deflate stream");
+	src = r_buf_new_with_bytes (stream, len);
+	b = r_buf_new_inflate (src, -15);
+	r_buf_free (src);
+	mu_assert_notnull (b, "big raw deflate stream should be accepted");
+	mu_assert_eq (r_buf_size (b), DEFLATE_SIZE, "big inflated size");
+	ut64 at = DEFLATE_SIZE;
+	while (at > 0) {
+		// backwards, every read crosses into the previous span
+		ut64 sz = R_MIN (at, 0x1ffff);
+		at -= sz;
+		r = r_buf_read_at (b, at, chunk, sz);
+		mu_assert_eq (r, sz, "backward read");
+		mu_assert_memeq (chunk, data + at, sz, "backward content");
+	}
+	ut32 seed = 1;
+	int i;
+	for (i = 0; i < 200; i++) {
+		seed = seed * 1103515245 + 12345;
+		at = ((ut64)seed << 8) % (DEFLATE_SIZE - 0x20000);
+		ut64 sz = 1 + (seed >> 16) % 0x20000;
+		r_buf_seek (b, at, R_BUF_SET);
+		r = r_buf_read (b, chunk, sz);
+		mu_assert_eq (r, sz, "random read");
+		mu_assert_memeq (chunk, data + at, sz, "random content");
+	}
+	r = r_buf_read_at (b, DEFLATE_SIZE - 5, chunk, 16);
+	mu_assert_eq (r, 5, "big reads are clamped to the inflated size");
+	mu_assert_memeq (chunk, data + DEFLATE_SIZE - 5, 5, "read at the end");
+	r_buf_free (b);
+	free (stream);
+	free (chunk);
+	free (data);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test (test_r_buf_file);
 	mu_run_test (test_r_buf_bytes);
@@ -415,6 +566,7 @@ int all_tests() {
 	mu_run_test (test_r_buf_get_string);
 	mu_run_test (test_r_buf_get_string_nothing);
 	mu_run_test (test_r_buf_slice_too_big);
+	mu_run_test (test_r_buf_inflate);
 	return tests_passed != tests_run;
 }
 
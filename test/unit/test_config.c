@@ -0,0 +1,111 @@
+#include <r_config.h>
+#include "minunit.h"
+
+// normalizes the value, reallocating it even when it does not change
+static bool dup_setter(void *user, void *data) {
+	RConfigNode *node = data;
+	char *v = strdup (node->value);
+	free (node->value);
+	node->value = v;
+	return true;
+}
+
+bool test_config_handle(void) {
+	RConfig *cfg = r_config_new (NULL);
+	r_config_set_i (cfg, "asm.bits", 32);
+	r_config_set (cfg, "asm.bytes", "true");
+	r_config_set (cfg, "asm.arch", "x86");
+
+	RConfigHandle bits, arch, missing;
+	r_config_handle_init (&bits, cfg, "asm.bits");
+	r_config_handle_init (&arch, cfg, "asm.arch");
+	r_config_handle_init (&missing, cfg, "asm.missing");
+	mu_assert_eq (r_config_handle_i (&bits), 32, "cached int value");
+	mu_assert_streq (r_config_handle_s (&arch), "x86", "cached str value");
+	mu_assert_false (bits.eval, "plain numbers are cached");
+	mu_assert ("strings are evaluated as numbers", arch.eval);
+	mu_assert_null (r_config_handle_s (&missing), "missing variable");
+
+	ut32 gen = cfg->gen;
+	r_config_set_i (cfg, "asm.bits", 64);
+	mu_assert ("generation bumped", cfg->gen != gen);
+	mu_assert_eq (r_config_handle_i (&bits), 64, "refreshed int value");
+	gen = cfg->gen;
+	const char *bits_value = r_config_node_get (cfg, "asm.bits")->value;
+	const char *arch_value = r_config_node_get (cfg, "asm.arch")->value;
+	const char *bytes_value = r_config_node_get (cfg, "asm.bytes")->value;
+	r_config_set_i (cfg, "asm.bits", 64);
+	r_config_set (cfg, "asm.arch", "x86");
+	r_config_set_b (cfg, "asm.bytes", true);
+	r_config_set (cfg, "asm.bytes", "true");
+	mu_assert_eq (cfg->gen, gen, "setting the same values is not a change");
+	mu_assert_ptreq (r_config_node_get (cfg, "asm.bits")->value, bits_value, "same int value is not reallocated");
+	mu_assert_ptreq (r_config_node_get (cfg, "asm.arch")->value, arch_value, "same str value is not reallocated");
+	mu_assert_ptreq (r_config_node_get (cfg, "asm.bytes")->value, bytes_value, "same bool value is not reallocated");
+	mu_assert_streq (r_config_handle_s (&arch), "x86", "str value after setting it again");
+	r_config_set (cfg, "asm.arch", "arm");
+	mu_assert_streq (r_config_handle_s (&arch), "arm", "refreshed str value");
+	r_config_set_setter (cfg, "asm.arch", dup_setter);
+	gen = cfg->gen;
+	r_config_set (cfg, "asm.arch", "arm");
+	mu_assert_eq (cfg->gen, gen, "reallocated but not changed");
+	RConfigNode *node = r_config_node_get (cfg, "asm.arch");
+	mu_assert_ptreq (r_config_handle_s (&arch), node->value, "str value is read from the node");
+
+	r_config_rm (cfg, "asm.arch");
+	mu_assert_null (r_config_handle_s (&arch), "removed variable");
+	r_config_free (cfg);
+	mu_end;
+}
+
+static int watch_calls = 0;
+static ut64 watch_value = 0;
+static void *watch_user = NULL;
+
+static void watch_cb(void *user, RConfigNode *node) {
+	watch_calls++;
+	watch_value = node->i_value;
+	watch_user = user;
+}
+
+static bool ro_setter(void *user, void *data) {
+	return false;
+}
+
+bool test_config_watch(void) {
+	RConfig *cfg = r_config_new (NULL);
+	r_config_set_i (cfg, "asm.bits", 32);
+	r_config_set_i (cfg, "scr.color", 0);
+	r_config_set_i_cb (cfg, "asm.fixed", 1, NULL);
+	RConfigWatch *w = r_config_watch (cfg, "asm.", watch_cb, cfg);
+	mu_assert_notnull (w, "watch created");
+
+	r_config_set_i (cfg, "asm.bits", 64);
+	mu_assert_eq (watch_calls, 1, "watcher called on change");
+	mu_assert_eq (watch_value, 64, "watcher sees the new value");
+	mu_assert_ptreq (watch_user, cfg, "user pointer is passed");
+	r_config_set_i (cfg, "scr.color", 1);
+	mu_assert_eq (watch_calls, 1, "other prefixes are not watched");
+	r_config_set (cfg, "asm.bits", "64");
+	mu_assert_eq (watch_calls, 1, "same value is not notified");
+
+	r_config_set_setter (cfg, "asm.fixed", ro_setter);
+	r_config_set_i (cfg, "asm.fixed", 2);
+	mu_assert_eq (watch_calls, 1, "rejected changes are not notified");
+
+	r_config_unwatch (cfg, w);
+	r_config_set_i (cfg, "asm.bits", 16);
+	mu_assert_eq (watch_calls, 1, "unwatched");
+	r_config_free (cfg);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_config_handle);
+	mu_run_test (test_config_watch);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests();
+}
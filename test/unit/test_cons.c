@@ -164,9 +164,57 @@ bool test_cons_to_html() {
 	mu_end;
 }
 
+static char *frame_output(RCons *cons, const char *frame, bool *ok) {
+	char *path = NULL;
+	int fd = r_file_mkstemp ("frame", &path);
+	int ofd = cons->fdout;
+	cons->fdout = fd;
+	*ok = r_cons_frame_write (frame, -1);
+	cons->fdout = ofd;
+	close (fd);
+	char *res = r_file_slurp (path, NULL);
+	r_file_rm (path);
+	free (path);
+	return res;
+}
+
+bool test_cons_frame_write() {
+	RCons *cons = r_cons_new ();
+	bool ok;
+	cons->rows = 3;
+	cons->columns = 10;
+	char *out = frame_output (cons, "\x1b[0;0Hab\n\x1b[31mcd\nef", &ok);
+	mu_assert ("first frame", ok);
+	mu_assert_streq_free (out, "\x1b[1;1H\x1b[0m\x1b[2Kab"
+		"\x1b[2;1H\x1b[0m\x1b[2K\x1b[31mcd"
+		"\x1b[3;1H\x1b[0m\x1b[2K\x1b[31mef\x1b[0m\x1b[31m", "all rows are drawn");
+	out = frame_output (cons, "\x1b[0;0Hab\n\x1b[31mcd\nef", &ok);
+	mu_assert_streq_free (out, "", "nothing changed");
+	out = frame_output (cons, "\x1b[0m\x1b[2J\r\x1b[0;0Hab\n\x1b[31mcd\x1b[0m\nef", &ok);
+	mu_assert_streq_free (out, "\x1b[2;1H\x1b[0m\x1b[2K\x1b[31mcd\x1b[0m"
+		"\x1b[3;1H\x1b[0m\x1b[2Kef\x1b[0m", "only the rows with new contents or colors");
+	out = frame_output (cons, "ab\ncd", &ok);
+	mu_assert ("frame must start at home", !ok);
+	free (out);
+	out = frame_output (cons, "\x1b[0;0Hab\ncd\x1b[5;5Hx", &ok);
+	mu_assert ("cursor moves are not supported", !ok);
+	free (out);
+	out = frame_output (cons, "\x1b[0;0Hab\ncd\nef\ngh", &ok);
+	mu_assert ("more rows than the screen", !ok);
+	free (out);
+	out = frame_output (cons, "\x1b[0;0Hab", &ok);
+	mu_assert_streq_free (out, "\x1b[1;1H\x1b[0m\x1b[2Kab"
+		"\x1b[2;1H\x1b[0m\x1b[2K"
+		"\x1b[3;1H\x1b[0m\x1b[2K\x1b[0m", "failed frames redraw everything");
+	r_cons_frame_reset ();
+	r_cons_free ();
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test (test_r_cons);
 	mu_run_test (test_cons_to_html);
+	mu_run_test (test_cons_frame_write);
 	return tests_passed != tests_run;
 }
 
@@ -0,0 +1,348 @@
+#include <r_core.h>
+#include <r_bin_dwarf.h>
+#include "minunit.h"
+
+// zlib compressed elf files, two C units each, built with:
+// gcc -g -c a.c b.c && ld.gold -N --gdb-index -e fa a.o b.o
+// llc -accel-tables=Dwarf -generate-arange-section a.ll b.ll && ld -N -e fa a.o b.o
+// a.c: int counter; int fa(int x) { return x + counter; }
+// b.c: struct point { int x, y; }; int fb(struct point *p) { return p->x * p->y; }
+static const ut8 gdb_index_elf[] = {
+	0x78, 0xda, 0xed, 0x5a, 0xcd, 0x6b, 0x13, 0x41, 0x14, 0x7f, 0xb3, 0x1f, 0x6d, 0xca, 0xb6, 0x69,
+	0x6b, 0xfc, 0x68, 0xaa, 0xd2, 0x14, 0x5b, 0x0b, 0x62, 0xb6, 0x2a, 0x7e, 0xc4, 0xef, 0xa0, 0x56,
+	0x5b, 0x94, 0x48, 0x85, 0xde, 0xac, 0x71, 0x37, 0xd9, 0x6d, 0x23, 0xed, 0xa6, 0x64, 0x37, 0x9a,
+	0x0a, 0x22, 0x88, 0xa0, 0x25, 0x07, 0xf1, 0xee, 0x51, 0x6f, 0x82, 0x1e, 0x3d, 0x6b, 0x8f, 0x1e,
+	0x3c, 0x7a, 0x90, 0xd2, 0x83, 0xfe, 0x01, 0xde, 0x04, 0x05, 0x7d, 0xb3, 0x99, 0x69, 0xd6, 0xb5,
+	0x6b, 0x14, 0xd1, 0x83, 0xcc, 0x0f, 0x66, 0xdf, 0xbc, 0x37, 0xef, 0xf7, 0xde, 0xec, 0x9b, 0xdd,
+	0x90, 0x90, 0x77, 0x7b, 0xec, 0xc2, 0x59, 0x89, 0x10, 0xe0, 0x90, 0xe0, 0x04, 0x50, 0xed, 0x39,
+	0x64, 0x7d, 0x3d, 0xcb, 0xec, 0xb1, 0x9d, 0x6b, 0x2e, 0x68, 0xcb, 0xa0, 0x5f, 0x16, 0xba, 0xa0,
+	0xd3, 0xf7, 0x6d, 0x87, 0x20, 0xb2, 0xdf, 0xc9, 0x15, 0xa6, 0xbd, 0xe7, 0x71, 0x98, 0x9c, 0xfc,
+	0xe0, 0x15, 0xdb, 0xe0, 0xd7, 0xd1, 0xc3, 0xe4, 0xd4, 0xf8, 0xd2, 0x87, 0xa5, 0x5b, 0x5f, 0xea,
+	0x9b, 0x76, 0xa0, 0x52, 0x1f, 0xfb, 0x42, 0xde, 0x4c, 0xbf, 0xa2, 0xb6, 0xf1, 0xa5, 0x5b, 0x9f,
+	0xc6, 0xeb, 0x63, 0x9f, 0xea, 0x3d, 0xfe, 0x35, 0xab, 0x74, 0x3f, 0x7b, 0x39, 0xfd, 0xca, 0x45,
+	0x27, 0x15, 0x88, 0x9f, 0xd4, 0xbf, 0xc7, 0xed, 0xf4, 0xa2, 0x04, 0xee, 0x6f, 0x63, 0x20, 0x87,
+	0x64, 0x52, 0x37, 0xa2, 0x9e, 0x41, 0xd1, 0x21, 0xaf, 0x32, 0x0f, 0x59, 0x51, 0x4b, 0x8e, 0x07,
+	0x8a, 0x6d, 0x00, 0x91, 0xfc, 0xb5, 0x30, 0x97, 0x3c, 0x52, 0x6b, 0xb8, 0xd6, 0x49, 0xd7, 0xa4,
+	0x87, 0x73, 0x00, 0xf7, 0x58, 0xda, 0x2b, 0x7e, 0x41, 0x69, 0xda, 0x4e, 0x96, 0x76, 0x99, 0x51,
+	0xfb, 0x19, 0xf5, 0x22, 0x4d, 0x70, 0x8d, 0xd6, 0x85, 0x90, 0x58, 0x8e, 0xc6, 0xaa, 0xc1, 0xc6,
+	0x9c, 0x1f, 0x74, 0x11, 0xb6, 0xe4, 0x7c, 0x96, 0xd2, 0xd8, 0x80, 0x6a, 0x9b, 0x74, 0x03, 0xb9,
+	0x75, 0xa2, 0x90, 0x47, 0x77, 0xf1, 0xda, 0xb6, 0x80, 0xeb, 0x9b, 0xef, 0xfa, 0x9b, 0x98, 0x85,
+	0xf6, 0x98, 0xee, 0x2f, 0xf5, 0x92, 0xe1, 0x78, 0x42, 0x93, 0x07, 0xb6, 0x0e, 0xf4, 0x92, 0x0d,
+	0xed, 0x3d, 0x5b, 0x70, 0x75, 0x3f, 0xc8, 0xf1, 0x23, 0xda, 0x51, 0xed, 0xb0, 0x36, 0x91, 0x38,
+	0x99, 0x94, 0xfa, 0x70, 0x0b, 0x43, 0xa0, 0x69, 0x27, 0x34, 0x19, 0x0b, 0xa5, 0xe8, 0xe4, 0x64,
+	0x52, 0x8e, 0x35, 0xd6, 0x47, 0x92, 0x13, 0x09, 0x4a, 0xcb, 0xf6, 0xdd, 0x4c, 0xe2, 0x2d, 0xa9,
+	0xc0, 0x17, 0x26, 0x12, 0x94, 0x06, 0xa4, 0x8b, 0x5a, 0x06, 0xc9, 0xd1, 0x41, 0x42, 0x6d, 0x19,
+	0x0d, 0xa3, 0xff, 0x98, 0x50, 0x4e, 0x10, 0x39, 0xae, 0x69, 0x0d, 0x26, 0x49, 0x60, 0x8e, 0x66,
+	0x3a, 0x35, 0x2a, 0x1d, 0xf5, 0x6b, 0x0b, 0x27, 0x6c, 0xef, 0x46, 0xe2, 0x04, 0xae, 0xc0, 0x79,
+	0xbf, 0xc4, 0x31, 0xd8, 0xe5, 0x1f, 0x19, 0xf9, 0x1c, 0xef, 0xa2, 0x82, 0x34, 0xce, 0x19, 0x27,
+	0x03, 0x84, 0x96, 0x5b, 0x22, 0x03, 0x52, 0xb7, 0xd4, 0x3c, 0x61, 0xb5, 0x1b, 0x3a, 0x24, 0x7e,
+	0x7c, 0x09, 0xb5, 0xdf, 0x53, 0x87, 0x9f, 0x4a, 0x12, 0xfa, 0x4f, 0xfe, 0x46, 0x38, 0x7a, 0x96,
+	0xe0, 0x5f, 0xd4, 0x24, 0x86, 0x5b, 0x5e, 0x0b, 0xb7, 0xe3, 0x8e, 0xba, 0xcb, 0x56, 0x47, 0x3c,
+	0x75, 0xf4, 0x98, 0x1f, 0xf4, 0x5c, 0x6e, 0x2a, 0x75, 0x7a, 0xef, 0xa1, 0xd4, 0xde, 0x7d, 0xfa,
+	0x3e, 0x7d, 0x4f, 0x2a, 0x3d, 0xef, 0x55, 0x1d, 0xeb, 0xf8, 0x8c, 0xe5, 0x58, 0x95, 0x52, 0x01,
+	0x55, 0xa3, 0x52, 0x98, 0x3d, 0x5e, 0xcb, 0x1c, 0x4c, 0x1f, 0xdc, 0x9f, 0x4a, 0xcf, 0xa4, 0xd2,
+	0x17, 0xd1, 0xc7, 0xb6, 0x2b, 0x96, 0xe5, 0x7a, 0x86, 0x53, 0x2c, 0x39, 0x68, 0xb2, 0x9d, 0x72,
+	0xda, 0x70, 0x17, 0x9d, 0xc2, 0x6c, 0xa5, 0xec, 0x94, 0xab, 0x6e, 0xba, 0xea, 0xdc, 0x28, 0x39,
+	0xc5, 0xb4, 0x67, 0x98, 0x73, 0x96, 0x0b, 0x85, 0x72, 0xd5, 0xf1, 0xac, 0x0a, 0x2c, 0x94, 0xe9,
+	0x13, 0x62, 0xe8, 0x05, 0x18, 0xf5, 0xe6, 0x17, 0x46, 0xed, 0x1a, 0x98, 0x38, 0xa7, 0xef, 0x25,
+	0x3d, 0xa5, 0x0c, 0x1b, 0x57, 0xe9, 0x48, 0x35, 0xab, 0x71, 0x23, 0x24, 0xeb, 0x4c, 0xf2, 0x02,
+	0x2d, 0xaf, 0xbd, 0xcb, 0xcd, 0xf9, 0x0a, 0x93, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+	0x04, 0xfe, 0x1d, 0x0e, 0xb3, 0xef, 0xde, 0xa7, 0x70, 0x0c, 0x89, 0x72, 0x08, 0x08, 0x08, 0x08,
+	0x08, 0xfc, 0x27, 0x38, 0x86, 0x63, 0x9b, 0x28, 0x83, 0x80, 0x80, 0x80, 0x80, 0x80, 0xc0, 0x7f,
+	0x85, 0xf4, 0x5f, 0x8a, 0x7b, 0x00, 0x9a, 0xff, 0xaf, 0x09, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+	0x08, 0xfc, 0x0d, 0xf0, 0x1e, 0x00, 0x29, 0xa0, 0x93, 0xd0, 0x7c, 0xcd, 0xc6, 0x5b, 0x15, 0x68,
+	0xa3, 0x82, 0x6d, 0xb0, 0x8e, 0x05, 0xdb, 0xfc, 0x95, 0x1c, 0x0a, 0x7c, 0xfc, 0x1a, 0xb6, 0xab,
+	0x11, 0xf6, 0x0e, 0xa0, 0xbd, 0x42, 0x04, 0xde, 0x07, 0x7a, 0x17, 0x28, 0xe2, 0xcc, 0xbe, 0x12,
+	0xb2, 0xf7, 0x47, 0xd8, 0x07, 0x71, 0x6c, 0x40, 0x7b, 0xb8, 0xd5, 0x66, 0x88, 0xd9, 0xc3, 0x3d,
+	0x40, 0x23, 0x38, 0x7a, 0x41, 0x06, 0xde, 0x35, 0xa4, 0xf0, 0x40, 0xb4, 0x29, 0x83, 0x36, 0x63,
+	0xe4, 0x2d, 0xa7, 0x08, 0xf9, 0xbc, 0xe9, 0xba, 0x79, 0xd7, 0x33, 0x2a, 0x1e, 0x1a, 0x8a, 0x86,
+	0x67, 0xd0, 0x12, 0x60, 0x39, 0x78, 0x75, 0x40, 0x77, 0x17, 0xe7, 0x3d, 0xc3, 0x44, 0xe9, 0x55,
+	0x1a, 0x72, 0x96, 0xcf, 0x3c, 0xab, 0xe6, 0x81, 0xee, 0x93, 0x74, 0x0c, 0x83, 0x53, 0xcb, 0xac,
+	0xce, 0xe4, 0x4b, 0x8e, 0x5d, 0xe6, 0x73, 0xc3, 0x34, 0x2b, 0xd6, 0x75, 0xae, 0xcd, 0x95, 0x1c,
+	0x8b, 0xcf, 0x31, 0x48, 0xd0, 0xdc, 0xd0, 0x67, 0x8a, 0x26, 0xd2, 0x8b, 0x56, 0xed, 0xcf, 0x9f,
+	0x85, 0xad, 0xec, 0xac, 0x78, 0x4f, 0x17, 0xaf, 0xcf, 0x73, 0xa6, 0xeb, 0x11, 0xcf, 0x4e, 0xb0,
+	0xde, 0xd4, 0x26, 0x33, 0x7d, 0x25, 0xd4, 0x3f, 0x06, 0x2d, 0xf8, 0x23, 0xec, 0xbb, 0x2f, 0xe7,
+	0xaf, 0x86, 0xf8, 0x4a, 0xc8, 0x3f, 0xac, 0xef, 0x86, 0xf5, 0x7b, 0x5a, 0x38, 0x5f, 0x22, 0x3f,
+	0xcf, 0x9f, 0x89, 0xe0, 0xaf, 0x32, 0xe3, 0xdb, 0x16, 0xfb, 0x3f, 0x1b, 0xc1, 0x7f, 0xc1, 0x5e,
+	0xae, 0xc7, 0x2d, 0xf8, 0x97, 0x98, 0x6d, 0x4f, 0xc8, 0x7e, 0x99, 0x15, 0x64, 0x21, 0x82, 0xcf,
+	0xe5, 0x74, 0x04, 0xff, 0x35, 0xe3, 0xf7, 0xb4, 0xe0, 0xcf, 0x47, 0xec, 0xff, 0x1d, 0xe3, 0x3f,
+	0x49, 0xfd, 0xbc, 0xfe, 0x24, 0xf0, 0x39, 0x12, 0xc4, 0xfd, 0xa1, 0xef, 0xeb, 0xa7, 0xb1, 0x33,
+	0xe6, 0xbf, 0x73, 0xfa, 0x02, 0xef, 0xbd, 0xbc, 0x0e, 0xff, 0xea, 0x70, 0x43, 0x8e, 0xb6, 0xa8,
+	0x5f, 0x6f, 0x04, 0xff, 0x01, 0xe3, 0xd7, 0x5a, 0xf0, 0xbf, 0x01, 0xee, 0x9c, 0xe0, 0x54,
+};
+
+static const ut8 debug_names_elf[] = {
+	0x78, 0xda, 0xad, 0x56, 0x4b, 0x6f, 0xd3, 0x40, 0x10, 0x9e, 0xb5, 0xe3, 0xa4, 0x25, 0xe9, 0x23,
+	0x4d, 0x45, 0x83, 0x82, 0x94, 0x02, 0x31, 0x2a, 0x12, 0x98, 0xd0, 0x06, 0xf1, 0xaa, 0x4a, 0xa8,
+	0x00, 0xb5, 0x52, 0x2b, 0xd4, 0x0b, 0x15, 0xe2, 0x10, 0xec, 0xc6, 0x6e, 0x2b, 0xb5, 0x6e, 0x65,
+	0xbb, 0x40, 0x4f, 0xbc, 0x7a, 0x00, 0x71, 0x80, 0xbf, 0x00, 0x67, 0x0e, 0xfc, 0x01, 0xa4, 0x4a,
+	0xbd, 0xc2, 0x89, 0x0b, 0x37, 0x4e, 0xfc, 0x00, 0x24, 0x90, 0x2a, 0x71, 0x28, 0xbb, 0x9b, 0x59,
+	0xc7, 0x75, 0xb3, 0x18, 0x24, 0x46, 0x5a, 0xcf, 0xee, 0xcc, 0xf7, 0xcd, 0xcc, 0x66, 0xc7, 0x1b,
+	0x3f, 0xba, 0x31, 0x73, 0x53, 0x21, 0x04, 0x84, 0x28, 0x30, 0x01, 0x6c, 0xf5, 0x1e, 0xea, 0x7c,
+	0x5d, 0x47, 0xfb, 0xae, 0x16, 0x42, 0xa8, 0xed, 0x22, 0xc5, 0xd5, 0xa1, 0x0f, 0x7a, 0x39, 0x36,
+	0xc3, 0xf1, 0x2d, 0x11, 0x3c, 0xa1, 0x0b, 0x68, 0xbf, 0x87, 0xba, 0x1f, 0xf5, 0xdc, 0xb7, 0xa0,
+	0x99, 0x86, 0xbf, 0x97, 0x2e, 0xd4, 0x2f, 0x76, 0x9f, 0x6d, 0x93, 0x1d, 0xc7, 0xe8, 0x2b, 0x6f,
+	0xf1, 0xf5, 0xcb, 0xcc, 0xce, 0x38, 0x2f, 0xbb, 0x05, 0xda, 0xa3, 0x92, 0x23, 0xad, 0xd4, 0xa9,
+	0x58, 0x49, 0xb2, 0x74, 0xa7, 0x39, 0x7f, 0x32, 0xe4, 0x6f, 0x23, 0x5e, 0x95, 0xe0, 0x27, 0xe8,
+	0xd0, 0x80, 0xf0, 0x8a, 0x08, 0xe4, 0x70, 0xc6, 0x82, 0x90, 0x34, 0x56, 0xaa, 0xa8, 0x06, 0xf7,
+	0x2a, 0x6f, 0x40, 0x4d, 0x69, 0xa9, 0x14, 0x77, 0x90, 0x79, 0x0d, 0x14, 0x6e, 0x1f, 0xc3, 0x08,
+	0xd3, 0x22, 0xc2, 0x08, 0x9d, 0x4c, 0xf1, 0x32, 0x58, 0xd2, 0xe1, 0x70, 0x46, 0xe6, 0x55, 0x50,
+	0x46, 0x59, 0x2d, 0x34, 0x0a, 0x90, 0x3c, 0xd1, 0xf5, 0x82, 0xa6, 0xea, 0xde, 0x50, 0xff, 0x50,
+	0x49, 0xcf, 0x97, 0x06, 0xd2, 0xfe, 0x10, 0x85, 0xd6, 0x40, 0xd5, 0xa7, 0x0b, 0x57, 0x8f, 0x5c,
+	0xce, 0x5e, 0xc9, 0x2a, 0x45, 0x0a, 0xae, 0x50, 0xc3, 0x44, 0x36, 0x9b, 0xa5, 0xbf, 0x81, 0x01,
+	0x0c, 0x56, 0x2f, 0xaa, 0x3a, 0xf3, 0x32, 0x14, 0x0b, 0x2b, 0x09, 0xd4, 0x09, 0x1c, 0x09, 0x06,
+	0xd7, 0x79, 0xdd, 0x5d, 0xa0, 0xb3, 0x18, 0x84, 0xfc, 0xea, 0xed, 0x61, 0x8a, 0xf0, 0x5d, 0xb0,
+	0x59, 0x99, 0xb4, 0x7e, 0x86, 0xb2, 0xd2, 0x47, 0x34, 0x3c, 0x82, 0x6e, 0x25, 0x6c, 0x05, 0x8d,
+	0x1c, 0x32, 0x14, 0xba, 0x0d, 0xf2, 0x2f, 0x71, 0xba, 0xc3, 0x38, 0xdb, 0x91, 0x38, 0x44, 0x51,
+	0x29, 0xd0, 0x1b, 0x05, 0xd3, 0x58, 0x80, 0xb3, 0xc1, 0xea, 0x3a, 0x2c, 0xac, 0x6d, 0xb8, 0x81,
+	0xed, 0xc1, 0xb2, 0x1b, 0x80, 0x63, 0x82, 0x45, 0xed, 0x8e, 0x05, 0x83, 0x98, 0x49, 0xf4, 0x84,
+	0xa8, 0x25, 0x87, 0x76, 0x11, 0x93, 0x87, 0x60, 0xb1, 0x18, 0x6f, 0x8b, 0x3b, 0x79, 0x31, 0xa1,
+	0xa8, 0x38, 0x0a, 0x78, 0xc2, 0x33, 0x33, 0xb7, 0x67, 0xab, 0x17, 0xaa, 0x55, 0xe1, 0x27, 0xd8,
+	0x84, 0x1f, 0x1f, 0xdc, 0x81, 0xea, 0xe3, 0xe7, 0x59, 0xfb, 0xd2, 0xcf, 0xcf, 0xf4, 0x28, 0x78,
+	0x01, 0x39, 0xc4, 0xa4, 0x71, 0x5e, 0xab, 0xa9, 0x34, 0x8c, 0x61, 0xb0, 0x67, 0xa5, 0xc2, 0x9e,
+	0x60, 0xb0, 0x43, 0x86, 0x0a, 0xef, 0x8e, 0xda, 0x09, 0xc4, 0x2f, 0x75, 0xa8, 0x43, 0xc1, 0xd1,
+	0x13, 0xab, 0x63, 0x32, 0x52, 0x03, 0xcb, 0xff, 0x89, 0xd6, 0xc1, 0x72, 0x97, 0x23, 0xb9, 0xf7,
+	0x65, 0xac, 0xf0, 0x8c, 0x86, 0xc8, 0x75, 0x14, 0x73, 0x89, 0xbd, 0x66, 0xb0, 0x56, 0x16, 0xa3,
+	0x88, 0x43, 0xf8, 0x4b, 0xe8, 0x2f, 0xa3, 0xff, 0x4f, 0x42, 0xf8, 0xe9, 0x7d, 0xdf, 0x8b, 0xdb,
+	0xd3, 0x12, 0x3b, 0x6b, 0xb3, 0x01, 0xca, 0x8a, 0xbf, 0x84, 0xbd, 0x74, 0xe4, 0xe9, 0xee, 0xe2,
+	0x2f, 0xf7, 0x61, 0x7e, 0xa7, 0xb4, 0xed, 0x42, 0x8e, 0x4b, 0xec, 0xa7, 0xd0, 0xde, 0x1f, 0xb3,
+	0x1b, 0x98, 0xf7, 0xc0, 0x65, 0x61, 0x1a, 0x2b, 0x2b, 0xb4, 0x2b, 0xe8, 0x83, 0xb6, 0x93, 0x68,
+	0xb2, 0x46, 0xc3, 0xf2, 0xfd, 0x86, 0x1f, 0x98, 0x5e, 0x00, 0x0d, 0xbb, 0x69, 0x06, 0x26, 0x55,
+	0x6e, 0x93, 0x35, 0x1e, 0x18, 0xfe, 0xe6, 0x6a, 0x60, 0x5a, 0x54, 0x07, 0x5e, 0x4b, 0x2f, 0x89,
+	0x59, 0x60, 0x3f, 0x0c, 0xc0, 0xa0, 0x54, 0x30, 0x9a, 0xb6, 0xb5, 0xb1, 0xd8, 0x30, 0x3d, 0xd3,
+	0x5d, 0xb4, 0xc3, 0xe5, 0xb2, 0xeb, 0xac, 0x85, 0x2e, 0xcb, 0xf2, 0xec, 0xfb, 0x62, 0xb5, 0xb2,
+	0xec, 0xda, 0x62, 0x4e, 0xa3, 0x85, 0xa0, 0x66, 0xd3, 0x8b, 0x42, 0xa2, 0x3e, 0xd7, 0x5c, 0x6d,
+	0x47, 0xa6, 0xf6, 0xc6, 0x9a, 0xe3, 0xf8, 0x76, 0xe0, 0xc3, 0x7f, 0x91, 0x12, 0x9e, 0x6d, 0xe6,
+	0xc0, 0xbd, 0x0f, 0xfb, 0xee, 0x7d, 0x88, 0xdd, 0xfb, 0x42, 0x8e, 0x61, 0xff, 0x8a, 0xf3, 0x15,
+	0xe7, 0xb4, 0x83, 0xeb, 0x54, 0x0c, 0x1f, 0x5f, 0x9f, 0x8c, 0xbd, 0x17, 0x42, 0x04, 0x7f, 0xbd,
+	0x43, 0x1f, 0x46, 0xe5, 0xbc, 0x84, 0x3f, 0x86, 0xc6, 0xcd, 0x04, 0xfe, 0x35, 0x09, 0xff, 0x1d,
+	0x1a, 0x9f, 0x24, 0xf0, 0x6f, 0x49, 0xf8, 0x67, 0x5a, 0xff, 0x64, 0xf0, 0x3a, 0x81, 0x7f, 0x17,
+	0x6d, 0xd5, 0x98, 0xfd, 0x83, 0xd2, 0xee, 0xff, 0x4e, 0x7c, 0xa1, 0x1d, 0x49, 0xfe, 0xaf, 0xc8,
+	0x1f, 0x49, 0xc8, 0xef, 0x49, 0xf2, 0x67, 0xf0, 0x40, 0x7b, 0x12, 0xf2, 0x3f, 0x95, 0xe4, 0x1f,
+	0x44, 0xfe, 0x8f, 0x84, 0xf3, 0x7f, 0x25, 0xe1, 0x77, 0x21, 0x70, 0x3c, 0xa1, 0x7e, 0x12, 0x7e,
+	0x34, 0xec, 0x97, 0x29, 0xe4, 0x7f, 0x81, 0xf6, 0x3e, 0xd4, 0xc8, 0xf7, 0x47, 0x11, 0x75, 0xb7,
+	0xe4, 0x03, 0x61, 0x18, 0x2f, 0xc9, 0x73, 0x09, 0xf9, 0xf3, 0x12, 0xfe, 0x1c, 0xf2, 0xdf, 0x26,
+	0xf0, 0x7f, 0x03, 0xff, 0x65, 0xb6, 0x37,
+};
+
+static RBuffer *fixture(const ut8 *data, int len) {
+	int size = 0;
+	ut8 *bytes = r_inflate (data, len, NULL, &size);
+	RBuffer *buf = bytes? r_buf_new_with_bytes (bytes, size): NULL;
+	free (bytes);
+	return buf;
+}
+
+static RBin *open_fixture(RIO *io, const ut8 *data, int len) {
+	RBin *bin = r_bin_new ();
+	r_io_bind (io, &bin->iob);
+	RBinFileOptions opt = {0};
+	RBuffer *buf = fixture (data, len);
+	if (!buf || !r_bin_open_buf (bin, buf, &opt)) {
+		r_buf_free (buf);
+		r_bin_free (bin);
+		return NULL;
+	}
+	r_buf_free (buf);
+	return bin;
+}
+
+static const RBinDwarfNameEntry *name_entry(RBinDwarfIndex *idx, const char *name, size_t i) {
+	const RVector *entries = r_bin_dwarf_index_find (idx, name);
+	return entries && i < r_vector_len (entries)? r_vector_index_ptr ((RVector *)entries, i): NULL;
+}
+
+bool test_dwarf_gdb_index(void) {
+	RIO *io = r_io_new ();
+	RBin *bin = open_fixture (io, gdb_index_elf, sizeof (gdb_index_elf));
+	mu_assert_notnull (bin, "fixture opened");
+	RBinDwarfIndex *idx = r_bin_dwarf_parse_index (bin);
+	mu_assert_notnull (idx, ".gdb_index parsed");
+	const RBinDwarfNameEntry *e = name_entry (idx, "fa", 0);
+	mu_assert_notnull (e, "function name");
+	mu_assert_eq (e->unit, 0, "unit of fa");
+	mu_assert_eq (e->die, UT64_MAX, "no die offsets in .gdb_index");
+	e = name_entry (idx, "point", 0);
+	mu_assert_notnull (e, "type name");
+	mu_assert_eq (e->unit, 0x77, "unit of point");
+	mu_assert_notnull (name_entry (idx, "int", 1), "names in both units");
+	mu_assert_null (r_bin_dwarf_index_find (idx, "missing"), "unknown name");
+	// address area
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000b0), 0, "first unit");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000c3), 0, "end of the first unit");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000c4), 0x77, "second unit");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000de), UT64_MAX, "past the units");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x1000), UT64_MAX, "before the units");
+
+	RBinDwarfDebugAbbrev *da = r_bin_dwarf_parse_abbrev (bin, R_MODE_SET);
+	mu_assert_notnull (da, "abbrevs");
+	const ut64 units[] = { 0x77 };
+	RBinDwarfDebugInfo *info = r_bin_dwarf_parse_units (da, bin, units, 1);
+	mu_assert_notnull (info, "unit parsed");
+	mu_assert_eq (info->count, 1, "only the requested unit");
+	mu_assert_eq (info->comp_units[0].offset, 0x77, "requested unit");
+	r_bin_dwarf_free_debug_info (info);
+	r_bin_dwarf_free_debug_abbrev (da);
+	r_bin_dwarf_index_free (idx);
+	r_bin_free (bin);
+	r_io_free (io);
+	mu_end;
+}
+
+bool test_dwarf_debug_names(void) {
+	RIO *io = r_io_new ();
+	RBin *bin = open_fixture (io, debug_names_elf, sizeof (debug_names_elf));
+	mu_assert_notnull (bin, "fixture opened");
+	RBinDwarfIndex *idx = r_bin_dwarf_parse_index (bin);
+	mu_assert_notnull (idx, ".debug_names parsed");
+	// one name index per unit, die offsets are made absolute
+	const RBinDwarfNameEntry *e = name_entry (idx, "fa", 0);
+	mu_assert_notnull (e, "name of the first index");
+	mu_assert_eq (e->unit, 0, "unit of fa");
+	mu_assert_eq (e->die, 0x32, "die of fa");
+	mu_assert_eq (e->tag, DW_TAG_subprogram, "tag of fa");
+	e = name_entry (idx, "fb", 0);
+	mu_assert_notnull (e, "name of the second index");
+	mu_assert_eq (e->unit, 0x42, "unit of fb");
+	mu_assert_eq (e->die, 0x65, "die of fb");
+	e = name_entry (idx, "counter", 0);
+	mu_assert_notnull (e, "variable name");
+	mu_assert_eq (e->tag, DW_TAG_variable, "tag of counter");
+	e = name_entry (idx, "int", 1);
+	mu_assert_notnull (e, "same name in both units");
+	mu_assert_eq (e->unit, 0x42, "second int");
+	mu_assert_eq (e->tag, DW_TAG_base_type, "tag of int");
+	// .debug_names has no addresses, they come from .debug_aranges
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000b0), 0, "fa");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000b6), UT64_MAX, "hole after fa");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x4000c0), 0x42, "fb");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x40010c), 0, "second range of the first set");
+	mu_assert_eq (r_bin_dwarf_index_unit_at (idx, 0x400110), UT64_MAX, "past the ranges");
+	r_bin_dwarf_index_free (idx);
+	r_bin_free (bin);
+	r_io_free (io);
+	mu_end;
+}
+
+bool test_dwarf_apply(void) {
+	char *file = r_file_temp ("dwarf_index");
+	RBuffer *buf = fixture (gdb_index_elf, sizeof (gdb_index_elf));
+	mu_assert_notnull (buf, "fixture inflated");
+	ut64 size = r_buf_size (buf);
+	ut8 *bytes = malloc (size);
+	r_buf_read_at (buf, 0, bytes, size);
+	mu_assert ("fixture written", r_file_dump (file, bytes, size, false));
+	free (bytes);
+	r_buf_free (buf);
+
+	RCore *core = r_core_new ();
+	r_config_set_b (core->config, "bin.dbginfo.lazy", true);
+	r_core_file_open (core, file, R_PERM_R, 0);
+	r_core_bin_load (core, file, 0);
+	RBinFile *bf = r_bin_cur (core->bin);
+	mu_assert_notnull (bf, "bin loaded");
+	mu_assert_notnull (bf->dwarf_index, "index loaded");
+	Sdb *dwarf_sdb = sdb_ns (core->anal->sdb, "dwarf", 0);
+	mu_assert ("no unit parsed at load", !dwarf_sdb || sdb_isempty (dwarf_sdb));
+
+	RAnalFunction *fcn = r_anal_create_function (core->anal, "fcn.fa", 0x4000b0, R_ANAL_FCN_TYPE_FCN, NULL);
+	r_anal_function_add_bb (core->anal, fcn, 0x4000b0, 0x14, UT64_MAX, UT64_MAX, NULL);
+	r_core_bin_dwarf_apply (core, fcn->addr);
+	mu_assert_streq (fcn->name, "dbg.fa", "dwarf name applied");
+	mu_assert_notnull (r_anal_function_get_var_byname (fcn, "x"), "dwarf var applied");
+	dwarf_sdb = sdb_ns (core->anal->sdb, "dwarf", 0);
+	mu_assert_notnull (dwarf_sdb, "unit parsed");
+	mu_assert_notnull (sdb_const_get (dwarf_sdb, "fcn.fa.addr", 0), "unit of fa parsed");
+	mu_assert_null (sdb_const_get (dwarf_sdb, "fcn.fb.addr", 0), "unit of fb not parsed");
+
+	// applied once, user changes are kept
+	r_anal_function_rename (fcn, "mine");
+	r_core_bin_dwarf_apply (core, fcn->addr);
+	r_core_bin_dwarf_apply (core, UT64_MAX);
+	mu_assert_streq (fcn->name, "mine", "not applied twice");
+
+	RAnalFunction *fcn2 = r_anal_create_function (core->anal, "fcn.fb", 0x4000c4, R_ANAL_FCN_TYPE_FCN, NULL);
+	r_anal_function_add_bb (core->anal, fcn2, 0x4000c4, 0x1a, UT64_MAX, UT64_MAX, NULL);
+	r_core_bin_dwarf_apply (core, UT64_MAX);
+	mu_assert_streq (fcn2->name, "dbg.fb", "second unit loaded");
+	r_core_free (core);
+	r_file_rm (file);
+	free (file);
+	mu_end;
+}
+
+static RStrBuf *printed = NULL;
+
+static int print_cb(const char *fmt, ...) {
+	va_list ap;
+	va_start (ap, fmt);
+	r_strbuf_vappendf (printed, fmt, ap);
+	va_end (ap);
+	return 0;
+}
+
+// prints every unit parsed with the given number of threads
+static char *parse_info_with(RBin *bin, RBinDwarfDebugAbbrev *da, int threads, const ut64 *units, size_t count) {
+	bin->dwarf_threads = threads;
+	printed = r_strbuf_new ("");
+	bin->cb_printf = print_cb;
+	RBinDwarfDebugInfo *info = units
+		? r_bin_dwarf_parse_units (da, bin, units, count)
+		: r_bin_dwarf_parse_info (da, bin, R_MODE_PRINT);
+	size_t i;
+	for (i = 0; units && info && i < info->count; i++) {
+		r_strbuf_appendf (printed, "unit 0x%"PFMT64x" %"PFMT64d" dies\n",
+			info->comp_units[i].offset, (ut64)info->comp_units[i].count);
+	}
+	char *res = info? r_strbuf_drain (printed): NULL;
+	if (!info) {
+		r_strbuf_free (printed);
+	}
+	printed = NULL;
+	r_bin_dwarf_free_debug_info (info);
+	return res;
+}
+
+bool test_dwarf_units_threads(void) {
+	RIO *io = r_io_new ();
+	RBin *bin = open_fixture (io, gdb_index_elf, sizeof (gdb_index_elf));
+	mu_assert_notnull (bin, "fixture opened");
+	RBinDwarfDebugAbbrev *da = r_bin_dwarf_parse_abbrev (bin, R_MODE_SET);
+	mu_assert_notnull (da, "abbrevs");
+	// the section is small, 0 parses it serially like 1 does
+	char *serial = parse_info_with (bin, da, 1, NULL, 0);
+	mu_assert_notnull (serial, "serial parse");
+	mu_assert_notnull (strstr (serial, "DW_AT_name"), "dies printed");
+	mu_assert_notnull (strstr (serial, "offset 0x77:"), "second unit printed");
+	char *bysize = parse_info_with (bin, da, 0, NULL, 0);
+	char *threaded = parse_info_with (bin, da, 4, NULL, 0);
+	mu_assert_streq (bysize, serial, "small sections are parsed serially");
+	mu_assert_streq (threaded, serial, "one thread per unit");
+
+	const ut64 units[] = { 0x77, 0 };
+	char *some = parse_info_with (bin, da, 1, units, 2);
+	char *tsome = parse_info_with (bin, da, 4, units, 2);
+	mu_assert_notnull (some, "units parsed");
+	mu_assert_streq (tsome, some, "same units with threads");
+	free (serial);
+	free (bysize);
+	free (threaded);
+	free (some);
+	free (tsome);
+	r_bin_dwarf_free_debug_abbrev (da);
+	r_bin_free (bin);
+	r_io_free (io);
+	mu_end;
+}
+
+int all_tests(void) {
+	mu_run_test (test_dwarf_gdb_index);
+	mu_run_test (test_dwarf_debug_names);
+	mu_run_test (test_dwarf_apply);
+	mu_run_test (test_dwarf_units_threads);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
@@ -0,0 +1,173 @@
+#include <r_core.h>
+#include "minunit.h"
+
+// a dyld shared cache with one image and a data mapping of two pages, the
+// first one holds a chain of two pointers rebased with the v2 slide info
+#define DATA_OFF 0x2000
+#define DATA_SIZE 0x2000
+#define SLIDE_OFF (DATA_OFF + DATA_SIZE)
+#define CACHE_SIZE (SLIDE_OFF + 0x100)
+#define DELTA_MASK 0x00ffff0000000000ULL
+// the delta to the next pointer is stored in 4 byte units
+#define CHAIN(value, next) ((value) | (((ut64)(next) / 4) << 40))
+
+static char *files[2] = { NULL };
+
+static bool write_cache(const char *path) {
+	ut8 *buf = calloc (1, CACHE_SIZE);
+	if (!buf) {
+		return false;
+	}
+	// header
+	memcpy (buf, "dyld_v1   arm64", 16);
+	r_write_le32 (buf + 0x10, 0x100); // mappingOffset
+	r_write_le32 (buf + 0x14, 2); // mappingCount
+	r_write_le32 (buf + 0x18, 0x180); // imagesOffset
+	r_write_le32 (buf + 0x1c, 1); // imagesCount
+	r_write_le64 (buf + 0x28, CACHE_SIZE); // codeSignatureOffset
+	r_write_le64 (buf + 0x38, SLIDE_OFF); // slideInfoOffset
+	r_write_le64 (buf + 0x40, 0x100); // slideInfoSize
+	// mappings: address, size, fileOffset, maxProt, initProt
+	r_write_le64 (buf + 0x100, 0x10000);
+	r_write_le64 (buf + 0x108, DATA_OFF);
+	r_write_le64 (buf + 0x110, 0);
+	r_write_le32 (buf + 0x118, 5);
+	r_write_le32 (buf + 0x11c, 5);
+	r_write_le64 (buf + 0x120, 0x20000);
+	r_write_le64 (buf + 0x128, DATA_SIZE);
+	r_write_le64 (buf + 0x130, DATA_OFF);
+	r_write_le32 (buf + 0x138, 3);
+	r_write_le32 (buf + 0x13c, 3);
+	// image: address, modTime, inode, pathFileOffset
+	r_write_le64 (buf + 0x180, 0x11000);
+	r_write_le32 (buf + 0x198, 0x1c0);
+	strcpy ((char *)buf + 0x1c0, "/usr/lib/libtest.dylib");
+	// an empty arm64 dylib
+	r_write_le32 (buf + 0x1000, 0xfeedfacf);
+	r_write_le32 (buf + 0x1004, 0x0100000c);
+	r_write_le32 (buf + 0x100c, 6);
+	// the pointers, the second page is not rebased
+	r_write_le64 (buf + DATA_OFF, CHAIN (0x20100, 8));
+	r_write_le64 (buf + DATA_OFF + 8, CHAIN (0x20200, 0));
+	r_write_le64 (buf + DATA_OFF + 0x1000, CHAIN (0x20300, 0));
+	// slide info v2: version, page_size, page_starts_offset/count,
+	// page_extras_offset/count, delta_mask and value_add
+	ut8 *si = buf + SLIDE_OFF;
+	r_write_le32 (si, 2);
+	r_write_le32 (si + 4, 0x1000);
+	r_write_le32 (si + 8, 0x28);
+	r_write_le32 (si + 0xc, 2);
+	r_write_le32 (si + 0x10, 0x2c);
+	r_write_le64 (si + 0x18, DELTA_MASK);
+	r_write_le16 (si + 0x28, 0); // the first pointer is at the page start
+	r_write_le16 (si + 0x2a, 0x4000); // DYLD_CACHE_SLIDE_PAGE_ATTR_NO_REBASE
+	bool ret = r_file_dump (path, buf, CACHE_SIZE, false);
+	free (buf);
+	return ret;
+}
+
+static RCore *open_cache(const char *path) {
+	RCore *core = r_core_new ();
+	r_core_file_open (core, path, R_PERM_RW, 0);
+	r_core_bin_load (core, path, 0);
+	return core;
+}
+
+static ut64 read_ptr(RCore *core, ut64 at) {
+	ut8 buf[8] = {0};
+	r_io_pread_at (core->io, at, buf, sizeof (buf));
+	return r_read_le64 (buf);
+}
+
+static bool setup(void) {
+	int i;
+	for (i = 0; i < 2; i++) {
+		files[i] = r_file_temp ("dyldcache");
+		if (!files[i] || !write_cache (files[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void teardown(void) {
+	int i;
+	for (i = 0; i < 2; i++) {
+		r_file_rm (files[i]);
+		R_FREE (files[i]);
+	}
+}
+
+bool test_dyldcache_rebase(void) {
+	RCore *core = open_cache (files[0]);
+	RBinFile *bf = r_bin_cur (core->bin);
+	mu_assert ("dyld cache loaded", bf && bf->o && bf->o->plugin);
+	mu_assert_streq (bf->o->plugin->name, "dyldcache", "dyld cache plugin");
+	mu_assert_eq (read_ptr (core, DATA_OFF), 0x20100, "first pointer rebased");
+	mu_assert_eq (read_ptr (core, DATA_OFF + 8), 0x20200, "chained pointer rebased");
+	mu_assert_eq (read_ptr (core, DATA_OFF + 0x1000), CHAIN (0x20300, 0), "page without rebases");
+	ut8 buf[0x20];
+	mu_assert_eq (r_io_pread_at (core->io, DATA_OFF - 0x10, buf, sizeof (buf)), sizeof (buf), "read across mappings");
+	mu_assert_eq (r_read_le64 (buf + 0x10), 0x20100, "rebased from the middle of a read");
+	// the page is cached, it must not be rebased twice
+	mu_assert_eq (read_ptr (core, DATA_OFF), 0x20100, "cached page");
+	r_core_free (core);
+	mu_end;
+}
+
+bool test_dyldcache_write(void) {
+	RCore *core = open_cache (files[0]);
+	mu_assert_eq (read_ptr (core, DATA_OFF + 8), 0x20200, "page cached");
+	ut8 ptr[8];
+	r_write_le64 (ptr, CHAIN (0x20400, 0));
+	mu_assert ("written", r_io_pwrite_at (core->io, DATA_OFF + 8, ptr, sizeof (ptr)) == sizeof (ptr));
+	mu_assert_eq (read_ptr (core, DATA_OFF + 8), 0x20400, "written page is rebased again");
+	mu_assert_eq (read_ptr (core, DATA_OFF), 0x20100, "rest of the page");
+	r_write_le64 (ptr, CHAIN (0x20200, 0));
+	r_io_pwrite_at (core->io, DATA_OFF + 8, ptr, sizeof (ptr));
+	r_core_free (core);
+	mu_end;
+}
+
+bool test_dyldcache_by_desc(void) {
+	RCore *a = open_cache (files[0]);
+	RCore *b = open_cache (files[1]);
+	// both files get the same fd number in their own io
+	mu_assert_eq (a->io->desc->fd, b->io->desc->fd, "same fd");
+	ut8 ptr[8];
+	r_write_le64 (ptr, CHAIN (0x20500, 0));
+	r_io_pwrite_at (b->io, DATA_OFF + 8, ptr, sizeof (ptr));
+	mu_assert_eq (read_ptr (a, DATA_OFF + 8), 0x20200, "first cache");
+	mu_assert_eq (read_ptr (b, DATA_OFF + 8), 0x20500, "second cache");
+	r_core_free (b);
+	mu_assert_eq (read_ptr (a, DATA_OFF + 8), 0x20200, "still rebased after the other cache is freed");
+
+	// files opened after a cache with the same io plugin are read as they are
+	char *plain = r_file_temp ("plain");
+	r_file_dump (plain, (const ut8 *)"plainbytes", 10, false);
+	RCore *c = r_core_new ();
+	r_core_file_open (c, plain, R_PERM_R, 0);
+	char buf[11] = {0};
+	mu_assert_eq (r_io_pread_at (c->io, 0, (ut8 *)buf, 10), 10, "plain file read");
+	mu_assert_streq (buf, "plainbytes", "plain bytes");
+	r_core_free (c);
+	r_core_free (a);
+	r_file_rm (plain);
+	free (plain);
+	mu_end;
+}
+
+int all_tests() {
+	if (!setup ()) {
+		return 1;
+	}
+	mu_run_test (test_dyldcache_rebase);
+	mu_run_test (test_dyldcache_write);
+	mu_run_test (test_dyldcache_by_desc);
+	teardown ();
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
@@ -0,0 +1,127 @@
+#include <r_core.h>
+#include "minunit.h"
+
+// the expected outputs were taken from the tracer that kept the log in an sdb
+
+static RCore *open_core(const char *arch, int bits, const char *code) {
+	RCore *core = r_core_new ();
+	r_core_file_open (core, "malloc://256", R_PERM_RWX, 0);
+	r_core_bin_load (core, NULL, 0);
+	r_config_set_i (core->config, "scr.color", 0);
+	r_config_set (core->config, "asm.arch", arch);
+	r_config_set_i (core->config, "asm.bits", bits);
+	r_core_cmdf (core, "wx %s", code);
+	return core;
+}
+
+static RCore *trace_gb(void) {
+	// ld a, 0x12; ld [0xc000], a; ld a, [0xc000]; ld b, a; add b; ret
+	RCore *core = open_core ("gb", 16, "3e12ea00c0fa00c04780c9");
+	r_core_cmd0 (core, "aei;aeim;dtei;dtei 2;dtei 5;dtei 8;dtei 9");
+	return core;
+}
+
+bool test_esil_trace_list(void) {
+	RCore *core = trace_gb ();
+	mu_assert_streq_free (r_core_cmd_str (core, "dte"),
+		"0.addr=0\n"
+		"0.reg.write=a\n"
+		"0.reg.write.a=0x12\n"
+		"1.addr=0x2\n"
+		"1.mem.write=0xc000\n"
+		"1.mem.write.data.0xc000=12\n"
+		"1.reg.read=a\n"
+		"1.reg.read.a=0x12\n"
+		"2.addr=0x5\n"
+		"2.mem.read=0xc000\n"
+		"2.mem.read.data.0xc000=ff\n"
+		"2.reg.write=a\n"
+		"2.reg.write.a=0xff\n"
+		"3.addr=0x8\n"
+		"3.reg.read=a\n"
+		"3.reg.read.a=0xff\n"
+		"3.reg.write=b\n"
+		"3.reg.write.b=0xff\n"
+		"4.addr=0x9\n"
+		"4.reg.read=b,a\n"
+		"4.reg.read.a=0xff\n"
+		"4.reg.read.b=0xff\n"
+		"4.reg.write=a,Z,H,C,N\n"
+		"4.reg.write.C=0x1\n"
+		"4.reg.write.H=0x1\n"
+		"4.reg.write.N=0\n"
+		"4.reg.write.Z=0\n"
+		"4.reg.write.a=0x1fe\n"
+		"idx=4\n", "trace log");
+	mu_assert_streq_free (r_core_cmd_str (core, "dte 2"), "ar PC = 0x5\nwx ff @ 0xc000\n", "memory read by a step");
+	mu_assert_streq_free (r_core_cmd_str (core, "dte 4"), "ar PC = 0x9\nar b = 0xff\nar a = 0xff\n", "registers read by a step");
+	mu_assert_streq_free (r_core_cmd_str (core, "dte 5"), "", "no such step");
+	r_core_free (core);
+	mu_end;
+}
+
+bool test_esil_trace_query(void) {
+	RCore *core = trace_gb ();
+	mu_assert_streq_free (r_core_cmd_str (core, "dtek 2.mem.read.data.0xc000"), "ff\n\n", "memory read");
+	mu_assert_streq_free (r_core_cmd_str (core, "dtek 4.reg.read"), "b,a\n\n", "registers read");
+	mu_assert_streq_free (r_core_cmd_str (core, "dtek *~mem"),
+		"1.mem.write=0xc000\n"
+		"1.mem.write.data.0xc000=12\n"
+		"2.mem.read=0xc000\n"
+		"2.mem.read.data.0xc000=ff\n", "all the memory accesses");
+	r_core_free (core);
+	mu_end;
+}
+
+bool test_esil_trace_clear(void) {
+	RCore *core = trace_gb ();
+	RAnalEsilTrace *trace = core->anal->esil->trace;
+	r_core_cmd0 (core, "dte-*");
+	mu_assert ("the trace is kept", core->anal->esil->trace == trace);
+	mu_assert_streq_free (r_core_cmd_str (core, "dte"), "", "log dropped");
+	// the next steps keep their trace index
+	r_core_cmd0 (core, "dtei 10");
+	mu_assert_streq_free (r_core_cmd_str (core, "dte"),
+		"5.addr=0xa\n"
+		"5.mem.read=0x8000\n"
+		"5.mem.read.data.0x8000=ffff\n"
+		"5.reg.read=sp\n"
+		"5.reg.read.sp=0x8000\n"
+		"5.reg.write=pc,sp\n"
+		"5.reg.write.pc=0xffff\n"
+		"5.reg.write.sp=0x8002\n"
+		"idx=0x5\n", "steps after the clear");
+	// the changes before the clear can still be stepped back
+	r_core_cmd0 (core, "aesb;aesb");
+	mu_assert_eq (r_reg_getv (core->anal->reg, "PC"), 0x9, "stepped back");
+	r_core_free (core);
+	mu_end;
+}
+
+bool test_esil_trace_aaft(void) {
+	// a mips function passing a stack buffer to strlen
+	RCore *core = open_core ("mips.gnu", 32,
+		"e0ffbd271c00bfaf1000a4271000000c000000001800a2af1c00bf8f2000bd270800e00300000000");
+	r_core_cmd0 (core, "wx 0800e00300000000 @ 0x40");
+	r_core_cmd0 (core, "tcc v0 o32(a0,a1,a2,a3);e anal.cc=o32");
+	r_core_cmd0 (core, "af @ 0x40;afn strlen @ 0x40;af @ 0;aaft");
+	mu_assert_streq_free (r_core_cmd_str (core, "afv @ 0"),
+		"arg int32_t arg1 @ a0\n"
+		"arg char * s @ sp+0x10\n"
+		"arg int32_t arg_18h @ sp+0x18\n"
+		"arg int32_t arg_1ch @ sp+0x1c\n", "argument typed from the callee");
+	r_core_free (core);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_esil_trace_list);
+	mu_run_test (test_esil_trace_query);
+	mu_run_test (test_esil_trace_clear);
+	mu_run_test (test_esil_trace_aaft);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
@@ -128,10 +128,76 @@ bool test_r_flag_get_at() {
 	mu_end;
 }
 
+bool test_r_flag_bulk(void) {
+	RFlag *flag = r_flag_new ();
+	r_flag_bulk_begin (flag);
+	RFlagItem *c = r_flag_set (flag, "c", 0x300, 0);
+	RFlagItem *a = r_flag_set (flag, "a", 0x100, 0);
+	RFlagItem *b = r_flag_set (flag, "b", 0x200, 0);
+	RFlagItem *a2 = r_flag_set (flag, "a2", 0x100, 0);
+	mu_assert_ptreq (r_flag_get (flag, "b"), b, "name lookups work in bulk mode");
+	mu_assert_ptreq (r_flag_get_i (flag, 0x300), c, "offset lookups flush the pending flags");
+	RFlagItem *d = r_flag_set (flag, "d", 0x50, 0);
+	r_flag_bulk_end (flag);
+
+	const RList *list = r_flag_get_list (flag, 0x100);
+	mu_assert_eq (r_list_length (list), 2, "two flags at 0x100");
+	mu_assert_ptreq (r_list_first (list), a, "insertion order is kept");
+	mu_assert_ptreq (r_list_last (list), a2, "insertion order is kept");
+	mu_assert_ptreq (r_flag_get_at (flag, 0x60, true), d, "flag added after the flush");
+	mu_assert_eq (r_flag_count (flag, NULL), 5, "all flags indexed");
+
+	r_flag_item_set_comment (a, "hello");
+	mu_assert_streq (r_flag_item_comment (a), "hello", "comment");
+	r_flag_item_set_comment (a, NULL);
+	mu_assert_null (a->meta, "meta is released when empty");
+	mu_assert_true (r_flag_rename (flag, a, "renamed"), "rename");
+	mu_assert_null (r_flag_get (flag, "a"), "old name is gone");
+	mu_assert_ptreq (r_flag_get (flag, "renamed"), a, "new name");
+
+	r_flag_free (flag);
+	mu_end;
+}
+
+static bool check_order(RFlagItem *fi, void *user) {
+	ut64 *last = user;
+	if (fi->offset < *last) {
+		return false;
+	}
+	*last = fi->offset;
+	return true;
+}
+
+bool test_r_flag_many(void) {
+	RFlag *flag = r_flag_new ();
+	char name[32];
+	int i;
+	// spans several index blocks, inserted out of order
+	for (i = 0; i < 2000; i++) {
+		ut64 off = ((i * 7919) % 2000) * 0x10;
+		snprintf (name, sizeof (name), "f%d", i);
+		r_flag_set (flag, name, off, 4);
+	}
+	for (i = 0; i < 2000 * 0x10; i += 0x8) {
+		RFlagItem *fi = r_flag_get_at (flag, i, true);
+		mu_assert_notnull (fi, "closest flag");
+		mu_assert_eq (fi->offset, i & ~0xf, "closest flag offset");
+	}
+	ut64 last = 0;
+	r_flag_foreach (flag, check_order, &last);
+	mu_assert_eq (last, 1999 * 0x10, "foreach walks all flags by offset");
+	mu_assert_eq (r_flag_unset_glob (flag, "f1*"), 1111, "unset while iterating");
+	mu_assert_eq (r_flag_count (flag, NULL), 889, "remaining flags");
+	r_flag_free (flag);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test (test_r_flag_get_set);
 	mu_run_test (test_r_flag_by_spaces);
 	mu_run_test (test_r_flag_get_at);
+	mu_run_test (test_r_flag_bulk);
+	mu_run_test (test_r_flag_many);
 	return tests_passed != tests_run;
 }
 
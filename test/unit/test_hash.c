@@ -0,0 +1,193 @@
+#include <r_hash.h>
+#include <r_util.h>
+#include <math.h>
+#include "minunit.h"
+
+static ut8 *random_bytes(size_t size) {
+	ut8 *buf = malloc (size);
+	size_t i;
+	ut32 x = 1234;
+	for (i = 0; buf && i < size; i++) {
+		x = x * 1103515245 + 12345;
+		// skew the distribution and leave some runs of zeros
+		buf[i] = (i % 4096 < 512)? 0: (ut8)((x >> 16) % (1 + i % 251));
+	}
+	return buf;
+}
+
+bool test_r_hash_histogram(void) {
+	const size_t size = 100003; // not a multiple of the word size
+	ut8 *buf = random_bytes (size);
+	ut64 count[256], expect[256] = {0};
+	size_t i;
+	for (i = 0; i < size; i++) {
+		expect[buf[i]]++;
+	}
+	r_hash_histogram (buf, size, count);
+	for (i = 0; i < 256; i++) {
+		mu_assert_eq (count[i], expect[i], "histogram count");
+	}
+	r_hash_histogram (buf, 5, count);
+	mu_assert_eq (count[0], 5, "short histogram");
+	r_hash_histogram (buf, 0, count);
+	mu_assert_eq (count[0], 0, "empty histogram");
+	mu_assert_eq (r_hash_pcprint ((const ut8 *)"ab\x01\x02", 4), 50, "printable percentage");
+	free (buf);
+	mu_end;
+}
+
+bool test_r_hash_entropy(void) {
+	ut8 buf[256];
+	int i;
+	for (i = 0; i < 256; i++) {
+		buf[i] = i;
+	}
+	mu_assert ("uniform entropy", fabs (r_hash_entropy (buf, sizeof (buf)) - 8.0) < 1e-9);
+	mu_assert ("uniform entropy fraction", fabs (r_hash_entropy_fraction (buf, sizeof (buf)) - 1.0) < 1e-9);
+	memset (buf, 'A', sizeof (buf));
+	mu_assert ("constant entropy", r_hash_entropy (buf, sizeof (buf)) == 0.0);
+	mu_end;
+}
+
+bool test_r_hash_entropy_fraction_blocks(void) {
+	// big enough to be split between threads
+	const ut64 bsize = 4096;
+	const size_t nblocks = 1000;
+	ut8 *buf = random_bytes (bsize * nblocks);
+	double *e = R_NEWS (double, nblocks);
+	size_t i;
+	r_hash_entropy_fraction_blocks (buf, bsize, nblocks, e);
+	for (i = 0; i < nblocks; i++) {
+		double expect = r_hash_entropy_fraction (buf + i * bsize, bsize);
+		mu_assert ("block entropy", e[i] == expect);
+	}
+	free (buf);
+	free (e);
+	mu_end;
+}
+
+static ut8 *pattern_bytes(size_t size) {
+	ut8 *buf = malloc (size);
+	size_t i;
+	for (i = 0; buf && i < size; i++) {
+		buf[i] = (ut8)(i * 7 + (i >> 8));
+	}
+	return buf;
+}
+
+// the textbook bit at a time crc, to check the table and hardware paths
+static utcrc crc_bitwise(const ut8 *data, ut32 len, ut32 size, int reflect, utcrc poly, utcrc init, utcrc xout) {
+	const utcrc top = UTCRC_C(1) << (size - 1);
+	const utcrc mask = ((top - 1) << 1) | 1;
+	utcrc crc = init, r = 0;
+	ut32 i, j;
+	for (i = 0; i < len; i++) {
+		for (j = 0; j < 8; j++) {
+			int bit = reflect? (data[i] >> j) & 1: (data[i] >> (7 - j)) & 1;
+			bool msb = (crc & top) != 0;
+			crc <<= 1;
+			if (msb ^ bit) {
+				crc ^= poly;
+			}
+		}
+	}
+	crc &= mask;
+	if (reflect) {
+		for (i = 0; i < size; i++, crc >>= 1) {
+			r = (r << 1) | (crc & 1);
+		}
+		crc = r;
+	}
+	return crc ^ xout;
+}
+
+bool test_r_hash_crc(void) {
+	const ut32 lens[] = { 1, 9, 63, 64, 65, 255, 256, 257, 1000, 4099 };
+	const struct {
+		enum CRC_PRESETS preset;
+		ut32 size;
+		int reflect;
+		utcrc poly, init, xout;
+	} algos[] = {
+		{ CRC_PRESET_8_SMBUS, 8, 0, 0x07, 0, 0 },
+		{ CRC_PRESET_16, 16, 1, 0x8005, 0, 0 },
+		{ CRC_PRESET_16_CITT, 16, 0, 0x1021, 0xffff, 0 },
+		{ CRC_PRESET_24, 24, 0, 0x864cfb, 0xb704ce, 0 },
+		{ CRC_PRESET_32, 32, 1, 0x04c11db7, 0xffffffff, 0xffffffff },
+		{ CRC_PRESET_32C, 32, 1, 0x1edc6f41, 0xffffffff, 0xffffffff },
+		{ CRC_PRESET_CRC32_BZIP2, 32, 0, 0x04c11db7, 0xffffffff, 0xffffffff },
+		{ CRC_PRESET_CRC64, 64, 0, 0x42f0e1eba9ea3693ULL, 0, 0 },
+		{ CRC_PRESET_CRC64_XZ, 64, 1, 0x42f0e1eba9ea3693ULL, UT64_MAX, UT64_MAX },
+	};
+	ut8 *buf = pattern_bytes (4099);
+	size_t i, j;
+	mu_assert_eq (r_hash_crc_preset ((const ut8 *)"123456789", 9, CRC_PRESET_32), 0xcbf43926, "crc32 check");
+	mu_assert_eq (r_hash_crc_preset ((const ut8 *)"123456789", 9, CRC_PRESET_32C), 0xe3069283, "crc32c check");
+	mu_assert_eq (r_hash_crc_preset (buf, 1000, CRC_PRESET_32), 0x668f073d, "crc32 of 1000 bytes");
+	for (i = 0; i < R_ARRAY_SIZE (algos); i++) {
+		for (j = 0; j < R_ARRAY_SIZE (lens); j++) {
+			utcrc expect = crc_bitwise (buf, lens[j], algos[i].size, algos[i].reflect,
+				algos[i].poly, algos[i].init, algos[i].xout);
+			mu_assert_eq (r_hash_crc_preset (buf, lens[j], algos[i].preset), expect, "crc differs from the bitwise one");
+		}
+	}
+	free (buf);
+	mu_end;
+}
+
+static char *sha_hex(RHash *ctx, ut64 algo, const ut8 *buf, int len, int step) {
+	int i;
+	r_hash_do_begin (ctx, algo);
+	for (i = 0; i < len; i += step) {
+		int n = R_MIN (step, len - i);
+		if (algo == R_HASH_SHA1) {
+			r_hash_do_sha1 (ctx, buf + i, n);
+		} else {
+			r_hash_do_sha256 (ctx, buf + i, n);
+		}
+	}
+	r_hash_do_end (ctx, algo);
+	return r_hex_bin2strdup (ctx->digest, r_hash_size (algo));
+}
+
+bool test_r_hash_sha(void) {
+	const int steps[] = { 100000, 1, 63, 64, 65, 4096, 9999 };
+	RHash *ctx = r_hash_new (false, R_HASH_SHA1 | R_HASH_SHA256);
+	ut8 *buf = pattern_bytes (100000);
+	size_t i;
+	char *s = sha_hex (ctx, R_HASH_SHA1, buf, 1000, 1000);
+	mu_assert_streq_free (s, "36b3862969aef72235b9f6aadcf795eefeacd183", "sha1 of 1000 bytes");
+	s = sha_hex (ctx, R_HASH_SHA256, buf, 1000, 1000);
+	mu_assert_streq_free (s, "c85a431e0fe575b2609289d3a4042414715f400612575a125d2ce5573d608732", "sha256 of 1000 bytes");
+	// bulk blocks and byte at a time updates must agree
+	for (i = 0; i < R_ARRAY_SIZE (steps); i++) {
+		s = sha_hex (ctx, R_HASH_SHA1, buf, 100000, steps[i]);
+		mu_assert_streq_free (s, "557878b8118e7a9bdc75bcfc419f9b082ce073e6", "sha1 by steps");
+		s = sha_hex (ctx, R_HASH_SHA256, buf, 100000, steps[i]);
+		mu_assert_streq_free (s, "55af394c980c7a7fb68aa904c4afdd93d76e5f826487105fc06f92a25bab8cbe", "sha256 by steps");
+	}
+	free (buf);
+	r_hash_free (ctx);
+	mu_end;
+}
+
+bool all_tests() {
+	mu_run_test (test_r_hash_histogram);
+	mu_run_test (test_r_hash_entropy);
+	mu_run_test (test_r_hash_entropy_fraction_blocks);
+	mu_run_test (test_r_hash_crc);
+	mu_run_test (test_r_hash_sha);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	int ret = all_tests ();
+	// the backends are picked once per process, run again on the portable code
+	if (!r_sys_getenv_asbool ("R2_HASH_NOHW")) {
+		r_sys_setenv ("R2_HASH_NOHW", "1");
+		if (r_sys_cmd (argv[0])) {
+			ret = 1;
+		}
+	}
+	return ret;
+}
@@ -160,6 +160,37 @@ TEST_IN (test_r_interval_tree_in_end_inclusive_point, true, false)
 TEST_IN (test_r_interval_tree_in_end_exclusive_interval, false, true)
 TEST_IN (test_r_interval_tree_in_end_inclusive_interval, true, true)
 
+bool test_r_interval_tree_first_from() {
+	RIntervalTree tree;
+	r_interval_tree_init (&tree, NULL);
+	RIntervalTreeIter it = r_interval_tree_first_from (&tree, 0);
+	mu_assert ("empty", !r_rbtree_iter_has (&it));
+
+	ut64 starts[] = { 40, 10, 30, 30, 20, 50, 30 };
+	size_t i;
+	for (i = 0; i < R_ARRAY_SIZE (starts); i++) {
+		r_interval_tree_insert (&tree, starts[i], starts[i] + 5, NULL);
+	}
+	ut64 prev = 0;
+	size_t count = 0;
+	it = r_interval_tree_first_from (&tree, 25);
+	while (r_rbtree_iter_has (&it)) {
+		RIntervalNode *node = r_interval_tree_iter_get (&it);
+		mu_assert ("from", node->start >= 25 && node->start >= prev);
+		prev = node->start;
+		count++;
+		r_rbtree_iter_next (&it);
+	}
+	mu_assert_eq (count, 5, "all nodes from 25");
+	it = r_interval_tree_first_from (&tree, 30);
+	mu_assert_eq (r_interval_tree_iter_get (&it)->start, 30, "exact start");
+	it = r_interval_tree_first_from (&tree, 51);
+	mu_assert ("past the end", !r_rbtree_iter_has (&it));
+
+	r_interval_tree_fini (&tree);
+	mu_end;
+}
+
 bool test_r_interval_tree_all_at() {
 	RIntervalTree tree;
 	r_interval_tree_init (&tree, NULL);
@@ -325,6 +356,7 @@ int all_tests() {
 	mu_run_test (test_r_interval_tree_in_end_exclusive_interval);
 	mu_run_test (test_r_interval_tree_in_end_inclusive_interval);
 	mu_run_test (test_r_interval_tree_all_at);
+	mu_run_test (test_r_interval_tree_first_from);
 	mu_run_test (test_r_interval_tree_node_at_data);
 	mu_run_test (test_r_interval_tree_delete);
 	mu_run_test (test_r_interval_tree_resize_start_and_end);
@@ -0,0 +1,134 @@
+#include <r_parse.h>
+#include "minunit.h"
+
+static RParse *setup(RAnal *anal) {
+	RParse *p = r_parse_new ();
+	r_anal_bind (anal, &p->analb);
+	r_reg_set_profile_string (anal->reg,
+		"=PC pc\n=SP sp\n=A0 a0\n=A1 a1\n"
+		"gpr pc .32 0 0\ngpr sp .32 4 0\ngpr a0 .32 8 0\ngpr a1 .32 12 0\ngpr t0 .32 16 0\n");
+	return p;
+}
+
+bool test_r_parse_tokenize(void) {
+	RAnal *anal = r_anal_new ();
+	RParse *p = setup (anal);
+	RVector tokens;
+	r_vector_init (&tokens, sizeof (RParseToken), NULL, NULL);
+	const char *s = "lw a0, 0xa0(sp)";
+	mu_assert ("tokenize", r_parse_tokenize (p, s, &tokens));
+	mu_assert_eq (r_vector_len (&tokens), 9, "token count");
+	RParseToken *t = r_vector_index_ptr (&tokens, 0);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_MNEMONIC, "mnemonic");
+	t = r_vector_index_ptr (&tokens, 2);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_REGISTER, "a0 is a register");
+	mu_assert_eq (t->role, R_REG_NAME_A0, "a0 role");
+	t = r_vector_index_ptr (&tokens, 5);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_NUMBER, "immediate");
+	mu_assert_eq (t->len, 4, "immediate length");
+	t = r_vector_index_ptr (&tokens, 7);
+	mu_assert_eq (t->role, R_REG_NAME_SP, "sp role");
+
+	s = "\x1b[33mjal\x1b[0m foo, t0";
+	mu_assert ("tokenize colors", r_parse_tokenize (p, s, &tokens));
+	mu_assert_eq (r_vector_len (&tokens), 8, "colored token count");
+	t = r_vector_index_ptr (&tokens, 0);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_ANSI, "ansi");
+	mu_assert_eq (t->len, 5, "ansi length");
+	t = r_vector_index_ptr (&tokens, 1);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_MNEMONIC, "colored mnemonic");
+	t = r_vector_index_ptr (&tokens, 4);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_SYMBOL, "foo is a symbol");
+	t = r_vector_index_ptr (&tokens, 7);
+	mu_assert_eq (t->type, R_PARSE_TOKEN_REGISTER, "t0 is a register");
+	mu_assert_eq (t->role, -1, "t0 has no role");
+
+	r_vector_fini (&tokens);
+	r_parse_free (p);
+	r_anal_free (anal);
+	mu_end;
+}
+
+bool test_r_parse_filter_subreg(void) {
+	RAnal *anal = r_anal_new ();
+	RParse *p = setup (anal);
+	char str[64];
+	char data[64];
+	p->subreg = true;
+	strcpy (data, "lw a0, 0xa0(sp)");
+	r_parse_filter (p, 0, NULL, NULL, data, str, sizeof (str), false);
+	mu_assert_streq (str, "lw A0, 0xa0(SP)", "registers replaced, numbers untouched");
+	strcpy (data, "mv a1, spare");
+	r_parse_filter (p, 0, NULL, NULL, data, str, sizeof (str), false);
+	mu_assert_streq (str, "mv A1, spare", "only whole words are replaced");
+	strcpy (data, "auipc t0, 0");
+	r_parse_filter (p, 0, NULL, NULL, data, str, sizeof (str), false);
+	mu_assert_streq (str, "auipc t0, 0", "nothing to replace");
+	r_parse_free (p);
+	r_anal_free (anal);
+	mu_end;
+}
+
+static RFlagItem *no_flag(RFlag *f, ut64 addr) {
+	return NULL;
+}
+
+// the nth number found in the opcode is printed in decimal
+static char *filter_nth(RParse *p, const char *s, int nth, char *str, int len) {
+	RAnalHint hint = { .immbase = 10, .nword = nth };
+	char *data = strdup (s);
+	r_parse_filter (p, 0, NULL, &hint, data, str, len, false);
+	free (data);
+	return str;
+}
+
+bool test_r_parse_filter_numbers(void) {
+	RAnal *anal = r_anal_new ();
+	RParse *p = setup (anal);
+	char str[64];
+	mu_assert_streq (filter_nth (p, "lw a0, 0xa0(sp)", 0, str, sizeof (str)), "lw a0, 160(sp)", "operand");
+	mu_assert_streq (filter_nth (p, "sw t0, [0x10]", 0, str, sizeof (str)), "sw t0, [16]", "memory operand");
+	mu_assert_streq (filter_nth (p, "b foo[0x10], 0x20", 0, str, sizeof (str)), "b foo[0x10], 32", "not an operand");
+	mu_assert_streq (filter_nth (p, "addi a0, a0, -0x8", 0, str, sizeof (str)), "addi a0, a0, -8", "negative");
+	mu_assert_streq (filter_nth (p, "li a1, 0x10, 0x20", 1, str, sizeof (str)), "li a1, 0x10, 32", "second number");
+	mu_assert_streq (filter_nth (p, "li r8, a1+0x10", 0, str, sizeof (str)), "li r8, a1+0x10", "no operand numbers");
+	mu_assert_streq (filter_nth (p, "\x1b[33mli\x1b[0m a1, \x1b[33m0x10\x1b[0m", 0, str, sizeof (str)),
+		"\x1b[33mli\x1b[0m a1, \x1b[33m16\x1b[0m", "colored");
+
+	// the register substitution and the number filter share the tokens
+	p->subreg = true;
+	mu_assert_streq (filter_nth (p, "lw a0, 0xa0(sp)", 0, str, sizeof (str)), "lw A0, 160(SP)", "substituted and filtered");
+	r_parse_free (p);
+	r_anal_free (anal);
+	mu_end;
+}
+
+bool test_r_parse_filter_subtail(void) {
+	RAnal *anal = r_anal_new ();
+	RParse *p = setup (anal);
+	RFlag *f = r_flag_new ();
+	char str[64];
+	p->flag_get = no_flag;
+	p->subtail = true;
+	// the tails are longer than the decimal numbers they replace
+	char *data = strdup ("b 511, 511, 0x100");
+	r_parse_filter (p, 0x100, f, NULL, data, str, sizeof (str), false);
+	mu_assert_streq (str, "b ..ff, ..ff, $$", "tails");
+	free (data);
+	r_flag_free (f);
+	r_parse_free (p);
+	r_anal_free (anal);
+	mu_end;
+}
+
+bool all_tests(void) {
+	mu_run_test (test_r_parse_tokenize);
+	mu_run_test (test_r_parse_filter_subreg);
+	mu_run_test (test_r_parse_filter_numbers);
+	mu_run_test (test_r_parse_filter_subtail);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
@@ -0,0 +1,161 @@
+#include <r_core.h>
+#include "minunit.h"
+
+#define ROP_SIZE 0x28000
+
+static char *home = NULL;
+static char *file = NULL;
+
+static RCore *open_core(int threads, bool cache) {
+	RCore *core = r_core_new ();
+	r_config_set_i (core->config, "scr.color", 0);
+	r_config_set (core->config, "asm.arch", "gb");
+	r_config_set_i (core->config, "rop.threads", threads);
+	r_config_set_b (core->config, "rop.cache", cache);
+	r_core_file_open (core, file, R_PERM_R, 0);
+	r_core_bin_load (core, file, 0);
+	return core;
+}
+
+static bool setup(void) {
+	// gameboy code, a few loads and pops between the returns
+	const ut8 ops[] = { 0x78, 0x79, 0xc1, 0xd1, 0xe1, 0xf1, 0x3c, 0x04, 0xaf, 0x00, 0xc9 };
+	home = r_file_temp ("rop_home");
+	file = r_file_temp ("rop_bin");
+	ut8 *buf = malloc (ROP_SIZE);
+	if (!home || !file || !buf || !r_sys_mkdirp (home)) {
+		free (buf);
+		return false;
+	}
+	r_sys_setenv ("HOME", home);
+	ut32 seed = 0x1337;
+	int i;
+	for (i = 0; i < ROP_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		buf[i] = ops[(seed >> 16) % sizeof (ops)];
+	}
+	bool ret = r_file_dump (file, buf, ROP_SIZE, false);
+	free (buf);
+	return ret;
+}
+
+static void teardown(void) {
+	r_file_rm_rf (home);
+	r_file_rm (file);
+	R_FREE (home);
+	R_FREE (file);
+}
+
+static char *rop_index_dir(void) {
+	return r_str_newf ("%s" R_SYS_DIR ".cache" R_SYS_DIR "radare2" R_SYS_DIR "rop", home);
+}
+
+bool test_rop_threads(void) {
+	RCore *core = open_core (1, false);
+	char *serial = r_core_cmd_str (core, "/Rq");
+	char *grep = r_core_cmd_str (core, "/Rq pop bc");
+	r_core_free (core);
+	mu_assert ("gadgets found", serial && r_str_char_count (serial, '\n') > 1000);
+
+	core = open_core (4, false);
+	char *threaded = r_core_cmd_str (core, "/Rq");
+	char *tgrep = r_core_cmd_str (core, "/Rq pop bc");
+	r_core_free (core);
+	mu_assert_streq (threaded, serial, "same gadgets in the same order");
+	mu_assert_streq (tgrep, grep, "same filtered gadgets");
+	mu_assert_notnull (strstr (grep, "pop bc"), "filtered gadgets found");
+	free (serial);
+	free (threaded);
+	free (grep);
+	free (tgrep);
+	mu_end;
+}
+
+static int lines(const char *s) {
+	return s? r_str_char_count (s, '\n'): -1;
+}
+
+static char *rop_index_file(const char *dir) {
+	RList *files = r_sys_dir (dir);
+	RListIter *iter;
+	char *name, *path = NULL;
+	r_list_foreach (files, iter, name) {
+		if (r_str_endswith (name, ".sdb")) {
+			path = r_str_newf ("%s" R_SYS_DIR "%s", dir, name);
+			break;
+		}
+	}
+	r_list_free (files);
+	return path;
+}
+
+bool test_rop_cache(void) {
+	char *dir = rop_index_dir ();
+	RCore *core = open_core (1, true);
+	char *full = r_core_cmd_str (core, "/Rq");
+	char *grep = r_core_cmd_str (core, "/Rq pop bc");
+	r_core_free (core);
+	RList *files = r_sys_dir (dir);
+	mu_assert_eq (r_list_length (files) - 2, 1, "one index written");
+	r_list_free (files);
+
+	// move the first gadget, only a query answered from the index sees it
+	char *path = rop_index_file (dir);
+	mu_assert_notnull (path, "index file");
+	char *db = r_file_slurp (path, NULL);
+	mu_assert_notnull (db, "index read");
+	char *first = strstr (db, "\n0=0x");
+	mu_assert_notnull (first, "first gadget indexed");
+	char *moved = r_str_newf ("%.*s1%s", (int)(first + 6 - db), db, first + 6);
+	r_file_dump (path, (const ut8 *)moved, strlen (moved), false);
+	core = open_core (1, true);
+	char *cached = r_core_cmd_str (core, "/Rq");
+	char *cgrep = r_core_cmd_str (core, "/Rq pop bc");
+	r_core_free (core);
+	mu_assert_eq (lines (cached), lines (full), "same number of gadgets");
+	mu_assert ("answered from the index", strcmp (cached, full));
+	mu_assert_eq (lines (cgrep), lines (grep), "index is filtered");
+
+	// patches in the io cache change the bytes, the range is swept again
+	core = open_core (1, true);
+	r_config_set_b (core->config, "io.cache", true);
+	ut8 *zero = calloc (1, ROP_SIZE);
+	r_io_write_at (core->io, 0, zero, ROP_SIZE);
+	free (zero);
+	char *patched = r_core_cmd_str (core, "/Rq");
+	r_core_free (core);
+	mu_assert_eq (lines (patched), 0, "patched range has no gadgets");
+
+	// other settings get their own index
+	core = open_core (1, true);
+	r_config_set_i (core->config, "rop.len", 3);
+	r_core_cmd0 (core, "/Rq");
+	r_core_free (core);
+	files = r_sys_dir (dir);
+	mu_assert_eq (r_list_length (files) - 2, 2, "index per settings");
+	r_list_free (files);
+	free (full);
+	free (grep);
+	free (path);
+	free (db);
+	free (moved);
+	free (cached);
+	free (cgrep);
+	free (patched);
+	free (dir);
+	mu_end;
+}
+
+int all_tests() {
+	if (!setup ()) {
+		return 1;
+	}
+	mu_run_test (test_rop_threads);
+	mu_run_test (test_rop_cache);
+	teardown ();
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}
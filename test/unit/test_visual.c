@@ -0,0 +1,46 @@
+#include <r_core.h>
+#include "minunit.h"
+
+// runs Visual on the given keys and counts the frames running cmd.visual
+static int visual_frames(bool dropframes, const char *keys) {
+	RCore *core = r_core_new ();
+	r_core_file_open (core, "malloc://512", R_PERM_RW, 0);
+	r_config_set_b (core->config, "scr.interactive", true);
+	r_config_set_b (core->config, "scr.null", true);
+	r_config_set_i (core->config, "scr.fix.columns", 80);
+	r_config_set_i (core->config, "scr.fix.rows", 25);
+	r_config_set_b (core->config, "scr.dropframes", dropframes);
+	r_config_set (core->config, "cmd.visual", "f frames=frames+1");
+	r_core_cmd0 (core, "f frames=0");
+	r_cons_readpush (keys, strlen (keys));
+	r_core_visual (core, "");
+	r_cons_readflush ();
+	int n = (int)r_num_math (core->num, "frames");
+	r_core_free (core);
+	return n;
+}
+
+bool test_visual_dropframes_default(void) {
+	RCore *core = r_core_new ();
+	mu_assert_false (r_config_get_b (core->config, "scr.dropframes"), "frames are not dropped by default");
+	r_core_free (core);
+	mu_end;
+}
+
+bool test_visual_dropframes_user_cmd(void) {
+	int frames = visual_frames (false, "pppq");
+	mu_assert_eq (frames, 4, "a frame per key");
+	// the keys are all pending, but cmd.visual is a user command
+	mu_assert_eq (visual_frames (true, "pppq"), frames, "cmd.visual runs on every frame");
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_visual_dropframes_default);
+	mu_run_test (test_visual_dropframes_user_cmd);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests ();
+}